@@ -0,0 +1,258 @@
+/**
+* @package    GraspStudio
+* @copyright  2026 GNU Lesser General Public License
+*/
+
+#define BOOST_TEST_MODULE GraspStudio_GraspStudioGenericGraspPlannerTest
+
+#include <VirtualRobot/VirtualRobotTest.h>
+#include <VirtualRobot/Robot.h>
+#include <VirtualRobot/ManipulationObject.h>
+#include <VirtualRobot/EndEffector/EndEffector.h>
+#include <VirtualRobot/EndEffector/EndEffectorActor.h>
+#include <VirtualRobot/Grasping/GraspSet.h>
+#include <VirtualRobot/Nodes/RobotNode.h>
+#include <VirtualRobot/XML/ObjectIO.h>
+#include <VirtualRobot/XML/RobotIO.h>
+
+#include <GraspPlanning/ApproachMovementSurfaceNormal.h>
+#include <GraspPlanning/GraspPlanner/GenericGraspPlanner.h>
+#include <GraspPlanning/GraspQuality/GraspQualityMeasureWrenchSpace.h>
+
+#include <chrono>
+#include <cmath>
+#include <set>
+#include <string>
+
+using namespace VirtualRobot;
+
+BOOST_AUTO_TEST_SUITE(GenericGraspPlanner)
+
+namespace
+{
+    // a gripper with two fingers of two links, built from primitives, which opens to -30 degree
+    RobotPtr createGripper()
+    {
+        auto link = [](const std::string& name, const std::string& translation, const std::string& axis, int length, const std::string& child)
+        {
+            return "  <RobotNode name='" + name + "'>"
+                   "    <Transform><Translation " + translation + "/></Transform>"
+                   "    <Joint type='revolute'>"
+                   "      <Limits unit='degree' lo='-30' hi='90'/>"
+                   "      <Axis " + axis + "/>"
+                   "    </Joint>"
+                   "    <CollisionModel><Primitives>"
+                   "      <Box width='10' height='30' depth='" + std::to_string(length) + "'>"
+                   "        <Transform><Translation x='0' y='0' z='" + std::to_string(length / 2) + "'/></Transform>"
+                   "      </Box>"
+                   "    </Primitives></CollisionModel>"
+                   + (child.empty() ? std::string() : "    <Child name='" + child + "'/>") +
+                   "  </RobotNode>";
+        };
+
+        std::string robotString =
+            "<Robot Type='Gripper' RootNode='Base'>"
+            "  <RobotNode name='Base'>"
+            "    <Child name='Palm'/>"
+            "    <Child name='GCP'/>"
+            "    <Child name='Left J0'/>"
+            "    <Child name='Right J0'/>"
+            "  </RobotNode>"
+            "  <RobotNode name='Palm'>"
+            "    <CollisionModel><Primitives><Box width='110' height='40' depth='20'/></Primitives></CollisionModel>"
+            "  </RobotNode>"
+            "  <RobotNode name='GCP'>"
+            "    <Transform><Translation x='0' y='0' z='60'/></Transform>"
+            "  </RobotNode>"
+            + link("Left J0", "x='-50' y='0' z='20'", "x='0' y='1' z='0'", 60, "Left J1")
+            + link("Left J1", "x='0' y='0' z='60'", "x='0' y='1' z='0'", 40, "")
+            + link("Right J0", "x='50' y='0' z='20'", "x='0' y='-1' z='0'", 60, "Right J1")
+            + link("Right J1", "x='0' y='0' z='60'", "x='0' y='-1' z='0'", 40, "") +
+            "  <Endeffector name='Gripper' base='Base' tcp='GCP' gcp='GCP'>"
+            "    <Static><Node name='Palm'/></Static>"
+            "    <Actor name='Left'>"
+            "      <Node name='Left J0' considerCollisions='All'/>"
+            "      <Node name='Left J1' considerCollisions='All'/>"
+            "    </Actor>"
+            "    <Actor name='Right'>"
+            "      <Node name='Right J0' considerCollisions='All'/>"
+            "      <Node name='Right J1' considerCollisions='All'/>"
+            "    </Actor>"
+            "  </Endeffector>"
+            "</Robot>";
+
+        RobotPtr robot = RobotIO::createRobotFromString(robotString, "", RobotIO::eCollisionModelNoVisualization);
+        BOOST_REQUIRE(robot);
+        BOOST_REQUIRE(robot->getEndEffector("Gripper"));
+        return robot;
+    }
+
+    ManipulationObjectPtr createObject()
+    {
+        std::string objectString =
+            "<ManipulationObject name='Object'>"
+            "  <CollisionModel><Primitives>"
+            "    <Cylinder radius='25' height='60'/>"
+            "    <Box width='30' height='30' depth='30'>"
+            "      <Transform><Translation x='0' y='40' z='0'/></Transform>"
+            "    </Box>"
+            "  </Primitives></CollisionModel>"
+            "</ManipulationObject>";
+
+        ManipulationObjectPtr object = ObjectIO::createManipulationObjectFromString(objectString, "", false);
+        BOOST_REQUIRE(object && object->getCollisionModel());
+        return object;
+    }
+
+    std::set<std::string> getContactNodes(const EndEffector::ContactInfoVector& contacts)
+    {
+        std::set<std::string> result;
+
+        for (const EndEffector::ContactInfo& c : contacts)
+        {
+            result.insert(c.robotNode->getName());
+        }
+
+        return result;
+    }
+
+    double elapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testAdaptiveClosing)
+{
+    RobotPtr robot = createGripper();
+    ManipulationObjectPtr object = createObject();
+    EndEffectorPtr eef = robot->getEndEffector("Gripper");
+    GraspStudio::ApproachMovementSurfaceNormalPtr approach(new GraspStudio::ApproachMovementSurfaceNormal(object, eef));
+    EndEffectorPtr eefCloned = approach->getEEF();
+    std::vector<RobotNodePtr> joints = eefCloned->getRobot()->getRobotNodes();
+    std::vector<EndEffectorActorPtr> actors;
+    eefCloned->getActors(actors);
+
+    const float stepSize = 0.02f;
+    const float tolerance = 0.002f;
+    int numPoses = 0;
+    int numContacts = 0;
+    int numEqual = 0;
+    float fixedDistance = 0.0f;
+    float fineDistance = 0.0f;
+    float adaptiveDistance = 0.0f;
+    double fixedMs = 0.0;
+    double fineMs = 0.0;
+    double adaptiveMs = 0.0;
+
+    while (numPoses < 100)
+    {
+        if (!approach->setEEFToRandomApproachPose())
+        {
+            continue;
+        }
+
+        numPoses++;
+        RobotConfigPtr open = eefCloned->getConfiguration();
+
+        eefCloned->setAdaptiveClosing(false);
+        auto start = std::chrono::steady_clock::now();
+        EndEffector::ContactInfoVector fixedContacts = eefCloned->closeActors(object, stepSize);
+        fixedMs += elapsedMs(start);
+        eefCloned->getRobot()->setJointValues(open);
+
+        // fixed steps with the accuracy of adaptive closing
+        start = std::chrono::steady_clock::now();
+        EndEffector::ContactInfoVector fineContacts = eefCloned->closeActors(object, tolerance);
+        fineMs += elapsedMs(start);
+        std::vector<float> fineValues;
+
+        for (const RobotNodePtr& joint : joints)
+        {
+            fineValues.push_back(joint->getJointValue());
+        }
+
+        eefCloned->getRobot()->setJointValues(open);
+        eefCloned->setAdaptiveClosing(true, tolerance);
+        start = std::chrono::steady_clock::now();
+        EndEffector::ContactInfoVector adaptiveContacts = eefCloned->closeActors(object, stepSize);
+        adaptiveMs += elapsedMs(start);
+
+        // the joints move together instead of one after another, hence the joint values may differ by a few fine steps
+        bool equal = getContactNodes(fineContacts) == getContactNodes(adaptiveContacts);
+
+        for (size_t i = 0; i < joints.size(); i++)
+        {
+            equal &= std::fabs(joints[i]->getJointValue() - fineValues[i]) < 5.0f * tolerance;
+        }
+
+        numEqual += equal ? 1 : 0;
+
+        // no contact is reported while a finger intersects the object (the palm may touch it at the approach pose)
+        for (const EndEffectorActorPtr& actor : actors)
+        {
+            BOOST_CHECK(!actor->isColliding(object));
+        }
+
+        for (const EndEffector::ContactInfo& c : fixedContacts)
+        {
+            fixedDistance += c.distance;
+        }
+
+        for (const EndEffector::ContactInfo& c : fineContacts)
+        {
+            fineDistance += c.distance;
+        }
+
+        for (const EndEffector::ContactInfo& c : adaptiveContacts)
+        {
+            BOOST_CHECK_GE(c.distance, 0.0f);
+            BOOST_CHECK_CLOSE(c.approachDirectionGlobal.norm(), 1.0f, 1e-3f);
+            adaptiveDistance += c.distance;
+        }
+
+        numContacts += int(adaptiveContacts.size());
+        eefCloned->getRobot()->setJointValues(open);
+    }
+
+    eefCloned->setAdaptiveClosing(false);
+    BOOST_TEST_MESSAGE("Closing the gripper at " << numPoses << " approach poses (" << numContacts << " contacts, " << numEqual
+                       << " equal to fine steps): fixed steps " << fixedMs << " ms (" << fixedDistance / numContacts << " mm), fine steps "
+                       << fineMs << " ms (" << fineDistance / numContacts << " mm), adaptive " << adaptiveMs << " ms ("
+                       << adaptiveDistance / numContacts << " mm)");
+    BOOST_CHECK_GT(numContacts, numPoses);
+    BOOST_CHECK_GE(numEqual, numPoses * 4 / 5);
+    BOOST_CHECK_LT(adaptiveDistance, fixedDistance);
+}
+
+BOOST_AUTO_TEST_CASE(testPlannerBenchmark)
+{
+    RobotPtr robot = createGripper();
+    ManipulationObjectPtr object = createObject();
+    EndEffectorPtr eef = robot->getEndEffector("Gripper");
+
+    for (bool adaptive : {false, true})
+    {
+        eef->setAdaptiveClosing(adaptive);
+        GraspSetPtr grasps(new GraspSet("Grasps", robot->getType(), eef->getName()));
+        GraspStudio::GraspQualityMeasureWrenchSpacePtr quality(new GraspStudio::GraspQualityMeasureWrenchSpace(object));
+        quality->calculateObjectProperties();
+        GraspStudio::ApproachMovementSurfaceNormalPtr approach(new GraspStudio::ApproachMovementSurfaceNormal(object, eef));
+        BOOST_REQUIRE(approach->getEEF()->isAdaptiveClosingEnabled() == adaptive);
+
+        GraspStudio::GenericGraspPlanner planner(grasps, quality, approach, 0.0f, false);
+        planner.setVerbose(false);
+        planner.setRetreatOnLowContacts(false);
+
+        const int numGrasps = 50;
+        auto start = std::chrono::steady_clock::now();
+        int planned = planner.plan(numGrasps, 600000);
+        double ms = elapsedMs(start);
+
+        BOOST_CHECK_EQUAL(planned, numGrasps);
+        BOOST_TEST_MESSAGE("GenericGraspPlanner, " << (adaptive ? "adaptive (tolerance 0.002)" : "fixed step (0.02)") << " closing: " << planned << " grasps in "
+                           << ms << " ms, " << planned / ms * 1000.0 << " grasps/s");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -8,6 +8,8 @@
 #include "ConfigurationConstraint.h"
 #include <VirtualRobot/CollisionDetection/CDManager.h>
 #include <VirtualRobot/CollisionDetection/CollisionChecker.h>
+#include <VirtualRobot/CollisionDetection/CollisionModel.h>
+#include <VirtualRobot/Visualization/TriMeshModel.h>
 #include <cfloat>
 #include <cmath>
 #include <fstream>
@@ -411,28 +413,88 @@ namespace Saba
         SABA_ASSERT(config.rows() == dimension)
         SABA_ASSERT(nextConfig.rows() == dimension)
 
-        SABA_WARNING << "NYI..." << endl;
-        // todo : oobb updates in VirtualRobot
-        return 0.0f;
-
-        /*if (multiThreaded)
-            colCheckMutex.lock();
-
-        robotNodes->setJointValues(config);
+        if (motionRadius.size() != dimension)
+        {
+            updateMotionBounds();
+        }
 
         float directedFreeSpaceStep = 0.0f;
-        for (unsigned int i=0;i<dimension;i++)
+
+        for (unsigned int i = 0; i < dimension; i++)
         {
+            float delta = fabs(nextConfig[i] - config[i]);
+
+            if (borderLessDimension[i])
+            {
+                delta = fabs(VirtualRobot::MathTools::AngleDelta(config[i], nextConfig[i]));
+            }
+
             if (robotJoints[i]->isRotationalJoint())
-                directedFreeSpaceStep += robotJoints[i]->getMaxDistanceOOBB() * fabs(nextConfig[i] - config[i]);
+            {
+                directedFreeSpaceStep += motionRadius[i] * delta;
+            }
             else if (robotJoints[i]->isTranslationalJoint())
-                directedFreeSpaceStep += fabs(nextConfig[i] - config[i]);
+            {
+                directedFreeSpaceStep += delta;
+            }
         }
 
+        return directedFreeSpaceStep;
+    }
+
+    // maximal distance of any collision model in the subtree of object to the origin of object
+    static float getSubtreeRadius(const VirtualRobot::SceneObjectPtr& object)
+    {
+        const Eigen::Vector3f origin = object->getGlobalPose().block<3, 1>(0, 3);
+        float radius = 0.0f;
+        VirtualRobot::CollisionModelPtr colModel = object->getCollisionModel();
+
+        if (colModel && colModel->getTriMeshModel())
+        {
+            const Eigen::Matrix4f pose = colModel->getGlobalPose();
+
+            for (const Eigen::Vector3f& v : colModel->getTriMeshModel()->vertices)
+            {
+                Eigen::Vector3f p = pose.block<3, 3>(0, 0) * v + pose.block<3, 1>(0, 3);
+                radius = std::max(radius, (p - origin).norm());
+            }
+        }
+
+        for (const VirtualRobot::SceneObjectPtr& child : object->getChildren())
+        {
+            // children of revolute joints keep their distance, prismatic children may move by their joint range
+            float offset = (child->getGlobalPose().block<3, 1>(0, 3) - origin).norm();
+            VirtualRobot::RobotNodePtr childNode = boost::dynamic_pointer_cast<VirtualRobot::RobotNode>(child);
+
+            if (childNode && childNode->isTranslationalJoint())
+            {
+                offset += fabs(childNode->getJointLimitHi() - childNode->getJointLimitLo());
+            }
+
+            radius = std::max(radius, offset + getSubtreeRadius(child));
+        }
+
+        return radius;
+    }
+
+    void CSpace::updateMotionBounds()
+    {
         if (multiThreaded)
-            colCheckMutex.unlock();
+        {
+            colCheckMutex.lock();
+        }
+
+        motionRadius.resize(dimension);
+
+        for (unsigned int i = 0; i < dimension; i++)
+        {
+            motionRadius[i] = getSubtreeRadius(robotJoints[i]);
+        }
 
-        return directedFreeSpaceStep;*/
+        if (multiThreaded)
+        {
+            colCheckMutex.unlock();
+        }
     }
 
 
@@ -284,6 +284,14 @@ namespace Saba
         Eigen::VectorXf interpolate(const Eigen::VectorXf& q1, const Eigen::VectorXf& q2, float step);
 
 
+        /*!
+            Computes for each c-space dimension the motion radius, i.e. the maximal distance between the joint and any point
+            of the collision models that are moved by the joint.
+            The radii are derived from the kinematic structure and do not depend on the configuration.
+            They are computed on the first call of getDirectedMaxMovement(), call this method again when objects have been attached to the robot.
+        */
+        void updateMotionBounds();
+
         //! check whether a configuration is valid (collision, boundary, and constraints check)
         virtual bool isConfigValid(const Eigen::VectorXf& pConfig, bool checkBorders = true, bool checkCollisions = true, bool checkConstraints = true);
 
@@ -304,7 +312,12 @@ namespace Saba
 
 
 
-        //! return upper limit for movement of any point on joints if moving from config to nextConfig
+        /*!
+            Returns an upper bound for the distance any point of the robot's geometry travels, when moving
+            linearly from config to nextConfig.
+            For rotational joints, the bound is the joint's motion radius (see updateMotionBounds()) times the angle,
+            translational joints move all attached points by the joint distance.
+        */
         virtual float getDirectedMaxMovement(const Eigen::VectorXf& config, const Eigen::VectorXf& nextConfig);
 
         static int cloneCounter;
@@ -335,6 +348,7 @@ namespace Saba
         std::vector< CSpaceNodePtr > freeNodes;                     //! vector with pointers to free (not used) nodes
 
         std::vector<VirtualRobot::RobotNodePtr> robotJoints;        //!< joints of the robot that we are manipulating
+        std::vector<float> motionRadius;                            //!< motion radius of each joint, empty until computed
 
         bool useMetricWeights;
         bool checkForBorderlessDims;
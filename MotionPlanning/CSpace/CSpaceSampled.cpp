@@ -4,7 +4,9 @@
 #include "CSpacePath.h"
 #include "CSpaceTree.h"
 #include "VirtualRobot/Robot.h"
+#include "VirtualRobot/VirtualRobotException.h"
 //#include "MathHelpers.h"
+#include <algorithm>
 #include <cmath>
 #include <cfloat>
 #include <iostream>
@@ -25,6 +27,8 @@ namespace Saba
         recursiveTmpValuesIndex = 0;
         samplingSizePaths = 0.1f;
         samplingSizeDCD = 0.1f;
+        useContinuousCollisionDetection = false;
+        minObstacleDistanceCCD = 1.0f;
         SABA_ASSERT(dimension != 0);
 
         checkPathConfig.setZero(dimension);
@@ -62,6 +66,7 @@ namespace Saba
         // sampled cspace
         result->setSamplingSize(getSamplingSize());
         result->setSamplingSizeDCD(getSamplingSizeDCD());
+        result->enableContinuousCollisionDetection(useContinuousCollisionDetection, minObstacleDistanceCCD);
 
         // todo
         return (CSpacePtr)result;
@@ -79,6 +84,13 @@ namespace Saba
         samplingSizeDCD = fSize;
     }
 
+    void CSpaceSampled::enableContinuousCollisionDetection(bool enable, float minObstacleDistance)
+    {
+        THROW_VR_EXCEPTION_IF(minObstacleDistance <= 0.0f, "The minimum obstacle distance of the continuous collision detection has to be positive");
+        useContinuousCollisionDetection = enable;
+        minObstacleDistanceCCD = minObstacleDistance;
+    }
+
 
     CSpacePathPtr CSpaceSampled::createPath(const Eigen::VectorXf& start, const Eigen::VectorXf& goal)
     {
@@ -243,13 +255,33 @@ namespace Saba
             return false;
         }
 
+        if (!useContinuousCollisionDetection)
+        {
+            return isPathValidDCD(q1, q2, true);
+        }
+
+        if (!constraints.empty() && !isPathValidDCD(q1, q2, false))
+        {
+            return false;
+        }
+
+        return isPathCollisionFreeCCD(q1, q2);
+    }
+
+    bool CSpaceSampled::isPathValidDCD(const Eigen::VectorXf& q1, const Eigen::VectorXf& q2, bool checkCollisions)
+    {
+        if (stopPathCheck)
+        {
+            return false;
+        }
+
         // actual weighted distance for collision checking
         float actualWeightedDistance = calcDist(q1, q2);
 
         if (actualWeightedDistance <= samplingSizeDCD * 1.001f)
         {
             // just checking q2, to avoid double checks
-            return isConfigValid(q2, false, true, true); // assuming that q1 and q2 are within the limits of the CSpace
+            return isConfigValid(q2, false, checkCollisions, true); // assuming that q1 and q2 are within the limits of the CSpace
         }
         else
         {
@@ -267,10 +299,46 @@ namespace Saba
             // generate a configuration exactly in the middle of q1 and q2 using weighted distances
             generateNewConfig(q2, q1, middleConfiguration, actualWeightedDistance * 0.5f, actualWeightedDistance);
 
-            bool r = (isPathValid(q1, middleConfiguration) && isPathValid(middleConfiguration, q2));
+            bool r = (isPathValidDCD(q1, middleConfiguration, checkCollisions) && isPathValidDCD(middleConfiguration, q2, checkCollisions));
             recursiveTmpValuesIndex--;
             return r;
         }
     }
 
+    bool CSpaceSampled::isPathCollisionFreeCCD(const Eigen::VectorXf& q1, const Eigen::VectorXf& q2)
+    {
+        // both objects of a checked pair may be moved by the robot, so their distance may shrink twice as fast
+        float maxMovement = 2.0f * getDirectedMaxMovement(q1, q2);
+        float t = 0.0f;
+
+        while (!stopPathCheck)
+        {
+            tmpConfig = interpolate(q1, q2, t);
+            float d = calculateObstacleDistance(tmpConfig);
+
+            if (d < minObstacleDistanceCCD)
+            {
+                return false;
+            }
+
+            if (t >= 1.0f || maxMovement <= 0.0f)
+            {
+                return true;
+            }
+
+            // no point can travel d on the segment [t, t + d / maxMovement], the step is at least minObstacleDistanceCCD / maxMovement
+            float next = std::min(1.0f, t + d / maxMovement);
+
+            if (next <= t)
+            {
+                // the step is below the float precision of t, the segment cannot be shown to be collision free
+                return false;
+            }
+
+            t = next;
+        }
+
+        return false;
+    }
+
 } // Saba
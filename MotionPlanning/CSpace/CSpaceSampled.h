@@ -87,6 +87,28 @@ namespace Saba
             return samplingSizeDCD;
         };
 
+        /*!
+            Enables continuous collision detection for path segments.
+            Instead of sampling a segment with the DCD sampling size, isPathValid() certifies it by conservative advancement:
+            The obstacle distance at the current configuration, divided by an upper bound of the motion of the robot's geometry
+            (see getDirectedMaxMovement()), gives a step along the segment that is guaranteed to be collision free.
+            Hence thin obstacles can not be missed and segments far from obstacles need only a few distance queries.
+            Requires a collision checker with distance support, constraints are still checked with the DCD sampling size.
+            \param enable Enable or disable the continuous mode.
+            \param minObstacleDistance Segments that get closer to an obstacle than this distance are reported as invalid.
+                   It has to be positive, since it bounds the number of distance queries of a segment from below.
+        */
+        void enableContinuousCollisionDetection(bool enable, float minObstacleDistance = 1.0f);
+
+        bool isContinuousCollisionDetectionEnabled()
+        {
+            return useContinuousCollisionDetection;
+        }
+        float getMinObstacleDistanceCCD()
+        {
+            return minObstacleDistanceCCD;
+        }
+
 
 
         CSpacePtr clone(VirtualRobot::CollisionCheckerPtr newColChecker, VirtualRobot::RobotPtr newRobot, VirtualRobot::CDManagerPtr newCDM, unsigned int newRandomSeed = 0) override;
@@ -96,6 +118,7 @@ namespace Saba
             and both parts are recursively checked until the distance is smalled than the DCD sampling size.
             Recursion is performed maximal recursionMaxDepth times, since an array of temporary variables is used,
             in order to avoid slow allocating/deallocating of memory.
+            When continuous collision detection is enabled, collisions are checked by conservative advancement instead.
         */
         bool isPathValid(const Eigen::VectorXf& q1, const Eigen::VectorXf& q2) override;
 
@@ -116,6 +139,11 @@ namespace Saba
 
 
     protected:
+        //! Recursive check of the segment with the DCD sampling size.
+        bool isPathValidDCD(const Eigen::VectorXf& q1, const Eigen::VectorXf& q2, bool checkCollisions);
+
+        //! Conservative advancement along the segment, see enableContinuousCollisionDetection().
+        bool isPathCollisionFreeCCD(const Eigen::VectorXf& q1, const Eigen::VectorXf& q2);
 
         float samplingSizePaths;                //!< euclidean sample size
         float samplingSizeDCD;                  //!< euclidean sample size for collision check
@@ -126,6 +154,9 @@ namespace Saba
         Eigen::VectorXf tmpConfig;
 
         const int recursionMaxDepth;
+
+        bool useContinuousCollisionDetection;
+        float minObstacleDistanceCCD;
     };
 
 }
@@ -15,6 +15,8 @@
 #include <VirtualRobot/Obstacle.h>
 #include <CSpace/CSpaceSampled.h>
 #include <VirtualRobot/CollisionDetection/CDManager.h>
+#include <VirtualRobot/Visualization/TriMeshUtils.h>
+#include <VirtualRobot/VirtualRobotException.h>
 #include <string>
 
 #include <Eigen/Core>
@@ -135,4 +137,73 @@ BOOST_AUTO_TEST_CASE(testCSpace)
 
 }
 
+BOOST_AUTO_TEST_CASE(testContinuousCollisionDetection)
+{
+    const std::string robotString =
+        "<Robot Type='MyDemoRobotType' StandardName='ExampleRobo' RootNode='Joint1'>"
+        " <RobotNode name='Joint1'>"
+        "   <Joint type='revolute'>"
+        "    <Limits unit='degree' lo='-180' hi='180'/>"
+        "	  <Axis x='0' y='0' z='1'/>"
+        "   </Joint>"
+        " </RobotNode>"
+        "</Robot>";
+    VirtualRobot::RobotPtr rob = VirtualRobot::RobotIO::createRobotFromString(robotString);
+    BOOST_REQUIRE(rob);
+
+    // a thin bar along the x axis, rotating around z
+    VirtualRobot::RobotNodePtr joint = rob->getRobotNode("Joint1");
+    Eigen::Matrix4f barPose = Eigen::Matrix4f::Identity();
+    barPose(0, 3) = 250.0f;
+    joint->setCollisionModel(VirtualRobot::CollisionModelPtr(new VirtualRobot::CollisionModel(VirtualRobot::TriMeshUtils::CreateBox(barPose, 500.0f, 2.0f, 10.0f))));
+
+    // a thin wall at 1.2 rad, between the configurations that are checked with a DCD sampling size of 1 rad
+    Eigen::Vector3f wallDir(std::cos(1.2f), std::sin(1.2f), 0);
+    VirtualRobot::ObstaclePtr wall(new VirtualRobot::Obstacle("wall", VirtualRobot::VisualizationNodePtr(),
+                                   VirtualRobot::CollisionModelPtr(new VirtualRobot::CollisionModel(VirtualRobot::TriMeshUtils::CreateBox(Eigen::Matrix4f::Identity(), 2.0f, 2.0f, 40.0f)))));
+    Eigen::Matrix4f wallPose = Eigen::Matrix4f::Identity();
+    wallPose.block<3, 1>(0, 3) = wallDir * 300.0f;
+    wall->setGlobalPose(wallPose);
+
+    std::vector< std::string > nodes;
+    nodes.push_back(std::string("Joint1"));
+    VirtualRobot::RobotNodeSetPtr rns = VirtualRobot::RobotNodeSet::createRobotNodeSet(rob, "nodeSet", nodes);
+    VirtualRobot::CDManagerPtr cdm(new VirtualRobot::CDManager());
+    cdm->addCollisionModelPair(wall, rns);
+    Saba::CSpaceSampledPtr cspace(new Saba::CSpaceSampled(rob, cdm, rns));
+    cspace->setSamplingSizeDCD(1.0f);
+
+    Eigen::VectorXf start(1);
+    Eigen::VectorXf goal(1);
+    Eigen::VectorXf free(1);
+    start(0) = 0;
+    goal(0) = (float)M_PI - 0.1f;
+    free(0) = 1.0f;
+
+    BOOST_REQUIRE(cspace->isConfigValid(start));
+    BOOST_REQUIRE(cspace->isConfigValid(goal));
+
+    // discrete sampling misses the wall
+    BOOST_CHECK(cspace->isPathValid(start, goal));
+
+    cspace->enableContinuousCollisionDetection(true, 0.5f);
+    BOOST_CHECK(!cspace->isPathValid(start, goal));
+    BOOST_CHECK(!cspace->isPathValid(goal, start));
+
+    // the bar stops ~60 mm before the wall
+    cspace->resetPerformanceVars();
+    BOOST_CHECK(cspace->isPathValid(start, free));
+    BOOST_CHECK_GT(cspace->performaceVars_distanceCheck, 1);
+
+    // without a positive threshold the advancement could stall at touching geometry
+    BOOST_CHECK_THROW(cspace->enableContinuousCollisionDetection(true, 0.0f), VirtualRobot::VirtualRobotException);
+    BOOST_CHECK_THROW(cspace->enableContinuousCollisionDetection(true, -1.0f), VirtualRobot::VirtualRobotException);
+    BOOST_CHECK_EQUAL(cspace->getMinObstacleDistanceCCD(), 0.5f);
+
+    // a tiny threshold still terminates
+    cspace->enableContinuousCollisionDetection(true, 1e-6f);
+    BOOST_CHECK(!cspace->isPathValid(start, goal));
+    BOOST_CHECK(cspace->isPathValid(start, free));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
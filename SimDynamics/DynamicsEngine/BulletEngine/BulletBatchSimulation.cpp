@@ -0,0 +1,272 @@
+#include "BulletBatchSimulation.h"
+
+#include <VirtualRobot/Obstacle.h>
+#include <VirtualRobot/ManipulationObject.h>
+#include <VirtualRobot/Robot.h>
+#include <VirtualRobot/Nodes/RobotNode.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace VirtualRobot;
+
+namespace SimDynamics
+{
+
+    VirtualRobot::SceneObjectPtr BulletBatchSimulation::World::getObject(const std::string& name) const
+    {
+        for (const auto& o : objects)
+        {
+            if (o->getName() == name)
+            {
+                return o;
+            }
+        }
+
+        return SceneObjectPtr();
+    }
+
+    VirtualRobot::RobotPtr BulletBatchSimulation::World::getRobot(const std::string& name) const
+    {
+        for (const auto& r : robots)
+        {
+            if (r->getName() == name)
+            {
+                return r;
+            }
+        }
+
+        return RobotPtr();
+    }
+
+    BulletBatchSimulation::BulletBatchSimulation(ScenePtr scene, BulletEngineConfigPtr config) :
+        scene(scene),
+        config(config),
+        dt(0.01),
+        maxSubSteps(10),
+        fixedTimeStep(0.001),
+        floorEnabled(true),
+        floorPos(Eigen::Vector3f::Zero()),
+        floorUp(Eigen::Vector3f::UnitZ()),
+        poseSyncMode(BulletEngine::eSyncOnDemand)
+    {
+        THROW_VR_EXCEPTION_IF(!scene, "NULL scene");
+
+        if (!this->config)
+        {
+            this->config.reset(new BulletEngineConfig());
+        }
+
+        statistics = Statistics();
+    }
+
+    BulletBatchSimulation::~BulletBatchSimulation()
+    {
+        worlds.clear();
+    }
+
+    void BulletBatchSimulation::setSetupCallback(SetupCallback callback)
+    {
+        setupCallback = callback;
+    }
+
+    void BulletBatchSimulation::setStepCallback(StepCallback callback)
+    {
+        stepCallback = callback;
+    }
+
+    void BulletBatchSimulation::setEvaluateCallback(EvaluateCallback callback)
+    {
+        evaluateCallback = callback;
+    }
+
+    void BulletBatchSimulation::setTimeStep(double dt, int maxSubSteps, double fixedTimeStep)
+    {
+        THROW_VR_EXCEPTION_IF(dt <= 0 || fixedTimeStep <= 0 || maxSubSteps < 1, "Invalid time step parameters");
+        this->dt = dt;
+        this->maxSubSteps = maxSubSteps;
+        this->fixedTimeStep = fixedTimeStep;
+    }
+
+    void BulletBatchSimulation::setFloorPlane(bool enable, const Eigen::Vector3f& pos, const Eigen::Vector3f& up)
+    {
+        floorEnabled = enable;
+        floorPos = pos;
+        floorUp = up;
+    }
+
+    void BulletBatchSimulation::setPoseSyncMode(BulletEngine::PoseSyncMode mode)
+    {
+        poseSyncMode = mode;
+    }
+
+    BulletBatchSimulation::World BulletBatchSimulation::createWorld(size_t worldIndex)
+    {
+        World w;
+        w.world = DynamicsWorld::Create(config);
+        w.engine = boost::dynamic_pointer_cast<BulletEngine>(w.world->getEngine());
+        THROW_VR_EXCEPTION_IF(!w.engine, "Batch simulation requires the Bullet engine");
+        w.engine->setPoseSyncMode(poseSyncMode);
+
+        if (floorEnabled)
+        {
+            w.world->createFloorPlane(floorPos, floorUp);
+        }
+
+        // each world needs its own scene objects, since the engine writes the simulated poses back to them
+        for (const auto& r : scene->getRobots())
+        {
+            RobotPtr robot = r->clone(r->getName());
+            DynamicsRobotPtr dynRobot = DynamicsWorld::CreateDynamicsRobot(robot);
+            w.world->addRobot(dynRobot);
+            w.robots.push_back(robot);
+            w.dynamicsRobots.push_back(dynRobot);
+        }
+
+        std::vector<SceneObjectPtr> objects;
+
+        for (const auto& o : scene->getObstacles())
+        {
+            objects.push_back(o->clone(o->getName()));
+        }
+
+        for (const auto& o : scene->getManipulationObjects())
+        {
+            objects.push_back(o->clone(o->getName()));
+        }
+
+        for (const auto& o : objects)
+        {
+            DynamicsObjectPtr dynObject = DynamicsWorld::CreateDynamicsObject(o);
+            w.world->addObject(dynObject);
+            w.objects.push_back(o);
+            w.dynamicsObjects.push_back(dynObject);
+        }
+
+        if (setupCallback)
+        {
+            setupCallback(worldIndex, w);
+        }
+
+        return w;
+    }
+
+    void BulletBatchSimulation::simulate(size_t worldIndex, int steps)
+    {
+        World& w = worlds[worldIndex];
+        WorldResult& result = results[worldIndex];
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < steps; i++)
+        {
+            w.engine->stepSimulation(dt, maxSubSteps, fixedTimeStep);
+
+            if (stepCallback)
+            {
+                stepCallback(worldIndex, w, w.engine->getSimTime());
+            }
+        }
+
+        result.wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.worldIndex = worldIndex;
+        result.steps = steps;
+        result.simTime = w.engine->getSimTime();
+
+        w.engine->syncSimoxPoses();
+
+        for (const auto& o : w.objects)
+        {
+            result.poses[o->getName()] = o->getGlobalPose();
+        }
+
+        for (const auto& r : w.robots)
+        {
+            result.poses[r->getName()] = r->getGlobalPose();
+
+            for (const auto& n : r->getRobotNodes())
+            {
+                if (n->isRotationalJoint() || n->isTranslationalJoint())
+                {
+                    result.jointValues[r->getName() + ":" + n->getName()] = n->getJointValue();
+                }
+            }
+        }
+
+        if (evaluateCallback)
+        {
+            evaluateCallback(worldIndex, w, result);
+        }
+    }
+
+    const std::vector<BulletBatchSimulation::WorldResult, Eigen::aligned_allocator<BulletBatchSimulation::WorldResult> >& BulletBatchSimulation::run(size_t numWorlds, double simSeconds, size_t numThreads)
+    {
+        if (numThreads == 0)
+        {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        numThreads = std::max<size_t>(1, std::min(numThreads, numWorlds));
+
+        worlds.clear();
+        results.clear();
+
+        for (size_t i = 0; i < numWorlds; i++)
+        {
+            worlds.push_back(createWorld(i));
+        }
+
+        results.resize(numWorlds);
+        int steps = int(std::ceil(simSeconds / dt - 1e-9));
+
+        // worlds are handed out one at a time, so that threads that finish early pick up the remaining ones
+        std::atomic<size_t> nextWorld(0);
+        std::vector<std::thread> threads;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (size_t t = 0; t < numThreads; t++)
+        {
+            threads.emplace_back([this, &nextWorld, numWorlds, steps]()
+            {
+                for (size_t i = nextWorld++; i < numWorlds; i = nextWorld++)
+                {
+                    simulate(i, steps);
+                }
+            });
+        }
+
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        statistics.worlds = numWorlds;
+        statistics.threads = numThreads;
+        statistics.totalSteps = numWorlds * size_t(steps);
+        statistics.wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        statistics.worldStepsPerSecond = statistics.wallTime > 0 ? double(statistics.totalSteps) / statistics.wallTime : 0;
+        statistics.worldStepsPerSecondPerThread = statistics.worldStepsPerSecond / double(numThreads);
+
+        return results;
+    }
+
+    const std::vector<BulletBatchSimulation::WorldResult, Eigen::aligned_allocator<BulletBatchSimulation::WorldResult> >& BulletBatchSimulation::getResults() const
+    {
+        return results;
+    }
+
+    const BulletBatchSimulation::Statistics& BulletBatchSimulation::getStatistics() const
+    {
+        return statistics;
+    }
+
+    std::vector<BulletBatchSimulation::World>& BulletBatchSimulation::getWorlds()
+    {
+        return worlds;
+    }
+
+} // namespace SimDynamics
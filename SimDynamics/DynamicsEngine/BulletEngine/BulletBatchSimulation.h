@@ -0,0 +1,178 @@
+/**
+* This file is part of Simox.
+*
+* Simox is free software; you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 2 of
+* the License, or (at your option) any later version.
+*
+* Simox is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* @package    SimDynamics
+* @copyright  2026 GNU Lesser General Public License
+*
+*/
+#pragma once
+
+#include "../../DynamicsWorld.h"
+#include "BulletEngine.h"
+
+#include <VirtualRobot/Scene.h>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace SimDynamics
+{
+    /*!
+        Runs many independent simulations of the same scene without any visualization.
+
+        For each world a copy of the scene (robots, obstacles and manipulation objects) is created and added to its own
+        DynamicsWorld/BulletEngine. The worlds are set up sequentially, since model loading and cloning is not thread safe,
+        and then stepped in parallel on a pool of worker threads. Each world is simulated by exactly one thread at a time,
+        so the per-engine mutex is never contended.
+
+        Typical usage for a parameter sweep:
+        \code
+        BulletBatchSimulation batch(SceneIO::loadScene("scene.xml"));
+        batch.setSetupCallback([&](size_t i, BulletBatchSimulation::World & w) { w.getObstacle("box")->... });
+        batch.run(100, 2.0);
+        for (auto& r : batch.getResults()) ...
+        \endcode
+    */
+    class SIMDYNAMICS_IMPORT_EXPORT BulletBatchSimulation
+    {
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        //! One simulated copy of the scene.
+        struct World
+        {
+            DynamicsWorldPtr world;
+            BulletEnginePtr engine;
+            std::vector<VirtualRobot::RobotPtr> robots;
+            std::vector<VirtualRobot::SceneObjectPtr> objects;
+            std::vector<DynamicsRobotPtr> dynamicsRobots;
+            std::vector<DynamicsObjectPtr> dynamicsObjects;
+
+            //! Returns the copy of the scene object (obstacle or manipulation object) with the given name.
+            VirtualRobot::SceneObjectPtr getObject(const std::string& name) const;
+            //! Returns the copy of the robot with the given name.
+            VirtualRobot::RobotPtr getRobot(const std::string& name) const;
+        };
+
+        //! Result of one world.
+        struct WorldResult
+        {
+            EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+            size_t worldIndex;
+            int steps;
+            double simTime;
+            //! Wall-clock time that was spent stepping this world [s]
+            double wallTime;
+            //! Final global poses of all objects and robot roots, by name
+            std::map<std::string, Eigen::Matrix4f, std::less<std::string>, Eigen::aligned_allocator<std::pair<const std::string, Eigen::Matrix4f> > > poses;
+            //! Final joint values of all robots, by robot node name (prefixed with the robot name and a colon)
+            std::map<std::string, float> jointValues;
+            //! Custom values, filled by the evaluation callback
+            std::map<std::string, float> values;
+        };
+
+        //! Throughput of the last run.
+        struct Statistics
+        {
+            size_t worlds;
+            size_t threads;
+            size_t totalSteps;
+            double wallTime;
+            double worldStepsPerSecond;
+            double worldStepsPerSecondPerThread;
+        };
+
+        //! Called for each world after it was created and before it is stepped (e.g. to vary parameters or initial poses).
+        typedef std::function<void(size_t worldIndex, World& world)> SetupCallback;
+        //! Called once per step of each world, from the worker thread that steps the world.
+        typedef std::function<void(size_t worldIndex, World& world, double simTime)> StepCallback;
+        //! Called after the last step of each world, from the worker thread, to extract custom results.
+        typedef std::function<void(size_t worldIndex, World& world, WorldResult& result)> EvaluateCallback;
+
+        /*!
+            \param scene The scene that is copied for each world. It is not modified.
+            \param config The engine configuration of all worlds. If not set, a standard BulletEngineConfig is used.
+        */
+        BulletBatchSimulation(VirtualRobot::ScenePtr scene, BulletEngineConfigPtr config = BulletEngineConfigPtr());
+        virtual ~BulletBatchSimulation();
+
+        void setSetupCallback(SetupCallback callback);
+        void setStepCallback(StepCallback callback);
+        void setEvaluateCallback(EvaluateCallback callback);
+
+        /*!
+            Set the time step parameters that are passed to BulletEngine::stepSimulation(), all in seconds.
+            Standard: dt = 0.01, maxSubSteps = 10, fixedTimeStep = 0.001
+        */
+        void setTimeStep(double dt, int maxSubSteps, double fixedTimeStep);
+
+        /*!
+            Create a floor plane in every world. Enabled by default.
+        */
+        void setFloorPlane(bool enable, const Eigen::Vector3f& pos = Eigen::Vector3f::Zero(), const Eigen::Vector3f& up = Eigen::Vector3f::UnitZ());
+
+        /*!
+            By default the Simox poses are only synchronized at the end of the run (BulletEngine::eSyncOnDemand),
+            which is the fastest mode. Set eSyncPerStep if a step callback needs up-to-date Simox poses.
+        */
+        void setPoseSyncMode(BulletEngine::PoseSyncMode mode);
+
+        /*!
+            Creates numWorlds copies of the scene and simulates each of them for simSeconds.
+            \param numThreads Number of worker threads. If 0, std::thread::hardware_concurrency() is used.
+            \return The collected results, ordered by world index.
+        */
+        const std::vector<WorldResult, Eigen::aligned_allocator<WorldResult> >& run(size_t numWorlds, double simSeconds, size_t numThreads = 0);
+
+        const std::vector<WorldResult, Eigen::aligned_allocator<WorldResult> >& getResults() const;
+        const Statistics& getStatistics() const;
+
+        /*!
+            The worlds of the last run. They are kept until the next run or until the batch is destroyed,
+            so that they can be inspected after the simulation.
+        */
+        std::vector<World>& getWorlds();
+
+    protected:
+        World createWorld(size_t worldIndex);
+        void simulate(size_t worldIndex, int steps);
+
+        VirtualRobot::ScenePtr scene;
+        BulletEngineConfigPtr config;
+
+        SetupCallback setupCallback;
+        StepCallback stepCallback;
+        EvaluateCallback evaluateCallback;
+
+        double dt;
+        int maxSubSteps;
+        double fixedTimeStep;
+        bool floorEnabled;
+        Eigen::Vector3f floorPos;
+        Eigen::Vector3f floorUp;
+        BulletEngine::PoseSyncMode poseSyncMode;
+
+        std::vector<World> worlds;
+        std::vector<WorldResult, Eigen::aligned_allocator<WorldResult> > results;
+        Statistics statistics;
+    };
+
+    typedef boost::shared_ptr<BulletBatchSimulation> BulletBatchSimulationPtr;
+
+} // namespace SimDynamics
@@ -1,6 +1,7 @@
 #include "BulletEngine.h"
 #include "BulletObject.h"
 #include "SimoxCollisionDispatcher.h"
+#include <BulletDynamics/Featherstone/btMultiBodyConstraintSolver.h>
 #include "../../DynamicsWorld.h"
 #include <VirtualRobot/Obstacle.h>
 #include <VirtualRobot/MathTools.h>
@@ -27,6 +28,7 @@ namespace SimDynamics
         bulletSolverSuccessiveOverRelaxation = btScalar(0.0);
         //bulletSolverContactSurfaceLayer = btScalar(0.001);
         bulletSolverSplitImpulsePenetrationThreshold = btScalar(-0.01);
+        bulletUseMultiBodyWorld = false;
     }
 
 
@@ -39,6 +41,7 @@ namespace SimDynamics
         constraintSolver = nullptr;
         dynamicsWorld = nullptr;
         simTime = 0;
+        poseSyncMode = eSyncImmediate;
     }
 
     BulletEngine::~BulletEngine()
@@ -87,9 +90,17 @@ namespace SimDynamics
         //overlappingPairCache = new btSimpleBroadphase();
 
 
-        constraintSolver = new btSequentialImpulseConstraintSolver;
-
-        dynamicsWorld = new btDiscreteDynamicsWorld(dispatcher, overlappingPairCache, constraintSolver, collision_config);
+        if (config->bulletUseMultiBodyWorld)
+        {
+            btMultiBodyConstraintSolver* multiBodySolver = new btMultiBodyConstraintSolver;
+            constraintSolver = multiBodySolver;
+            dynamicsWorld = new btMultiBodyDynamicsWorld(dispatcher, overlappingPairCache, multiBodySolver, collision_config);
+        }
+        else
+        {
+            constraintSolver = new btSequentialImpulseConstraintSolver;
+            dynamicsWorld = new btDiscreteDynamicsWorld(dispatcher, overlappingPairCache, constraintSolver, collision_config);
+        }
 
         dynamicsWorld->setGravity(btVector3(btScalar(config->gravity[0] * BulletObject::ScaleFactor),
                                   btScalar(config->gravity[1] * BulletObject::ScaleFactor),
@@ -240,6 +251,7 @@ namespace SimDynamics
         btObject->getRigidBody()->setAngularVelocity(btVector3(0, 0, 0));
         btObject->getRigidBody()->setLinearVelocity(btVector3(0, 0, 0));
         btObject->getRigidBody()->activate(true);
+        btObject->getMotionState()->setDeferredSync(poseSyncMode != eSyncImmediate);
 
         return DynamicsEngine::addObject(o);
     }
@@ -275,6 +287,16 @@ namespace SimDynamics
         return dynamicsWorld;
     }
 
+    btMultiBodyDynamicsWorld* BulletEngine::getBulletMultiBodyWorld()
+    {
+        if (!bulletConfig || !bulletConfig->bulletUseMultiBodyWorld)
+        {
+            return nullptr;
+        }
+
+        return static_cast<btMultiBodyDynamicsWorld*>(dynamicsWorld);
+    }
+
     void BulletEngine::createFloorPlane(const Eigen::Vector3f& pos, const Eigen::Vector3f& up, float friction)
     {
         MutexLockPtr lock = getScopedLock();
@@ -418,6 +440,13 @@ namespace SimDynamics
     bool BulletEngine::addRobot(DynamicsRobotPtr r)
     {
         MutexLockPtr lock = getScopedLock();
+        BulletMultiBodyRobotPtr mbRobot = boost::dynamic_pointer_cast<BulletMultiBodyRobot>(r);
+
+        if (mbRobot)
+        {
+            return addMultiBodyRobot(mbRobot) && DynamicsEngine::addRobot(r);
+        }
+
         BulletRobotPtr btRobot = boost::dynamic_pointer_cast<BulletRobot>(r);
 
         if (!btRobot)
@@ -474,6 +503,17 @@ namespace SimDynamics
     {
         for (auto & robot : robots)
         {
+            if (poseSyncMode == eSyncImmediate)
+            {
+                // the rigid bodies of BulletRobots are synchronized by their motion states
+                BulletMultiBodyRobotPtr mbRobot = boost::dynamic_pointer_cast<BulletMultiBodyRobot>(robot);
+
+                if (mbRobot)
+                {
+                    mbRobot->syncSimoxPose();
+                }
+            }
+
             robot->actuateJoints(static_cast<double>(timeStep));
             robot->updateSensors(static_cast<double>(timeStep));
         }
@@ -482,6 +522,14 @@ namespace SimDynamics
     bool BulletEngine::removeRobot(DynamicsRobotPtr r)
     {
         MutexLockPtr lock = getScopedLock();
+        BulletMultiBodyRobotPtr mbRobot = boost::dynamic_pointer_cast<BulletMultiBodyRobot>(r);
+
+        if (mbRobot)
+        {
+            removeMultiBodyRobot(mbRobot);
+            return DynamicsEngine::removeRobot(r);
+        }
+
         BulletRobotPtr btRobot = boost::dynamic_pointer_cast<BulletRobot>(r);
 
         if (!btRobot)
@@ -507,6 +555,90 @@ namespace SimDynamics
         return DynamicsEngine::removeRobot(r);
     }
 
+    bool BulletEngine::addMultiBodyRobot(BulletMultiBodyRobotPtr r)
+    {
+        MutexLockPtr lock = getScopedLock();
+        btMultiBodyDynamicsWorld* world = getBulletMultiBodyWorld();
+
+        if (!world)
+        {
+            VR_ERROR << "Robot " << r->getName() << " needs a btMultiBody world, see BulletEngineConfig::bulletUseMultiBodyWorld" << endl;
+            return false;
+        }
+
+        btMultiBody* multiBody = r->getMultiBody();
+        multiBody->setLinearDamping(bulletConfig->bulletObjectDampingLinear);
+        multiBody->setAngularDamping(bulletConfig->bulletObjectDampingAngular);
+        world->addMultiBody(multiBody);
+
+        for (auto collider : r->getColliders())
+        {
+            BulletObject* o = static_cast<BulletObject*>(collider->getUserPointer());
+            auto friction = o->getSceneObject()->getPhysics().friction;
+            collider->setRestitution(bulletConfig->bulletObjectRestitution);
+            collider->setFriction(friction > 0.0 ? friction : bulletConfig->bulletObjectFriction);
+
+            if (r->hasFixedBase() && collider->m_link < 0)
+            {
+                collider->setCollisionFlags(btCollisionObject::CF_STATIC_OBJECT);
+                world->addCollisionObject(collider, short(btBroadphaseProxy::StaticFilter), short(btBroadphaseProxy::AllFilter ^ btBroadphaseProxy::StaticFilter));
+            }
+            else
+            {
+                world->addCollisionObject(collider, short(btBroadphaseProxy::DefaultFilter), short(btBroadphaseProxy::AllFilter));
+            }
+        }
+
+        for (auto constraint : r->getJointConstraints())
+        {
+            world->addMultiBodyConstraint(constraint);
+        }
+
+        for (auto & disabledCollisionPair : r->disabledCollisionPairs)
+        {
+            this->disableCollision(disabledCollisionPair.first.get(), disabledCollisionPair.second.get());
+        }
+
+        return true;
+    }
+
+    bool BulletEngine::removeMultiBodyRobot(BulletMultiBodyRobotPtr r)
+    {
+        MutexLockPtr lock = getScopedLock();
+        btMultiBodyDynamicsWorld* world = getBulletMultiBodyWorld();
+
+        if (!world)
+        {
+            return false;
+        }
+
+        for (auto constraint : r->getJointConstraints())
+        {
+            world->removeMultiBodyConstraint(constraint);
+        }
+
+        for (auto collider : r->getColliders())
+        {
+            world->removeCollisionObject(collider);
+        }
+
+        world->removeMultiBody(r->getMultiBody());
+
+        // frees the collision filter slots of the links together with their disabled pairs
+        for (auto & disabledCollisionPair : r->disabledCollisionPairs)
+        {
+            releaseCollisionFilterIndex(disabledCollisionPair.first.get());
+            releaseCollisionFilterIndex(disabledCollisionPair.second.get());
+        }
+
+        for (auto collider : r->getColliders())
+        {
+            releaseCollisionFilterIndex(static_cast<BulletObject*>(collider->getUserPointer()));
+        }
+
+        return true;
+    }
+
     bool BulletEngine::addLink(BulletRobot::LinkInfo& l)
     {
         MutexLockPtr lock = getScopedLock();
@@ -548,6 +680,12 @@ namespace SimDynamics
         {
             cout << "++ Robot " << i << ":" << objects[i]->getName() << endl;
             BulletRobotPtr br = boost::dynamic_pointer_cast<BulletRobot>(robots[i]);
+
+            if (!br)
+            {
+                continue;
+            }
+
             std::vector<BulletRobot::LinkInfo> links = br->getLinks();
 
             for (size_t j = 0; j < links.size(); j++)
@@ -644,6 +782,11 @@ namespace SimDynamics
         MutexLockPtr lock = getScopedLock();
         simTime += dt;
         dynamicsWorld->stepSimulation(btScalar(dt), maxSubSteps, btScalar(fixedTimeStep));
+
+        if (poseSyncMode == eSyncPerStep)
+        {
+            syncSimoxPoses();
+        }
     }
 
     double BulletEngine::getSimTime()
@@ -651,6 +794,53 @@ namespace SimDynamics
         return simTime;
     }
 
+    void BulletEngine::setPoseSyncMode(PoseSyncMode mode)
+    {
+        MutexLockPtr lock = getScopedLock();
+        poseSyncMode = mode;
+
+        for (auto& o : objects)
+        {
+            BulletObjectPtr btObject = boost::dynamic_pointer_cast<BulletObject>(o);
+
+            if (btObject)
+            {
+                // leaving the deferred mode synchronizes pending poses
+                btObject->getMotionState()->setDeferredSync(mode != eSyncImmediate);
+            }
+        }
+    }
+
+    BulletEngine::PoseSyncMode BulletEngine::getPoseSyncMode()
+    {
+        return poseSyncMode;
+    }
+
+    void BulletEngine::syncSimoxPoses()
+    {
+        MutexLockPtr lock = getScopedLock();
+
+        for (auto& o : objects)
+        {
+            BulletObjectPtr btObject = boost::dynamic_pointer_cast<BulletObject>(o);
+
+            if (btObject)
+            {
+                btObject->getMotionState()->syncSimoxPose();
+            }
+        }
+
+        for (auto& r : robots)
+        {
+            BulletMultiBodyRobotPtr mbRobot = boost::dynamic_pointer_cast<BulletMultiBodyRobot>(r);
+
+            if (mbRobot)
+            {
+                mbRobot->syncSimoxPose();
+            }
+        }
+    }
+
 
     bool BulletEngine::attachObjectToRobot(DynamicsRobotPtr r, const std::string& nodeName, DynamicsObjectPtr object)
     {
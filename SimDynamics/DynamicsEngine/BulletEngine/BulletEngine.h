@@ -25,8 +25,10 @@
 #include <VirtualRobot/SceneObject.h>
 #include "../DynamicsEngine.h"
 #include "BulletRobot.h"
+#include "BulletMultiBodyRobot.h"
 
 #include "btBulletDynamicsCommon.h"
+#include <BulletDynamics/Featherstone/btMultiBodyDynamicsWorld.h>
 
 namespace internal
 {
@@ -62,6 +64,12 @@ namespace SimDynamics
         btScalar bulletSolverSuccessiveOverRelaxation;
         //btScalar bulletSolverContactSurfaceLayer;
         btScalar bulletSolverSplitImpulsePenetrationThreshold;
+
+        /*!
+            Use a btMultiBodyDynamicsWorld, which is needed to simulate robots in reduced coordinates (BulletMultiBodyRobot).
+            Rigid bodies and BulletRobots can be simulated in such a world as well. (standard: false)
+        */
+        bool bulletUseMultiBodyWorld;
     };
 
     typedef boost::shared_ptr<BulletEngineConfig> BulletEngineConfigPtr;
@@ -75,6 +83,16 @@ namespace SimDynamics
     public:
         EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
+        /*!
+            Specifies when the poses that Bullet computes are passed to the Simox objects (robot nodes, obstacles).
+        */
+        enum PoseSyncMode
+        {
+            eSyncImmediate,     //!< on every Bullet substep (standard)
+            eSyncPerStep,       //!< once at the end of each stepSimulation() call
+            eSyncOnDemand       //!< only when syncSimoxPoses() is called
+        };
+
         friend class BulletObject;
 
         /*!
@@ -117,6 +135,9 @@ namespace SimDynamics
 
         btDynamicsWorld* getBulletWorld();
 
+        //! The world as btMultiBodyDynamicsWorld, NULL if BulletEngineConfig::bulletUseMultiBodyWorld was not set.
+        btMultiBodyDynamicsWorld* getBulletMultiBodyWorld();
+
         std::vector<DynamicsEngine::DynamicsContactInfo> getContacts() override;
 
         void print();
@@ -132,6 +153,21 @@ namespace SimDynamics
         */
         double getSimTime();
 
+        /*!
+            Deferring the pose synchronization avoids updating Simox poses, collision models and visualizations
+            on every Bullet substep, which is useful when the Simox poses are only needed once per control cycle.
+            Note that in deferred modes, the Simox poses of robot nodes (as used by torque control and sensors)
+            may lag behind the Bullet state until the next synchronization.
+        */
+        void setPoseSyncMode(PoseSyncMode mode);
+        PoseSyncMode getPoseSyncMode();
+
+        /*!
+            Passes the current Bullet poses of all objects and robots to Simox in one batch.
+            Only needed with eSyncOnDemand (or to read poses within a step in eSyncPerStep mode).
+        */
+        void syncSimoxPoses();
+
         bool attachObjectToRobot(DynamicsRobotPtr r, const std::string& nodeName, DynamicsObjectPtr object) override;
         bool detachObjectFromRobot(DynamicsRobotPtr r, DynamicsObjectPtr object) override;
 
@@ -166,7 +202,7 @@ namespace SimDynamics
                 btCollisionObject* bt1 = static_cast<btCollisionObject*>(proxy1->m_clientObject);
                 SimDynamics::BulletObject* o0 = static_cast<SimDynamics::BulletObject*>(bt0->getUserPointer());
                 SimDynamics::BulletObject* o1 = static_cast<SimDynamics::BulletObject*>(bt1->getUserPointer());
-                return engine->checkCollisionEnabled(o0, o1);
+                return engine->isCollisionEnabled(o0, o1);
                 //return true;//btOverlapFilterCallback::needBroadphaseCollision(proxy0,proxy1);
             }
         protected:
@@ -180,6 +216,9 @@ namespace SimDynamics
         virtual bool addLink(BulletRobot::LinkInfo& l);
         virtual bool removeLink(BulletRobot::LinkInfo& l);
 
+        virtual bool addMultiBodyRobot(BulletMultiBodyRobotPtr r);
+        virtual bool removeMultiBodyRobot(BulletMultiBodyRobotPtr r);
+
         btDynamicsWorld* dynamicsWorld;
 
         btBroadphaseInterface* overlappingPairCache;
@@ -195,6 +234,8 @@ namespace SimDynamics
 
         double simTime;
 
+        PoseSyncMode poseSyncMode;
+
         // btActionInterface interface
     public:
         void updateAction(btCollisionWorld *collisionWorld, btScalar deltaTimeStep) override;
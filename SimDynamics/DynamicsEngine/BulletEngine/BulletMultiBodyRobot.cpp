@@ -0,0 +1,658 @@
+#include "BulletMultiBodyRobot.h"
+#include "BulletEngine.h"
+#include "../../DynamicsWorld.h"
+
+#include <VirtualRobot/Robot.h>
+#include <VirtualRobot/RobotNodeSet.h>
+#include <VirtualRobot/Nodes/RobotNodeRevolute.h>
+#include <VirtualRobot/Nodes/RobotNodePrismatic.h>
+#include <VirtualRobot/Nodes/ForceTorqueSensor.h>
+#include <VirtualRobot/Nodes/ContactSensor.h>
+#include <VirtualRobot/CollisionDetection/CollisionModel.h>
+
+#include <cmath>
+
+using namespace VirtualRobot;
+using namespace std;
+
+namespace SimDynamics
+{
+
+    namespace
+    {
+        bool isMovable(const RobotNodePtr& rn)
+        {
+            return rn->isRotationalJoint() || rn->isTranslationalJoint();
+        }
+
+        // bullet units: masses are scaled by MassFactor, lengths by ScaleFactor
+        double getForceScale()
+        {
+            return BulletObject::MassFactor * BulletObject::ScaleFactor;
+        }
+
+        double getTorqueScale()
+        {
+            return BulletObject::MassFactor * BulletObject::ScaleFactor * BulletObject::ScaleFactor;
+        }
+    }
+
+    BulletMultiBodyRobot::BulletMultiBodyRobot(VirtualRobot::RobotPtr rob)
+        : DynamicsRobot(rob)
+        , fixedBase(false)
+        // same standard value as BulletRobot
+        , bulletMaxMotorImpulse(30 * BulletObject::ScaleFactor)
+    {
+        buildMultiBody();
+
+        for (auto& sensor : sensors)
+        {
+            ForceTorqueSensorPtr ftSensor = boost::dynamic_pointer_cast<ForceTorqueSensor>(sensor);
+
+            if (ftSensor)
+            {
+                VirtualRobot::RobotNodePtr node = ftSensor->getRobotNode();
+                THROW_VR_EXCEPTION_IF(!node, "parent of sensor could not be casted to RobotNode");
+
+                if (!hasJoint(node))
+                {
+                    VR_WARNING << "Ignoring FT sensor " << ftSensor->getName() << ". Must be linked to a joint" << endl;
+                }
+            }
+            else if (boost::dynamic_pointer_cast<ContactSensor>(sensor))
+            {
+                VR_WARNING << "Contact sensors are not supported by BulletMultiBodyRobot, ignoring " << sensor->getName() << endl;
+            }
+        }
+    }
+
+    BulletMultiBodyRobot::~BulletMultiBodyRobot()
+    {
+        // the engine has removed all colliders and constraints from the world at this point
+        links.clear();
+        baseCollider.reset();
+        multiBody.reset();
+    }
+
+    BulletObjectPtr BulletMultiBodyRobot::getBulletObject(VirtualRobot::RobotNodePtr node)
+    {
+        if (!hasDynamicsRobotNode(node))
+        {
+            dynamicRobotNodes[node] = BulletObjectPtr(new BulletObject(node));
+        }
+
+        return boost::dynamic_pointer_cast<BulletObject>(dynamicRobotNodes[node]);
+    }
+
+    void BulletMultiBodyRobot::collectLinks(VirtualRobot::RobotNodePtr node, int parent, VirtualRobot::RobotNodePtr joint)
+    {
+        for (const auto& child : node->getChildren())
+        {
+            RobotNodePtr rn = boost::dynamic_pointer_cast<RobotNode>(child);
+
+            if (!rn)
+            {
+                continue;
+            }
+
+            RobotNodePtr childJoint = joint;
+
+            if (isMovable(rn))
+            {
+                // as in BulletRobot, the joint next to the body is used
+                if (childJoint)
+                {
+                    VR_WARNING << "No body between " << childJoint->getName() << " and " << rn->getName() << ", skipping " << childJoint->getName() << endl;
+                }
+
+                childJoint = rn;
+            }
+
+            if (rn->getCollisionModel())
+            {
+                createLink(rn, parent, childJoint);
+                collectLinks(rn, int(links.size()) - 1, RobotNodePtr());
+            }
+            else
+            {
+                collectLinks(rn, parent, childJoint);
+            }
+        }
+    }
+
+    void BulletMultiBodyRobot::createLink(VirtualRobot::RobotNodePtr node, int parent, VirtualRobot::RobotNodePtr joint)
+    {
+        LinkInfo l;
+        l.node = node;
+        l.nodeJoint = joint;
+        l.dynNode = getBulletObject(node);
+        l.parent = parent;
+        l.jointValueOffset = joint ? joint->getJointValue() : 0.0;
+        l.jointScale = 1.0;
+        l.velocityTarget = 0;
+
+        if (joint && joint->isTranslationalJoint() && DynamicsWorld::convertMM2M)
+        {
+            l.jointScale = 0.001 * BulletObject::ScaleFactor; // mm -> m
+        }
+
+        bodyLinks[node] = int(links.size());
+
+        if (joint)
+        {
+            jointLinks[joint] = int(links.size());
+        }
+
+        links.push_back(l);
+    }
+
+    void BulletMultiBodyRobot::addIgnoredCollisionModels(VirtualRobot::RobotNodePtr rn)
+    {
+        BulletObjectPtr drn1 = getBulletObject(rn);
+
+        for (const auto& i : rn->getIgnoredCollisionModels())
+        {
+            RobotNodePtr rn2 = robot->getRobotNode(i);
+
+            if (!rn2)
+            {
+                VR_ERROR << "Error while processing robot node <" << rn->getName() << ">: Ignored collision model <" << i << "> is not part of robot..." << endl;
+            }
+            else if (bodyLinks.find(rn2) != bodyLinks.end())
+            {
+                disabledCollisionPairs.push_back(std::make_pair(drn1, getBulletObject(rn2)));
+            }
+        }
+    }
+
+    void BulletMultiBodyRobot::buildMultiBody()
+    {
+        MutexLockPtr lock = getScopedLock();
+
+        robotNodes = robot->getRobotNodes();
+        RobotNodePtr root = robot->getRootNode();
+        THROW_VR_EXCEPTION_IF(!root, "Robot " << robot->getName() << " has no root node");
+
+        baseNode = getBulletObject(root);
+        bodyLinks[root] = -1;
+        collectLinks(root, -1, RobotNodePtr());
+
+        for (const auto& b : bodyLinks)
+        {
+            if (b.first->getCollisionModel())
+            {
+                addIgnoredCollisionModels(b.first);
+            }
+        }
+
+        SceneObject::Physics::SimulationType rootSimType = root->getSimulationType();
+        fixedBase = (rootSimType == SceneObject::Physics::eStatic || rootSimType == SceneObject::Physics::eKinematic);
+
+        btScalar baseMass = 0;
+        btVector3 baseInertia(0, 0, 0);
+        boost::shared_ptr<btRigidBody> baseBody = baseNode->getRigidBody();
+
+        if (!fixedBase && baseBody->getInvMass() > 0)
+        {
+            baseMass = btScalar(1) / baseBody->getInvMass();
+            baseInertia = baseBody->getLocalInertia();
+        }
+
+        multiBody.reset(new btMultiBody(int(links.size()), baseMass, baseInertia, fixedBase, false));
+        const btTransform& baseTr = baseBody->getWorldTransform();
+        multiBody->setBasePos(baseTr.getOrigin());
+        multiBody->setWorldToBaseRot(baseTr.getRotation().inverse());
+
+        for (size_t i = 0; i < links.size(); i++)
+        {
+            LinkInfo& l = links[i];
+            boost::shared_ptr<btRigidBody> body = l.dynNode->getRigidBody();
+
+            btScalar mass = 0;
+            btVector3 inertia(0, 0, 0);
+
+            if (body->getInvMass() > 0)
+            {
+                mass = btScalar(1) / body->getInvMass();
+                inertia = body->getLocalInertia();
+            }
+            else
+            {
+                // static/kinematic robot nodes are simulated as part of the articulation
+                VR_WARNING << "Robot node " << l.node->getName() << " has no mass, using 1kg" << endl;
+                mass = btScalar(BulletObject::MassFactor);
+                body->getCollisionShape()->calculateLocalInertia(mass, inertia);
+            }
+
+            // all link frames are located at the CoM of the body, as the rigid bodies of BulletObject
+            const btTransform& parentTr = (l.parent < 0) ? baseTr : links[l.parent].dynNode->getRigidBody()->getWorldTransform();
+            const btTransform& thisTr = body->getWorldTransform();
+
+            Eigen::Vector3f pivotGlobal = (l.nodeJoint ? l.nodeJoint : l.node)->getGlobalPose().block<3, 1>(0, 3);
+            btVector3 pivot = BulletEngine::getVecBullet(pivotGlobal);
+
+            btQuaternion rotParentToThis;
+            (thisTr.getBasis().transpose() * parentTr.getBasis()).getRotation(rotParentToThis);
+            btVector3 parentComToPivot = parentTr.invXform(pivot);
+            btVector3 pivotToThisCom = thisTr.getBasis().transpose() * (thisTr.getOrigin() - pivot);
+
+            if (l.nodeJoint && l.nodeJoint->isRotationalJoint())
+            {
+                RobotNodeRevolutePtr rev = boost::dynamic_pointer_cast<RobotNodeRevolute>(l.nodeJoint);
+                THROW_VR_EXCEPTION_IF(!rev, "Rotational joint " << l.nodeJoint->getName() << " is not a revolute node");
+                Eigen::Vector3f axisGlobal = rev->getJointRotationAxis().normalized();
+                btVector3 axis = thisTr.getBasis().transpose() * BulletEngine::getVecBullet(axisGlobal, false);
+                multiBody->setupRevolute(int(i), mass, inertia, l.parent, rotParentToThis, axis, parentComToPivot, pivotToThisCom, true);
+            }
+            else if (l.nodeJoint && l.nodeJoint->isTranslationalJoint())
+            {
+                RobotNodePrismaticPtr pris = boost::dynamic_pointer_cast<RobotNodePrismatic>(l.nodeJoint);
+                THROW_VR_EXCEPTION_IF(!pris, "Translational joint " << l.nodeJoint->getName() << " is not a prismatic node");
+                Eigen::Vector3f dirGlobal = pris->getJointTranslationDirection().normalized();
+                btVector3 axis = thisTr.getBasis().transpose() * BulletEngine::getVecBullet(dirGlobal, false);
+                multiBody->setupPrismatic(int(i), mass, inertia, l.parent, rotParentToThis, axis, parentComToPivot, pivotToThisCom, true);
+            }
+            else
+            {
+                multiBody->setupFixed(int(i), mass, inertia, l.parent, rotParentToThis, parentComToPivot, pivotToThisCom);
+            }
+
+            if (l.nodeJoint)
+            {
+                // the reaction forces are only computed for links with a feedback struct, which has to be set before finalizing
+                l.feedback.reset(new btMultiBodyJointFeedback());
+                multiBody->getLink(int(i)).m_jointFeedback = l.feedback.get();
+            }
+        }
+
+        multiBody->finalizeMultiDof();
+        multiBody->setHasSelfCollision(true);
+
+        for (size_t i = 0; i < links.size(); i++)
+        {
+            LinkInfo& l = links[i];
+
+            if (!l.nodeJoint)
+            {
+                continue;
+            }
+
+            if (!l.nodeJoint->isLimitless())
+            {
+                btScalar lo = btScalar((l.nodeJoint->getJointLimitLo() - l.jointValueOffset) * l.jointScale);
+                btScalar hi = btScalar((l.nodeJoint->getJointLimitHi() - l.jointValueOffset) * l.jointScale);
+                l.limit.reset(new btMultiBodyJointLimitConstraint(multiBody.get(), int(i), lo, hi));
+            }
+
+            // disabled until the joint is actuated
+            l.motor.reset(new btMultiBodyJointMotor(multiBody.get(), int(i), 0, 0));
+        }
+
+        // colliders share the collision shapes of the BulletObjects
+        if (root->getCollisionModel())
+        {
+            baseCollider.reset(new btMultiBodyLinkCollider(multiBody.get(), -1));
+            baseCollider->setCollisionShape(baseBody->getCollisionShape());
+            baseCollider->setWorldTransform(baseTr);
+            baseCollider->setUserPointer((void*)(baseNode.get()));
+            multiBody->setBaseCollider(baseCollider.get());
+        }
+
+        for (size_t i = 0; i < links.size(); i++)
+        {
+            LinkInfo& l = links[i];
+            boost::shared_ptr<btRigidBody> body = l.dynNode->getRigidBody();
+            l.collider.reset(new btMultiBodyLinkCollider(multiBody.get(), int(i)));
+            l.collider->setCollisionShape(body->getCollisionShape());
+            l.collider->setWorldTransform(body->getWorldTransform());
+            l.collider->setUserPointer((void*)(l.dynNode.get()));
+            multiBody->getLink(int(i)).m_collider = l.collider.get();
+        }
+    }
+
+    bool BulletMultiBodyRobot::hasJoint(VirtualRobot::RobotNodePtr rn)
+    {
+        MutexLockPtr lock = getScopedLock();
+        return jointLinks.find(rn) != jointLinks.end();
+    }
+
+    bool BulletMultiBodyRobot::hasFixedBase() const
+    {
+        return fixedBase;
+    }
+
+    btMultiBody* BulletMultiBodyRobot::getMultiBody()
+    {
+        return multiBody.get();
+    }
+
+    std::vector<BulletMultiBodyRobot::LinkInfo> BulletMultiBodyRobot::getLinks()
+    {
+        MutexLockPtr lock = getScopedLock();
+        return links;
+    }
+
+    std::vector<btMultiBodyLinkCollider*> BulletMultiBodyRobot::getColliders()
+    {
+        MutexLockPtr lock = getScopedLock();
+        std::vector<btMultiBodyLinkCollider*> result;
+
+        if (baseCollider)
+        {
+            result.push_back(baseCollider.get());
+        }
+
+        for (const auto& l : links)
+        {
+            result.push_back(l.collider.get());
+        }
+
+        return result;
+    }
+
+    std::vector<btMultiBodyConstraint*> BulletMultiBodyRobot::getJointConstraints()
+    {
+        MutexLockPtr lock = getScopedLock();
+        std::vector<btMultiBodyConstraint*> result;
+
+        for (const auto& l : links)
+        {
+            if (l.limit)
+            {
+                result.push_back(l.limit.get());
+            }
+
+            if (l.motor)
+            {
+                result.push_back(l.motor.get());
+            }
+        }
+
+        return result;
+    }
+
+    btTransform BulletMultiBodyRobot::getLinkTransform(int index)
+    {
+        if (index < 0)
+        {
+            return btTransform(multiBody->getWorldToBaseRot().inverse(), multiBody->getBasePos());
+        }
+
+        return btTransform(multiBody->localFrameToWorld(index, btMatrix3x3::getIdentity()), multiBody->localPosToWorld(index, btVector3(0, 0, 0)));
+    }
+
+    void BulletMultiBodyRobot::setMaximumMotorImpulse(double maxImpulse)
+    {
+        MutexLockPtr lock = getScopedLock();
+        bulletMaxMotorImpulse = btScalar(maxImpulse);
+    }
+
+    void BulletMultiBodyRobot::actuateJoints(double dt)
+    {
+        MutexLockPtr lock = getScopedLock();
+
+        for (auto& target : actuationTargets)
+        {
+            std::map<RobotNodePtr, int>::const_iterator j = jointLinks.find(target.first);
+
+            if (j == jointLinks.end())
+            {
+                continue;
+            }
+
+            int index = j->second;
+            LinkInfo& link = links[index];
+            RobotNodePtr node = target.first;
+            const ActuationMode& actuation = target.second.actuation;
+            double effortScale = node->isTranslationalJoint() ? getForceScale() : getTorqueScale();
+
+            if (actuation.mode == 0)
+            {
+                link.motor->setMaxAppliedImpulse(0);
+                link.velocityTarget = 0;
+                continue;
+            }
+
+            if (actuation.modes.torque)
+            {
+                double torque = target.second.jointTorqueTarget;
+
+                if (node->getMaxTorque() > 0)
+                {
+                    torque = std::max<double>(-node->getMaxTorque(), std::min<double>(node->getMaxTorque(), torque));
+                }
+
+                link.motor->setMaxAppliedImpulse(0);
+                link.velocityTarget = 0;
+                multiBody->addJointTorque(index, btScalar(torque * effortScale));
+            }
+            else if (actuation.modes.position || actuation.modes.velocity)
+            {
+                // in simox units, but meters instead of mm
+                double unitScale = node->isTranslationalJoint() ? 0.001 : 1.0;
+                double velocityTarget = target.second.jointVelocityTarget * unitScale;
+                double targetVelocity = velocityTarget;
+
+                // the joint motors of btMultiBody reach velocity targets, so no position controller is needed in pure velocity mode
+                if (actuation.modes.position)
+                {
+                    double delta = target.second.jointValueTarget - getJointAngle(node);
+
+                    if (node->isLimitless())
+                    {
+                        delta = std::remainder(delta, 2.0 * M_PI);
+                    }
+
+                    VelocityMotorController& controller = actuationControllers[node];
+                    controller.setName(node->getName());
+                    targetVelocity = controller.update(delta * unitScale, velocityTarget, actuation, btScalar(dt));
+                }
+
+                btScalar maxImpulse = bulletMaxMotorImpulse;
+
+                if (node->getMaxTorque() > 0)
+                {
+                    maxImpulse = btScalar(node->getMaxTorque() * dt * effortScale);
+                }
+
+                link.velocityTarget = btScalar(targetVelocity / unitScale * link.jointScale);
+                link.motor->setVelocityTarget(link.velocityTarget);
+                link.motor->setMaxAppliedImpulse(maxImpulse);
+            }
+        }
+    }
+
+    void BulletMultiBodyRobot::updateSensors(double /*dt*/)
+    {
+        MutexLockPtr lock = getScopedLock();
+
+        for (auto& sensor : sensors)
+        {
+            ForceTorqueSensorPtr ftSensor = boost::dynamic_pointer_cast<ForceTorqueSensor>(sensor);
+
+            if (ftSensor && hasJoint(ftSensor->getRobotNode()))
+            {
+                ftSensor->updateSensors(getJointForceTorqueGlobal(ftSensor->getRobotNode()));
+            }
+        }
+    }
+
+    double BulletMultiBodyRobot::getJointAngle(VirtualRobot::RobotNodePtr rn)
+    {
+        MutexLockPtr lock = getScopedLock();
+        std::map<RobotNodePtr, int>::const_iterator j = jointLinks.find(rn);
+
+        if (j == jointLinks.end())
+        {
+            return 0.0;
+        }
+
+        const LinkInfo& link = links[j->second];
+        return link.jointValueOffset + multiBody->getJointPos(j->second) / link.jointScale;
+    }
+
+    double BulletMultiBodyRobot::getJointSpeed(VirtualRobot::RobotNodePtr rn)
+    {
+        MutexLockPtr lock = getScopedLock();
+        std::map<RobotNodePtr, int>::const_iterator j = jointLinks.find(rn);
+
+        if (j == jointLinks.end())
+        {
+            return 0.0;
+        }
+
+        return multiBody->getJointVel(j->second) / links[j->second].jointScale;
+    }
+
+    double BulletMultiBodyRobot::getJointTargetSpeed(VirtualRobot::RobotNodePtr rn)
+    {
+        MutexLockPtr lock = getScopedLock();
+        std::map<RobotNodePtr, int>::const_iterator j = jointLinks.find(rn);
+
+        if (j == jointLinks.end())
+        {
+            return 0.0;
+        }
+
+        return links[j->second].velocityTarget / links[j->second].jointScale;
+    }
+
+    Eigen::VectorXf BulletMultiBodyRobot::getJointForceTorqueGlobal(VirtualRobot::RobotNodePtr rn)
+    {
+        MutexLockPtr lock = getScopedLock();
+        Eigen::VectorXf result = Eigen::VectorXf::Zero(6);
+        std::map<RobotNodePtr, int>::const_iterator j = jointLinks.find(rn);
+
+        if (j == jointLinks.end())
+        {
+            return result;
+        }
+
+        // the reaction forces are given in the link frame, with respect to the CoM of the link
+        const btSpatialForceVector& reaction = links[j->second].feedback->m_reactionForces;
+        btTransform linkTr = getLinkTransform(j->second);
+        btVector3 force = linkTr.getBasis() * reaction.getLinear();
+        btVector3 torque = linkTr.getBasis() * reaction.getAngular();
+
+        Eigen::Vector3f forceGlobal = BulletEngine::getVecEigen(force, false) / float(getForceScale());
+        Eigen::Vector3f torqueCoMGlobal = BulletEngine::getVecEigen(torque, false) / float(getTorqueScale());
+
+        // move the torque to the joint
+        Eigen::Vector3f jointGlobal = rn->getGlobalPose().block<3, 1>(0, 3);
+        Eigen::Vector3f lever = (BulletEngine::getVecEigen(linkTr.getOrigin()) - jointGlobal) * 0.001f; // mm -> m
+        result.head(3) = forceGlobal;
+        result.tail(3) = torqueCoMGlobal + lever.cross(forceGlobal);
+        return result;
+    }
+
+    Eigen::Vector3f BulletMultiBodyRobot::getJointForces(VirtualRobot::RobotNodePtr rn)
+    {
+        return getJointForceTorqueGlobal(rn).head(3);
+    }
+
+    Eigen::Vector3f BulletMultiBodyRobot::getJointTorques(VirtualRobot::RobotNodePtr rn)
+    {
+        return getJointForceTorqueGlobal(rn).tail(3);
+    }
+
+    double BulletMultiBodyRobot::getJointTorque(VirtualRobot::RobotNodePtr rn)
+    {
+        MutexLockPtr lock = getScopedLock();
+
+        if (!hasJoint(rn))
+        {
+            return 0.0;
+        }
+
+        Eigen::VectorXf ft = getJointForceTorqueGlobal(rn);
+
+        if (rn->isTranslationalJoint())
+        {
+            RobotNodePrismaticPtr pris = boost::dynamic_pointer_cast<RobotNodePrismatic>(rn);
+            return ft.head(3).dot(pris->getJointTranslationDirection().normalized());
+        }
+
+        RobotNodeRevolutePtr rev = boost::dynamic_pointer_cast<RobotNodeRevolute>(rn);
+        return ft.tail(3).dot(rev->getJointRotationAxis().normalized());
+    }
+
+    Eigen::Vector3f BulletMultiBodyRobot::getComGlobal(const VirtualRobot::RobotNodeSetPtr& set)
+    {
+        MutexLockPtr lock = getScopedLock();
+        return set->getCoM();
+    }
+
+    Eigen::Vector3f BulletMultiBodyRobot::getComVelocityGlobal(const VirtualRobot::RobotNodeSetPtr& set)
+    {
+        MutexLockPtr lock = getScopedLock();
+        Eigen::Vector3f com = Eigen::Vector3f::Zero();
+        double totalMass = 0.0;
+
+        // velocities of the link frames (located at the CoMs), given in the link frames, index 0 is the base
+        std::vector<btVector3> omega(links.size() + 1);
+        std::vector<btVector3> vel(links.size() + 1);
+        multiBody->compTreeLinkVelocities(&omega[0], &vel[0]);
+
+        for (unsigned int i = 0; i < set->getSize(); i++)
+        {
+            VirtualRobot::RobotNodePtr node = (*set)[i];
+            std::map<RobotNodePtr, int>::const_iterator b = bodyLinks.find(node);
+
+            if (b == bodyLinks.end())
+            {
+                continue;
+            }
+
+            btVector3 v = multiBody->localDirToWorld(b->second, vel[b->second + 1]);
+            com += node->getMass() * BulletEngine::getVecEigen(v);
+            totalMass += node->getMass();
+        }
+
+        if (fabs(totalMass) < 1e-5)
+        {
+            VR_ERROR << "Little mass: " << totalMass << ". Could not compute com velocity..." << endl;
+        }
+        else
+        {
+            com *= float(1.0f / totalMass);
+        }
+
+        return com;
+    }
+
+    void BulletMultiBodyRobot::setGlobalPose(const Eigen::Matrix4f& gp)
+    {
+        MutexLockPtr lock = getScopedLock();
+        robot->setGlobalPose(gp);
+
+        Eigen::Matrix4f comLocal = Eigen::Matrix4f::Identity();
+        comLocal.block<3, 1>(0, 3) = baseNode->getCom();
+        btTransform baseTr = BulletEngine::getPoseBullet(robot->getRootNode()->getGlobalPose() * comLocal);
+        multiBody->setBasePos(baseTr.getOrigin());
+        multiBody->setWorldToBaseRot(baseTr.getRotation().inverse());
+        multiBody->setBaseVel(btVector3(0, 0, 0));
+        multiBody->setBaseOmega(btVector3(0, 0, 0));
+
+        btAlignedObjectArray<btQuaternion> scratchQ;
+        btAlignedObjectArray<btVector3> scratchM;
+        multiBody->updateCollisionObjectWorldTransforms(scratchQ, scratchM);
+    }
+
+    void BulletMultiBodyRobot::syncSimoxPose()
+    {
+        MutexLockPtr lock = getScopedLock();
+        std::map<RobotNodePtr, float> jointValues;
+
+        for (const auto& j : jointLinks)
+        {
+            jointValues[j.first] = float(getJointAngle(j.first));
+        }
+
+        robot->setJointValues(jointValues);
+
+        Eigen::Matrix4f comLocal = Eigen::Matrix4f::Identity();
+        comLocal.block<3, 1>(0, 3) = -baseNode->getCom();
+        robot->setGlobalPoseForRobotNode(robot->getRootNode(), BulletEngine::getPoseEigen(getLinkTransform(-1)) * comLocal);
+    }
+
+} // namespace SimDynamics
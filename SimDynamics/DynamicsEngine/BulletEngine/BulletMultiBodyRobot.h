@@ -0,0 +1,153 @@
+/**
+* This file is part of Simox.
+*
+* Simox is free software; you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 2 of
+* the License, or (at your option) any later version.
+*
+* Simox is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* @package    SimDynamics
+* @copyright  2026 GNU Lesser General Public License
+*
+*/
+#pragma once
+
+#include "../DynamicsRobot.h"
+#include "BulletObject.h"
+
+#include "btBulletDynamicsCommon.h"
+#include <BulletDynamics/Featherstone/btMultiBody.h>
+#include <BulletDynamics/Featherstone/btMultiBodyLinkCollider.h>
+#include <BulletDynamics/Featherstone/btMultiBodyJointMotor.h>
+#include <BulletDynamics/Featherstone/btMultiBodyJointLimitConstraint.h>
+#include <BulletDynamics/Featherstone/btMultiBodyJointFeedback.h>
+
+namespace SimDynamics
+{
+    /*!
+        A robot that is simulated in reduced (joint) coordinates with Bullet's Featherstone implementation (btMultiBody).
+
+        In contrast to BulletRobot, where each body is a free rigid body and the joints are constraints that the solver has to
+        enforce, the joints of a btMultiBody can not drift apart. This allows larger time steps and fewer solver iterations
+        for long kinematic chains and heavy links.
+
+        The bodies are determined as in BulletRobot: each robot node with a collision model is a link, which is connected to
+        its parent body by the nearest movable robot node in between (or rigidly, if there is none). The robot's root node
+        is the base of the multibody, it is fixed if its simulation type is eStatic or eKinematic.
+        Joint limits, position/velocity actuation (via joint motors), torque actuation and force torque sensors are supported.
+        Contact sensors are not supported.
+
+        The robot can only be added to a BulletEngine that was initialized with BulletEngineConfig::bulletUseMultiBodyWorld.
+        The Simox joint values and the root pose are updated from the multibody state according to the engine's pose sync mode.
+    */
+    class SIMDYNAMICS_IMPORT_EXPORT BulletMultiBodyRobot : public DynamicsRobot
+    {
+        friend class BulletEngine;
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        /*!
+            Constructor.
+            Builds the multibody in the current configuration of rob.
+        */
+        BulletMultiBodyRobot(VirtualRobot::RobotPtr rob);
+
+        /*!
+        */
+        ~BulletMultiBodyRobot() override;
+
+        struct LinkInfo
+        {
+            VirtualRobot::RobotNodePtr node; // body
+            VirtualRobot::RobotNodePtr nodeJoint; // joint (empty for fixed links)
+            BulletObjectPtr dynNode; // provides shape, mass and CoM of the body
+            int parent; // link index of the parent body (-1: base)
+            double jointValueOffset; // simox joint value at construction time (bullet joint position 0)
+            double jointScale; // simox -> bullet joint units
+            btScalar velocityTarget; // current motor target in bullet units
+            boost::shared_ptr<btMultiBodyLinkCollider> collider; // empty if the body has no collision model
+            boost::shared_ptr<btMultiBodyJointMotor> motor;
+            boost::shared_ptr<btMultiBodyJointLimitConstraint> limit;
+            boost::shared_ptr<btMultiBodyJointFeedback> feedback;
+        };
+
+        void actuateJoints(double dt) override;
+        void updateSensors(double dt) override;
+
+        double getJointAngle(VirtualRobot::RobotNodePtr rn) override;
+        double getJointSpeed(VirtualRobot::RobotNodePtr rn) override;
+        double getJointTargetSpeed(VirtualRobot::RobotNodePtr rn) override;
+
+        /*!
+            Force [N] and torque [Nm] in the given joint, that the parent applies on the child link, in global coordinates.
+            The torque is given with respect to the joint position.
+        */
+        Eigen::VectorXf getJointForceTorqueGlobal(VirtualRobot::RobotNodePtr rn);
+        Eigen::Vector3f getJointForces(VirtualRobot::RobotNodePtr rn);
+        Eigen::Vector3f getJointTorques(VirtualRobot::RobotNodePtr rn);
+
+        //! The torque along the joint axis (or the force along the translation direction of prismatic joints).
+        double getJointTorque(VirtualRobot::RobotNodePtr rn);
+
+        Eigen::Vector3f getComGlobal(const VirtualRobot::RobotNodeSetPtr& set) override;
+        Eigen::Vector3f getComVelocityGlobal(const VirtualRobot::RobotNodeSetPtr& set) override;
+
+        //! Moves the base (and all links) to the given global pose of the robot.
+        void setGlobalPose(const Eigen::Matrix4f& gp) override;
+
+        /*!
+            Passes the root pose and joint values of the multibody to the Simox robot.
+            Called by the BulletEngine according to its pose sync mode.
+        */
+        void syncSimoxPose();
+
+        //! Returns true if rn is the joint of a link.
+        bool hasJoint(VirtualRobot::RobotNodePtr rn);
+
+        //! Used for position/velocity control if the robot node does not specify a maximum torque.
+        void setMaximumMotorImpulse(double maxImpulse);
+
+        btMultiBody* getMultiBody();
+        std::vector<LinkInfo> getLinks();
+
+        //! All colliders of the multibody, starting with the base collider (if present).
+        std::vector<btMultiBodyLinkCollider*> getColliders();
+        //! Limits and motors of all joints.
+        std::vector<btMultiBodyConstraint*> getJointConstraints();
+
+        bool hasFixedBase() const;
+
+    protected:
+        void buildMultiBody();
+        void collectLinks(VirtualRobot::RobotNodePtr node, int parent, VirtualRobot::RobotNodePtr joint);
+        void createLink(VirtualRobot::RobotNodePtr node, int parent, VirtualRobot::RobotNodePtr joint);
+        void addIgnoredCollisionModels(VirtualRobot::RobotNodePtr rn);
+        BulletObjectPtr getBulletObject(VirtualRobot::RobotNodePtr node);
+        btTransform getLinkTransform(int index);
+
+        boost::shared_ptr<btMultiBody> multiBody;
+        bool fixedBase;
+        BulletObjectPtr baseNode;
+        boost::shared_ptr<btMultiBodyLinkCollider> baseCollider;
+
+        std::vector<LinkInfo> links;
+        std::map<VirtualRobot::RobotNodePtr, int> jointLinks; // joint node -> link index
+        std::map<VirtualRobot::RobotNodePtr, int> bodyLinks; // body node -> link index (-1: base)
+
+        // applied by the engine when the robot is added
+        std::vector< std::pair<DynamicsObjectPtr, DynamicsObjectPtr> > disabledCollisionPairs;
+
+        btScalar bulletMaxMotorImpulse;
+    };
+
+    typedef boost::shared_ptr<BulletMultiBodyRobot> BulletMultiBodyRobotPtr;
+
+} // namespace SimDynamics
@@ -15,6 +15,7 @@
 #include <BulletCollision/CollisionShapes/btSphereShape.h>
 #include <BulletCollision/CollisionShapes/btCylinderShape.h>
 #include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btCapsuleShape.h>
 
 //#define DEBUG_FIXED_OBJECTS
 //#define USE_BULLET_GENERIC_6DOF_CONSTRAINT
@@ -28,6 +29,9 @@ namespace SimDynamics
 
     float BulletObject::ScaleFactor = 2.0f;
     float BulletObject::MassFactor = 0.1f;
+    BulletObject::CollisionShapeMode BulletObject::ShapeMode = BulletObject::eConvexHull;
+    VirtualRobot::ConvexDecomposition::Parameters BulletObject::DecompositionParameters;
+    std::string BulletObject::DecompositionCacheDirectory;
 
     BulletObject::BulletObject(VirtualRobot::SceneObjectPtr o)
         : DynamicsObject(o)
@@ -94,7 +98,21 @@ namespace SimDynamics
                     TriMeshModelPtr trimesh;
                     trimesh = colModel->getTriMeshModel();
                     THROW_VR_EXCEPTION_IF((!trimesh || trimesh->faces.size() == 0) , "No TriMeshModel, could not create dynamics model...");
-                    collisionShape.reset(createConvexHullShape(trimesh));
+                    btCompoundShape* decomposed = NULL;
+
+                    if (ShapeMode == eConvexDecomposition)
+                    {
+                        decomposed = createDecomposedShape(trimesh);
+                    }
+
+                    if (decomposed)
+                    {
+                        collisionShape.reset(decomposed);
+                    }
+                    else
+                    {
+                        collisionShape.reset(createConvexHullShape(trimesh));
+                    }
                 }
             }
             else
@@ -216,11 +234,7 @@ namespace SimDynamics
 
         //com = trimesh->getCOM();
 
-        Eigen::Matrix4f comLoc;
-        comLoc.setIdentity();
-        comLoc.block(0, 3, 3, 1) = sceneObject->getCoMGlobal();
-        comLoc = (sceneObject->getGlobalPose().inverse() * comLoc);
-        com = comLoc.block(0, 3, 3, 1);
+        updateCom();
 
         double sc = ScaleFactor;
 
@@ -268,6 +282,83 @@ namespace SimDynamics
         return btConvex;
     }
 
+    btCompoundShape* BulletObject::createDecomposedShape(VirtualRobot::TriMeshModelPtr trimesh)
+    {
+        VR_ASSERT(trimesh);
+        ConvexDecomposition::PartList parts = ConvexDecomposition::computeCached(*trimesh, DecompositionCacheDirectory, DecompositionParameters);
+
+        if (parts.empty())
+        {
+            VR_WARNING << "Convex decomposition of " << sceneObject->getName() << " failed, using a single convex hull" << endl;
+            return NULL;
+        }
+
+        updateCom();
+
+        btScalar sc = ScaleFactor;
+
+        if (DynamicsWorld::convertMM2M)
+        {
+            sc = 0.001f * ScaleFactor;
+        }
+
+        btCompoundShape* compoundShape = new btCompoundShape(true);
+
+        for (const auto& part : parts)
+        {
+            btCollisionShape* child;
+            Eigen::Matrix4f pose = part.transform;
+            pose.block(0, 3, 3, 1) -= com;
+
+            switch (part.type)
+            {
+                case ConvexDecomposition::eBox:
+                    child = new btBoxShape(btVector3(part.size.x() / 2 * sc, part.size.y() / 2 * sc, part.size.z() / 2 * sc));
+                    break;
+
+                case ConvexDecomposition::eCylinder:
+                    child = new btCylinderShapeZ(btVector3(part.size.x() * sc, part.size.y() * sc, part.size.z() / 2 * sc));
+                    break;
+
+                case ConvexDecomposition::eCapsule:
+                    child = new btCapsuleShapeZ(part.size.x() * sc, part.size.z() * sc);
+                    break;
+
+                default:
+                {
+                    // vertices are given in mesh coordinates
+                    btConvexHullShape* hull = new btConvexHullShape();
+
+                    for (const auto& v : part.vertices)
+                    {
+                        hull->addPoint(btVector3(btScalar((v[0] - com[0]) * sc), btScalar((v[1] - com[1]) * sc), btScalar((v[2] - com[2]) * sc)), false);
+                    }
+
+                    hull->recalcLocalAabb();
+                    hull->setMargin(btMargin);
+                    child = hull;
+                    pose.setIdentity();
+                }
+            }
+
+            btTransform t = BulletEngine::getPoseBullet(pose, false);
+            t.setOrigin(t.getOrigin() * sc);
+            compoundShape->addChildShape(t, child);
+            childShapes.push_back(boost::shared_ptr<btCollisionShape>(child));
+        }
+
+        return compoundShape;
+    }
+
+    void BulletObject::updateCom()
+    {
+        Eigen::Matrix4f comLoc;
+        comLoc.setIdentity();
+        comLoc.block(0, 3, 3, 1) = sceneObject->getCoMGlobal();
+        comLoc = (sceneObject->getGlobalPose().inverse() * comLoc);
+        com = comLoc.block(0, 3, 3, 1);
+    }
+
     boost::shared_ptr<btRigidBody> BulletObject::getRigidBody()
     {
         return rigidBody;
@@ -364,6 +455,11 @@ namespace SimDynamics
         return BulletEngine::getPoseEigen(tr);
     }
 
+    SimoxMotionState* BulletObject::getMotionState()
+    {
+        return motionState;
+    }
+
     void BulletObject::applyForce(const Eigen::Vector3f& force)
     {
         MutexLockPtr lock = getScopedLock();
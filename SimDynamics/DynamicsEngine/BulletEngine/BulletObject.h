@@ -25,6 +25,8 @@
 #include "../DynamicsObject.h"
 #include "SimoxMotionState.h"
 
+#include <VirtualRobot/Tools/ConvexDecomposition.h>
+
 #include "btBulletDynamicsCommon.h"
 
 namespace SimDynamics
@@ -71,6 +73,9 @@ namespace SimDynamics
         //! This is the world pose which is set by bullet
         Eigen::Matrix4f getComGlobal();
 
+        //! The motion state that passes the Bullet poses to the Simox object.
+        SimoxMotionState* getMotionState();
+
         /*!
          * \brief applyForce Applies an external force on this object. The force is applied at the CoM position.
          * \param force The force to apply (value with respect to one second). The force will be deleted after one simulation step.
@@ -95,15 +100,34 @@ namespace SimDynamics
         //! All object's masses are scaled by this factor. (Heavy objects do not work well with motors.)
         static float MassFactor;
 
+        enum CollisionShapeMode
+        {
+            eConvexHull,            // a single convex hull of the collision model
+            eConvexDecomposition    // a compound of convex hulls and primitives (see VirtualRobot::ConvexDecomposition)
+        };
+
+        /*!
+            How the collision shapes of objects with trimesh collision models are created. Collision models that consist of primitives are not affected.
+            eConvexDecomposition keeps the cavities of concave objects, the decomposition is computed once per mesh and
+            parameter set and stored in DecompositionCacheDirectory (if not empty).
+        */
+        static CollisionShapeMode ShapeMode;
+        static VirtualRobot::ConvexDecomposition::Parameters DecompositionParameters;
+        static std::string DecompositionCacheDirectory;
+
     protected:
 
         void setPoseIntern(const Eigen::Matrix4f& pose);
         btCollisionShape* getShapeFromPrimitive(VirtualRobot::Primitive::PrimitivePtr primitive);
 
         btConvexHullShape* createConvexHullShape(VirtualRobot::TriMeshModelPtr trimesh);
+        //! Returns NULL if the decomposition is empty.
+        btCompoundShape* createDecomposedShape(VirtualRobot::TriMeshModelPtr trimesh);
+        void updateCom();
 
         boost::shared_ptr<btRigidBody> rigidBody;
         boost::shared_ptr<btCollisionShape> collisionShape; // bullet collision shape
+        std::vector< boost::shared_ptr<btCollisionShape> > childShapes; // of decomposed shapes
 
         Eigen::Vector3f com; // com offset of trimesh
 
@@ -1,12 +1,51 @@
 
 #include <Eigen/Dense>
+#include <algorithm>
 #include <fstream>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
 #include <VirtualRobot/RobotNodeSet.h>
 
 #include "BulletRobotLogger.h"
 
 using namespace SimDynamics;
 
+namespace
+{
+    const char logMagic[6] = {'S', 'X', 'R', 'L', 'O', 'G'};
+    const uint16_t logVersion = 1;
+
+    enum ColumnType : uint8_t
+    {
+        eFloat32 = 0,
+        eFloat64 = 1
+    };
+
+    template <typename T>
+    void append(std::vector<char>& buffer, const T& value)
+    {
+        const char* p = reinterpret_cast<const char*>(&value);
+        buffer.insert(buffer.end(), p, p + sizeof(T));
+    }
+
+    template <typename T>
+    bool read(std::ifstream& input, T& value)
+    {
+        return bool(input.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    void writeCSVHeader(std::ostream& output, const std::vector<std::string>& names)
+    {
+        for (const auto& name : names)
+        {
+            output << name << ",";
+        }
+
+        output << std::endl;
+    }
+}
+
 void BulletRobotLogger::startLogging()
 {
     running = true;
@@ -17,74 +56,329 @@ void BulletRobotLogger::stopLogging()
     running = false;
 }
 
+std::vector<std::string> BulletRobotLogger::getColumnNames() const
+{
+    std::vector<std::string> names;
+    names.push_back("Timestamp");
+
+    for (const auto& node : nodes)
+    {
+        const std::string& name = node->getName();
+        names.push_back("TargetAngle" + name);
+        names.push_back("ActualAngle" + name);
+        names.push_back("TargetVelocity" + name);
+        names.push_back("ActualVelocity" + name);
+        names.push_back("ActualTorque" + name);
+        names.push_back("ActualForceX" + name);
+        names.push_back("ActualForceY" + name);
+        names.push_back("ActualForceZ" + name);
+    }
+
+    names.push_back("CoM X");
+    names.push_back("CoM Y");
+    names.push_back("CoM Z");
+    names.push_back("CoMVelocity X");
+    names.push_back("CoMVelocity Y");
+    names.push_back("CoMVelocity Z");
+    return names;
+}
+
 void BulletRobotLogger::writeToFile(const std::string& path)
 {
     // Nothing to log
-    if (targetAngleLog.size() == 0)
+    if (timestamps.size() == 0)
     {
         return;
     }
 
     std::ofstream output(path.c_str());
+    writeCSVHeader(output, getColumnNames());
+
+    for (size_t frame = 0; frame < timestamps.size(); frame++)
+    {
+        output << timestamps[frame] << ",";
+        const float* values = &memoryLog[frame * frameSize];
+
+        for (size_t i = 0; i < frameSize; i++)
+        {
+            output << values[i] << ",";
+        }
+
+        output << std::endl;
+    }
+}
+
+bool BulletRobotLogger::openStream(const std::string& path, size_t ringBufferFrames, size_t flushBlockFrames)
+{
+    closeStream();
 
-    int num_frames = timestamps.size();
-    int num_dof = targetAngleLog[0].rows();
+    THROW_VR_EXCEPTION_IF(ringBufferFrames == 0 || flushBlockFrames == 0, "Invalid ring buffer size");
 
-    output << "Timestamp" << ",";
+    streamFile = fopen(path.c_str(), "wb");
 
-    for (int dof = 0; dof < num_dof; dof++)
+    if (!streamFile)
     {
-        std::string name = (*jointNodes)[dof]->getName();
-        output << "TargetAngle" << name << ",";
-        output << "ActualAngle" << name << ",";
-        output << "TargetVelocity" << name << ",";
-        output << "ActualVelocity" << name << ",";
-        output << "ActualTorque" << name << ",";
-        output << "ActualForceX" << name << ",";
-        output << "ActualForceY" << name << ",";
-        output << "ActualForceZ" << name << ",";
+        VR_ERROR << "Could not open log file " << path << std::endl;
+        return false;
     }
 
-    output << "CoM X" << ",";
-    output << "CoM Y" << ",";
-    output << "CoM Z" << ",";
-    output << "CoMVelocity X" << ",";
-    output << "CoMVelocity Y" << ",";
-    output << "CoMVelocity Z" << ",";
-    output << std::endl;
+    // schema header
+    std::vector<std::string> names = getColumnNames();
+    std::vector<char> header;
+    header.insert(header.end(), logMagic, logMagic + sizeof(logMagic));
+    append(header, logVersion);
+    append(header, uint32_t(names.size()));
 
-    for (int frame = 0; frame < num_frames; frame++)
+    for (size_t i = 0; i < names.size(); i++)
     {
-        output << timestamps[frame] << ",";
+        append(header, uint8_t(i == 0 ? eFloat64 : eFloat32));
+        append(header, uint16_t(names[i].size()));
+        header.insert(header.end(), names[i].begin(), names[i].end());
+    }
+
+    fwrite(header.data(), 1, header.size(), streamFile);
+
+    ringFrames = ringBufferFrames;
+    blockFrames = std::min(flushBlockFrames, ringBufferFrames);
+    ring.assign(ringFrames * frameSize, 0.0f);
+    ringTimestamps.assign(ringFrames, 0.0);
+    ringHead = 0;
+    ringTail = 0;
+    droppedFrames = 0;
+    stopFlush = false;
+    flushThread = std::thread(&BulletRobotLogger::flushLoop, this);
+    return true;
+}
+
+void BulletRobotLogger::closeStream()
+{
+    if (!streamFile)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(flushMutex);
+        stopFlush = true;
+    }
+    flushCondition.notify_one();
+    flushThread.join();
+
+    // frames that were logged after the last flush of the thread
+    flushPending();
+    fclose(streamFile);
+    streamFile = nullptr;
+
+    if (droppedFrames > 0)
+    {
+        VR_WARNING << "Dropped " << droppedFrames << " frames, since the ring buffer was full. Consider increasing its size." << std::endl;
+    }
+}
 
-        for (int dof = 0; dof < num_dof; dof++)
+bool BulletRobotLogger::isStreaming() const
+{
+    return streamFile != nullptr;
+}
+
+size_t BulletRobotLogger::getNumFrames() const
+{
+    return numFrames;
+}
+
+size_t BulletRobotLogger::getDroppedFrames() const
+{
+    return droppedFrames;
+}
+
+double BulletRobotLogger::getAverageLogTime() const
+{
+    size_t ticks = numFrames + droppedFrames;
+    return ticks > 0 ? double(logTimeNS) / 1000.0 / double(ticks) : 0.0;
+}
+
+void BulletRobotLogger::flushLoop()
+{
+    while (true)
+    {
         {
-            output << targetAngleLog[frame](dof) << ",";
-            output << actualAngleLog[frame](dof) << ",";
-            output << targetVelocityLog[frame](dof) << ",";
-            output << actualVelocityLog[frame](dof) << ",";
-            output << actualJointTorquesLog[frame](dof) << ",";
-            output << actualJointForcesLog[frame](0, dof) << ",";
-            output << actualJointForcesLog[frame](1, dof) << ",";
-            output << actualJointForcesLog[frame](2, dof) << ",";
+            std::unique_lock<std::mutex> lock(flushMutex);
+            flushCondition.wait_for(lock, std::chrono::milliseconds(20), [this]()
+            {
+                return stopFlush || ringHead.load(std::memory_order_acquire) - ringTail.load(std::memory_order_relaxed) >= blockFrames;
+            });
         }
 
-        output << actualCoMLog[frame].x() << ",";
-        output << actualCoMLog[frame].y() << ",";
-        output << actualCoMLog[frame].z() << ",";
-        output << actualCoMVelocityLog[frame].x() << ",";
-        output << actualCoMVelocityLog[frame].y() << ",";
-        output << actualCoMVelocityLog[frame].z() << ",";
-        output << std::endl;
+        flushPending();
+
+        if (stopFlush)
+        {
+            return;
+        }
     }
 }
 
+void BulletRobotLogger::flushPending()
+{
+    size_t head = ringHead.load(std::memory_order_acquire);
+    size_t tail = ringTail.load(std::memory_order_relaxed);
+
+    while (tail < head)
+    {
+        size_t n = std::min(head - tail, blockFrames);
+
+        // transpose the frames into columns
+        blockBuffer.clear();
+        blockBuffer.reserve(sizeof(uint32_t) + n * (sizeof(double) + frameSize * sizeof(float)));
+        append(blockBuffer, uint32_t(n));
+
+        for (size_t f = 0; f < n; f++)
+        {
+            append(blockBuffer, ringTimestamps[(tail + f) % ringFrames]);
+        }
+
+        for (size_t c = 0; c < frameSize; c++)
+        {
+            for (size_t f = 0; f < n; f++)
+            {
+                append(blockBuffer, ring[((tail + f) % ringFrames) * frameSize + c]);
+            }
+        }
+
+        fwrite(blockBuffer.data(), 1, blockBuffer.size(), streamFile);
+        tail += n;
+        ringTail.store(tail, std::memory_order_release);
+    }
+
+    fflush(streamFile);
+}
+
+bool BulletRobotLogger::convertToCSV(const std::string& binaryPath, const std::string& csvPath)
+{
+    std::ifstream input(binaryPath.c_str(), std::ios::binary);
+
+    if (!input)
+    {
+        VR_ERROR << "Could not open log file " << binaryPath << std::endl;
+        return false;
+    }
+
+    char magic[sizeof(logMagic)];
+    uint16_t version = 0;
+    uint32_t numColumns = 0;
+
+    if (!input.read(magic, sizeof(magic)) || memcmp(magic, logMagic, sizeof(logMagic)) != 0
+        || !read(input, version) || version != logVersion || !read(input, numColumns))
+    {
+        VR_ERROR << binaryPath << " is not a robot log file" << std::endl;
+        return false;
+    }
+
+    std::vector<std::string> names(numColumns);
+    std::vector<uint8_t> types(numColumns);
+
+    for (uint32_t i = 0; i < numColumns; i++)
+    {
+        uint16_t length = 0;
+
+        if (!read(input, types[i]) || !read(input, length) || types[i] > eFloat64)
+        {
+            VR_ERROR << "Corrupt header in " << binaryPath << std::endl;
+            return false;
+        }
+
+        names[i].resize(length);
+
+        if (length > 0 && !input.read(&names[i][0], length))
+        {
+            VR_ERROR << "Corrupt header in " << binaryPath << std::endl;
+            return false;
+        }
+    }
+
+    std::ofstream output(csvPath.c_str());
+
+    if (!output)
+    {
+        VR_ERROR << "Could not open " << csvPath << std::endl;
+        return false;
+    }
+
+    writeCSVHeader(output, names);
+
+    std::vector<std::vector<char> > columns(numColumns);
+    uint32_t n = 0;
+
+    while (read(input, n))
+    {
+        for (uint32_t c = 0; c < numColumns; c++)
+        {
+            columns[c].resize(size_t(n) * (types[c] == eFloat64 ? sizeof(double) : sizeof(float)));
+
+            if (!input.read(columns[c].data(), columns[c].size()))
+            {
+                VR_ERROR << "Truncated block in " << binaryPath << std::endl;
+                return false;
+            }
+        }
+
+        for (uint32_t f = 0; f < n; f++)
+        {
+            for (uint32_t c = 0; c < numColumns; c++)
+            {
+                if (types[c] == eFloat64)
+                {
+                    double v;
+                    memcpy(&v, &columns[c][f * sizeof(double)], sizeof(double));
+                    output << v << ",";
+                }
+                else
+                {
+                    float v;
+                    memcpy(&v, &columns[c][f * sizeof(float)], sizeof(float));
+                    output << v << ",";
+                }
+            }
+
+            output << std::endl;
+        }
+    }
+
+    return true;
+}
+
 void BulletRobotLogger::logCB(void* data, btScalar dt)
 {
     BulletRobotLogger* logger = static_cast<BulletRobotLogger*>(data);
     logger->log(dt);
 }
 
+void BulletRobotLogger::recordFrame(float* frame)
+{
+    for (const auto& node : nodes)
+    {
+        Eigen::Vector3f forces = robot->getJointForces(node);
+        frame[0] = float(robot->getNodeTarget(node));
+        frame[1] = float(robot->getJointAngle(node));
+        frame[2] = float(robot->getJointTargetSpeed(node));
+        // bullet changes the sign???
+        frame[3] = float(-robot->getJointSpeed(node));
+        frame[4] = float(robot->getJointTorque(node));
+        frame[5] = forces.x();
+        frame[6] = forces.y();
+        frame[7] = forces.z();
+        frame += 8;
+    }
+
+    Eigen::Vector3f com = bodyNodes->getCoM();
+    Eigen::Vector3f comVelocity = robot->getComVelocityGlobal(bodyNodes);
+    frame[0] = com.x();
+    frame[1] = com.y();
+    frame[2] = com.z();
+    frame[3] = comVelocity.x();
+    frame[4] = comVelocity.y();
+    frame[5] = comVelocity.z();
+}
+
 void BulletRobotLogger::log(btScalar dt)
 {
     if (!running)
@@ -92,42 +386,47 @@ void BulletRobotLogger::log(btScalar dt)
         return;
     }
 
-    if (int(actualAngleLog.size()) > max_samples)
+    auto start = std::chrono::steady_clock::now();
+
+    if (streamFile)
     {
-        std::cout << "Warning: Exceeded max_samples! Stopping logging." << std::endl;
-        running = false;
-        return;
-    }
+        size_t head = ringHead.load(std::memory_order_relaxed);
+        timestamp += dt;
 
-    int dof = jointNodes->getSize();
-    Eigen::VectorXf actualAngle(dof);
-    Eigen::VectorXf targetAngle(dof);
-    Eigen::VectorXf actualVelocity(dof);
-    Eigen::VectorXf targetVelocity(dof);
-    Eigen::VectorXf actualTorque(dof);
-    Eigen::Matrix3Xf actualForces(3, dof);
+        if (head - ringTail.load(std::memory_order_acquire) >= ringFrames)
+        {
+            // never block the simulation
+            droppedFrames++;
+        }
+        else
+        {
+            size_t slot = head % ringFrames;
+            ringTimestamps[slot] = timestamp;
+            recordFrame(&ring[slot * frameSize]);
+            ringHead.store(head + 1, std::memory_order_release);
+            numFrames++;
 
-    for (unsigned int i = 0; i < jointNodes->getSize(); i++)
+            if ((head + 1) % blockFrames == 0)
+            {
+                flushCondition.notify_one();
+            }
+        }
+    }
+    else
     {
-        const VirtualRobot::RobotNodePtr& node = (*jointNodes)[i];
-        actualAngle(i)    = float(robot->getJointAngle(node));
-        // bullet changes the sign???
-        actualVelocity(i) = float(-robot->getJointSpeed(node));
-        targetAngle(i) = float(robot->getNodeTarget(node));
-        targetVelocity(i) = float(robot->getJointTargetSpeed(node));
-        actualTorque(i) = float(robot->getJointTorque(node));
-        actualForces.col(i) = robot->getJointForces(node);
+        if (int(timestamps.size()) > max_samples)
+        {
+            std::cout << "Warning: Exceeded max_samples! Stopping logging." << std::endl;
+            running = false;
+            return;
+        }
+
+        memoryLog.resize(memoryLog.size() + frameSize);
+        recordFrame(&memoryLog[timestamps.size() * frameSize]);
+        timestamp += dt;
+        timestamps.push_back(timestamp);
+        numFrames++;
     }
 
-    actualJointTorquesLog.push_back(actualTorque);
-    actualJointForcesLog.push_back(actualForces);
-    actualCoMLog.push_back(bodyNodes->getCoM());
-    actualCoMVelocityLog.push_back(robot->getComVelocityGlobal(bodyNodes));
-    actualVelocityLog.push_back(actualVelocity);
-    actualAngleLog.push_back(actualAngle);
-    targetAngleLog.push_back(targetAngle);
-    targetVelocityLog.push_back(targetVelocity);
-    timestamp += dt;
-    timestamps.push_back(timestamp);
+    logTimeNS += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
 }
-
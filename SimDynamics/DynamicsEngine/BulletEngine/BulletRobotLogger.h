@@ -6,8 +6,29 @@
 #include "BulletEngine.h"
 #include "BulletRobot.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
 /*
  * Logger for a BulletRobot that logs target/actual position/velocity to a file.
+ *
+ * Per tick, one frame is recorded: the timestamp and, for each joint, target/actual angle, target/actual velocity,
+ * torque and force (x/y/z), followed by the CoM position and velocity (x/y/z).
+ *
+ * Two modes are supported:
+ *  - In-memory (standard): frames are appended to a flat buffer (up to max_samples) and written as CSV with writeToFile().
+ *  - Streaming: after openStream(), frames are written into a fixed-size ring buffer. A background thread transposes
+ *    them into column blocks and appends them to a binary file, so memory usage is constant for arbitrarily long runs.
+ *    Use convertToCSV() to obtain the same CSV layout as writeToFile().
+ *
+ * Binary format (native byte order):
+ *  - header: magic "SXRLOG", uint16 version, uint32 number of columns,
+ *            per column: uint8 type (0: float32, 1: float64), uint16 name length, name
+ *  - blocks: uint32 number of frames n, followed by n values of each column (column by column)
+ * The first column is the timestamp (float64), all others are float32.
  */
 namespace SimDynamics
 {
@@ -27,19 +48,25 @@ namespace SimDynamics
             , max_samples(1024 * 1024)
             , timestamp(0.0f)
             , logPath("")
+            , numFrames(0)
+            , streamFile(nullptr)
+            , ringFrames(0)
+            , blockFrames(0)
+            , ringHead(0)
+            , ringTail(0)
+            , droppedFrames(0)
+            , stopFlush(false)
+            , logTimeNS(0)
         {
-            int dof = jointNodes->getSize();
-            actualAngle.resize(dof);
-            targetAngle.resize(dof);
-            actualVelocity.resize(dof);
-            targetVelocity.resize(dof);
-            actualTorque.resize(dof);
-            actualForces.resize(3, dof);
+            nodes = jointNodes->getAllRobotNodes();
+            frameSize = nodes.size() * 8 + 6;
             engine->addExternalCallback(logCB, (void*) this);
         }
 
         ~BulletRobotLogger()
         {
+            closeStream();
+
             if (logPath.size() > 0)
             {
                 writeToFile(logPath);
@@ -51,40 +78,79 @@ namespace SimDynamics
             logPath = path;
         }
 
+        //! Writes the frames that were logged in memory as CSV.
         void writeToFile(const std::string& path);
         void startLogging();
         void stopLogging();
 
+        /*!
+            Switch to streaming mode: all following frames are written to the binary file at path.
+            \param ringBufferFrames Capacity of the ring buffer. If the flush thread can not keep up, frames are dropped (see getDroppedFrames()) instead of stalling the simulation.
+            \param flushBlockFrames The flush thread is woken up whenever this many frames are pending, this is also the maximum size of the column blocks in the file.
+        */
+        bool openStream(const std::string& path, size_t ringBufferFrames = 8192, size_t flushBlockFrames = 1024);
+
+        //! Writes all pending frames, stops the flush thread and closes the binary file.
+        void closeStream();
+        bool isStreaming() const;
+
+        /*!
+            Converts a binary log to the CSV layout of writeToFile().
+        */
+        static bool convertToCSV(const std::string& binaryPath, const std::string& csvPath);
+
+        //! Names of the logged columns, starting with the timestamp.
+        std::vector<std::string> getColumnNames() const;
+
+        //! Number of logged frames (in memory or streamed).
+        size_t getNumFrames() const;
+        //! Number of frames that were dropped, since the ring buffer was full.
+        size_t getDroppedFrames() const;
+        //! Average time that was spent in the logging callback per tick, in microseconds.
+        double getAverageLogTime() const;
+
     private:
         const BulletRobotPtr robot;
         bool running;
         VirtualRobot::RobotNodeSetPtr jointNodes;
         VirtualRobot::RobotNodeSetPtr bodyNodes;
-        std::vector<Eigen::VectorXf, Eigen::aligned_allocator<Eigen::VectorXf> > targetAngleLog;
-        std::vector<Eigen::VectorXf, Eigen::aligned_allocator<Eigen::VectorXf> > targetVelocityLog;
-        std::vector<Eigen::VectorXf, Eigen::aligned_allocator<Eigen::VectorXf> > actualAngleLog;
-        std::vector<Eigen::VectorXf, Eigen::aligned_allocator<Eigen::VectorXf> > actualVelocityLog;
-        std::vector<Eigen::VectorXf, Eigen::aligned_allocator<Eigen::VectorXf> > actualJointTorquesLog;
-        std::vector<Eigen::Matrix3Xf, Eigen::aligned_allocator<Eigen::Matrix3Xf> > actualJointForcesLog;
-        std::vector<Eigen::Vector3f, Eigen::aligned_allocator<Eigen::Vector3f> > actualCoMLog;
-        std::vector<Eigen::Vector3f, Eigen::aligned_allocator<Eigen::Vector3f> > actualCoMVelocityLog;
-        std::vector<double> timestamps;
+        std::vector<VirtualRobot::RobotNodePtr> nodes;
         int max_samples;
         double timestamp;
         std::string logPath;
 
-        Eigen::VectorXf actualAngle;
-        Eigen::VectorXf targetAngle;
-        Eigen::VectorXf actualVelocity;
-        Eigen::VectorXf targetVelocity;
-        Eigen::VectorXf actualTorque;
-        Eigen::Matrix3Xf actualForces;
+        // number of float values per frame (without the timestamp)
+        size_t frameSize;
+        size_t numFrames;
+
+        // in-memory log, frame by frame
+        std::vector<float> memoryLog;
+        std::vector<double> timestamps;
+
+        // streaming: single producer (the simulation) / single consumer (flush thread) ring buffer
+        FILE* streamFile;
+        std::vector<float> ring;
+        std::vector<double> ringTimestamps;
+        size_t ringFrames;
+        size_t blockFrames;
+        std::atomic<size_t> ringHead;
+        std::atomic<size_t> ringTail;
+        std::atomic<size_t> droppedFrames;
+        std::thread flushThread;
+        std::mutex flushMutex;
+        std::condition_variable flushCondition;
+        std::atomic<bool> stopFlush;
+        std::vector<char> blockBuffer;
+
+        std::atomic<long long> logTimeNS;
 
         static void logCB(void* data, btScalar dt);
         void log(btScalar dt);
+        void recordFrame(float* frame);
+        void flushLoop();
+        void flushPending();
     };
 
     typedef boost::shared_ptr<BulletRobotLogger> BulletRobotLoggerPtr;
 
 }
-
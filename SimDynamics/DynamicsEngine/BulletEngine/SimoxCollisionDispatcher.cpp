@@ -21,7 +21,7 @@ namespace SimDynamics
         SimDynamics::BulletObject* o0 = static_cast<SimDynamics::BulletObject*>(body0->getUserPointer());
         SimDynamics::BulletObject* o1 = static_cast<SimDynamics::BulletObject*>(body1->getUserPointer());
 
-        if (!engine || engine->checkCollisionEnabled(o0, o1))
+        if (!engine || engine->isCollisionEnabled(o0, o1))
         {
             return btCollisionDispatcher::needsCollision(body0, body1);
         }
@@ -34,7 +34,7 @@ namespace SimDynamics
         SimDynamics::BulletObject* o0 = static_cast<SimDynamics::BulletObject*>(body0->getUserPointer());
         SimDynamics::BulletObject* o1 = static_cast<SimDynamics::BulletObject*>(body1->getUserPointer());
 
-        if (!engine || engine->checkCollisionEnabled(o0, o1))
+        if (!engine || engine->isCollisionEnabled(o0, o1))
         {
             return btCollisionDispatcher::needsResponse(body0, body1);
         }
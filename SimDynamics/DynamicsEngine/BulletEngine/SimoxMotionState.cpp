@@ -13,7 +13,9 @@ namespace SimDynamics
 
 
     SimoxMotionState::SimoxMotionState(VirtualRobot::SceneObjectPtr sceneObject)
-        : btDefaultMotionState()
+        : btDefaultMotionState(),
+          deferredSync(false),
+          simoxPoseDirty(false)
     {
         this->sceneObject = sceneObject;
         initalGlobalPose.setIdentity();
@@ -54,7 +56,7 @@ namespace SimDynamics
     void SimoxMotionState::setWorldTransform(const btTransform& worldPose)
     {
         // Check callbacks
-        if (callbacks.size() > 0)
+        if (!deferredSync && callbacks.size() > 0)
         {
             std::vector<SimoxMotionStateCallback*>::iterator it;
 
@@ -78,7 +80,52 @@ namespace SimDynamics
         _graphicsTransfrom = _transform;
         //_graphicsTransfrom.getOrigin();// -= _comOffset.getOrigin(); // com adjusted
 
+        if (deferredSync)
+        {
+            // the Simox pose is updated in syncSimoxPose()
+            simoxPoseDirty = true;
+            return;
+        }
+
+        setGlobalPoseSimox(BulletEngine::getPoseEigen(_graphicsTransfrom));
+    }
+
+    void SimoxMotionState::setDeferredSync(bool enable)
+    {
+        deferredSync = enable;
+
+        if (!enable)
+        {
+            syncSimoxPose();
+        }
+    }
+
+    bool SimoxMotionState::isDeferredSync() const
+    {
+        return deferredSync;
+    }
+
+    bool SimoxMotionState::isSimoxPoseDirty() const
+    {
+        return simoxPoseDirty;
+    }
+
+    bool SimoxMotionState::syncSimoxPose()
+    {
+        if (!simoxPoseDirty)
+        {
+            return false;
+        }
+
+        simoxPoseDirty = false;
+
+        for (auto& callback : callbacks)
+        {
+            callback->poseChanged(_transform);
+        }
+
         setGlobalPoseSimox(BulletEngine::getPoseEigen(_graphicsTransfrom));
+        return true;
     }
 
     void SimoxMotionState::getWorldTransform(btTransform& worldTrans) const
@@ -220,6 +267,9 @@ namespace SimDynamics
         //Eigen::Matrix4f m = Eigen::Matrix4f::Identity();
         //m.block(0,3,3,1) = com;
         setWorldTransform(m_startWorldTrans);
+
+        // explicitly set poses are passed to Simox immediately
+        syncSimoxPose();
     }
 
 }
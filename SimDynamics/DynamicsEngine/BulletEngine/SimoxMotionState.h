@@ -107,6 +107,25 @@ namespace SimDynamics
         */
         void setGlobalPose(const Eigen::Matrix4f& pose);
 
+        /*!
+            In deferred mode, setWorldTransform() only stores the Bullet transform.
+            The Simox pose is not updated and the callbacks are not executed until syncSimoxPose() is called.
+            This avoids updating Simox poses (and collision/visualization models) on every Bullet substep.
+            Explicitly set poses (setGlobalPose(), setCOM()) are always passed to Simox immediately.
+            Disabling the deferred mode synchronizes a pending pose.
+        */
+        void setDeferredSync(bool enable);
+        bool isDeferredSync() const;
+
+        //! True, if the Bullet transform changed since the Simox pose was updated the last time (only in deferred mode).
+        bool isSimoxPoseDirty() const;
+
+        /*!
+            Executes the callbacks and updates the Simox pose from the current Bullet transform, if it changed.
+            \return True, if the pose was updated.
+        */
+        bool syncSimoxPose();
+
     protected:
         void updateTransform();
         void _setCOM(const Eigen::Vector3f& com);
@@ -126,6 +145,9 @@ namespace SimDynamics
 
 
         std::vector<SimoxMotionStateCallback*> callbacks;
+
+        bool deferredSync;
+        bool simoxPoseDirty;
     };
 
 }
@@ -10,9 +10,27 @@
 #include <VirtualRobot/RuntimeEnvironment.h>
 #include <SimDynamics/DynamicsWorld.h>
 #include <SimDynamics/DynamicsEngine/BulletEngine/BulletEngineFactory.h>
+#include <SimDynamics/DynamicsEngine/BulletEngine/BulletEngine.h>
+#include <SimDynamics/DynamicsEngine/BulletEngine/BulletBatchSimulation.h>
+#include <SimDynamics/DynamicsEngine/BulletEngine/BulletMultiBodyRobot.h>
+#include <SimDynamics/DynamicsEngine/BulletEngine/BulletRobotLogger.h>
+#include <VirtualRobot/XML/RobotIO.h>
+#include <VirtualRobot/Robot.h>
+#include <VirtualRobot/RobotNodeSet.h>
+#include <VirtualRobot/CollisionDetection/CollisionModel.h>
+#include <VirtualRobot/Scene.h>
 
 #include <VirtualRobot/Obstacle.h>
+#include <VirtualRobot/Visualization/VisualizationFactory.h>
+#include <VirtualRobot/Visualization/TriMeshModel.h>
+#include <VirtualRobot/Visualization/TriMeshUtils.h>
+#include <VirtualRobot/Import/MeshImport/STLReader.h>
 
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <string>
 
 
@@ -57,3 +75,717 @@ BOOST_AUTO_TEST_CASE(testSimDynamicsBulletFactoryCreateObject)
 
     BOOST_REQUIRE_NO_THROW(SimDynamics::DynamicsWorld::Close());
 }
+
+namespace
+{
+    // steps a scene of falling boxes and returns simulated seconds per wall-clock second
+    double runFallingBoxes(SimDynamics::BulletEngine::PoseSyncMode mode, int nBoxes, double simSeconds)
+    {
+        SimDynamics::DynamicsWorldPtr world = SimDynamics::DynamicsWorld::Init();
+        SimDynamics::BulletEnginePtr engine = boost::dynamic_pointer_cast<SimDynamics::BulletEngine>(world->getEngine());
+        BOOST_REQUIRE(engine);
+        engine->setPoseSyncMode(mode);
+        world->createFloorPlane();
+
+        std::vector<VirtualRobot::ObstaclePtr> boxes;
+        std::vector<SimDynamics::DynamicsObjectPtr> dynBoxes;
+
+        for (int i = 0; i < nBoxes; i++)
+        {
+            VirtualRobot::ObstaclePtr o = VirtualRobot::Obstacle::createBox(100.0f, 100.0f, 100.0f);
+            o->setMass(1.0f);
+            Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+            pose(0, 3) = float(i % 10) * 150.0f;
+            pose(1, 3) = float(i / 10) * 150.0f;
+            pose(2, 3) = 500.0f + float(i) * 10.0f;
+            o->setGlobalPose(pose);
+            SimDynamics::DynamicsObjectPtr dynObj = world->CreateDynamicsObject(o);
+            world->addObject(dynObj);
+            boxes.push_back(o);
+            dynBoxes.push_back(dynObj);
+        }
+
+        Eigen::Matrix4f startPose = boxes[0]->getGlobalPose();
+        const double dt = 0.01;
+        int steps = int(simSeconds / dt);
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < steps; i++)
+        {
+            engine->stepSimulation(dt, 10, 0.001);
+        }
+
+        double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (mode == SimDynamics::BulletEngine::eSyncOnDemand)
+        {
+            // Simox poses are only updated on request
+            BOOST_CHECK(boxes[0]->getGlobalPose().isApprox(startPose));
+            engine->syncSimoxPoses();
+        }
+
+        BOOST_CHECK_LT(boxes[0]->getGlobalPose()(2, 3), startPose(2, 3) - 100.0f);
+
+        for (auto& d : dynBoxes)
+        {
+            world->removeObject(d);
+        }
+
+        dynBoxes.clear();
+        boxes.clear();
+        SimDynamics::DynamicsWorld::Close();
+        return simSeconds / wall;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSimDynamicsBulletPoseSyncModes)
+{
+    const int nBoxes = 50;
+    const double simSeconds = 1.0;
+
+    double immediate = runFallingBoxes(SimDynamics::BulletEngine::eSyncImmediate, nBoxes, simSeconds);
+    double perStep = runFallingBoxes(SimDynamics::BulletEngine::eSyncPerStep, nBoxes, simSeconds);
+    double onDemand = runFallingBoxes(SimDynamics::BulletEngine::eSyncOnDemand, nBoxes, simSeconds);
+
+    BOOST_TEST_MESSAGE("simulated seconds per wall second, " << nBoxes << " boxes: immediate " << immediate
+                       << ", per step " << perStep << ", on demand " << onDemand);
+
+    VirtualRobot::RuntimeEnvironment::cleanup();
+}
+
+namespace
+{
+    // steps a scene with copies of the robot and returns the wall-clock milliseconds per stepSimulation() call
+    double runRobots(SimDynamics::BulletEngine::PoseSyncMode mode, VirtualRobot::RobotPtr robot, int nRobots, int steps)
+    {
+        SimDynamics::DynamicsWorldPtr world = SimDynamics::DynamicsWorld::Init();
+        SimDynamics::BulletEnginePtr engine = boost::dynamic_pointer_cast<SimDynamics::BulletEngine>(world->getEngine());
+        BOOST_REQUIRE(engine);
+        engine->setPoseSyncMode(mode);
+        world->createFloorPlane();
+
+        std::vector<VirtualRobot::RobotPtr> robots;
+        std::vector<SimDynamics::DynamicsRobotPtr> dynRobots;
+
+        for (int i = 0; i < nRobots; i++)
+        {
+            VirtualRobot::RobotPtr r = robot->clone(robot->getName() + std::to_string(i));
+            Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+            pose(0, 3) = float(i % 4) * 2000.0f;
+            pose(1, 3) = float(i / 4) * 2000.0f;
+            r->setGlobalPose(pose);
+            SimDynamics::DynamicsRobotPtr dynRobot = world->CreateDynamicsRobot(r);
+            world->addRobot(dynRobot);
+            robots.push_back(r);
+            dynRobots.push_back(dynRobot);
+        }
+
+        const double dt = 0.01;
+        auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < steps; i++)
+        {
+            engine->stepSimulation(dt, 10, 0.001);
+        }
+
+        double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (mode == SimDynamics::BulletEngine::eSyncOnDemand)
+        {
+            engine->syncSimoxPoses();
+        }
+
+        for (auto& d : dynRobots)
+        {
+            world->removeRobot(d);
+        }
+
+        dynRobots.clear();
+        robots.clear();
+        SimDynamics::DynamicsWorld::Close();
+        return wallMs / steps;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSimDynamicsBulletPoseSyncModesArmarIII)
+{
+    std::string filename = "robots/ArmarIII/ArmarIII.xml";
+    BOOST_REQUIRE(VirtualRobot::RuntimeEnvironment::getDataFileAbsolute(filename));
+    VirtualRobot::RobotPtr robot;
+    BOOST_REQUIRE_NO_THROW(robot = VirtualRobot::RobotIO::loadRobot(filename));
+    BOOST_REQUIRE(robot);
+
+    const int nRobots = 4;
+    const int steps = 50;
+
+    double immediate = runRobots(SimDynamics::BulletEngine::eSyncImmediate, robot, nRobots, steps);
+    double perStep = runRobots(SimDynamics::BulletEngine::eSyncPerStep, robot, nRobots, steps);
+    double onDemand = runRobots(SimDynamics::BulletEngine::eSyncOnDemand, robot, nRobots, steps);
+
+    BOOST_TEST_MESSAGE("ms per 10 ms step, " << nRobots << " ArmarIII (" << robot->getRobotNodes().size() << " nodes each): immediate "
+                       << immediate << ", per step " << perStep << ", on demand " << onDemand);
+
+    robot.reset();
+    VirtualRobot::RuntimeEnvironment::cleanup();
+}
+
+BOOST_AUTO_TEST_CASE(testSimDynamicsCollisionFilter)
+{
+    SimDynamics::DynamicsWorldPtr world;
+    BOOST_REQUIRE_NO_THROW(world = SimDynamics::DynamicsWorld::Init());
+    BOOST_REQUIRE(world);
+    SimDynamics::DynamicsEnginePtr engine = world->getEngine();
+
+    const int nObjects = 64;
+    std::vector<SimDynamics::DynamicsObjectPtr> objects;
+
+    for (int i = 0; i < nObjects; i++)
+    {
+        VirtualRobot::ObstaclePtr o = VirtualRobot::Obstacle::createBox(10.0f, 10.0f, 10.0f);
+        o->setMass(1.0f);
+        SimDynamics::DynamicsObjectPtr dynObj = world->CreateDynamicsObject(o);
+        BOOST_REQUIRE(dynObj);
+        BOOST_REQUIRE(world->addObject(dynObj));
+        objects.push_back(dynObj);
+    }
+
+    SimDynamics::DynamicsObject* a = objects[0].get();
+    SimDynamics::DynamicsObject* b = objects[1].get();
+    SimDynamics::DynamicsObject* c = objects[2].get();
+
+    BOOST_CHECK(engine->checkCollisionEnabled(a, b));
+
+    // pairs are symmetric
+    engine->disableCollision(a, b);
+    BOOST_CHECK(!engine->checkCollisionEnabled(a, b));
+    BOOST_CHECK(!engine->checkCollisionEnabled(b, a));
+    BOOST_CHECK(engine->checkCollisionEnabled(a, c));
+    engine->enableCollision(b, a);
+    BOOST_CHECK(engine->checkCollisionEnabled(a, b));
+
+    // disabling all collisions of an object overrides the pairs
+    engine->disableCollision(c);
+    BOOST_CHECK(!engine->checkCollisionEnabled(c));
+    BOOST_CHECK(!engine->checkCollisionEnabled(a, c));
+    BOOST_CHECK(!engine->checkCollisionEnabled(c, b));
+    engine->enableCollision(c);
+    BOOST_CHECK(engine->checkCollisionEnabled(a, c));
+
+    engine->disableCollision(a, b);
+    engine->disableCollision(c, a);
+    engine->disableCollision(a);
+    engine->resetCollisions(a);
+    BOOST_CHECK(engine->checkCollisionEnabled(a));
+    BOOST_CHECK(engine->checkCollisionEnabled(a, b));
+    BOOST_CHECK(engine->checkCollisionEnabled(c, a));
+
+    // removing an object frees its slot, re-added objects start without disabled collisions
+    engine->disableCollision(a, b);
+    engine->disableCollision(b);
+    BOOST_REQUIRE(world->removeObject(objects[1]));
+    BOOST_CHECK(engine->checkCollisionEnabled(a, b));
+    BOOST_REQUIRE(world->addObject(objects[1]));
+    BOOST_CHECK(engine->checkCollisionEnabled(b));
+    BOOST_CHECK(engine->checkCollisionEnabled(a, b));
+
+    // filter throughput, as queried by the broadphase
+    for (int i = 0; i < nObjects; i += 2)
+    {
+        engine->disableCollision(objects[i].get(), objects[(i + 1) % nObjects].get());
+    }
+
+    const int loops = 200;
+    size_t enabled = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int l = 0; l < loops; l++)
+    {
+        for (int i = 0; i < nObjects; i++)
+        {
+            for (int j = 0; j < nObjects; j++)
+            {
+                enabled += engine->isCollisionEnabled(objects[i].get(), objects[j].get()) ? 1 : 0;
+            }
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double pairs = double(loops) * nObjects * nObjects;
+    double seconds = std::chrono::duration<double>(end - start).count();
+    BOOST_CHECK_EQUAL(enabled, size_t(loops) * (nObjects * nObjects - nObjects));
+    BOOST_TEST_MESSAGE("collision filter: " << pairs / seconds << " pair checks per second");
+
+    for (auto& o : objects)
+    {
+        world->removeObject(o);
+    }
+
+    objects.clear();
+    engine.reset();
+    VirtualRobot::RuntimeEnvironment::cleanup();
+    BOOST_REQUIRE_NO_THROW(SimDynamics::DynamicsWorld::Close());
+}
+
+BOOST_AUTO_TEST_CASE(testSimDynamicsBulletBatchSimulation)
+{
+    VirtualRobot::ScenePtr scene(new VirtualRobot::Scene("boxes"));
+
+    for (int i = 0; i < 10; i++)
+    {
+        VirtualRobot::ObstaclePtr o = VirtualRobot::Obstacle::createBox(100.0f, 100.0f, 100.0f);
+        o->setName("box" + std::to_string(i));
+        o->setMass(1.0f);
+        Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+        pose(0, 3) = float(i) * 150.0f;
+        pose(2, 3) = 500.0f;
+        o->setGlobalPose(pose);
+        scene->registerObstacle(o);
+    }
+
+    const size_t nWorlds = 8;
+    SimDynamics::BulletBatchSimulation batch(scene);
+
+    // vary the drop height per world
+    batch.setSetupCallback([](size_t worldIndex, SimDynamics::BulletBatchSimulation::World & w)
+    {
+        VirtualRobot::SceneObjectPtr box = w.getObject("box0");
+        BOOST_REQUIRE(box);
+        Eigen::Matrix4f pose = box->getGlobalPose();
+        pose(2, 3) = 500.0f + 100.0f * float(worldIndex);
+        box->setGlobalPose(pose);
+    });
+    batch.setEvaluateCallback([](size_t, SimDynamics::BulletBatchSimulation::World & w, SimDynamics::BulletBatchSimulation::WorldResult & r)
+    {
+        r.values["objects"] = float(w.objects.size());
+    });
+
+    batch.run(nWorlds, 1.0, 4);
+
+    const auto& results = batch.getResults();
+    BOOST_REQUIRE_EQUAL(results.size(), nWorlds);
+
+    for (size_t i = 0; i < nWorlds; i++)
+    {
+        BOOST_CHECK_EQUAL(results[i].worldIndex, i);
+        BOOST_CHECK_EQUAL(results[i].steps, 100);
+        BOOST_CHECK_CLOSE(results[i].simTime, 1.0, 1e-3);
+        BOOST_CHECK_EQUAL(results[i].values.at("objects"), 10.0f);
+        BOOST_REQUIRE_EQUAL(results[i].poses.size(), 10);
+        // the boxes have landed on the floor
+        BOOST_CHECK_LT(results[i].poses.at("box0")(2, 3), 100.0f);
+    }
+
+    // the scene itself is not simulated
+    BOOST_CHECK_CLOSE(scene->getObstacle("box0")->getGlobalPose()(2, 3), 500.0f, 1e-3f);
+
+    const SimDynamics::BulletBatchSimulation::Statistics& s = batch.getStatistics();
+    BOOST_CHECK_EQUAL(s.totalSteps, nWorlds * 100);
+    BOOST_TEST_MESSAGE("batch simulation: " << s.worldStepsPerSecond << " world steps/s on " << s.threads << " threads, "
+                       << s.worldStepsPerSecondPerThread << " per thread");
+
+    batch.getWorlds().clear();
+    scene.reset();
+    VirtualRobot::RuntimeEnvironment::cleanup();
+}
+
+namespace
+{
+    std::string readFile(const std::string& path)
+    {
+        std::ifstream f(path.c_str());
+        return std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSimDynamicsBulletRobotLoggerStreaming)
+{
+    const std::string robotString =
+        "<Robot Type='LogRobot' RootNode='Base'>"
+        " <RobotNode name='Base'>"
+        "  <Physics><Mass value='2' units='kg'/><SimulationType value='Kinematic'/></Physics>"
+        "  <Child name='Joint1'/>"
+        " </RobotNode>"
+        " <RobotNode name='Joint1'>"
+        "  <Transform><Translation x='0' y='0' z='500'/></Transform>"
+        "  <Joint type='revolute'>"
+        "   <Limits unit='degree' lo='-180' hi='180'/>"
+        "   <Axis x='1' y='0' z='0'/>"
+        "  </Joint>"
+        "  <Physics><Mass value='1' units='kg'/><CoM location='joint' x='0' y='100' z='0' units='mm'/></Physics>"
+        "  <Child name='Joint2'/>"
+        " </RobotNode>"
+        " <RobotNode name='Joint2'>"
+        "  <Transform><Translation x='0' y='200' z='0'/></Transform>"
+        "  <Joint type='revolute'>"
+        "   <Limits unit='degree' lo='-180' hi='180'/>"
+        "   <Axis x='1' y='0' z='0'/>"
+        "  </Joint>"
+        "  <Physics><Mass value='1' units='kg'/><CoM location='joint' x='0' y='100' z='0' units='mm'/></Physics>"
+        " </RobotNode>"
+        "</Robot>";
+    VirtualRobot::RobotPtr robot = VirtualRobot::RobotIO::createRobotFromString(robotString);
+    BOOST_REQUIRE(robot);
+
+    VirtualRobot::ObstaclePtr box = VirtualRobot::Obstacle::createBox(50.0f, 50.0f, 50.0f);
+
+    for (const auto& rn : robot->getRobotNodes())
+    {
+        rn->setCollisionModel(box->getCollisionModel()->clone());
+    }
+
+    VirtualRobot::RobotNodeSetPtr joints = VirtualRobot::RobotNodeSet::createRobotNodeSet(robot, "Joints", {"Joint1", "Joint2"}, "", "", true);
+    VirtualRobot::RobotNodeSetPtr bodies = VirtualRobot::RobotNodeSet::createRobotNodeSet(robot, "Bodies", {"Base", "Joint1", "Joint2"}, "", "", true);
+
+    SimDynamics::DynamicsWorldPtr world = SimDynamics::DynamicsWorld::Init();
+    SimDynamics::BulletEnginePtr engine = boost::dynamic_pointer_cast<SimDynamics::BulletEngine>(world->getEngine());
+    BOOST_REQUIRE(engine);
+    SimDynamics::BulletRobotPtr dynRobot = boost::dynamic_pointer_cast<SimDynamics::BulletRobot>(world->CreateDynamicsRobot(robot));
+    BOOST_REQUIRE(dynRobot);
+    world->addRobot(dynRobot);
+
+    boost::filesystem::path dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::create_directories(dir);
+    const std::string binaryPath = (dir / "log.bin").string();
+    const std::string streamCSV = (dir / "stream.csv").string();
+    const std::string memoryCSV = (dir / "memory.csv").string();
+
+    // the same ticks are logged in memory and streamed with a small ring buffer, to exercise wrap-around
+    SimDynamics::BulletRobotLoggerPtr memoryLogger(new SimDynamics::BulletRobotLogger(engine, dynRobot, joints, bodies));
+    SimDynamics::BulletRobotLoggerPtr streamLogger(new SimDynamics::BulletRobotLogger(engine, dynRobot, joints, bodies));
+    BOOST_REQUIRE(streamLogger->openStream(binaryPath, 4096, 256));
+    BOOST_CHECK(streamLogger->isStreaming());
+    memoryLogger->startLogging();
+    streamLogger->startLogging();
+
+    const int steps = 300;
+
+    for (int i = 0; i < steps; i++)
+    {
+        engine->stepSimulation(0.01, 10, 0.001);
+    }
+
+    streamLogger->stopLogging();
+    memoryLogger->stopLogging();
+    streamLogger->closeStream();
+    BOOST_CHECK(!streamLogger->isStreaming());
+
+    BOOST_CHECK_EQUAL(streamLogger->getDroppedFrames(), 0);
+    BOOST_CHECK_EQUAL(streamLogger->getNumFrames(), memoryLogger->getNumFrames());
+    BOOST_CHECK_GT(streamLogger->getNumFrames(), size_t(steps));
+    BOOST_TEST_MESSAGE("logging overhead per tick: streaming " << streamLogger->getAverageLogTime()
+                       << " us, in memory " << memoryLogger->getAverageLogTime() << " us");
+
+    memoryLogger->writeToFile(memoryCSV);
+    BOOST_REQUIRE(SimDynamics::BulletRobotLogger::convertToCSV(binaryPath, streamCSV));
+    std::string csv = readFile(streamCSV);
+    BOOST_CHECK_EQUAL(csv, readFile(memoryCSV));
+    BOOST_CHECK_EQUAL(size_t(std::count(csv.begin(), csv.end(), '\n')), streamLogger->getNumFrames() + 1);
+    BOOST_CHECK_EQUAL(csv.substr(0, csv.find('\n')), "Timestamp,TargetAngleJoint1,ActualAngleJoint1,TargetVelocityJoint1,ActualVelocityJoint1,"
+                      "ActualTorqueJoint1,ActualForceXJoint1,ActualForceYJoint1,ActualForceZJoint1,TargetAngleJoint2,ActualAngleJoint2,"
+                      "TargetVelocityJoint2,ActualVelocityJoint2,ActualTorqueJoint2,ActualForceXJoint2,ActualForceYJoint2,ActualForceZJoint2,"
+                      "CoM X,CoM Y,CoM Z,CoMVelocity X,CoMVelocity Y,CoMVelocity Z,");
+    BOOST_CHECK(!SimDynamics::BulletRobotLogger::convertToCSV(memoryCSV, streamCSV));
+
+    streamLogger.reset();
+    memoryLogger.reset();
+    boost::filesystem::remove_all(dir);
+
+    world->removeRobot(dynRobot);
+    dynRobot.reset();
+    robot.reset();
+    box.reset();
+    VirtualRobot::RuntimeEnvironment::cleanup();
+    SimDynamics::DynamicsWorld::Close();
+}
+
+namespace
+{
+    // a chain of revolute joints with 200mm links, attached to a kinematic base, neighbouring links do not collide
+    VirtualRobot::RobotPtr createChainRobot(int numJoints)
+    {
+        std::string robotString = "<Robot Type='ChainRobot' RootNode='Base'>"
+                                  " <RobotNode name='Base'>"
+                                  "  <Transform><Translation x='0' y='0' z='1000'/></Transform>"
+                                  "  <Physics><Mass value='2' units='kg'/><SimulationType value='Kinematic'/></Physics>"
+                                  "  <Child name='Joint0'/>"
+                                  " </RobotNode>";
+
+        for (int i = 0; i < numJoints; i++)
+        {
+            robotString += " <RobotNode name='Joint" + std::to_string(i) + "'>"
+                           "  <Transform><Translation x='0' y='" + std::string(i == 0 ? "0" : "200") + "' z='0'/></Transform>"
+                           "  <Joint type='revolute'>"
+                           "   <Limits unit='degree' lo='-180' hi='180'/>"
+                           "   <Axis x='1' y='0' z='0'/>"
+                           "  </Joint>"
+                           "  <Physics><Mass value='1' units='kg'/><CoM location='joint' x='0' y='100' z='0' units='mm'/>"
+                           + std::string(i == 0 ? "" : "<IgnoreCollision name='Joint" + std::to_string(i - 1) + "'/>") + "</Physics>";
+
+            if (i + 1 < numJoints)
+            {
+                robotString += "  <Child name='Joint" + std::to_string(i + 1) + "'/>";
+            }
+
+            robotString += " </RobotNode>";
+        }
+
+        robotString += "</Robot>";
+        VirtualRobot::RobotPtr robot = VirtualRobot::RobotIO::createRobotFromString(robotString);
+        VirtualRobot::ObstaclePtr box = VirtualRobot::Obstacle::createBox(50.0f, 50.0f, 50.0f);
+
+        for (const auto& rn : robot->getRobotNodes())
+        {
+            rn->setCollisionModel(box->getCollisionModel()->clone());
+        }
+
+        return robot;
+    }
+
+    struct ChainResult
+    {
+        double stepsPerSecond;
+        double maxTrackingError;
+        double maxLinkDrift;
+    };
+
+    // moves all joints to target and measures tracking error, drift of the link distances and throughput
+    ChainResult simulateChain(SimDynamics::BulletEnginePtr engine, SimDynamics::DynamicsRobotPtr dynRobot, double target, double dt, int steps)
+    {
+        VirtualRobot::RobotPtr robot = dynRobot->getRobot();
+        std::vector<VirtualRobot::RobotNodePtr> joints;
+
+        for (const auto& rn : robot->getRobotNodes())
+        {
+            if (rn->isRotationalJoint())
+            {
+                joints.push_back(rn);
+                dynRobot->actuateNode(rn, target);
+            }
+        }
+
+        ChainResult result;
+        auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < steps; i++)
+        {
+            engine->stepSimulation(dt, 1, dt);
+        }
+
+        double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.stepsPerSecond = wallTime > 0 ? double(steps) / wallTime : 0;
+        engine->syncSimoxPoses();
+
+        result.maxTrackingError = 0;
+        result.maxLinkDrift = 0;
+
+        for (size_t i = 0; i < joints.size(); i++)
+        {
+            result.maxTrackingError = std::max(result.maxTrackingError, std::fabs(dynRobot->getJointAngle(joints[i]) - target));
+
+            if (i > 0)
+            {
+                float distance = (joints[i]->getGlobalPose().block<3, 1>(0, 3) - joints[i - 1]->getGlobalPose().block<3, 1>(0, 3)).norm();
+                result.maxLinkDrift = std::max(result.maxLinkDrift, double(std::fabs(distance - 200.0f)));
+            }
+        }
+
+        return result;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSimDynamicsBulletMultiBodyRobot)
+{
+    const int numJoints = 6;
+    const double target = 0.5;
+    // ten times the standard substep of 1ms
+    const double dt = 0.01;
+    const int steps = 300;
+
+    // constraint based reference, the BulletRobot needs the global world
+    SimDynamics::DynamicsWorldPtr world = SimDynamics::DynamicsWorld::Init();
+    SimDynamics::BulletEnginePtr engine = boost::dynamic_pointer_cast<SimDynamics::BulletEngine>(world->getEngine());
+    BOOST_REQUIRE(engine);
+    BOOST_CHECK(!engine->getBulletMultiBodyWorld());
+
+    VirtualRobot::RobotPtr robot = createChainRobot(numJoints);
+    BOOST_REQUIRE(robot);
+    SimDynamics::DynamicsRobotPtr dynRobot = world->CreateDynamicsRobot(robot);
+    world->addRobot(dynRobot);
+    ChainResult constraintResult = simulateChain(engine, dynRobot, target, dt, steps);
+
+    // the multibody robot can not be added to a standard world
+    VirtualRobot::RobotPtr mbRobot = createChainRobot(numJoints);
+    SimDynamics::BulletMultiBodyRobotPtr dynMBRobot(new SimDynamics::BulletMultiBodyRobot(mbRobot));
+    BOOST_CHECK(!engine->addRobot(dynMBRobot));
+
+    SimDynamics::BulletEngineConfigPtr config(new SimDynamics::BulletEngineConfig());
+    config->bulletUseMultiBodyWorld = true;
+    SimDynamics::DynamicsWorldPtr mbWorld = SimDynamics::DynamicsWorld::Create(config);
+    SimDynamics::BulletEnginePtr mbEngine = boost::dynamic_pointer_cast<SimDynamics::BulletEngine>(mbWorld->getEngine());
+    BOOST_REQUIRE(mbEngine);
+    BOOST_REQUIRE(mbEngine->getBulletMultiBodyWorld());
+
+    BOOST_CHECK(dynMBRobot->hasFixedBase());
+    BOOST_CHECK_EQUAL(dynMBRobot->getLinks().size(), size_t(numJoints));
+    BOOST_CHECK_EQUAL(dynMBRobot->getColliders().size(), size_t(numJoints + 1));
+    size_t numSlots = mbEngine->getNumCollisionFilterIndices();
+    BOOST_REQUIRE(mbWorld->addRobot(dynMBRobot));
+    ChainResult multiBodyResult = simulateChain(mbEngine, dynMBRobot, target, dt, steps);
+
+    BOOST_TEST_MESSAGE("chain with " << numJoints << " joints, dt=" << dt << "s: "
+                       << "BulletRobot " << constraintResult.stepsPerSecond << " steps/s, tracking error " << constraintResult.maxTrackingError
+                       << " rad, link drift " << constraintResult.maxLinkDrift << " mm; "
+                       << "BulletMultiBodyRobot " << multiBodyResult.stepsPerSecond << " steps/s, tracking error " << multiBodyResult.maxTrackingError
+                       << " rad, link drift " << multiBodyResult.maxLinkDrift << " mm");
+
+    // reduced coordinates: the links can not drift apart, and the joints reach their targets at the large time step
+    BOOST_CHECK_SMALL(multiBodyResult.maxLinkDrift, 0.1);
+    BOOST_CHECK_SMALL(multiBodyResult.maxTrackingError, 0.05);
+    BOOST_CHECK_CLOSE(mbRobot->getRobotNode("Joint0")->getJointValue(), dynMBRobot->getJointAngle(mbRobot->getRobotNode("Joint0")), 1e-3);
+    // the base is fixed
+    BOOST_CHECK_SMALL(double((mbRobot->getRobotNode("Base")->getGlobalPose().block<3, 1>(0, 3) - Eigen::Vector3f(0, 0, 1000.0f)).norm()), 0.1);
+
+    BOOST_CHECK(mbWorld->removeRobot(dynMBRobot));
+    BOOST_CHECK_EQUAL(mbEngine->getNumCollisionFilterIndices(), numSlots);
+
+    // adding and removing the robot again frees the collision filter slots of the links each time
+    for (int i = 0; i < 3; i++)
+    {
+        BOOST_REQUIRE(mbWorld->addRobot(dynMBRobot));
+        BOOST_CHECK_GT(mbEngine->getNumCollisionFilterIndices(), numSlots);
+        BOOST_CHECK(mbWorld->removeRobot(dynMBRobot));
+        BOOST_CHECK_EQUAL(mbEngine->getNumCollisionFilterIndices(), numSlots);
+    }
+
+    dynMBRobot.reset();
+    mbWorld.reset();
+    world->removeRobot(dynRobot);
+    dynRobot.reset();
+    VirtualRobot::RuntimeEnvironment::cleanup();
+    SimDynamics::DynamicsWorld::Close();
+}
+
+namespace
+{
+    VirtualRobot::ObstaclePtr createMeshObstacle(const std::string& name, VirtualRobot::TriMeshModelPtr mesh, const Eigen::Vector3f& position)
+    {
+        VirtualRobot::VisualizationFactoryPtr factory = VirtualRobot::VisualizationFactory::first(NULL);
+        Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+        VirtualRobot::VisualizationNodePtr visu = factory->createTriMeshModelVisualization(mesh, pose);
+        VirtualRobot::CollisionModelPtr colModel(new VirtualRobot::CollisionModel(visu->clone(), name));
+        VirtualRobot::ObstaclePtr o(new VirtualRobot::Obstacle(name, visu, colModel));
+        o->setMass(1.0f);
+        pose.block<3, 1>(0, 3) = position;
+        o->setGlobalPose(pose);
+        return o;
+    }
+
+    struct ShapeBenchmark
+    {
+        double stepsPerSecond;
+        double collisionDetectionMS; // per call of performDiscreteCollisionDetection
+        float boxHeight; // final height of the box that was dropped into the first bowl
+    };
+
+    ShapeBenchmark benchmarkCollisionShapes(SimDynamics::BulletObject::CollisionShapeMode mode, VirtualRobot::TriMeshModelPtr household)
+    {
+        SimDynamics::BulletObject::ShapeMode = mode;
+        SimDynamics::DynamicsWorldPtr world = SimDynamics::DynamicsWorld::Init();
+        SimDynamics::BulletEnginePtr engine = boost::dynamic_pointer_cast<SimDynamics::BulletEngine>(world->getEngine());
+        BOOST_REQUIRE(engine);
+        world->createFloorPlane();
+
+        // bowls and household objects on a 4x4 grid, a box is dropped into the first bowl
+        std::vector<VirtualRobot::ObstaclePtr> obstacles;
+        std::vector<SimDynamics::DynamicsObjectPtr> dynObjects;
+        VirtualRobot::TriMeshModelPtr bowl = VirtualRobot::TriMeshUtils::CreateOpenBox(Eigen::Matrix4f::Identity(), 200, 200, 100, 20);
+
+        for (int i = 0; i < 16; i++)
+        {
+            Eigen::Vector3f position(float(i % 4) * 400.0f, float(i / 4) * 400.0f, i % 2 == 0 ? 1.0f : 200.0f);
+            obstacles.push_back(createMeshObstacle("mesh" + std::to_string(i), i % 2 == 0 ? bowl : household, position));
+        }
+
+        VirtualRobot::ObstaclePtr box = VirtualRobot::Obstacle::createBox(40.0f, 40.0f, 40.0f);
+        box->setMass(0.1f);
+        Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+        pose(2, 3) = 300.0f;
+        box->setGlobalPose(pose);
+        obstacles.push_back(box);
+
+        for (auto& o : obstacles)
+        {
+            SimDynamics::DynamicsObjectPtr dynObj = world->CreateDynamicsObject(o);
+            world->addObject(dynObj);
+            dynObjects.push_back(dynObj);
+        }
+
+        const double dt = 0.01;
+        const int steps = 200;
+        auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < steps; i++)
+        {
+            engine->stepSimulation(dt, 10, 0.001);
+        }
+
+        ShapeBenchmark result;
+        result.stepsPerSecond = steps / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const int loops = 100;
+        start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < loops; i++)
+        {
+            engine->getBulletWorld()->performDiscreteCollisionDetection();
+        }
+
+        result.collisionDetectionMS = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / loops;
+        result.boxHeight = box->getGlobalPose()(2, 3);
+
+        for (auto& d : dynObjects)
+        {
+            world->removeObject(d);
+        }
+
+        dynObjects.clear();
+        obstacles.clear();
+        SimDynamics::DynamicsWorld::Close();
+        SimDynamics::BulletObject::ShapeMode = SimDynamics::BulletObject::eConvexHull;
+        return result;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSimDynamicsBulletConvexDecomposition)
+{
+    std::string filename = "objects/stl/Piggy6.stl";
+    BOOST_REQUIRE(VirtualRobot::RuntimeEnvironment::getDataFileAbsolute(filename));
+    VirtualRobot::STLReaderPtr reader(new VirtualRobot::STLReader());
+    VirtualRobot::TriMeshModelPtr household(new VirtualRobot::TriMeshModel());
+    BOOST_REQUIRE(reader->read(filename, household));
+
+    boost::filesystem::path cache = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("simox-decomposition-%%%%-%%%%");
+    SimDynamics::BulletObject::DecompositionCacheDirectory = cache.string();
+
+    ShapeBenchmark hull = benchmarkCollisionShapes(SimDynamics::BulletObject::eConvexHull, household);
+    ShapeBenchmark decomposed = benchmarkCollisionShapes(SimDynamics::BulletObject::eConvexDecomposition, household);
+    // the second run loads the decompositions from the cache
+    auto start = std::chrono::steady_clock::now();
+    ShapeBenchmark cached = benchmarkCollisionShapes(SimDynamics::BulletObject::eConvexDecomposition, household);
+    double cachedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    BOOST_TEST_MESSAGE("convex hull: " << hull.stepsPerSecond << " steps/s, " << hull.collisionDetectionMS << " ms collision detection");
+    BOOST_TEST_MESSAGE("convex decomposition: " << decomposed.stepsPerSecond << " steps/s, " << decomposed.collisionDetectionMS << " ms collision detection");
+    BOOST_TEST_MESSAGE("convex decomposition (cached): " << cachedSeconds << " s including setup");
+
+    // the hull of the bowl is closed at the top, the box rests on it. The decomposition keeps the cavity.
+    BOOST_CHECK_GT(hull.boxHeight, 100.0f);
+    BOOST_CHECK_LT(decomposed.boxHeight, 100.0f);
+    BOOST_CHECK_LT(cached.boxHeight, 100.0f);
+    BOOST_CHECK(!boost::filesystem::is_empty(cache));
+
+    boost::filesystem::remove_all(cache);
+    SimDynamics::BulletObject::DecompositionCacheDirectory.clear();
+    VirtualRobot::RuntimeEnvironment::cleanup();
+}
@@ -57,6 +57,7 @@ namespace SimDynamics
             objects.push_back(o);
         }
 
+        getCollisionFilterIndex(o.get());
         o->setMutex(engineMutexPtr);
         return true;
     }
@@ -64,6 +65,7 @@ namespace SimDynamics
     bool DynamicsEngine::removeObject(DynamicsObjectPtr o)
     {
         MutexLockPtr lock = getScopedLock();
+        releaseCollisionFilterIndex(o.get());
         std::vector<DynamicsObjectPtr>::iterator it = find(objects.begin(), objects.end(), o);
 
         if (it == objects.end())
@@ -179,75 +181,112 @@ namespace SimDynamics
         return true;
     }
 
-    void DynamicsEngine::disableCollision(DynamicsObject* o1, DynamicsObject* o2)
+    int DynamicsEngine::getCollisionFilterIndex(const DynamicsObject* o)
     {
-        MutexLockPtr lock = getScopedLock();
-        std::vector<DynamicsObject*>::iterator i1 = find(collisionDisabled[o1].begin(), collisionDisabled[o1].end(), o2);
+        int i = findCollisionFilterIndex(o);
 
-        if (i1 == collisionDisabled[o1].end())
+        if (i >= 0)
         {
-            collisionDisabled[o1].push_back(o2);
+            return i;
         }
 
-        std::vector<DynamicsObject*>::iterator i2 = find(collisionDisabled[o2].begin(), collisionDisabled[o2].end(), o1);
-
-        if (i2 == collisionDisabled[o2].end())
+        if (!freeCollisionFilterIndices.empty())
         {
-            collisionDisabled[o2].push_back(o1);
+            i = freeCollisionFilterIndices.back();
+            freeCollisionFilterIndices.pop_back();
         }
+        else
+        {
+            i = int(collisionToAllDisabled.size());
+            collisionToAllDisabled.push_back(false);
+            collisionDisabled.emplace_back();
+        }
+
+        collisionFilterIndices[o] = i;
+        return i;
     }
 
-    void DynamicsEngine::disableCollision(DynamicsObject* o1)
+    void DynamicsEngine::releaseCollisionFilterIndex(const DynamicsObject* o)
     {
-        MutexLockPtr lock = getScopedLock();
-        std::vector<DynamicsObject*>::iterator i1 = find(collisionToAllDisabled.begin(), collisionToAllDisabled.end(), o1);
+        int i = findCollisionFilterIndex(o);
 
-        if (i1 == collisionToAllDisabled.end())
+        if (i < 0)
         {
-            collisionToAllDisabled.push_back(o1);
+            return;
+        }
+
+        for (size_t j = 0; j < collisionDisabled[i].size(); j++)
+        {
+            if (collisionDisabled[i][j] && j < collisionDisabled.size() && size_t(i) < collisionDisabled[j].size())
+            {
+                collisionDisabled[j][i] = false;
+            }
         }
+
+        collisionDisabled[i].clear();
+        collisionToAllDisabled[i] = false;
+        collisionFilterIndices.erase(o);
+        freeCollisionFilterIndices.push_back(i);
+    }
+
+    void DynamicsEngine::disableCollision(DynamicsObject* o1, DynamicsObject* o2)
+    {
+        MutexLockPtr lock = getScopedLock();
+        int i1 = getCollisionFilterIndex(o1);
+        int i2 = getCollisionFilterIndex(o2);
+
+        std::vector<bool>& row1 = collisionDisabled[i1];
+        std::vector<bool>& row2 = collisionDisabled[i2];
+        row1.resize(std::max(row1.size(), size_t(i2 + 1)), false);
+        row2.resize(std::max(row2.size(), size_t(i1 + 1)), false);
+        row1[i2] = true;
+        row2[i1] = true;
+    }
+
+    void DynamicsEngine::disableCollision(DynamicsObject* o1)
+    {
+        MutexLockPtr lock = getScopedLock();
+        collisionToAllDisabled[getCollisionFilterIndex(o1)] = true;
     }
 
     void DynamicsEngine::enableCollision(DynamicsObject* o1, DynamicsObject* o2)
     {
         MutexLockPtr lock = getScopedLock();
-        //if (o1 < o2)
-        //{
-        std::vector<DynamicsObject*>::iterator i1 = find(collisionDisabled[o1].begin(), collisionDisabled[o1].end(), o2);
+        int i1 = findCollisionFilterIndex(o1);
+        int i2 = findCollisionFilterIndex(o2);
 
-        if (i1 != collisionDisabled[o1].end())
+        if (i1 < 0 || i2 < 0)
         {
-            collisionDisabled[o1].erase(i1);
+            return;
         }
 
-        //} else
-        //{
-        std::vector<DynamicsObject*>::iterator i2 = find(collisionDisabled[o2].begin(), collisionDisabled[o2].end(), o1);
-
-        if (i2 != collisionDisabled[o2].end())
+        if (size_t(i2) < collisionDisabled[i1].size())
         {
-            collisionDisabled[o2].erase(i2);
+            collisionDisabled[i1][i2] = false;
         }
 
-        //}
+        if (size_t(i1) < collisionDisabled[i2].size())
+        {
+            collisionDisabled[i2][i1] = false;
+        }
     }
 
     void DynamicsEngine::enableCollision(DynamicsObject* o1)
     {
         MutexLockPtr lock = getScopedLock();
-        std::vector<DynamicsObject*>::iterator i1 = find(collisionToAllDisabled.begin(), collisionToAllDisabled.end(), o1);
+        int i1 = findCollisionFilterIndex(o1);
 
-        if (i1 != collisionToAllDisabled.end())
+        if (i1 >= 0)
         {
-            collisionToAllDisabled.erase(i1);
+            collisionToAllDisabled[i1] = false;
         }
     }
 
     bool DynamicsEngine::checkCollisionEnabled(DynamicsObject* o1)
     {
         MutexLockPtr lock = getScopedLock();
-        std::vector<DynamicsObject*>::iterator i1 = find(collisionToAllDisabled.begin(), collisionToAllDisabled.end(), o1);
-        return (i1 == collisionToAllDisabled.end());
+        int i1 = findCollisionFilterIndex(o1);
+        return !(i1 >= 0 && collisionToAllDisabled[i1]);
     }
 
     void DynamicsEngine::getFloorInfo(Eigen::Vector3f& floorPos, Eigen::Vector3f& floorUp, double& floorExtendMM, double& floorDepthMM)
@@ -261,59 +300,13 @@ namespace SimDynamics
     bool DynamicsEngine::checkCollisionEnabled(DynamicsObject* o1, DynamicsObject* o2)
     {
         MutexLockPtr lock = getScopedLock();
-        if(o1 == nullptr || o2 == nullptr)
-            return true;
-        if (!checkCollisionEnabled(o1))
-        {
-            return false;
-        }
-
-        if (!checkCollisionEnabled(o2))
-        {
-            return false;
-        }
-
-        //if (o1 < o2)
-        //{
-        std::vector<DynamicsObject*>::iterator i1 = find(collisionDisabled[o1].begin(), collisionDisabled[o1].end(), o2);
-
-        if (i1 != collisionDisabled[o1].end())
-        {
-            return false;
-        }
-
-        //} else
-        //{
-        std::vector<DynamicsObject*>::iterator i2 = find(collisionDisabled[o2].begin(), collisionDisabled[o2].end(), o1);
-
-        if (i2 != collisionDisabled[o2].end())
-        {
-            return false;
-        }
-
-        //}
-        return true;
+        return isCollisionEnabled(o1, o2);
     }
 
     void DynamicsEngine::resetCollisions(DynamicsObject* o)
     {
         MutexLockPtr lock = getScopedLock();
-        collisionDisabled.erase(o);
-        std::map < DynamicsObject*, std::vector<DynamicsObject*> >::iterator i1 = collisionDisabled.begin();
-
-        while (i1 != collisionDisabled.end())
-        {
-            std::vector<DynamicsObject*>::iterator i2 = find(i1->second.begin(), i1->second.end(), o);
-
-            if (i2 != i1->second.end())
-            {
-                i1->second.erase(i2);
-            }
-
-            i1++;
-        }
-
-        enableCollision(o);
+        releaseCollisionFilterIndex(o);
     }
 
     std::vector<DynamicsRobotPtr> DynamicsEngine::getRobots()
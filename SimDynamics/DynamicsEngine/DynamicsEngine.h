@@ -26,6 +26,8 @@
 #include "DynamicsObject.h"
 #include "DynamicsRobot.h"
 
+#include <unordered_map>
+
 
 namespace SimDynamics
 {
@@ -139,6 +141,34 @@ namespace SimDynamics
         */
         virtual bool checkCollisionEnabled(DynamicsObject* o1);
 
+        /*!
+            Same as checkCollisionEnabled(o1, o2), but without locking and virtual dispatch.
+            Intended for the broadphase filter of the engine implementations, which is called for every pair of overlapping objects.
+        */
+        inline bool isCollisionEnabled(const DynamicsObject* o1, const DynamicsObject* o2) const
+        {
+            if (o1 == nullptr || o2 == nullptr)
+            {
+                return true;
+            }
+
+            int i1 = findCollisionFilterIndex(o1);
+            int i2 = findCollisionFilterIndex(o2);
+
+            if ((i1 >= 0 && collisionToAllDisabled[i1]) || (i2 >= 0 && collisionToAllDisabled[i2]))
+            {
+                return false;
+            }
+
+            if (i1 < 0 || i2 < 0)
+            {
+                return true;
+            }
+
+            const std::vector<bool>& row = collisionDisabled[i1];
+            return !(size_t(i2) < row.size() && row[i2]);
+        }
+
         DynamicsObjectPtr getFloor()
         {
             return floor;
@@ -201,14 +231,41 @@ namespace SimDynamics
         */
         MutexLockPtr getScopedLock();
 
+        //! The number of objects that currently hold a slot in the collision filter.
+        size_t getNumCollisionFilterIndices() const
+        {
+            return collisionFilterIndices.size();
+        }
+
     protected:
+        /*!
+            Returns the slot of o in the collision filter. If o has no slot in this engine, a new one is assigned.
+            Slots are assigned when objects are added or collision settings are changed, so the filter
+            can be evaluated with a few bit lookups.
+        */
+        int getCollisionFilterIndex(const DynamicsObject* o);
+
+        //! Returns the slot of o in the collision filter or -1, if o has no slot in this engine.
+        inline int findCollisionFilterIndex(const DynamicsObject* o) const
+        {
+            auto it = collisionFilterIndices.find(o);
+            return (it != collisionFilterIndices.end()) ? it->second : -1;
+        }
+
+        //! Clears the collision settings of o and frees its slot, which is reused by the next object that needs one.
+        void releaseCollisionFilterIndex(const DynamicsObject* o);
+
         DynamicsEngineConfigPtr dynamicsConfig;
 
         std::vector<DynamicsObjectPtr> objects;
         std::vector<DynamicsRobotPtr> robots;
 
-        std::map < DynamicsObject*, std::vector<DynamicsObject*> > collisionDisabled;
-        std::vector<DynamicsObject*> collisionToAllDisabled;
+        // symmetric bit matrix of disabled collision pairs, indexed by the filter slots of the objects (rows grow on demand)
+        std::vector< std::vector<bool> > collisionDisabled;
+        std::vector<bool> collisionToAllDisabled;
+        // the slots of the objects in this engine's collision filter and the freed slots
+        std::unordered_map<const DynamicsObject*, int> collisionFilterIndices;
+        std::vector<int> freeCollisionFilterIndices;
         DynamicsObjectPtr floor;
 
         Eigen::Vector3f floorPos;
@@ -66,6 +66,14 @@ namespace SimDynamics
 
 
 
+    DynamicsWorldPtr DynamicsWorld::Create(DynamicsEngineConfigPtr config)
+    {
+        DynamicsWorldPtr result(new DynamicsWorld(config));
+        // objects and robots that are added later share the mutex of the engine
+        result->engine->setMutex(boost::shared_ptr<boost::recursive_mutex>(new boost::recursive_mutex()));
+        return result;
+    }
+
     void DynamicsWorld::Close()
     {
         world.reset();
@@ -43,6 +43,14 @@ namespace SimDynamics
         static DynamicsWorldPtr Init(DynamicsEngineConfigPtr config = DynamicsEngineConfigPtr());
         static DynamicsWorldPtr GetWorld();
 
+        /*!
+            Creates a new, independent dynamics world that is not related to the singleton.
+            Each world owns its engine and an engine mutex (see DynamicsEngine::getScopedLock()), hence several worlds can be
+            stepped in parallel from different threads, and each world can be accessed safely while it is stepped.
+            @see BulletBatchSimulation
+        */
+        static DynamicsWorldPtr Create(DynamicsEngineConfigPtr config = DynamicsEngineConfigPtr());
+
         /*!
             Returns the engine implementation.
         */
@@ -0,0 +1,111 @@
+#include <SimDynamics/DynamicsEngine/BulletEngine/BulletBatchSimulation.h>
+
+#include <VirtualRobot/VirtualRobotException.h>
+#include <VirtualRobot/XML/SceneIO.h>
+#include <VirtualRobot/RuntimeEnvironment.h>
+
+#include <string>
+#include <iostream>
+#include <thread>
+
+using std::cout;
+using std::endl;
+using namespace VirtualRobot;
+
+/*!
+    Simulates N independent copies of a scene in parallel, without any visualization.
+
+    --scene <file>       The scene XML file (required)
+    --worlds <n>         Number of worlds (standard: 8)
+    --seconds <t>        Simulated time per world (standard: 2.0)
+    --threads <n>        Number of worker threads (standard: all cores)
+    --floor <0|1>        Add a floor plane to each world (standard: 1)
+*/
+int main(int argc, char* argv[])
+{
+    VirtualRobot::init(argc, argv, "SimDynamicsBatchRunner");
+
+    VirtualRobot::RuntimeEnvironment::considerKey("scene");
+    VirtualRobot::RuntimeEnvironment::considerKey("worlds");
+    VirtualRobot::RuntimeEnvironment::considerKey("seconds");
+    VirtualRobot::RuntimeEnvironment::considerKey("threads");
+    VirtualRobot::RuntimeEnvironment::considerKey("floor");
+    VirtualRobot::RuntimeEnvironment::processCommandLine(argc, argv);
+    VirtualRobot::RuntimeEnvironment::print();
+
+    if (!VirtualRobot::RuntimeEnvironment::hasValue("scene"))
+    {
+        cout << "Usage: SimDynamicsBatchRunner --scene <file> [--worlds <n>] [--seconds <t>] [--threads <n>] [--floor <0|1>]" << endl;
+        return 1;
+    }
+
+    std::string filename = VirtualRobot::RuntimeEnvironment::getValue("scene");
+
+    if (!VirtualRobot::RuntimeEnvironment::getDataFileAbsolute(filename))
+    {
+        VR_ERROR << "Could not find scene file " << filename << endl;
+        return 1;
+    }
+
+    int numWorlds = 8;
+    float seconds = 2.0f;
+    int numThreads = 0;
+    bool floor = true;
+
+    if (VirtualRobot::RuntimeEnvironment::hasValue("worlds"))
+    {
+        numWorlds = VirtualRobot::RuntimeEnvironment::toInt(VirtualRobot::RuntimeEnvironment::getValue("worlds"));
+    }
+
+    if (VirtualRobot::RuntimeEnvironment::hasValue("seconds"))
+    {
+        seconds = VirtualRobot::RuntimeEnvironment::toFloat(VirtualRobot::RuntimeEnvironment::getValue("seconds"));
+    }
+
+    if (VirtualRobot::RuntimeEnvironment::hasValue("threads"))
+    {
+        numThreads = VirtualRobot::RuntimeEnvironment::toInt(VirtualRobot::RuntimeEnvironment::getValue("threads"));
+    }
+
+    if (VirtualRobot::RuntimeEnvironment::hasValue("floor"))
+    {
+        floor = VirtualRobot::RuntimeEnvironment::toInt(VirtualRobot::RuntimeEnvironment::getValue("floor")) != 0;
+    }
+
+    if (numWorlds < 1 || seconds <= 0 || numThreads < 0)
+    {
+        VR_ERROR << "Invalid parameters" << endl;
+        return 1;
+    }
+
+    cout << "Loading scene " << filename << endl;
+    ScenePtr scene = SceneIO::loadScene(filename);
+
+    if (!scene)
+    {
+        VR_ERROR << "Could not load scene " << filename << endl;
+        return 1;
+    }
+
+    SimDynamics::BulletBatchSimulation batch(scene);
+    batch.setFloorPlane(floor);
+
+    cout << "Simulating " << numWorlds << " worlds for " << seconds << " s each" << endl;
+    batch.run(size_t(numWorlds), seconds, size_t(numThreads));
+
+    for (const auto& r : batch.getResults())
+    {
+        cout << "World " << r.worldIndex << ": " << r.steps << " steps, " << r.simTime << " s simulated in " << r.wallTime << " s" << endl;
+
+        for (const auto& p : r.poses)
+        {
+            cout << "  " << p.first << ": " << p.second.block<3, 1>(0, 3).transpose() << endl;
+        }
+    }
+
+    const SimDynamics::BulletBatchSimulation::Statistics& s = batch.getStatistics();
+    cout << "Total: " << s.totalSteps << " world steps on " << s.threads << " threads (" << std::thread::hardware_concurrency() << " cores) in " << s.wallTime << " s" << endl;
+    cout << "Throughput: " << s.worldStepsPerSecond << " world steps/s, " << s.worldStepsPerSecondPerThread << " world steps/s per core" << endl;
+
+    return 0;
+}
@@ -4,7 +4,11 @@
 #include <iostream>
 #include <set>
 #include <cfloat>
+#include <algorithm>
 #include "../Robot.h"
+#include "SphereTree.h"
+#include "PointCloudObstacle.h"
+#include "../VirtualRobotException.h"
 
 
 using namespace std;
@@ -15,6 +19,7 @@ namespace VirtualRobot
 {
 
     CDManager::CDManager(CollisionCheckerPtr colChecker)
+        : checkMode(eExact)
     {
         if (colChecker == nullptr)
         {
@@ -76,7 +81,7 @@ namespace VirtualRobot
         {
             if (m != colModel)
             {
-                if (colChecker->checkCollision(colModel, m))
+                if (checkCollision(colModel, m))
                 {
                     return true;
                 }
@@ -84,7 +89,7 @@ namespace VirtualRobot
         }
 
         // if here -> no collision
-        return false;
+        return isInCollisionWithPointClouds(m);
     }
 
 
@@ -113,6 +118,11 @@ namespace VirtualRobot
             }
         }
 
+        for (const auto & cloud : pointClouds)
+        {
+            minDist = getPointCloudDistance(cloud, m, minDist);
+        }
+
         return minDist;
     }
 
@@ -160,6 +170,14 @@ namespace VirtualRobot
             i++;
         }
 
+        for (const auto & pair : pointCloudPairs)
+        {
+            for (const auto & set : pair.second)
+            {
+                minDist = getPointCloudDistance(pair.first, set, minDist);
+            }
+        }
+
         return minDist;
     }
 
@@ -273,7 +291,7 @@ namespace VirtualRobot
     {
         for (const auto & set : sets)
         {
-            if (colChecker->checkCollision(m, set))
+            if (checkCollision(m, set))
             {
                 return true;
             }
@@ -282,6 +300,41 @@ namespace VirtualRobot
         return false;
     }
 
+    bool CDManager::checkCollision(SceneObjectSetPtr m1, SceneObjectSetPtr m2)
+    {
+        if (checkMode == eExact)
+        {
+            return colChecker->checkCollision(m1, m2);
+        }
+
+        std::vector<CollisionModelPtr> models1 = m1->getCollisionModels();
+        std::vector<CollisionModelPtr> models2 = m2->getCollisionModels();
+
+        for (const auto & model1 : models1)
+        {
+            for (const auto & model2 : models2)
+            {
+                if (SphereTree::Collide(*model1->getSphereTree(), model1->getGlobalPose(), *model2->getSphereTree(), model2->getGlobalPose())
+                    && (checkMode == eSphereTrees || colChecker->checkCollision(model1, model2)))
+                {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    void CDManager::setCheckMode(CheckMode mode)
+    {
+        checkMode = mode;
+    }
+
+    CDManager::CheckMode CDManager::getCheckMode() const
+    {
+        return checkMode;
+    }
+
     bool CDManager::isInCollision()
     {
         if (!colChecker)
@@ -301,9 +354,80 @@ namespace VirtualRobot
             i++;
         }
 
+        for (const auto & pair : pointCloudPairs)
+        {
+            for (const auto & set : pair.second)
+            {
+                if (pair.first->checkCollision(set))
+                {
+                    return true;
+                }
+            }
+        }
+
         return false;
     }
 
+    bool CDManager::isInCollisionWithPointClouds(SceneObjectSetPtr m)
+    {
+        for (const auto & cloud : pointClouds)
+        {
+            if (cloud->checkCollision(m))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    float CDManager::getPointCloudDistance(PointCloudObstaclePtr cloud, SceneObjectSetPtr m, float minDist)
+    {
+        // the search radius of the point clouds is limited
+        const float maxDistance = std::min(minDist, 1000.0f);
+        float dist = cloud->getDistance(m, maxDistance);
+        return dist < maxDistance ? dist : minDist;
+    }
+
+    void CDManager::addPointCloud(PointCloudObstaclePtr cloud, SceneObjectSetPtr m)
+    {
+        THROW_VR_EXCEPTION_IF(!cloud, "NULL point cloud");
+
+        if (!m)
+        {
+            return;
+        }
+
+        if (!_hasSceneObjectSet(m))
+        {
+            colModels.push_back(m);
+        }
+
+        if (std::find(pointClouds.begin(), pointClouds.end(), cloud) == pointClouds.end())
+        {
+            pointClouds.push_back(cloud);
+        }
+
+        pointCloudPairs[cloud].push_back(m);
+    }
+
+    void CDManager::addPointCloud(PointCloudObstaclePtr cloud, SceneObjectPtr m)
+    {
+        if (!m)
+        {
+            return;
+        }
+
+        VirtualRobot::SceneObjectSetPtr cms(new VirtualRobot::SceneObjectSet("", colChecker));
+        cms->addSceneObject(m);
+        addPointCloud(cloud, cms);
+    }
+
+    std::vector<PointCloudObstaclePtr> CDManager::getPointClouds()
+    {
+        return pointClouds;
+    }
+
 
     std::vector<SceneObjectSetPtr> CDManager::getSceneObjectSets()
     {
@@ -49,11 +49,21 @@ namespace VirtualRobot
     *
     * The methods can be safely mixed.
     *
+    * For coarse planning phases, the collision checks can use the sphere trees of the collision models (see setCheckMode()).
+    *
     * @see CollsionModelSet
     */
     class VIRTUAL_ROBOT_IMPORT_EXPORT CDManager
     {
     public:
+        //! How isInCollision() checks two collision models
+        enum CheckMode
+        {
+            eExact,             //!< With the collision checker
+            eSphereTrees,       //!< With the sphere trees only, which may report collisions of models that are close but not in contact
+            eSphereTreesExact   //!< With the collision checker, only if the sphere trees collide
+        };
+
         //! if pColChecker is not set, the global collision checker is used
         CDManager(CollisionCheckerPtr colChecker = CollisionCheckerPtr());
         CDManager(const CDManager&) = default;
@@ -110,13 +120,17 @@ namespace VirtualRobot
         */
         float getDistance(SceneObjectSetPtr m);
 
-        //! Stores min dist position and collision IDs
+        /*!
+            Stores min dist position and collision IDs.
+            Point clouds are not considered, they only provide lower bounds of the distance without closest points.
+        */
         float getDistance(Eigen::Vector3f& P1, Eigen::Vector3f& P2, int& trID1, int& trID2);
 
         /*!
             Calculates the shortest distance of SceneObjectSet m to all added colModels.
             Stores nearest positions and corresponding IDs, where P1 and trID1 is used to store the data of m and
             P2 and trID2 is used to store the data of this CDManager.
+            As above, point clouds are not considered.
         */
         float getDistance(SceneObjectSetPtr m, Eigen::Vector3f& P1, Eigen::Vector3f& P2, int& trID1, int& trID2);
 
@@ -126,6 +140,23 @@ namespace VirtualRobot
 
         CollisionCheckerPtr getCollisionChecker();
 
+        /*!
+            Adds a point cloud obstacle, which is only checked against m by isInCollision() and getDistance(),
+            similar to addCollisionModelPair(). A cloud can be added several times with different sets.
+            isInCollision(m) and getDistance(m) check a given set against all point clouds.
+            The points can be updated after adding the obstacle.
+        */
+        void addPointCloud(PointCloudObstaclePtr cloud, SceneObjectSetPtr m);
+        void addPointCloud(PointCloudObstaclePtr cloud, SceneObjectPtr m);
+        std::vector<PointCloudObstaclePtr> getPointClouds();
+
+        /*!
+            Selects the checks of isInCollision(), the distance calculations are not affected.
+            The sphere trees are built when they are used first (see CollisionModel::getSphereTree()).
+        */
+        void setCheckMode(CheckMode mode);
+        CheckMode getCheckMode() const;
+
     protected:
         /*!
             Performs also a check for sets with only one object added in order to cover potentionally added single SceneObjects.
@@ -133,12 +164,20 @@ namespace VirtualRobot
         bool _hasSceneObjectSet(SceneObjectSetPtr m);
 
         bool isInCollision(SceneObjectSetPtr m, std::vector<SceneObjectSetPtr>& sets);
+        //! checks two sets according to the check mode
+        bool checkCollision(SceneObjectSetPtr m1, SceneObjectSetPtr m2);
         float getDistance(SceneObjectSetPtr m, std::vector<SceneObjectSetPtr>& sets, Eigen::Vector3f& P1, Eigen::Vector3f& P2, int& trID1, int& trID2);
         float getDistance(SceneObjectSetPtr m, std::vector<SceneObjectSetPtr>& sets);
+        bool isInCollisionWithPointClouds(SceneObjectSetPtr m);
+        //! the distance to the point cloud, if it is smaller than minDist
+        float getPointCloudDistance(PointCloudObstaclePtr cloud, SceneObjectSetPtr m, float minDist);
         std::vector< SceneObjectSetPtr > colModels;
+        std::vector<PointCloudObstaclePtr> pointClouds;
         CollisionCheckerPtr colChecker;
+        CheckMode checkMode;
 
         std::map<SceneObjectSetPtr, std::vector<SceneObjectSetPtr> > colModelPairs;
+        std::map<PointCloudObstaclePtr, std::vector<SceneObjectSetPtr> > pointCloudPairs;
 
     };
 
@@ -3,6 +3,9 @@
 #include "CollisionChecker.h"
 #include "../Visualization/TriMeshModel.h"
 #include "../Visualization/VisualizationNode.h"
+#include "SphereTree.h"
+#include "../Tools/MeshSimplification.h"
+#include "../VirtualRobotException.h"
 #include "../XML/BaseIO.h"
 #include <algorithm>
 
@@ -58,11 +61,55 @@ namespace VirtualRobot
         if(!collisionModel)
             VR_WARNING << "internal collision model is NULL for " << name << endl;
         collisionModelImplementation = boost::dynamic_pointer_cast<InternalCollisionModel>(collisionModel->clone(false));
-        VR_ASSERT(collisionModelImplementation->getPQPModel());
+        VR_ASSERT(collisionModelImplementation->getCompactBVH() || collisionModelImplementation->getPQPModel());
         setVisualization(visu);
     }
 
 
+    CollisionModel::CollisionModel(const VisualizationNodePtr visu, TriMeshModelPtr model, InternalCollisionModelPtr collisionModel, const std::string& name, CollisionCheckerPtr colChecker, int id)
+    {
+        margin = 0.0;
+        globalPose = Eigen::Matrix4f::Identity();
+        this->id = id;
+
+        this->name = name;
+
+        this->colChecker = colChecker;
+
+        if (!this->colChecker)
+        {
+            this->colChecker = CollisionChecker::getGlobalCollisionChecker();
+        }
+
+        if (!this->colChecker)
+        {
+            VR_WARNING << "no col checker..." << endl;
+        }
+
+        updateVisualization = true;
+        visualization = visu;
+        origVisualization = visu;
+        this->model = model;
+
+        if (model)
+        {
+            bbox = model->boundingBox;
+        }
+
+        collisionModelImplementation = collisionModel;
+    }
+
+
+    CollisionModel::CollisionModel(TriMeshModelPtr model, const std::string& name, CollisionCheckerPtr colChecker, int id)
+#if defined(VR_COLLISION_DETECTION_PQP)
+        : CollisionModel(VisualizationNodePtr(), model, InternalCollisionModelPtr(new CollisionModelPQP(model, colChecker, id)), name, colChecker, id)
+#else
+        : CollisionModel(VisualizationNodePtr(), model, InternalCollisionModelPtr(new CollisionModelDummy(colChecker)), name, colChecker, id)
+#endif
+    {
+    }
+
+
     CollisionModel::~CollisionModel()
     {
 //        destroyData();
@@ -81,7 +128,12 @@ namespace VirtualRobot
     void CollisionModel::inflateModel(float value)
     {
         float diff = std::abs(margin - value);
-        if(diff > 0.01f || (origVisualization && !model))
+        if (!origVisualization && diff > 0.01f)
+        {
+            VR_WARNING << "Collision model " << name << " has no visualization and can not be inflated" << endl;
+        }
+
+        if (origVisualization && (diff > 0.01f || !model))
         {
             visualization = origVisualization->clone(true);
             visualization->shrinkFatten(value);
@@ -97,6 +149,7 @@ namespace VirtualRobot
 #else
             collisionModelImplementation.reset(new CollisionModelDummy(colChecker));
 #endif
+            sphereTree.reset();
         }
         if(!origVisualization)
             margin = 0.0;
@@ -121,6 +174,11 @@ namespace VirtualRobot
             BOOST_ASSERT(origVisualization);
             origVisualization->setGlobalPose(m);
         }
+
+        for (const CollisionModelPtr& level : levelsOfDetail)
+        {
+            level->setGlobalPose(m);
+        }
     }
 
     VirtualRobot::CollisionModelPtr CollisionModel::clone(CollisionCheckerPtr colChecker, float scaling, bool deepVisuMesh)
@@ -134,7 +192,19 @@ namespace VirtualRobot
         int idNew = id;
 
         CollisionModelPtr p;
-        if(deepVisuMesh || !this->collisionModelImplementation)
+        if (!origVisualization && model)
+        {
+            // no visualization: the triangle mesh is the only source of the collision data
+            if (scaling != 1.0f)
+            {
+                p.reset(new CollisionModel(model->clone(Eigen::Vector3f::Constant(scaling)), nameNew, colChecker, idNew));
+            }
+            else
+            {
+                p.reset(new CollisionModel(VisualizationNodePtr(), model, boost::dynamic_pointer_cast<InternalCollisionModel>(collisionModelImplementation->clone(false)), nameNew, colChecker, idNew));
+            }
+        }
+        else if(deepVisuMesh || !this->collisionModelImplementation)
             p.reset(new CollisionModel(visuOrigNew, nameNew, colChecker, idNew, margin));
         else
         {
@@ -150,11 +220,75 @@ namespace VirtualRobot
             }
 
         }
+        for (const CollisionModelPtr& level : levelsOfDetail)
+        {
+            p->levelsOfDetail.push_back(level->clone(colChecker, scaling, deepVisuMesh));
+        }
+
+        p->levelOfDetailErrors = levelOfDetailErrors;
+
+        if (scaling == 1.0f)
+        {
+            p->sphereTree = sphereTree;
+        }
+
         p->setGlobalPose(getGlobalPose());
         p->setUpdateVisualization(getUpdateVisualizationStatus());
         return p;
     }
 
+    size_t CollisionModel::addLevelOfDetail(float maxError, bool conservative)
+    {
+        TriMeshModelPtr mesh = getTriMeshModel();
+        THROW_VR_EXCEPTION_IF(!mesh, "Collision model " << name << " has no triangle mesh");
+
+        MeshSimplification::Parameters parameters;
+        parameters.maxError = maxError;
+        parameters.conservative = conservative;
+        TriMeshModelPtr simplified = MeshSimplification::simplify(*mesh, parameters);
+
+        CollisionModelPtr level(new CollisionModel(simplified, name + "_lod" + std::to_string(levelsOfDetail.size()), colChecker, id));
+        level->setGlobalPose(globalPose);
+        levelsOfDetail.push_back(level);
+        levelOfDetailErrors.push_back(maxError);
+        return levelsOfDetail.size() - 1;
+    }
+
+    size_t CollisionModel::getNumLevelsOfDetail() const
+    {
+        return levelsOfDetail.size();
+    }
+
+    CollisionModelPtr CollisionModel::getLevelOfDetail(size_t level)
+    {
+        THROW_VR_EXCEPTION_IF(level >= levelsOfDetail.size(), "Invalid level of detail " << level);
+        return levelsOfDetail[level];
+    }
+
+    float CollisionModel::getLevelOfDetailError(size_t level) const
+    {
+        THROW_VR_EXCEPTION_IF(level >= levelOfDetailErrors.size(), "Invalid level of detail " << level);
+        return levelOfDetailErrors[level];
+    }
+
+    SphereTreePtr CollisionModel::getSphereTree()
+    {
+        if (!sphereTree)
+        {
+            TriMeshModelPtr mesh = getTriMeshModel();
+            THROW_VR_EXCEPTION_IF(!mesh, "Collision model " << name << " has no triangle mesh");
+            Eigen::Vector3f size = mesh->boundingBox.getMax() - mesh->boundingBox.getMin();
+            sphereTree = SphereTree::Create(*mesh, std::max(size.norm() / 32, 1e-3f));
+        }
+
+        return sphereTree;
+    }
+
+    void CollisionModel::setSphereTree(SphereTreePtr tree)
+    {
+        sphereTree = tree;
+    }
+
     void CollisionModel::setVisualization(const VisualizationNodePtr visu)
     {
         visualization = visu;
@@ -199,7 +333,7 @@ namespace VirtualRobot
     {
         if (!visualization)
         {
-            return 0;
+            return model ? int(model->faces.size()) : 0;
         }
 
         return visualization->getNumFaces();
@@ -282,7 +416,7 @@ namespace VirtualRobot
 
         ss << pre << "<CollisionModel";
 
-        if (getVisualization()->usedBoundingBoxVisu())
+        if (visualization && visualization->usedBoundingBoxVisu())
         {
             ss << " BoundingBox='true'";
         }
@@ -398,12 +532,18 @@ namespace VirtualRobot
 #else
             collisionModelImplementation.reset(new CollisionModelDummy(colChecker));
 #endif
+            sphereTree.reset();
         }
 
         if (visualization)
         {
             visualization->scale(scaleFactor);
         }
+
+        for (const CollisionModelPtr& level : levelsOfDetail)
+        {
+            level->scale(scaleFactor);
+        }
     }
 
     /*
@@ -65,6 +65,21 @@ namespace VirtualRobot
             \param id A user id.
         */
         CollisionModel(const VisualizationNodePtr visu, const std::string& name = "", CollisionCheckerPtr colChecker = CollisionCheckerPtr(), int id = 666, float margin = 0.0f);
+
+        /*!
+            Creates a collision model from already processed collision data (e.g. loaded from a CollisionModelCache).
+            In contrast to the standard constructor, no triangle mesh is extracted from visu.
+            \param visu The visualization of the collision model.
+            \param model The triangle mesh of the collision model.
+            \param collisionModel The internal collision model, which has to be created for model.
+        */
+        CollisionModel(const VisualizationNodePtr visu, TriMeshModelPtr model, InternalCollisionModelPtr collisionModel, const std::string& name = "", CollisionCheckerPtr colChecker = CollisionCheckerPtr(), int id = 666);
+
+        /*!
+            Creates a collision model without visualization from a triangle mesh, e.g. for processes that never render.
+            Such models can not be inflated (see inflateModel()).
+        */
+        CollisionModel(TriMeshModelPtr model, const std::string& name = "", CollisionCheckerPtr colChecker = CollisionCheckerPtr(), int id = 666);
         /*!Standard Destructor
         */
         virtual ~CollisionModel();
@@ -169,6 +184,28 @@ namespace VirtualRobot
          */
         void inflateModel(float margin);
 
+        /*!
+            Adds a simplified copy of the triangle mesh (see MeshSimplification) as level of detail.
+            Queries against coarse levels are faster but less accurate, e.g. for a broad phase or for distant objects.
+            The levels follow the global pose of this model and are scaled and cloned with it, but they are not updated by inflateModel().
+            \param maxError The maximum distance [mm] of the simplified vertices to the planes of the original faces.
+            \param conservative If set, the simplified mesh is inflated until it encloses the vertices of the original mesh.
+            \return The index of the new level.
+        */
+        size_t addLevelOfDetail(float maxError, bool conservative = true);
+        size_t getNumLevelsOfDetail() const;
+        CollisionModelPtr getLevelOfDetail(size_t level);
+        //! The maximum error of a level as given to addLevelOfDetail().
+        float getLevelOfDetailError(size_t level) const;
+
+        /*!
+            The sphere tree of the triangle mesh, e.g. for conservative checks in CDManager.
+            It is built on the first call, with leaves of at most 1/32 of the bounding box diagonal.
+        */
+        SphereTreePtr getSphereTree();
+        //! Sets a tree with other parameters, it has to be built from the triangle mesh of this model.
+        void setSphereTree(SphereTreePtr tree);
+
     protected:
         // internal constructor needed for flat copy of internal collision model
         CollisionModel(VisualizationNodePtr visu, const std::string& name, CollisionCheckerPtr colChecker, int id, InternalCollisionModelPtr collisionModel);
@@ -192,6 +229,10 @@ namespace VirtualRobot
 
         Eigen::Matrix4f globalPose;     //< The transformation that is used for visualization and for updating the col model
 
+        std::vector<CollisionModelPtr> levelsOfDetail;
+        std::vector<float> levelOfDetailErrors;
+        SphereTreePtr sphereTree;
+
 
 #if defined(VR_COLLISION_DETECTION_PQP)
         boost::shared_ptr< CollisionModelPQP > collisionModelImplementation;
@@ -0,0 +1,365 @@
+
+#include "CollisionModelCache.h"
+#include "CollisionChecker.h"
+#include "../Visualization/TriMeshModel.h"
+#include "../Visualization/VisualizationFactory.h"
+#include "../Visualization/VisualizationNode.h"
+
+#include <boost/filesystem.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace VirtualRobot
+{
+    namespace
+    {
+        const char cacheMagic[4] = {'S', 'X', 'C', 'M'};
+        const uint32_t cacheVersion = 1;
+
+        void hashBytes(uint64_t& hash, const char* data, size_t size)
+        {
+            for (size_t i = 0; i < size; i++)
+            {
+                hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ull;
+            }
+        }
+
+        template <typename T>
+        void write(std::ofstream& output, const T& value)
+        {
+            output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        bool read(std::ifstream& input, T& value)
+        {
+            return bool(input.read(reinterpret_cast<char*>(&value), sizeof(T)));
+        }
+
+        template <typename T>
+        void writeArray(std::ofstream& output, const T* data, uint32_t size)
+        {
+            write(output, size);
+            output.write(reinterpret_cast<const char*>(data), std::streamsize(size) * sizeof(T));
+        }
+
+        template <typename T>
+        bool readVector(std::ifstream& input, std::vector<T>& values)
+        {
+            uint32_t size = 0;
+
+            if (!read(input, size))
+            {
+                return false;
+            }
+
+            values.resize(size);
+            return bool(input.read(reinterpret_cast<char*>(values.data()), std::streamsize(size) * sizeof(T)));
+        }
+    }
+
+    boost::mutex CollisionModelCache::mutex;
+    std::string CollisionModelCache::cacheDirectory;
+    size_t CollisionModelCache::numHits = 0;
+    size_t CollisionModelCache::numMisses = 0;
+
+    void CollisionModelCache::setCacheDirectory(const std::string& directory)
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        cacheDirectory = directory;
+    }
+
+    std::string CollisionModelCache::getCacheDirectory()
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        return cacheDirectory;
+    }
+
+    bool CollisionModelCache::isEnabled()
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        return !cacheDirectory.empty();
+    }
+
+    std::string CollisionModelCache::getKey(const std::vector<std::string>& files, const std::string& options)
+    {
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ull;
+        hashBytes(hash, reinterpret_cast<const char*>(&cacheVersion), sizeof(cacheVersion));
+        hashBytes(hash, options.c_str(), options.size() + 1);
+        std::vector<char> buffer(1 << 16);
+
+        for (const std::string& file : files)
+        {
+            std::ifstream input(file.c_str(), std::ios::binary);
+
+            if (!input)
+            {
+                return std::string();
+            }
+
+            uint64_t size = 0;
+
+            while (input)
+            {
+                input.read(buffer.data(), std::streamsize(buffer.size()));
+                hashBytes(hash, buffer.data(), size_t(input.gcount()));
+                size += uint64_t(input.gcount());
+            }
+
+            // separates the files
+            hashBytes(hash, reinterpret_cast<const char*>(&size), sizeof(size));
+        }
+
+        std::stringstream ss;
+        ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+        return ss.str();
+    }
+
+    std::string CollisionModelCache::getFilename(const std::string& key)
+    {
+        return (boost::filesystem::path(getCacheDirectory()) / (key + ".sxcm")).string();
+    }
+
+    CollisionModelPtr CollisionModelCache::createCollisionModel(const std::string& key, VisualizationFactoryPtr factory, const std::string& name, CollisionCheckerPtr colChecker, int id)
+    {
+        if (!isEnabled() || key.empty())
+        {
+            return CollisionModelPtr();
+        }
+
+        std::string filename = getFilename(key);
+        TriMeshModelPtr model;
+        InternalCollisionModelPtr collisionModel;
+
+        if (!boost::filesystem::exists(filename) || !load(filename, model, collisionModel, colChecker, id))
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            numMisses++;
+            return CollisionModelPtr();
+        }
+
+        VisualizationNodePtr visu;
+
+        if (factory)
+        {
+            Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+            visu = factory->createTriMeshModelVisualization(model, pose);
+        }
+
+        if (factory && !visu)
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            numMisses++;
+            return CollisionModelPtr();
+        }
+
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            numHits++;
+        }
+
+        return CollisionModelPtr(new CollisionModel(visu, model, collisionModel, name, colChecker, id));
+    }
+
+    bool CollisionModelCache::store(const std::string& key, CollisionModelPtr colModel)
+    {
+        if (!isEnabled() || key.empty() || !colModel || !colModel->getTriMeshModel())
+        {
+            return false;
+        }
+
+        std::string directory = getCacheDirectory();
+        boost::system::error_code error;
+        boost::filesystem::create_directories(directory, error);
+
+        // write to a temporary file first, so concurrent loads never see a partial entry
+        std::string filename = getFilename(key);
+        std::stringstream tmpName;
+        tmpName << filename << "." << boost::filesystem::unique_path().string();
+
+        if (error || !save(tmpName.str(), *colModel->getTriMeshModel(), colModel->getCollisionModelImplementation()))
+        {
+            VR_WARNING << "Could not write collision model cache file " << filename << endl;
+            boost::filesystem::remove(tmpName.str(), error);
+            return false;
+        }
+
+        boost::filesystem::rename(tmpName.str(), filename, error);
+
+        if (error)
+        {
+            VR_WARNING << "Could not write collision model cache file " << filename << endl;
+            boost::filesystem::remove(tmpName.str(), error);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool CollisionModelCache::save(const std::string& filename, const TriMeshModel& model, InternalCollisionModelPtr collisionModel)
+    {
+        std::ofstream output(filename.c_str(), std::ios::binary);
+
+        if (!output)
+        {
+            return false;
+        }
+
+        output.write(cacheMagic, sizeof(cacheMagic));
+        write(output, cacheVersion);
+
+        writeArray(output, model.vertices.data(), uint32_t(model.vertices.size()));
+        writeArray(output, model.normals.data(), uint32_t(model.normals.size()));
+        write(output, uint32_t(model.faces.size()));
+
+        for (const MathTools::TriangleFace& f : model.faces)
+        {
+            uint32_t ids[6] = {f.id1, f.id2, f.id3, f.idNormal1, f.idNormal2, f.idNormal3};
+            output.write(reinterpret_cast<const char*>(ids), sizeof(ids));
+            output.write(reinterpret_cast<const char*>(f.normal.data()), 3 * sizeof(float));
+        }
+
+#if defined(VR_COLLISION_DETECTION_PQP)
+        boost::shared_ptr<PQP::PQP_Model> pqpModel = collisionModel ? collisionModel->getPQPModel() : boost::shared_ptr<PQP::PQP_Model>();
+
+        if (pqpModel && pqpModel->num_bvs > 0)
+        {
+            // the raw structs are stored, their sizes are checked on loading
+            write(output, uint8_t(1));
+            write(output, uint32_t(sizeof(PQP::Tri)));
+            write(output, uint32_t(sizeof(PQP::BV)));
+            write(output, int32_t(pqpModel->build_state));
+            writeArray(output, pqpModel->tris, uint32_t(pqpModel->num_tris));
+            writeArray(output, pqpModel->b, uint32_t(pqpModel->num_bvs));
+        }
+        else
+#endif
+        {
+            write(output, uint8_t(0));
+        }
+
+        return bool(output);
+    }
+
+    bool CollisionModelCache::load(const std::string& filename, TriMeshModelPtr& storeModel, InternalCollisionModelPtr& storeCollisionModel, CollisionCheckerPtr colChecker, int id)
+    {
+        storeModel.reset();
+        storeCollisionModel.reset();
+
+        std::ifstream input(filename.c_str(), std::ios::binary);
+        char magic[sizeof(cacheMagic)];
+        uint32_t version = 0;
+
+        if (!input || !input.read(magic, sizeof(magic)) || memcmp(magic, cacheMagic, sizeof(cacheMagic)) != 0
+            || !read(input, version) || version != cacheVersion)
+        {
+            return false;
+        }
+
+        TriMeshModelPtr model(new TriMeshModel());
+        uint32_t numFaces = 0;
+
+        if (!readVector(input, model->vertices) || !readVector(input, model->normals) || !read(input, numFaces))
+        {
+            return false;
+        }
+
+        model->faces.resize(numFaces);
+
+        for (MathTools::TriangleFace& f : model->faces)
+        {
+            uint32_t ids[6];
+
+            if (!input.read(reinterpret_cast<char*>(ids), sizeof(ids))
+                || !input.read(reinterpret_cast<char*>(f.normal.data()), 3 * sizeof(float)))
+            {
+                return false;
+            }
+
+            if (ids[0] >= model->vertices.size() || ids[1] >= model->vertices.size() || ids[2] >= model->vertices.size())
+            {
+                return false;
+            }
+
+            f.set(ids[0], ids[1], ids[2]);
+            f.setNormal(ids[3], ids[4], ids[5]);
+        }
+
+        model->boundingBox.addPoints(model->vertices);
+
+        uint8_t hasHierarchy = 0;
+
+        if (!read(input, hasHierarchy))
+        {
+            return false;
+        }
+
+#if defined(VR_COLLISION_DETECTION_PQP)
+        boost::shared_ptr<PQP::PQP_Model> pqpModel;
+
+        if (hasHierarchy)
+        {
+            uint32_t triSize = 0;
+            uint32_t bvSize = 0;
+            int32_t buildState = 0;
+            std::vector<PQP::Tri> tris;
+            std::vector<PQP::BV> bvs;
+
+            if (!read(input, triSize) || triSize != sizeof(PQP::Tri) || !read(input, bvSize) || bvSize != sizeof(PQP::BV)
+                || !read(input, buildState) || !readVector(input, tris) || !readVector(input, bvs)
+                || tris.size() != numFaces || bvs.empty())
+            {
+                return false;
+            }
+
+            pqpModel.reset(new PQP::PQP_Model());
+            pqpModel->build_state = buildState;
+            pqpModel->num_tris = pqpModel->num_tris_alloced = int(tris.size());
+            pqpModel->tris = new PQP::Tri[tris.size()];
+            pqpModel->num_bvs = pqpModel->num_bvs_alloced = int(bvs.size());
+            pqpModel->b = new PQP::BV[bvs.size()];
+            pqpModel->last_tri = pqpModel->tris;
+
+            for (size_t i = 0; i < tris.size(); i++)
+            {
+                pqpModel->tris[i] = tris[i];
+                pqpModel->tris[i].id = id;
+            }
+
+            std::copy(bvs.begin(), bvs.end(), pqpModel->b);
+        }
+
+        storeCollisionModel.reset(new CollisionModelPQP(model, colChecker, id, pqpModel));
+#else
+        storeCollisionModel.reset(new CollisionModelDummy(colChecker));
+#endif
+
+        storeModel = model;
+        return true;
+    }
+
+    size_t CollisionModelCache::getNumHits()
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        return numHits;
+    }
+
+    size_t CollisionModelCache::getNumMisses()
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        return numMisses;
+    }
+
+    void CollisionModelCache::resetStatistics()
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        numHits = 0;
+        numMisses = 0;
+    }
+
+} // namespace VirtualRobot
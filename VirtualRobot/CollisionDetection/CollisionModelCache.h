@@ -0,0 +1,101 @@
+/**
+* This file is part of Simox.
+*
+* Simox is free software; you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 2 of
+* the License, or (at your option) any later version.
+*
+* Simox is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*
+*/
+
+#pragma once
+
+#include "../VirtualRobot.h"
+#include "CollisionModel.h"
+
+#include <boost/thread/mutex.hpp>
+
+#include <string>
+#include <vector>
+
+namespace VirtualRobot
+{
+    /*!
+        A binary cache for collision models that are loaded from mesh files.
+
+        Loading a collision model from a VRML/Inventor file requires parsing the file with the visualization
+        library, extracting the triangle mesh and building the bounding volume hierarchy of the collision checker.
+        When a cache directory is set, BaseIO::processCollisionTag() stores the resulting TriMeshModel together with
+        the serialized PQP hierarchy. Subsequent loads of the same files read the binary file instead:
+        The mesh file is not parsed and the hierarchy is not rebuilt, the visualization of the collision model is
+        created directly from the cached triangles.
+
+        Entries are keyed by a hash of the content of the mesh files (and the loading options), so modified files
+        are detected. Files that are referenced from within a mesh file (e.g. VRML inlines) are not considered.
+        The cache is disabled by default.
+    */
+    class VIRTUAL_ROBOT_IMPORT_EXPORT CollisionModelCache
+    {
+    public:
+        //! Enables the cache. An empty directory disables it. The directory is created when the first entry is stored.
+        static void setCacheDirectory(const std::string& directory);
+        static std::string getCacheDirectory();
+        static bool isEnabled();
+
+        /*!
+            A hash of the content of all files and the options string (e.g. file type and bounding box flag).
+            Returns an empty string if one of the files can not be read.
+        */
+        static std::string getKey(const std::vector<std::string>& files, const std::string& options);
+
+        /*!
+            Creates a collision model from the cache entry of key.
+            \param factory Used to create the visualization of the collision model from the cached triangles.
+                           If not set, the collision model has no visualization.
+            \return An empty pointer if the cache is disabled or there is no valid entry.
+        */
+        static CollisionModelPtr createCollisionModel(const std::string& key, VisualizationFactoryPtr factory, const std::string& name,
+                                                      CollisionCheckerPtr colChecker = CollisionCheckerPtr(), int id = 666);
+
+        //! Stores the triangle mesh and the collision hierarchy of colModel as entry for key.
+        static bool store(const std::string& key, CollisionModelPtr colModel);
+
+        /*!
+            Writes the triangles (vertices, normals and faces) and the PQP hierarchy to a binary file.
+            Colors and materials are not stored.
+        */
+        static bool save(const std::string& filename, const TriMeshModel& model, InternalCollisionModelPtr collisionModel);
+
+        /*!
+            Reads a file written by save().
+            If the file contains a hierarchy, storeCollisionModel is created from it, otherwise it is built from the triangles.
+        */
+        static bool load(const std::string& filename, TriMeshModelPtr& storeModel, InternalCollisionModelPtr& storeCollisionModel,
+                         CollisionCheckerPtr colChecker = CollisionCheckerPtr(), int id = 666);
+
+        //! Number of cache hits and misses since the last reset.
+        static size_t getNumHits();
+        static size_t getNumMisses();
+        static void resetStatistics();
+
+    protected:
+        static std::string getFilename(const std::string& key);
+
+        static boost::mutex mutex;
+        static std::string cacheDirectory;
+        static size_t numHits;
+        static size_t numMisses;
+    };
+
+} // namespace VirtualRobot
@@ -16,6 +16,7 @@ namespace VirtualRobot
     CollisionCheckerPQP::CollisionCheckerPQP(): CollisionCheckerImplementation()
     {
         automaticSizeCheck = true;
+        compactBVH = false;
 
         PQP::PQP_REAL a[3] = {0.0f,0.0f,0.00001f};
         PQP::PQP_REAL b[3] = {0.0f,0.00001f,0.00001f};
@@ -61,6 +62,18 @@ namespace VirtualRobot
         BOOST_ASSERT(model2);
         BOOST_ASSERT(model1->getCollisionModelImplementation());
         BOOST_ASSERT(model2->getCollisionModelImplementation());
+
+        boost::shared_ptr<CompactBVH> c1 = model1->getCollisionModelImplementation()->getCompactBVH();
+        boost::shared_ptr<CompactBVH> c2 = model2->getCollisionModelImplementation()->getCompactBVH();
+
+        if (c1 && c2)
+        {
+            return CompactBVH::Collide(*pqpChecker, compactStack,
+                                       *c1, model1->getCollisionModelImplementation()->getGlobalPose(),
+                                       *c2, model2->getCollisionModelImplementation()->getGlobalPose());
+        }
+
+        // a compact model that is checked against a PQP model uses its (lazily built) PQP model as well
         boost::shared_ptr<PQP::PQP_Model> m1 = model1->getCollisionModelImplementation()->getPQPModel();
         boost::shared_ptr<PQP::PQP_Model> m2 = model2->getCollisionModelImplementation()->getPQPModel();
         BOOST_ASSERT_MSG(m1, "NULL data in ColChecker in m1!");
@@ -132,9 +145,7 @@ namespace VirtualRobot
             pqpChecker->PQP_Tolerance(&result,
                                       R1, T1, m1.get(),
                                       R2, T2, pointModel.get(),
-                                      50);
-
-
+                                      tolerance);
 
             return ((bool)(result.CloserThanTolerance() != 0));
         }
@@ -32,6 +32,7 @@
 
 #include "PQP++/PQP_Compile.h"
 #include "PQP++/PQP.h"
+#include "CompactBVH.h"
 
 #include <Eigen/Core>
 #include <Eigen/Geometry>
@@ -109,10 +110,28 @@ namespace VirtualRobot
             return true;
         }
 
+        /*!
+            When enabled, collision models that are created with this checker use a CompactBVH,
+            which needs about a third of the memory of a PQP model. Only affects models created afterwards.
+            Collision queries between these models are slower, other queries build the full PQP model on first use (see CompactBVH).
+        */
+        void setCompactBVH(bool enable)
+        {
+            compactBVH = enable;
+        }
+
+        bool getCompactBVH() const
+        {
+            return compactBVH;
+        }
+
     protected:
         PQP::PQP_Checker* pqpChecker;
         std::unique_ptr<PQP::PQP_Model> pointModel;
 
+        bool compactBVH;
+        CompactBVH::CollideStack compactStack;
+
     };
 
 } // namespace
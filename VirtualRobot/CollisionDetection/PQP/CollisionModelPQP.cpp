@@ -25,13 +25,48 @@ namespace VirtualRobot
             colCheckerPQP = colChecker->getCollisionCheckerImplementation();
         }
 
-        createPQPModel();
+        if (colCheckerPQP && colCheckerPQP->getCompactBVH())
+        {
+            setCompactBVH(true);
+        }
+        else
+        {
+            createPQPModel();
+        }
+    }
+
+    CollisionModelPQP::CollisionModelPQP(TriMeshModelPtr modelData, CollisionCheckerPtr colChecker, int id, boost::shared_ptr<PQP::PQP_Model> pqpModel)
+        : CollisionModelImplementation(modelData, colChecker, id)
+    {
+        if (!colChecker)
+        {
+            colChecker = CollisionChecker::getGlobalCollisionChecker();
+        }
+
+        if (colChecker)
+        {
+            colCheckerPQP = colChecker->getCollisionCheckerImplementation();
+        }
+
+        if (colCheckerPQP && colCheckerPQP->getCompactBVH())
+        {
+            setCompactBVH(true);
+        }
+        else if (pqpModel)
+        {
+            this->pqpModel = pqpModel;
+        }
+        else
+        {
+            createPQPModel();
+        }
     }
 
     CollisionModelPQP::CollisionModelPQP(const CollisionModelPQP &orig) :
         CollisionModelImplementation(orig.modelData, nullptr, orig.id)
     {
         pqpModel = orig.pqpModel;
+        compactBVH = orig.compactBVH;
     }
 
 
@@ -42,6 +77,68 @@ namespace VirtualRobot
     void CollisionModelPQP::destroyData()
     {
         pqpModel.reset();
+        compactBVH.reset();
+    }
+
+    boost::shared_ptr<PQP::PQP_Model> CollisionModelPQP::getPQPModel()
+    {
+        if (!compactBVH)
+        {
+            return pqpModel;
+        }
+
+        boost::mutex::scoped_lock lock(pqpModelMutex);
+
+        if (!pqpModel)
+        {
+            createPQPModel();
+        }
+
+        return pqpModel;
+    }
+
+    void CollisionModelPQP::setCompactBVH(bool enable)
+    {
+        if (!enable)
+        {
+            if (compactBVH && !pqpModel)
+            {
+                createPQPModel();
+            }
+
+            compactBVH.reset();
+            return;
+        }
+
+        if (!modelData)
+        {
+            VR_WARNING << "no model data in PQP!" << endl;
+            return;
+        }
+
+        if (!compactBVH)
+        {
+            compactBVH.reset(new CompactBVH(*modelData));
+        }
+
+        pqpModel.reset();
+    }
+
+    size_t CollisionModelPQP::getMemoryUsage()
+    {
+        size_t result = 0;
+
+        if (pqpModel)
+        {
+            result += pqpModel->MemUsage(0);
+        }
+
+        if (compactBVH)
+        {
+            result += compactBVH->getMemoryUsage();
+        }
+
+        return result;
     }
 
     void CollisionModelPQP::createPQPModel()
@@ -146,10 +243,18 @@ namespace VirtualRobot
         boost::shared_ptr<CollisionModelPQP> p(new CollisionModelPQP(*this));
         if(deepCopy)
         {
-            p->createPQPModel();
+            if (compactBVH)
+            {
+                p->compactBVH.reset(new CompactBVH(*modelData));
+                p->pqpModel.reset();
+            }
+            else
+            {
+                p->createPQPModel();
+            }
         }
 
-        VR_ASSERT(this->pqpModel);
+        VR_ASSERT(this->pqpModel || this->compactBVH);
         return p;
     }
 
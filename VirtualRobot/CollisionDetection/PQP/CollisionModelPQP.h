@@ -31,8 +31,11 @@
 #include <map>
 #include <set>
 
+#include <boost/thread/mutex.hpp>
+
 #include "PQP++/PQP_Compile.h"
 #include "PQP++/PQP.h"
+#include "CompactBVH.h"
 
 namespace VirtualRobot
 {
@@ -52,15 +55,37 @@ namespace VirtualRobot
         Ptr If collision checks should be done in parallel, different CollisionCheckers can be specified.
         */
         CollisionModelPQP(TriMeshModelPtr modelData, CollisionCheckerPtr colChecker, int id);
+
+        /*!
+            Uses an already built PQP model of modelData (e.g. loaded from a CollisionModelCache) instead of building it.
+            If the collision checker uses compact hierarchies, the CompactBVH is created from modelData as usual.
+        */
+        CollisionModelPQP(TriMeshModelPtr modelData, CollisionCheckerPtr colChecker, int id, boost::shared_ptr<PQP::PQP_Model> pqpModel);
         /*!Standard Destructor
         */
         ~CollisionModelPQP() override;
 
-        boost::shared_ptr<PQP::PQP_Model> getPQPModel()
+        /*!
+            The PQP model is needed for distance and tolerance queries, and for collision queries against models
+            without a compact hierarchy. When a CompactBVH is used, it is created on first access and kept.
+        */
+        boost::shared_ptr<PQP::PQP_Model> getPQPModel();
+
+        /*!
+            Use a CompactBVH for collision queries instead of the PQP model.
+            Enabling it releases the PQP model, which is rebuilt on demand (see getPQPModel()).
+            See CompactBVH for the memory and speed trade-off.
+        */
+        void setCompactBVH(bool enable);
+
+        boost::shared_ptr<CompactBVH> getCompactBVH()
         {
-            return pqpModel;
+            return compactBVH;
         }
 
+        //! Memory of the collision data structures in bytes.
+        size_t getMemoryUsage();
+
         void print() override;
         boost::shared_ptr<CollisionModelImplementation> clone(bool deepCopy = false) const override;
     protected:
@@ -71,6 +96,9 @@ namespace VirtualRobot
         void createPQPModel();
 
         boost::shared_ptr<PQP::PQP_Model> pqpModel;
+        boost::shared_ptr<CompactBVH> compactBVH;
+        //! Guards the on demand creation of pqpModel when a compact hierarchy is used
+        boost::mutex pqpModelMutex;
 
         boost::shared_ptr<CollisionCheckerPQP> colCheckerPQP;
     };
@@ -0,0 +1,493 @@
+
+#include "CompactBVH.h"
+
+#include "PQP++/OBB_Disjoint.h"
+#include "../../Visualization/TriMeshModel.h"
+
+#include <Eigen/Geometry>
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace VirtualRobot
+{
+    namespace
+    {
+        // exact position of a vertex, used to merge duplicated vertices
+        struct VertexKey
+        {
+            uint32_t bits[3];
+
+            bool operator==(const VertexKey& other) const
+            {
+                return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2];
+            }
+        };
+
+        struct VertexKeyHash
+        {
+            size_t operator()(const VertexKey& k) const
+            {
+                return (size_t(k.bits[0]) * 73856093u) ^ (size_t(k.bits[1]) * 19349663u) ^ (size_t(k.bits[2]) * 83492791u);
+            }
+        };
+
+        // C = A * B
+        inline void mxm(float C[3][3], const float A[3][3], const float B[3][3])
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                for (int j = 0; j < 3; j++)
+                {
+                    C[i][j] = A[i][0] * B[0][j] + A[i][1] * B[1][j] + A[i][2] * B[2][j];
+                }
+            }
+        }
+
+        // C = A^T * B
+        inline void mTxm(float C[3][3], const float A[3][3], const float B[3][3])
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                for (int j = 0; j < 3; j++)
+                {
+                    C[i][j] = A[0][i] * B[0][j] + A[1][i] * B[1][j] + A[2][i] * B[2][j];
+                }
+            }
+        }
+
+        // c = A * v
+        inline void mxv(float c[3], const float A[3][3], const float v[3])
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                c[i] = A[i][0] * v[0] + A[i][1] * v[1] + A[i][2] * v[2];
+            }
+        }
+
+        // c = A^T * v
+        inline void mTxv(float c[3], const float A[3][3], const float v[3])
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                c[i] = A[0][i] * v[0] + A[1][i] * v[1] + A[2][i] * v[2];
+            }
+        }
+
+        inline float boxSize(const float d[3])
+        {
+            return d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+        }
+    }
+
+    CompactBVH::CompactBVH(const TriMeshModel& model)
+    {
+        // merge vertices with identical positions
+        std::unordered_map<VertexKey, uint32_t, VertexKeyHash> vertexIndex;
+        std::vector<uint32_t> remap(model.vertices.size());
+
+        for (size_t i = 0; i < model.vertices.size(); i++)
+        {
+            VertexKey key;
+            std::memcpy(key.bits, model.vertices[i].data(), sizeof(key.bits));
+            auto it = vertexIndex.insert(std::make_pair(key, uint32_t(vertices.size())));
+
+            if (it.second)
+            {
+                vertices.push_back(model.vertices[i]);
+            }
+
+            remap[i] = it.first->second;
+        }
+
+        vertices.shrink_to_fit();
+
+        // the temporary PQP model stores our triangle index as id
+        PQP::PQP_Model pqp;
+        pqp.BeginModel(int(model.faces.size()));
+        triangles.reserve(model.faces.size());
+
+        for (const MathTools::TriangleFace& f : model.faces)
+        {
+            std::array<uint32_t, 3> t = {{remap[f.id1], remap[f.id2], remap[f.id3]}};
+            pqp.AddTri(vertices[t[0]].data(), vertices[t[1]].data(), vertices[t[2]].data(), int(triangles.size()));
+            triangles.push_back(t);
+        }
+
+        if (triangles.empty())
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                for (int j = 0; j < 3; j++)
+                {
+                    rootR[i][j] = (i == j) ? 1.0f : 0.0f;
+                }
+
+                rootT[i] = rootD[i] = 0.0f;
+            }
+
+            return;
+        }
+
+        pqp.EndModel();
+        nodes.reserve(pqp.num_bvs);
+
+        // the root box is stored uncompressed, its dimensions are refitted like all other boxes
+        const PQP::BV& root = pqp.b[0];
+        std::memcpy(rootR, root.R, sizeof(rootR));
+        std::memcpy(rootT, root.To, sizeof(rootT));
+        fitExtents(pqp, 0, rootR, rootT, rootD);
+
+        for (int i = 0; i < 3; i++)
+        {
+            rootD[i] = std::max(rootD[i], root.d[i]) * (1.0f + 1e-5f);
+        }
+
+        nodes.push_back(Node());
+        std::memset(&nodes[0], 0, sizeof(Node));
+
+        if (root.first_child < 0)
+        {
+            nodes[0].next = -(pqp.tris[-root.first_child - 1].id + 1);
+        }
+        else
+        {
+            for (int c = 0; c < 2; c++)
+            {
+                const PQP::BV& child = pqp.b[root.first_child + c];
+                float R[3][3], T[3];
+                mxm(R, rootR, child.R);
+                mxv(T, rootR, child.To);
+
+                for (int i = 0; i < 3; i++)
+                {
+                    T[i] += rootT[i];
+                }
+
+                int index = buildNode(pqp, root.first_child + c, rootR, rootT, rootD, R, T);
+
+                if (c == 1)
+                {
+                    nodes[0].next = index;
+                }
+            }
+        }
+
+        nodes.shrink_to_fit();
+    }
+
+    int CompactBVH::buildNode(PQP::PQP_Model& pqp, int bn, const float parentR[3][3], const float parentT[3], const float parentD[3],
+                              const float pqpR[3][3], const float pqpT[3])
+    {
+        // placement of PQP's box relative to our (already quantized) parent box
+        float relR[3][3], relT[3], diff[3];
+        mTxm(relR, parentR, pqpR);
+
+        for (int i = 0; i < 3; i++)
+        {
+            diff[i] = pqpT[i] - parentT[i];
+        }
+
+        mTxv(relT, parentR, diff);
+
+        Eigen::Matrix3f m;
+        m << relR[0][0], relR[0][1], relR[0][2],
+          relR[1][0], relR[1][1], relR[1][2],
+          relR[2][0], relR[2][1], relR[2][2];
+        Eigen::Quaternionf q(m);
+        q.normalize();
+
+        if (q.w() < 0)
+        {
+            q.coeffs() *= -1.0f;
+        }
+
+        Node n;
+        n.rotation[0] = int16_t(std::lround(q.w() * 32767.0f));
+        n.rotation[1] = int16_t(std::lround(q.x() * 32767.0f));
+        n.rotation[2] = int16_t(std::lround(q.y() * 32767.0f));
+        n.rotation[3] = int16_t(std::lround(q.z() * 32767.0f));
+
+        const float s = QuantizationScale(parentD);
+
+        for (int i = 0; i < 3; i++)
+        {
+            float c = std::min(std::max(relT[i] / s, -1.0f), 1.0f);
+            n.center[i] = int16_t(std::lround(c * 32767.0f));
+            n.extents[i] = 0;
+        }
+
+        // refit the dimensions to the quantized placement
+        float decR[3][3], decT[3], decD[3];
+        DecodeNode(n, parentD, decR, decT, decD);
+
+        float R[3][3], T[3], e[3];
+        mxm(R, parentR, decR);
+        mxv(T, parentR, decT);
+
+        for (int i = 0; i < 3; i++)
+        {
+            T[i] += parentT[i];
+        }
+
+        fitExtents(pqp, bn, R, T, e);
+        const float ds = 3.0f * s / 65535.0f;
+        float d[3];
+
+        for (int i = 0; i < 3; i++)
+        {
+            float required = e[i] * (1.0f + 1e-5f);
+            long v = long(std::ceil(required / ds));
+
+            while (float(v) * ds < required)
+            {
+                v++;
+            }
+
+            if (v > 65535)
+            {
+                VR_WARNING << "Box dimension exceeds the quantization range, clamping" << endl;
+                v = 65535;
+            }
+
+            n.extents[i] = uint16_t(v);
+            d[i] = float(n.extents[i]) * ds;
+        }
+
+        int index = int(nodes.size());
+        nodes.push_back(n);
+        const PQP::BV& bv = pqp.b[bn];
+
+        if (bv.first_child < 0)
+        {
+            nodes[index].next = -(pqp.tris[-bv.first_child - 1].id + 1);
+            return index;
+        }
+
+        for (int c = 0; c < 2; c++)
+        {
+            const PQP::BV& child = pqp.b[bv.first_child + c];
+            float childR[3][3], childT[3];
+            mxm(childR, pqpR, child.R);
+            mxv(childT, pqpR, child.To);
+
+            for (int i = 0; i < 3; i++)
+            {
+                childT[i] += pqpT[i];
+            }
+
+            // the left child directly follows its parent
+            int childIndex = buildNode(pqp, bv.first_child + c, R, T, d, childR, childT);
+
+            if (c == 1)
+            {
+                nodes[index].next = childIndex;
+            }
+        }
+
+        return index;
+    }
+
+    void CompactBVH::fitExtents(PQP::PQP_Model& pqp, int bn, const float R[3][3], const float T[3], float e[3]) const
+    {
+        std::vector<int> pending(1, bn);
+        e[0] = e[1] = e[2] = 0.0f;
+
+        while (!pending.empty())
+        {
+            const PQP::BV& bv = pqp.b[pending.back()];
+            pending.pop_back();
+
+            if (bv.first_child >= 0)
+            {
+                pending.push_back(bv.first_child);
+                pending.push_back(bv.first_child + 1);
+                continue;
+            }
+
+            const std::array<uint32_t, 3>& t = triangles[pqp.tris[-bv.first_child - 1].id];
+
+            for (uint32_t v : t)
+            {
+                float diff[3] = {vertices[v][0] - T[0], vertices[v][1] - T[1], vertices[v][2] - T[2]};
+                float p[3];
+                mTxv(p, R, diff);
+
+                for (int i = 0; i < 3; i++)
+                {
+                    e[i] = std::max(e[i], std::abs(p[i]));
+                }
+            }
+        }
+    }
+
+    bool CompactBVH::Collide(PQP::PQP_Checker& checker, CollideStack& stack,
+                             const CompactBVH& m1, const Eigen::Matrix4f& pose1,
+                             const CompactBVH& m2, const Eigen::Matrix4f& pose2,
+                             int* numBVTests)
+    {
+        if (numBVTests)
+        {
+            *numBVTests = 0;
+        }
+
+        if (m1.nodes.empty() || m2.nodes.empty())
+        {
+            return false;
+        }
+
+        // pose of model 2 in the frame of model 1
+        float Rm[3][3], Tm[3];
+        {
+            Eigen::Matrix3f r = pose1.block<3, 3>(0, 0).transpose() * pose2.block<3, 3>(0, 0);
+            Eigen::Vector3f t = pose1.block<3, 3>(0, 0).transpose() * (pose2.block<3, 1>(0, 3) - pose1.block<3, 1>(0, 3));
+
+            for (int i = 0; i < 3; i++)
+            {
+                for (int j = 0; j < 3; j++)
+                {
+                    Rm[i][j] = r(i, j);
+                }
+
+                Tm[i] = t(i);
+            }
+        }
+
+        // root box of model 2 relative to the root box of model 1
+        stack.clear();
+        stack.resize(1);
+        {
+            CollideTask& task = stack.back();
+            float tmp[3][3], v[3], diff[3];
+            mxm(tmp, Rm, m2.rootR);
+            mTxm(task.R, m1.rootR, tmp);
+            mxv(v, Rm, m2.rootT);
+
+            for (int i = 0; i < 3; i++)
+            {
+                diff[i] = v[i] + Tm[i] - m1.rootT[i];
+                task.d1[i] = m1.rootD[i];
+                task.d2[i] = m2.rootD[i];
+            }
+
+            mTxv(task.T, m1.rootR, diff);
+            task.b1 = 0;
+            task.b2 = 0;
+        }
+
+        PQP::OBB_Processor obb;
+        int tests = 0;
+        bool colliding = false;
+
+        while (!stack.empty())
+        {
+            CollideTask task = stack.back();
+            stack.pop_back();
+            tests++;
+
+            if (obb.obb_disjoint(task.R, task.T, task.d1, task.d2))
+            {
+                continue;
+            }
+
+            const Node& n1 = m1.nodes[task.b1];
+            const Node& n2 = m2.nodes[task.b2];
+            bool leaf1 = n1.next < 0;
+            bool leaf2 = n2.next < 0;
+
+            if (leaf1 && leaf2)
+            {
+                const std::array<uint32_t, 3>& t1 = m1.triangles[-n1.next - 1];
+                const std::array<uint32_t, 3>& t2 = m2.triangles[-n2.next - 1];
+                PQP::PQP_REAL p[3][3], q[3][3];
+
+                for (int k = 0; k < 3; k++)
+                {
+                    const Eigen::Vector3f& a = m1.vertices[t1[k]];
+                    const Eigen::Vector3f& b = m2.vertices[t2[k]];
+                    p[k][0] = a[0];
+                    p[k][1] = a[1];
+                    p[k][2] = a[2];
+                    float bb[3] = {b[0], b[1], b[2]};
+                    mxv(q[k], Rm, bb);
+                    q[k][0] += Tm[0];
+                    q[k][1] += Tm[1];
+                    q[k][2] += Tm[2];
+                }
+
+                if (checker.TriContact(p[0], p[1], p[2], q[0], q[1], q[2]))
+                {
+                    colliding = true;
+                    break;
+                }
+
+                continue;
+            }
+
+            // descend into the larger box, as PQP does
+            if (leaf2 || (!leaf1 && boxSize(task.d1) > boxSize(task.d2)))
+            {
+                int children[2] = {task.b1 + 1, n1.next};
+
+                for (int c = 1; c >= 0; c--)
+                {
+                    CollideTask next;
+                    float R[3][3], T[3], diff[3];
+                    DecodeNode(m1.nodes[children[c]], task.d1, R, T, next.d1);
+                    mTxm(next.R, R, task.R);
+
+                    for (int i = 0; i < 3; i++)
+                    {
+                        diff[i] = task.T[i] - T[i];
+                        next.d2[i] = task.d2[i];
+                    }
+
+                    mTxv(next.T, R, diff);
+                    next.b1 = children[c];
+                    next.b2 = task.b2;
+                    stack.push_back(next);
+                }
+            }
+            else
+            {
+                int children[2] = {task.b2 + 1, n2.next};
+
+                for (int c = 1; c >= 0; c--)
+                {
+                    CollideTask next;
+                    float R[3][3], T[3];
+                    DecodeNode(m2.nodes[children[c]], task.d2, R, T, next.d2);
+                    mxm(next.R, task.R, R);
+                    mxv(next.T, task.R, T);
+
+                    for (int i = 0; i < 3; i++)
+                    {
+                        next.T[i] += task.T[i];
+                        next.d1[i] = task.d1[i];
+                    }
+
+                    next.b1 = task.b1;
+                    next.b2 = children[c];
+                    stack.push_back(next);
+                }
+            }
+        }
+
+        if (numBVTests)
+        {
+            *numBVTests = tests;
+        }
+
+        return colliding;
+    }
+
+    size_t CompactBVH::getMemoryUsage() const
+    {
+        return sizeof(CompactBVH)
+               + nodes.capacity() * sizeof(Node)
+               + vertices.capacity() * sizeof(Eigen::Vector3f)
+               + triangles.capacity() * sizeof(std::array<uint32_t, 3>);
+    }
+
+} // namespace
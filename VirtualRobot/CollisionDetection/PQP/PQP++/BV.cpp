@@ -54,6 +54,8 @@ namespace PQP
     void
     BV::FitToTris(PQP_REAL O[3][3], Tri* tris, int num_tris)
     {
+        MatVec pqp_math;
+
         // store orientation
 
         pqp_math.McM(R, O);
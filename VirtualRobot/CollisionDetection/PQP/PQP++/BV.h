@@ -76,8 +76,6 @@ namespace PQP
         }
         PQP_REAL GetSize();
         void     FitToTris(PQP_REAL O[3][3], Tri* tris, int num_tris);
-
-        MatVec pqp_math;
     };
 
     inline
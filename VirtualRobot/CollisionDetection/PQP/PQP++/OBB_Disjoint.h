@@ -45,6 +45,10 @@
 #include "MatVec.h"
 #include "PQP_Compile.h"
 
+#ifdef PQP_USE_SSE
+#include <emmintrin.h>
+#endif
+
 namespace PQP
 {
 
@@ -61,6 +65,9 @@ namespace PQP
     // placement of box A, in this coordinate system, are the identity matrix
     // and zero vector, respectively, so they need not be specified.  The
     // dimensions of box A are given in array a.
+    //
+    // The return value is 0 if the boxes overlap, otherwise the (1-based)
+    // index of the first separating axis in the order of the scalar test.
     class OBB_Processor
     {
     public:
@@ -68,6 +75,135 @@ namespace PQP
         int
         obb_disjoint(PQP_REAL B[3][3], PQP_REAL T[3], PQP_REAL a[3], PQP_REAL b[3])
         {
+#ifdef PQP_USE_SSE
+            return obb_disjoint_sse(B, T, a, b);
+#else
+            return obb_disjoint_scalar(B, T, a, b);
+#endif
+        }
+
+#ifdef PQP_USE_SSE
+        // Evaluates the separating axes in batches (face axes of A, face axes
+        // of B, then the edge-edge axes grouped by the axis of A).  Only the
+        // first three lanes of each batch are evaluated.
+        inline
+        int
+        obb_disjoint_sse(PQP_REAL B[3][3], PQP_REAL T[3], PQP_REAL a[3], PQP_REAL b[3])
+        {
+            static_assert(sizeof(PQP_REAL) == sizeof(float), "PQP_USE_SSE requires PQP_REAL to be float");
+
+            // Most BV pairs of a traversal are rejected by the first axis,
+            // which is cheaper to test before the vectors are set up.
+            {
+                static constexpr PQP_REAL reps = (PQP_REAL)1e-6;
+
+                if (!(std::abs(T[0]) <= (a[0] + b[0] * (std::abs(B[0][0]) + reps) + b[1] * (std::abs(B[0][1]) + reps) + b[2] * (std::abs(B[0][2]) + reps))))
+                {
+                    return 1;
+                }
+            }
+
+            const __m128 reps = _mm_set1_ps(1e-6f);
+
+            // rows of B and Bf = fabs(B) + reps, the padding lanes of the
+            // first two rows hold the next row's first entry
+            const __m128 B0 = _mm_loadu_ps(B[0]);
+            const __m128 B1 = _mm_loadu_ps(B[1]);
+            const __m128 B2 = load3(B[2]);
+            const __m128 Bf0 = _mm_add_ps(abs4(B0), reps);
+            const __m128 Bf1 = _mm_add_ps(abs4(B1), reps);
+            const __m128 Bf2 = _mm_add_ps(abs4(B2), reps);
+
+            // columns of Bf (padding lanes are zero)
+            __m128 C0 = Bf0;
+            __m128 C1 = Bf1;
+            __m128 C2 = Bf2;
+            __m128 C3 = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(C0, C1, C2, C3);
+
+            const __m128 av = load3(a);
+            const __m128 bv = load3(b);
+            const __m128 T0 = _mm_set1_ps(T[0]);
+            const __m128 T1 = _mm_set1_ps(T[1]);
+            const __m128 T2 = _mm_set1_ps(T[2]);
+
+            // A0, A1, A2
+            __m128 rhs = _mm_add_ps(av, _mm_mul_ps(_mm_set1_ps(b[0]), C0));
+            rhs = _mm_add_ps(rhs, _mm_mul_ps(_mm_set1_ps(b[1]), C1));
+            rhs = _mm_add_ps(rhs, _mm_mul_ps(_mm_set1_ps(b[2]), C2));
+            const int maskA = _mm_movemask_ps(_mm_cmpnle_ps(abs4(load3(T)), rhs)) & 6;
+
+            // B0, B1, B2
+            __m128 s = _mm_add_ps(_mm_mul_ps(T0, B0), _mm_mul_ps(T1, B1));
+            s = _mm_add_ps(s, _mm_mul_ps(T2, B2));
+            rhs = _mm_add_ps(bv, _mm_mul_ps(_mm_set1_ps(a[0]), Bf0));
+            rhs = _mm_add_ps(rhs, _mm_mul_ps(_mm_set1_ps(a[1]), Bf1));
+            rhs = _mm_add_ps(rhs, _mm_mul_ps(_mm_set1_ps(a[2]), Bf2));
+            const int maskB = _mm_movemask_ps(_mm_cmpnle_ps(abs4(s), rhs)) & 7;
+
+            if (maskA | maskB)
+            {
+                // same order as the scalar test: A0, B0, A1, A2, B1, B2
+                if (maskB & 1)
+                {
+                    return 2;
+                }
+
+                if (maskA & 2)
+                {
+                    return 3;
+                }
+
+                if (maskA & 4)
+                {
+                    return 4;
+                }
+
+                return (maskB & 2) ? 5 : 6;
+            }
+
+            // lanes (b1, b0, b0) and (b2, b2, b1) of the edge-edge terms
+            const __m128 bX = _mm_shuffle_ps(bv, bv, _MM_SHUFFLE(3, 0, 0, 1));
+            const __m128 bY = _mm_shuffle_ps(bv, bv, _MM_SHUFFLE(3, 1, 2, 2));
+
+            // A0 x B0, A0 x B1, A0 x B2
+            s = _mm_sub_ps(_mm_mul_ps(T2, B1), _mm_mul_ps(T1, B2));
+            rhs = edgeRhs(_mm_set1_ps(a[1]), Bf2, _mm_set1_ps(a[2]), Bf1, bX, bY, Bf0);
+            int mask = _mm_movemask_ps(_mm_cmpnle_ps(abs4(s), rhs)) & 7;
+
+            if (mask)
+            {
+                return 7 + firstLane(mask);
+            }
+
+            // A1 x B0, A1 x B1, A1 x B2
+            s = _mm_sub_ps(_mm_mul_ps(T0, B2), _mm_mul_ps(T2, B0));
+            rhs = edgeRhs(_mm_set1_ps(a[0]), Bf2, _mm_set1_ps(a[2]), Bf0, bX, bY, Bf1);
+            mask = _mm_movemask_ps(_mm_cmpnle_ps(abs4(s), rhs)) & 7;
+
+            if (mask)
+            {
+                return 10 + firstLane(mask);
+            }
+
+            // A2 x B0, A2 x B1, A2 x B2
+            s = _mm_sub_ps(_mm_mul_ps(T1, B0), _mm_mul_ps(T0, B1));
+            rhs = edgeRhs(_mm_set1_ps(a[0]), Bf1, _mm_set1_ps(a[1]), Bf0, bX, bY, Bf2);
+            mask = _mm_movemask_ps(_mm_cmpnle_ps(abs4(s), rhs)) & 7;
+
+            if (mask)
+            {
+                return 13 + firstLane(mask);
+            }
+
+            return 0;
+        }
+#endif
+
+        inline
+        int
+        obb_disjoint_scalar(PQP_REAL B[3][3], PQP_REAL T[3], PQP_REAL a[3], PQP_REAL b[3])
+        {
             PQP_REAL s;
             int r;
             PQP_REAL Bf[3][3];
@@ -265,6 +401,35 @@ namespace PQP
 
             return 0;  // should equal 0
         }
+
+#ifdef PQP_USE_SSE
+    private:
+        static inline __m128 load3(const PQP_REAL v[3])
+        {
+            return _mm_setr_ps(v[0], v[1], v[2], 0.0f);
+        }
+
+        static inline __m128 abs4(__m128 v)
+        {
+            return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+        }
+
+        static inline int firstLane(int mask)
+        {
+            return (mask & 1) ? 0 : ((mask & 2) ? 1 : 2);
+        }
+
+        // ((x1 * r1 + x2 * r2) + bX * rX) + bY * rY, where rX and rY are the
+        // lanes (2, 2, 1) and (1, 0, 0) of the row r of Bf.
+        static inline __m128 edgeRhs(__m128 x1, __m128 r1, __m128 x2, __m128 r2, __m128 bX, __m128 bY, __m128 r)
+        {
+            const __m128 rX = _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 1, 2, 2));
+            const __m128 rY = _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 0, 0, 1));
+            __m128 rhs = _mm_add_ps(_mm_mul_ps(x1, r1), _mm_mul_ps(x2, r2));
+            rhs = _mm_add_ps(rhs, _mm_mul_ps(bX, rX));
+            return _mm_add_ps(rhs, _mm_mul_ps(bY, rY));
+        }
+#endif
     };
 
 } // namespace
@@ -615,128 +615,140 @@ namespace PQP
 
 
     void
-    PQP_Checker::CollideRecurse(PQP_CollideResult* res,
-                                PQP_REAL R[3][3], PQP_REAL T[3], // b2 relative to b1
-                                PQP_Model* o1, int b1,
-                                PQP_Model* o2, int b2, int flag)
+    PQP_Checker::CollideTraverse(PQP_CollideResult* res,
+                                 PQP_REAL R[3][3], PQP_REAL T[3], // root of o2 relative to root of o1
+                                 PQP_Model* o1, PQP_Model* o2, int flag)
     {
-        // first thing, see if we're overlapping
+        // Depth first traversal of the BV test tree with an explicit stack.
+        // The children of a node are pushed in reverse order, so the nodes
+        // are visited in the same order as by the former recursive
+        // implementation, and the [R,T] of each BV pair is computed by the
+        // very same operations.
 
-        res->num_bv_tests++;
-        BV_Processor p;
+        collideStack.clear();
+        collideStack.emplace_back();
+        pqp_math.McM(collideStack.back().R, R);
+        pqp_math.VcV(collideStack.back().T, T);
+        collideStack.back().b1 = 0;
+        collideStack.back().b2 = 0;
 
-        if (!p.BV_Overlap(R, T, o1->child(b1), o2->child(b2)))
+        while (!collideStack.empty())
         {
-            return;
-        }
+            // copy, the stack may reallocate while the children are pushed
+            CollideTask task = collideStack.back();
+            collideStack.pop_back();
 
-        // if we are, see if we test triangles next
+            const int b1 = task.b1;
+            const int b2 = task.b2;
 
-        int l1 = o1->child(b1)->Leaf();
-        int l2 = o2->child(b2)->Leaf();
+            // first thing, see if we're overlapping
 
-        if (l1 && l2)
-        {
-            res->num_tri_tests++;
+            res->num_bv_tests++;
 
-#if 1
-            // transform the points in b2 into space of b1, then compare
-
-            Tri* t1 = &o1->tris[-o1->child(b1)->first_child - 1];
-            Tri* t2 = &o2->tris[-o2->child(b2)->first_child - 1];
-            PQP_REAL q1[3], q2[3], q3[3];
-            PQP_REAL* p1 = t1->p1;
-            PQP_REAL* p2 = t1->p2;
-            PQP_REAL* p3 = t1->p3;
-            pqp_math.MxVpV(q1, res->R, t2->p1, res->T);
-            pqp_math.MxVpV(q2, res->R, t2->p2, res->T);
-            pqp_math.MxVpV(q3, res->R, t2->p3, res->T);
-
-            if (TriContact(p1, p2, p3, q1, q2, q3))
+            if (!bvProcessor.BV_Overlap(task.R, task.T, o1->child(b1), o2->child(b2)))
             {
-                // add this to result
-
-                res->Add(t1->id, t2->id);
+                continue;
             }
 
-#else
-            PQP_REAL p[3], q[3];
+            // if we are, see if we test triangles next
 
-            Tri* t1 = &o1->tris[-o1->child(b1)->first_child - 1];
-            Tri* t2 = &o2->tris[-o2->child(b2)->first_child - 1];
+            int l1 = o1->child(b1)->Leaf();
+            int l2 = o2->child(b2)->Leaf();
 
-            if (TriDistance(res->R, res->T, t1, t2, p, q) == 0.0)
+            if (l1 && l2)
             {
-                // add this to result
+                res->num_tri_tests++;
 
-                res->Add(t1->id, t2->id);
-            }
+                // transform the points in b2 into space of b1, then compare
 
-#endif
+                Tri* t1 = &o1->tris[-o1->child(b1)->first_child - 1];
+                Tri* t2 = &o2->tris[-o2->child(b2)->first_child - 1];
+                PQP_REAL q1[3], q2[3], q3[3];
+                PQP_REAL* p1 = t1->p1;
+                PQP_REAL* p2 = t1->p2;
+                PQP_REAL* p3 = t1->p3;
+                pqp_math.MxVpV(q1, res->R, t2->p1, res->T);
+                pqp_math.MxVpV(q2, res->R, t2->p2, res->T);
+                pqp_math.MxVpV(q3, res->R, t2->p3, res->T);
 
-            return;
-        }
+                if (TriContact(p1, p2, p3, q1, q2, q3))
+                {
+                    // add this to result
 
-        // we dont, so decide whose children to visit next
+                    res->Add(t1->id, t2->id);
 
-        PQP_REAL sz1 = o1->child(b1)->GetSize();
-        PQP_REAL sz2 = o2->child(b2)->GetSize();
+                    if (flag == PQP_FIRST_CONTACT)
+                    {
+                        return;
+                    }
+                }
 
-        PQP_REAL Rc[3][3], Tc[3], Ttemp[3];
+                continue;
+            }
 
-        if (l2 || (!l1 && (sz1 > sz2)))
-        {
-            int c1 = o1->child(b1)->first_child;
-            int c2 = c1 + 1;
+            // we dont, so decide whose children to visit next
 
-            pqp_math.MTxM(Rc, o1->child(c1)->R, R);
-#if PQP_BV_TYPE & OBB_TYPE
-            pqp_math.VmV(Ttemp, T, o1->child(c1)->To);
-#else
-            pqp_math.VmV(Ttemp, T, o1->child(c1)->Tr);
-#endif
-            pqp_math.MTxV(Tc, o1->child(c1)->R, Ttemp);
-            CollideRecurse(res, Rc, Tc, o1, c1, o2, b2, flag);
+            PQP_REAL sz1 = o1->child(b1)->GetSize();
+            PQP_REAL sz2 = o2->child(b2)->GetSize();
+
+            PQP_REAL Ttemp[3];
+            PQP_REAL(*R)[3] = task.R;
+            PQP_REAL* T = task.T;
+
+            // the first child ends up on top of the stack
+            const size_t first = collideStack.size();
+            collideStack.resize(first + 2);
+            CollideTask& second = collideStack[first];
+            CollideTask& next = collideStack[first + 1];
 
-            if ((flag == PQP_FIRST_CONTACT) && (res->num_pairs > 0))
+            if (l2 || (!l1 && (sz1 > sz2)))
             {
-                return;
-            }
+                int c1 = o1->child(b1)->first_child;
+                int c2 = c1 + 1;
 
-            pqp_math.MTxM(Rc, o1->child(c2)->R, R);
+                pqp_math.MTxM(next.R, o1->child(c1)->R, R);
 #if PQP_BV_TYPE & OBB_TYPE
-            pqp_math.VmV(Ttemp, T, o1->child(c2)->To);
+                pqp_math.VmV(Ttemp, T, o1->child(c1)->To);
 #else
-            pqp_math.VmV(Ttemp, T, o1->child(c2)->Tr);
+                pqp_math.VmV(Ttemp, T, o1->child(c1)->Tr);
 #endif
-            pqp_math.MTxV(Tc, o1->child(c2)->R, Ttemp);
-            CollideRecurse(res, Rc, Tc, o1, c2, o2, b2, flag);
-        }
-        else
-        {
-            int c1 = o2->child(b2)->first_child;
-            int c2 = c1 + 1;
+                pqp_math.MTxV(next.T, o1->child(c1)->R, Ttemp);
+                next.b1 = c1;
+                next.b2 = b2;
 
-            pqp_math.MxM(Rc, R, o2->child(c1)->R);
+                pqp_math.MTxM(second.R, o1->child(c2)->R, R);
 #if PQP_BV_TYPE & OBB_TYPE
-            pqp_math.MxVpV(Tc, R, o2->child(c1)->To, T);
+                pqp_math.VmV(Ttemp, T, o1->child(c2)->To);
 #else
-            pqp_math.MxVpV(Tc, R, o2->child(c1)->Tr, T);
+                pqp_math.VmV(Ttemp, T, o1->child(c2)->Tr);
 #endif
-            CollideRecurse(res, Rc, Tc, o1, b1, o2, c1, flag);
-
-            if ((flag == PQP_FIRST_CONTACT) && (res->num_pairs > 0))
-            {
-                return;
+                pqp_math.MTxV(second.T, o1->child(c2)->R, Ttemp);
+                second.b1 = c2;
+                second.b2 = b2;
             }
+            else
+            {
+                int c1 = o2->child(b2)->first_child;
+                int c2 = c1 + 1;
+
+                pqp_math.MxM(next.R, R, o2->child(c1)->R);
+#if PQP_BV_TYPE & OBB_TYPE
+                pqp_math.MxVpV(next.T, R, o2->child(c1)->To, T);
+#else
+                pqp_math.MxVpV(next.T, R, o2->child(c1)->Tr, T);
+#endif
+                next.b1 = b1;
+                next.b2 = c1;
 
-            pqp_math.MxM(Rc, R, o2->child(c2)->R);
+                pqp_math.MxM(second.R, R, o2->child(c2)->R);
 #if PQP_BV_TYPE & OBB_TYPE
-            pqp_math.MxVpV(Tc, R, o2->child(c2)->To, T);
+                pqp_math.MxVpV(second.T, R, o2->child(c2)->To, T);
 #else
-            pqp_math.MxVpV(Tc, R, o2->child(c2)->Tr, T);
+                pqp_math.MxVpV(second.T, R, o2->child(c2)->Tr, T);
 #endif
-            CollideRecurse(res, Rc, Tc, o1, b1, o2, c2, flag);
+                second.b1 = b1;
+                second.b2 = c2;
+            }
         }
     }
 
@@ -798,7 +810,7 @@ namespace PQP
 
         // now start with both top level BVs
 
-        CollideRecurse(res, R, T, o1, 0, o2, 0, flag);
+        CollideTraverse(res, R, T, o1, o2, flag);
 
         double t2 = ti.GetTime();
         res->query_time_secs = t2 - t1;
@@ -44,6 +44,8 @@
 #include "PQP_Internal.h"
 #include "TriDist.h"
 
+#include <vector>
+
 namespace PQP
 {
 
@@ -334,6 +336,9 @@ namespace PQP
                       int qsize = 2);
 #endif
 
+        // Checks two triangles, given in the same coordinate system, for contact.
+        int TriContact(PQP_REAL* P1, PQP_REAL* P2, PQP_REAL* P3, PQP_REAL* Q1, PQP_REAL* Q2, PQP_REAL* Q3);
+
     private:
         MatVec pqp_math;
         void ToleranceQueueRecurse(PQP_ToleranceResult* res, PQP_REAL R[3][3], PQP_REAL T[3], PQP_Model* o1, int b1, PQP_Model* o2, int b2);
@@ -342,16 +347,25 @@ namespace PQP
         void DistanceRecurse(PQP_DistanceResult* res, PQP_REAL R[3][3], PQP_REAL T[3], // b2 relative to b1
                              PQP_Model* o1, int b1, PQP_Model* o2, int b2);
 
-        void CollideRecurse(PQP_CollideResult* res, PQP_REAL R[3][3], PQP_REAL T[3], // b2 relative to b1
-                            PQP_Model* o1, int b1,  PQP_Model* o2, int b2, int flag);
+        void CollideTraverse(PQP_CollideResult* res, PQP_REAL R[3][3], PQP_REAL T[3], // root of o2 relative to root of o1
+                             PQP_Model* o1, PQP_Model* o2, int flag);
         PQP_REAL TriDistance(PQP_REAL R[3][3], PQP_REAL T[3], Tri* t1, Tri* t2, PQP_REAL p[3], PQP_REAL q[3]);
-        int TriContact(PQP_REAL* P1, PQP_REAL* P2, PQP_REAL* P3, PQP_REAL* Q1, PQP_REAL* Q2, PQP_REAL* Q3);
         int project6(PQP_REAL* ax, PQP_REAL* p1, PQP_REAL* p2, PQP_REAL* p3, PQP_REAL* q1, PQP_REAL* q2, PQP_REAL* q3);
         PQP_REAL pqp_min(PQP_REAL a, PQP_REAL b, PQP_REAL c);
         PQP_REAL pqp_max(PQP_REAL a, PQP_REAL b, PQP_REAL c);
 
         Tri_Processor triProcessor;
         BV_Processor bvProcessor;
+
+        // pending BV pairs of the collision traversal, kept to reuse its memory
+        struct CollideTask
+        {
+            PQP_REAL R[3][3];     // b2 relative to b1
+            PQP_REAL T[3];
+            int b1;
+            int b2;
+        };
+        std::vector<CollideTask> collideStack;
     };
 
 } // namespace
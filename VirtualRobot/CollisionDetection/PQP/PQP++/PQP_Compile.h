@@ -104,5 +104,21 @@ namespace PQP
 
 #define PQP_BV_TYPE  RSS_TYPE | OBB_TYPE
 
+    //-------------------------------------------------------------------------
+    //
+    // PQP_USE_SSE
+    //
+    // With PQP_REAL being float and SSE2 available (always the case on
+    // x86_64), the OBB overlap test evaluates its 15 separating axes in
+    // batches of three.  Every lane performs exactly the same float
+    // operations in the same order as the scalar test, so the results are
+    // bit-identical.  Remove the define when PQP_REAL is switched to double.
+    //
+    //-------------------------------------------------------------------------
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PQP_USE_SSE
+#endif
+
 } // namespace
 
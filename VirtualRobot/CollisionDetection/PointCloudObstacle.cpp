@@ -0,0 +1,492 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+
+#include "PointCloudObstacle.h"
+#include "CollisionModel.h"
+#include "SphereTree.h"
+#include "../SceneObjectSet.h"
+#include "../Tools/ParallelTools.h"
+#include "../VirtualRobotException.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace VirtualRobot
+{
+
+    namespace
+    {
+        const int blockSize = 8;
+        const int64_t keyOffset = int64_t(1) << 20;
+        const int64_t keyMask = (int64_t(1) << 21) - 1;
+        const uint8_t invalidShard = 255;
+
+        int64_t floorDiv(int64_t value, int64_t divisor)
+        {
+            return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+        }
+
+        int64_t packBlock(int64_t x, int64_t y, int64_t z)
+        {
+            return ((x + keyOffset) & keyMask) | (((y + keyOffset) & keyMask) << 21) | (((z + keyOffset) & keyMask) << 42);
+        }
+
+        // the distance between a point and an axis aligned box
+        float boxDistance(const Eigen::Vector3f& point, const Eigen::Vector3f& min, const Eigen::Vector3f& max)
+        {
+            return (min - point).cwiseMax(point - max).cwiseMax(0.0f).norm();
+        }
+    }
+
+    PointCloudObstacle::Block::Block()
+        : numPoints(0), numVoxels(0)
+    {
+        counts.fill(0);
+        occupied.fill(0);
+    }
+
+    PointCloudObstacle::PointCloudObstacle(float resolution, const std::string& name)
+        : name(name), resolution(resolution), numPoints(0), numVoxels(0)
+    {
+        THROW_VR_EXCEPTION_IF(resolution <= 0, "The resolution of a point cloud obstacle has to be positive");
+    }
+
+    PointCloudObstacle::VoxelKey PointCloudObstacle::getKey(const Eigen::Vector3f& point) const
+    {
+        int64_t voxel[3];
+        int64_t block[3];
+
+        for (int i = 0; i < 3; i++)
+        {
+            voxel[i] = (int64_t)std::floor(point[i] / resolution);
+            block[i] = floorDiv(voxel[i], blockSize);
+            voxel[i] -= block[i] * blockSize;
+        }
+
+        return VoxelKey(packBlock(block[0], block[1], block[2]), int(voxel[0] + blockSize * (voxel[1] + blockSize * voxel[2])));
+    }
+
+    int PointCloudObstacle::getShard(int64_t blockKey)
+    {
+        return int((uint64_t(blockKey) * 0x9E3779B97F4A7C15ull) >> 60) % numShards;
+    }
+
+    void PointCloudObstacle::update(const std::vector<Eigen::Vector3f>& points, unsigned int numThreads, bool add)
+    {
+        // the keys are computed in chunks, then each thread updates whole shards
+        const int chunkSize = 1 << 16;
+        std::vector<VoxelKey> keys(points.size());
+        std::vector<uint8_t> keyShards(points.size());
+
+        ParallelTools::runParallel((points.size() + chunkSize - 1) / chunkSize, numThreads, [&](size_t chunk)
+        {
+            size_t end = std::min(points.size(), size_t(chunk + 1) * chunkSize);
+
+            for (size_t i = size_t(chunk) * chunkSize; i < end; i++)
+            {
+                // sensors report invalid measurements as NaN
+                if (!points[i].allFinite())
+                {
+                    keyShards[i] = invalidShard;
+                    continue;
+                }
+
+                keys[i] = getKey(points[i]);
+                keyShards[i] = uint8_t(getShard(keys[i].first));
+            }
+        });
+
+        // sort the points by shard
+        std::array<size_t, numShards + 1> shardBegin;
+        shardBegin.fill(0);
+
+        for (uint8_t shard : keyShards)
+        {
+            if (shard != invalidShard)
+            {
+                shardBegin[shard + 1]++;
+            }
+        }
+
+        for (int i = 0; i < numShards; i++)
+        {
+            shardBegin[i + 1] += shardBegin[i];
+        }
+
+        std::vector<unsigned int> order(shardBegin[numShards]);
+        std::array<size_t, numShards> shardEnd;
+        std::copy(shardBegin.begin(), shardBegin.end() - 1, shardEnd.begin());
+
+        for (size_t i = 0; i < keyShards.size(); i++)
+        {
+            if (keyShards[i] != invalidShard)
+            {
+                order[shardEnd[keyShards[i]]++] = (unsigned int)i;
+            }
+        }
+
+        std::array<int64_t, numShards> pointChanges;
+        std::array<int64_t, numShards> voxelChanges;
+        pointChanges.fill(0);
+        voxelChanges.fill(0);
+
+        ParallelTools::runParallel(numShards, numThreads, [&](size_t shard)
+        {
+            BlockMap& blocks = shards[shard];
+            // consecutive points are mostly in the same block
+            Block* block = nullptr;
+            int64_t blockKey = 0;
+            bool cached = false;
+            std::vector<int64_t> emptyBlocks;
+
+            for (size_t j = shardBegin[shard]; j < shardBegin[shard + 1]; j++)
+            {
+                const size_t i = order[j];
+
+                if (!cached || keys[i].first != blockKey)
+                {
+                    blockKey = keys[i].first;
+                    cached = true;
+
+                    if (add)
+                    {
+                        block = &blocks[blockKey];
+                    }
+                    else
+                    {
+                        BlockMap::iterator it = blocks.find(blockKey);
+                        block = it == blocks.end() ? nullptr : &it->second;
+                    }
+                }
+
+                const int voxel = keys[i].second;
+                const uint64_t bit = uint64_t(1) << (voxel % 64);
+
+                if (add)
+                {
+                    if (block->counts[voxel]++ == 0)
+                    {
+                        block->occupied[voxel / 64] |= bit;
+                        block->numVoxels++;
+                        voxelChanges[shard]++;
+                    }
+
+                    block->numPoints++;
+                    pointChanges[shard]++;
+                }
+                else
+                {
+                    if (!block || block->counts[voxel] == 0)
+                    {
+                        continue;
+                    }
+
+                    if (--block->counts[voxel] == 0)
+                    {
+                        block->occupied[voxel / 64] &= ~bit;
+                        block->numVoxels--;
+                        voxelChanges[shard]--;
+                    }
+
+                    pointChanges[shard]--;
+
+                    if (--block->numPoints == 0)
+                    {
+                        emptyBlocks.push_back(blockKey);
+                    }
+                }
+            }
+
+            // the blocks are erased afterwards to keep the cached block valid
+            for (int64_t key : emptyBlocks)
+            {
+                blocks.erase(key);
+            }
+        });
+
+        for (int i = 0; i < numShards; i++)
+        {
+            numPoints += pointChanges[i];
+            numVoxels += voxelChanges[i];
+        }
+    }
+
+    void PointCloudObstacle::insert(const std::vector<Eigen::Vector3f>& points, unsigned int numThreads)
+    {
+        update(points, numThreads, true);
+    }
+
+    void PointCloudObstacle::remove(const std::vector<Eigen::Vector3f>& points, unsigned int numThreads)
+    {
+        update(points, numThreads, false);
+    }
+
+    void PointCloudObstacle::clear()
+    {
+        for (BlockMap& blocks : shards)
+        {
+            blocks.clear();
+        }
+
+        numPoints = 0;
+        numVoxels = 0;
+    }
+
+    bool PointCloudObstacle::isOccupied(const Eigen::Vector3f& point) const
+    {
+        VoxelKey key = getKey(point);
+        const BlockMap& blocks = shards[getShard(key.first)];
+        BlockMap::const_iterator it = blocks.find(key.first);
+        return it != blocks.end() && it->second.counts[key.second] > 0;
+    }
+
+    void PointCloudObstacle::getBlocks(const Eigen::Vector3f& center, float radius, BlockList& blocks) const
+    {
+        const float blockLength = blockSize * resolution;
+        Eigen::Vector3i min = ((center.array() - radius) / blockLength).floor().cast<int>().matrix();
+        Eigen::Vector3i max = ((center.array() + radius) / blockLength).floor().cast<int>().matrix();
+        blocks.clear();
+
+        for (int z = min.z(); z <= max.z(); z++)
+        {
+            for (int y = min.y(); y <= max.y(); y++)
+            {
+                for (int x = min.x(); x <= max.x(); x++)
+                {
+                    Eigen::Vector3f blockMin = Eigen::Vector3f(x, y, z) * blockLength;
+
+                    if (boxDistance(center, blockMin, blockMin + Eigen::Vector3f::Constant(blockLength)) > radius)
+                    {
+                        continue;
+                    }
+
+                    int64_t key = packBlock(x, y, z);
+                    const BlockMap& map = shards[getShard(key)];
+                    BlockMap::const_iterator it = map.find(key);
+
+                    if (it != map.end())
+                    {
+                        blocks.push_back(std::make_pair(blockMin, &it->second));
+                    }
+                }
+            }
+        }
+    }
+
+    float PointCloudObstacle::getClosest(const BlockList& blocks, const Eigen::Vector3f& center, float radius, bool checkVoxels) const
+    {
+        const float blockLength = blockSize * resolution;
+        float best = radius;
+        bool found = false;
+
+        for (const auto& block : blocks)
+        {
+            const Eigen::Vector3f& blockMin = block.first;
+            float blockDistance = boxDistance(center, blockMin, blockMin + Eigen::Vector3f::Constant(blockLength));
+
+            if (blockDistance > best || (found && blockDistance == best))
+            {
+                continue;
+            }
+
+            if (!checkVoxels)
+            {
+                best = blockDistance;
+                found = true;
+                continue;
+            }
+
+            // the occupied voxels of the block within the current distance, with masks of the bits of each layer
+            Eigen::Array3f local = (center - blockMin).array() / resolution;
+            Eigen::Vector3i first = (local - best / resolution).floor().cast<int>().matrix().cwiseMax(0);
+            Eigen::Vector3i last = (local + best / resolution).floor().cast<int>().matrix().cwiseMin(blockSize - 1);
+            uint64_t row = ((uint64_t(1) << (last.x() + 1)) - 1) & ~((uint64_t(1) << first.x()) - 1);
+            uint64_t mask = 0;
+
+            for (int vy = first.y(); vy <= last.y(); vy++)
+            {
+                mask |= row << (blockSize * vy);
+            }
+
+            for (int vz = first.z(); vz <= last.z(); vz++)
+            {
+                uint64_t bits = block.second->occupied[vz] & mask;
+
+                for (int i = 0; bits != 0; i++, bits >>= 1)
+                {
+                    if ((bits & 1) == 0)
+                    {
+                        continue;
+                    }
+
+                    Eigen::Vector3f voxelMin = blockMin + Eigen::Vector3f(i % blockSize, i / blockSize, vz) * resolution;
+                    float d = boxDistance(center, voxelMin, voxelMin + Eigen::Vector3f::Constant(resolution));
+
+                    if (d <= best)
+                    {
+                        best = d;
+                        found = true;
+                    }
+                }
+            }
+        }
+
+        return found ? best : FLT_MAX;
+    }
+
+    bool PointCloudObstacle::checkCollision(CollisionModelPtr model, float tolerance)
+    {
+        THROW_VR_EXCEPTION_IF(!model, "NULL collision model");
+        SphereTreePtr tree = model->getSphereTree();
+
+        if (numVoxels == 0 || tree->getNumNodes() == 0)
+        {
+            return false;
+        }
+
+        BlockList blocks;
+        bool root = true;
+        bool collision = false;
+        tree->traverse(model->getGlobalPose(), [&](const Eigen::Vector3f & center, float radius, bool leaf)
+        {
+            if (collision)
+            {
+                return false;
+            }
+
+            float reach = radius + tolerance;
+
+            if (root)
+            {
+                root = false;
+                getBlocks(center, reach, blocks);
+                return !blocks.empty();
+            }
+
+            if (!leaf)
+            {
+                return getClosest(blocks, center, reach, false) <= reach;
+            }
+
+            collision = getClosest(blocks, center, reach, true) <= reach;
+            return false;
+        });
+
+        return collision;
+    }
+
+    float PointCloudObstacle::getDistance(CollisionModelPtr model, float maxDistance)
+    {
+        THROW_VR_EXCEPTION_IF(!model, "NULL collision model");
+        SphereTreePtr tree = model->getSphereTree();
+
+        if (numVoxels == 0 || tree->getNumNodes() == 0)
+        {
+            return maxDistance;
+        }
+
+        // the costs grow with the volume of the search, hence the search radius is doubled until points are found
+        BlockList blocks;
+        float limit = std::min(maxDistance, blockSize * resolution);
+
+        while (true)
+        {
+            float best = limit;
+            bool root = true;
+            tree->traverse(model->getGlobalPose(), [&](const Eigen::Vector3f & center, float radius, bool leaf)
+            {
+                if (best <= 0)
+                {
+                    return false;
+                }
+
+                float reach = radius + best;
+
+                if (root)
+                {
+                    root = false;
+                    getBlocks(center, reach, blocks);
+
+                    if (blocks.empty())
+                    {
+                        return false;
+                    }
+                }
+
+                // the voxels are only scanned for small spheres
+                float d = getClosest(blocks, center, reach, leaf || reach < blockSize * resolution);
+
+                if (!leaf)
+                {
+                    return d < reach;
+                }
+
+                if (d < reach)
+                {
+                    best = std::max(0.0f, d - radius);
+                }
+
+                return false;
+            });
+
+            if (best < limit || limit >= maxDistance)
+            {
+                return best;
+            }
+
+            limit = std::min(2 * limit, maxDistance);
+        }
+    }
+
+    bool PointCloudObstacle::checkCollision(SceneObjectSetPtr objects, float tolerance)
+    {
+        THROW_VR_EXCEPTION_IF(!objects, "NULL scene object set");
+
+        for (const CollisionModelPtr& model : objects->getCollisionModels())
+        {
+            if (checkCollision(model, tolerance))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    float PointCloudObstacle::getDistance(SceneObjectSetPtr objects, float maxDistance)
+    {
+        THROW_VR_EXCEPTION_IF(!objects, "NULL scene object set");
+        float best = maxDistance;
+
+        for (const CollisionModelPtr& model : objects->getCollisionModels())
+        {
+            best = std::min(best, getDistance(model, best));
+        }
+
+        return best;
+    }
+
+    std::string PointCloudObstacle::getName() const
+    {
+        return name;
+    }
+
+    float PointCloudObstacle::getResolution() const
+    {
+        return resolution;
+    }
+
+    size_t PointCloudObstacle::getNumPoints() const
+    {
+        return numPoints;
+    }
+
+    size_t PointCloudObstacle::getNumVoxels() const
+    {
+        return numVoxels;
+    }
+
+} // namespace VirtualRobot
@@ -0,0 +1,128 @@
+/**
+* This file is part of Simox.
+*
+* Simox is free software; you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 2 of
+* the License, or (at your option) any later version.
+*
+* Simox is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*
+*/
+#pragma once
+
+#include "../VirtualRobot.h"
+
+#include <Eigen/Core>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace VirtualRobot
+{
+    /*!
+        An obstacle given by points in global coordinates, e.g. from a depth sensor, that can be added to a CDManager.
+
+        The points are counted in a hashed voxel grid: Blocks of 8x8x8 voxels are stored in hash maps, only blocks that
+        contain points exist. Since the points of each voxel are counted, points can be inserted and removed incrementally,
+        e.g. to replace the points of the previous sensor frame. Updates are distributed over threads by splitting the
+        hash maps into shards.
+
+        Collision models are checked with their sphere trees (see CollisionModel::getSphereTree()), against the occupied voxels:
+        A collision is reported if a leaf sphere intersects an occupied voxel. Hence, no contact with a point is missed,
+        but models that are closer than about twice the leaf radius plus the voxel diagonal may be reported as colliding.
+        Accordingly, the distances are lower bounds of the distances between the triangles and the points.
+    */
+    class VIRTUAL_ROBOT_IMPORT_EXPORT PointCloudObstacle
+    {
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        /*!
+            \param resolution The edge length of the voxels [mm].
+        */
+        PointCloudObstacle(float resolution, const std::string& name = "");
+
+        /*!
+            Adds points to the obstacle.
+            \param numThreads The number of threads, 0 uses one thread per core.
+        */
+        void insert(const std::vector<Eigen::Vector3f>& points, unsigned int numThreads = 0);
+
+        //! Removes points that have been inserted before. Points of empty voxels are ignored.
+        void remove(const std::vector<Eigen::Vector3f>& points, unsigned int numThreads = 0);
+
+        void clear();
+
+        bool isOccupied(const Eigen::Vector3f& point) const;
+
+        //! Checks the collision model at its current global pose.
+        bool checkCollision(CollisionModelPtr model, float tolerance = 0.0f);
+        bool checkCollision(SceneObjectSetPtr objects, float tolerance = 0.0f);
+
+        /*!
+            A lower bound of the distance between the collision model and the points.
+            \return The distance or maxDistance, if no point is closer.
+        */
+        float getDistance(CollisionModelPtr model, float maxDistance = 1000.0f);
+        float getDistance(SceneObjectSetPtr objects, float maxDistance = 1000.0f);
+
+        std::string getName() const;
+        float getResolution() const;
+        size_t getNumPoints() const;
+        size_t getNumVoxels() const;
+
+    protected:
+        static const int numShards = 16;
+
+        struct Block
+        {
+            Block();
+
+            std::array<uint32_t, 512> counts;
+            // the occupied voxels, one word per layer in z
+            std::array<uint64_t, 8> occupied;
+            unsigned int numPoints;
+            unsigned int numVoxels;
+        };
+
+        typedef std::unordered_map<int64_t, Block> BlockMap;
+        // blocks with their minimum corner
+        typedef std::vector<std::pair<Eigen::Vector3f, const Block*>> BlockList;
+
+        // a voxel, given by the key of its block and its index in the block
+        typedef std::pair<int64_t, int> VoxelKey;
+
+        VoxelKey getKey(const Eigen::Vector3f& point) const;
+        static int getShard(int64_t blockKey);
+        void update(const std::vector<Eigen::Vector3f>& points, unsigned int numThreads, bool add);
+
+        //! Collects the blocks within the sphere, the queries of a model only consider the blocks around its root sphere.
+        void getBlocks(const Eigen::Vector3f& center, float radius, BlockList& blocks) const;
+
+        /*!
+            The smallest distance between the center and an occupied voxel of the blocks, if it is at most radius.
+            \param checkVoxels If not set, the distance to the blocks is returned, which is faster to compute.
+        */
+        float getClosest(const BlockList& blocks, const Eigen::Vector3f& center, float radius, bool checkVoxels) const;
+
+        std::string name;
+        float resolution;
+        std::array<BlockMap, numShards> shards;
+        size_t numPoints;
+        size_t numVoxels;
+    };
+
+} // namespace VirtualRobot
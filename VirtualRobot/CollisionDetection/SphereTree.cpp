@@ -0,0 +1,385 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+
+#include "SphereTree.h"
+#include "../Visualization/TriMeshModel.h"
+#include "../VirtualRobotException.h"
+
+#include <Eigen/Geometry>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <utility>
+
+namespace VirtualRobot
+{
+
+    namespace
+    {
+        // nodes with at most this number of leaves are tested in one loop
+        const unsigned int bucketSize = 8;
+
+        // the center of the bounding box of the points and the largest distance to it
+        template<class Iterator>
+        std::pair<Eigen::Vector3f, float> boundingSphere(Iterator begin, Iterator end)
+        {
+            Eigen::Vector3f min = Eigen::Vector3f::Constant(FLT_MAX);
+            Eigen::Vector3f max = Eigen::Vector3f::Constant(-FLT_MAX);
+
+            for (Iterator it = begin; it != end; ++it)
+            {
+                min = min.cwiseMin(*it);
+                max = max.cwiseMax(*it);
+            }
+
+            Eigen::Vector3f center = (min + max) / 2;
+            float radius = 0;
+
+            for (Iterator it = begin; it != end; ++it)
+            {
+                radius = std::max(radius, (*it - center).squaredNorm());
+            }
+
+            return std::make_pair(center, std::sqrt(radius));
+        }
+    }
+
+    struct SphereTree::Piece
+    {
+        Eigen::Vector3f vertices[3];
+        Eigen::Vector3f centroid;
+    };
+
+    SphereTree::SphereTree()
+        : maxLeafRadius(0)
+    {
+    }
+
+    SphereTreePtr SphereTree::Create(const TriMeshModel& mesh, float maxLeafRadius)
+    {
+        THROW_VR_EXCEPTION_IF(maxLeafRadius <= 0, "The leaf radius of a sphere tree has to be positive");
+
+        // subdivide the triangles into pieces that fit into a leaf
+        std::vector<Piece> pieces;
+        std::vector<Piece> stack;
+
+        for (const MathTools::TriangleFace& f : mesh.faces)
+        {
+            Piece piece;
+            piece.vertices[0] = mesh.vertices.at(f.id1);
+            piece.vertices[1] = mesh.vertices.at(f.id2);
+            piece.vertices[2] = mesh.vertices.at(f.id3);
+            stack.push_back(piece);
+
+            while (!stack.empty())
+            {
+                Piece p = stack.back();
+                stack.pop_back();
+
+                if (boundingSphere(p.vertices, p.vertices + 3).second <= maxLeafRadius)
+                {
+                    p.centroid = (p.vertices[0] + p.vertices[1] + p.vertices[2]) / 3;
+                    pieces.push_back(p);
+                    continue;
+                }
+
+                Eigen::Vector3f m01 = (p.vertices[0] + p.vertices[1]) / 2;
+                Eigen::Vector3f m12 = (p.vertices[1] + p.vertices[2]) / 2;
+                Eigen::Vector3f m20 = (p.vertices[2] + p.vertices[0]) / 2;
+                const Eigen::Vector3f corners[4][3] = {{p.vertices[0], m01, m20}, {m01, p.vertices[1], m12}, {m20, m12, p.vertices[2]}, {m01, m12, m20}};
+
+                for (const auto& corner : corners)
+                {
+                    Piece child;
+                    std::copy(corner, corner + 3, child.vertices);
+                    stack.push_back(child);
+                }
+            }
+        }
+
+        SphereTreePtr tree(new SphereTree());
+        tree->maxLeafRadius = maxLeafRadius;
+
+        if (!pieces.empty())
+        {
+            tree->build(pieces, 0, pieces.size());
+        }
+
+        return tree;
+    }
+
+    int SphereTree::build(std::vector<Piece>& pieces, size_t begin, size_t end)
+    {
+        std::vector<Eigen::Vector3f> points;
+
+        for (size_t i = begin; i < end; i++)
+        {
+            points.insert(points.end(), pieces[i].vertices, pieces[i].vertices + 3);
+        }
+
+        std::pair<Eigen::Vector3f, float> sphere = boundingSphere(points.begin(), points.end());
+        int index = (int)nodes.size();
+        Node node;
+        node.center = sphere.first;
+        node.radius = sphere.second;
+        node.left = -1;
+        node.right = -1;
+        node.firstLeaf = (unsigned int)leafRadius.size();
+        nodes.push_back(node);
+
+        if (sphere.second <= maxLeafRadius || end - begin == 1)
+        {
+            leafX.push_back(sphere.first.x());
+            leafY.push_back(sphere.first.y());
+            leafZ.push_back(sphere.first.z());
+            leafRadius.push_back(sphere.second);
+            nodes[index].numLeaves = 1;
+            return index;
+        }
+
+        Eigen::Vector3f min = Eigen::Vector3f::Constant(FLT_MAX);
+        Eigen::Vector3f max = Eigen::Vector3f::Constant(-FLT_MAX);
+
+        for (size_t i = begin; i < end; i++)
+        {
+            min = min.cwiseMin(pieces[i].centroid);
+            max = max.cwiseMax(pieces[i].centroid);
+        }
+
+        int axis;
+        (max - min).maxCoeff(&axis);
+        size_t mid = (begin + end) / 2;
+        std::nth_element(pieces.begin() + begin, pieces.begin() + mid, pieces.begin() + end, [axis](const Piece & a, const Piece & b)
+        {
+            return a.centroid[axis] < b.centroid[axis];
+        });
+
+        int left = build(pieces, begin, mid);
+        int right = build(pieces, mid, end);
+        unsigned int numLeaves = (unsigned int)leafRadius.size() - nodes[index].firstLeaf;
+        nodes[index].numLeaves = numLeaves;
+
+        if (numLeaves <= bucketSize)
+        {
+            // the subtree was stored after this node
+            nodes.resize(index + 1);
+        }
+        else
+        {
+            nodes[index].left = left;
+            nodes[index].right = right;
+        }
+
+        return index;
+    }
+
+    int SphereTree::overlaps(const Node& bucket, const Eigen::Vector3f& center, float radius) const
+    {
+        const float* x = leafX.data() + bucket.firstLeaf;
+        const float* y = leafY.data() + bucket.firstLeaf;
+        const float* z = leafZ.data() + bucket.firstLeaf;
+        const float* r = leafRadius.data() + bucket.firstLeaf;
+        const float cx = center.x();
+        const float cy = center.y();
+        const float cz = center.z();
+        int count = 0;
+
+        for (unsigned int i = 0; i < bucket.numLeaves; i++)
+        {
+            float dx = x[i] - cx;
+            float dy = y[i] - cy;
+            float dz = z[i] - cz;
+            float d = r[i] + radius;
+            count += (dx * dx + dy * dy + dz * dz <= d * d) ? 1 : 0;
+        }
+
+        return count;
+    }
+
+    bool SphereTree::Collide(const SphereTree& tree1, const Eigen::Matrix4f& pose1, const SphereTree& tree2, const Eigen::Matrix4f& pose2, float margin)
+    {
+        if (tree1.nodes.empty() || tree2.nodes.empty())
+        {
+            return false;
+        }
+
+        // the spheres of tree1 in the coordinate system of tree2
+        Eigen::Matrix4f transform = pose2.inverse() * pose1;
+        Eigen::Matrix3f rotation = transform.block<3, 3>(0, 0);
+        Eigen::Vector3f translation = transform.block<3, 1>(0, 3);
+
+        std::vector<std::pair<int, int>> stack;
+        stack.push_back(std::make_pair(0, 0));
+
+        while (!stack.empty())
+        {
+            int index1 = stack.back().first;
+            int index2 = stack.back().second;
+            stack.pop_back();
+            const Node& node1 = tree1.nodes[index1];
+            const Node& node2 = tree2.nodes[index2];
+
+            Eigen::Vector3f center1 = rotation * node1.center + translation;
+            float d = node1.radius + node2.radius + margin;
+
+            if ((center1 - node2.center).squaredNorm() > d * d)
+            {
+                continue;
+            }
+
+            // descend into the larger sphere
+            if (node1.left >= 0 && (node2.left < 0 || node1.radius >= node2.radius))
+            {
+                stack.push_back(std::make_pair(node1.left, index2));
+                stack.push_back(std::make_pair(node1.right, index2));
+            }
+            else if (node2.left >= 0)
+            {
+                stack.push_back(std::make_pair(index1, node2.left));
+                stack.push_back(std::make_pair(index1, node2.right));
+            }
+            else
+            {
+                // two buckets
+                for (unsigned int i = node1.firstLeaf; i < node1.firstLeaf + node1.numLeaves; i++)
+                {
+                    Eigen::Vector3f leaf = rotation * Eigen::Vector3f(tree1.leafX[i], tree1.leafY[i], tree1.leafZ[i]) + translation;
+
+                    if (tree2.overlaps(node2, leaf, tree1.leafRadius[i] + margin) > 0)
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+    bool SphereTree::collidesLocal(const Eigen::Vector3f& point, float tolerance) const
+    {
+        if (nodes.empty())
+        {
+            return false;
+        }
+
+        int stack[64];
+        int size = 0;
+        stack[size++] = 0;
+
+        while (size > 0)
+        {
+            const Node& node = nodes[stack[--size]];
+            float d = node.radius + tolerance;
+
+            if ((point - node.center).squaredNorm() > d * d)
+            {
+                continue;
+            }
+
+            if (node.left < 0)
+            {
+                if (overlaps(node, point, tolerance) > 0)
+                {
+                    return true;
+                }
+            }
+            else
+            {
+                stack[size++] = node.left;
+                stack[size++] = node.right;
+            }
+        }
+
+        return false;
+    }
+
+    bool SphereTree::collides(const Eigen::Vector3f& point, const Eigen::Matrix4f& pose, float tolerance) const
+    {
+        Eigen::Matrix4f inverse = pose.inverse();
+        return collidesLocal(inverse.block<3, 3>(0, 0) * point + inverse.block<3, 1>(0, 3), tolerance);
+    }
+
+    bool SphereTree::collides(const std::vector<Eigen::Vector3f>& points, const Eigen::Matrix4f& pose, float tolerance) const
+    {
+        Eigen::Matrix4f inverse = pose.inverse();
+        Eigen::Matrix3f rotation = inverse.block<3, 3>(0, 0);
+        Eigen::Vector3f translation = inverse.block<3, 1>(0, 3);
+
+        for (const Eigen::Vector3f& p : points)
+        {
+            if (collidesLocal(rotation * p + translation, tolerance))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void SphereTree::traverse(const Eigen::Matrix4f& pose, const std::function<bool(const Eigen::Vector3f&, float, bool)>& visitor) const
+    {
+        if (nodes.empty())
+        {
+            return;
+        }
+
+        Eigen::Matrix3f rotation = pose.block<3, 3>(0, 0);
+        Eigen::Vector3f translation = pose.block<3, 1>(0, 3);
+        int stack[64];
+        int size = 0;
+        stack[size++] = 0;
+
+        while (size > 0)
+        {
+            const Node& node = nodes[stack[--size]];
+            bool leaf = node.left < 0 && node.numLeaves == 1;
+
+            if (!visitor(rotation * node.center + translation, node.radius, leaf) || leaf)
+            {
+                continue;
+            }
+
+            if (node.left >= 0)
+            {
+                stack[size++] = node.right;
+                stack[size++] = node.left;
+                continue;
+            }
+
+            for (unsigned int i = node.firstLeaf; i < node.firstLeaf + node.numLeaves; i++)
+            {
+                visitor(rotation * Eigen::Vector3f(leafX[i], leafY[i], leafZ[i]) + translation, leafRadius[i], true);
+            }
+        }
+    }
+
+    size_t SphereTree::getNumLeaves() const
+    {
+        return leafRadius.size();
+    }
+
+    size_t SphereTree::getNumNodes() const
+    {
+        return nodes.size();
+    }
+
+    Eigen::Vector3f SphereTree::getLeafCenter(size_t leaf) const
+    {
+        return Eigen::Vector3f(leafX.at(leaf), leafY.at(leaf), leafZ.at(leaf));
+    }
+
+    float SphereTree::getLeafRadius(size_t leaf) const
+    {
+        return leafRadius.at(leaf);
+    }
+
+    float SphereTree::getMaxLeafRadius() const
+    {
+        return maxLeafRadius;
+    }
+
+} // namespace VirtualRobot
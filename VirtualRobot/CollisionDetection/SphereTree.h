@@ -0,0 +1,110 @@
+/**
+* This file is part of Simox.
+*
+* Simox is free software; you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 2 of
+* the License, or (at your option) any later version.
+*
+* Simox is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*
+*/
+#pragma once
+
+#include "../VirtualRobot.h"
+
+#include <Eigen/Core>
+
+#include <functional>
+#include <vector>
+
+namespace VirtualRobot
+{
+    /*!
+        A hierarchy of bounding spheres around the triangles of a mesh, for fast and conservative collision checks.
+
+        Triangles are subdivided until they fit into spheres of the given maximum radius. The pieces are split
+        recursively at the median of their centroids along the longest axis, until the bounding sphere of a node
+        is smaller than the maximum radius; such nodes become the leaf spheres. Nodes with a few leaves are stored
+        as buckets, whose leaves are tested against a sphere in one loop over contiguous arrays of coordinates,
+        which the compiler vectorizes.
+
+        Since each leaf sphere encloses its triangles, two meshes whose triangles intersect always have overlapping leaves:
+        The checks never miss a collision that CollisionChecker would report, but report collisions
+        for meshes that are closer than about twice the leaf radius.
+        The tree is given in the local coordinate system of the mesh, poses are passed to the queries.
+    */
+    class VIRTUAL_ROBOT_IMPORT_EXPORT SphereTree
+    {
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        /*!
+            Builds the tree of a mesh.
+            \param maxLeafRadius The maximum radius of the leaf spheres [mm], it has to be positive.
+        */
+        static SphereTreePtr Create(const TriMeshModel& mesh, float maxLeafRadius);
+
+        /*!
+            Checks if leaf spheres of the two trees overlap.
+            \param margin The spheres are enlarged by this distance, i.e. trees closer than margin are reported as colliding.
+        */
+        static bool Collide(const SphereTree& tree1, const Eigen::Matrix4f& pose1, const SphereTree& tree2, const Eigen::Matrix4f& pose2, float margin = 0.0f);
+
+        //! Checks if a point (in global coordinates) is closer than tolerance to a leaf sphere.
+        bool collides(const Eigen::Vector3f& point, const Eigen::Matrix4f& pose, float tolerance = 0.0f) const;
+
+        //! Checks if one of the points is closer than tolerance to a leaf sphere.
+        bool collides(const std::vector<Eigen::Vector3f>& points, const Eigen::Matrix4f& pose, float tolerance = 0.0f) const;
+
+        /*!
+            Visits the spheres depth first, with their centers in global coordinates.
+            The visitor is called with the center, the radius and whether the sphere is a leaf.
+            The children of a sphere are only visited if the visitor returns true for it.
+        */
+        void traverse(const Eigen::Matrix4f& pose, const std::function<bool(const Eigen::Vector3f&, float, bool)>& visitor) const;
+
+        size_t getNumLeaves() const;
+        size_t getNumNodes() const;
+        Eigen::Vector3f getLeafCenter(size_t leaf) const;
+        float getLeafRadius(size_t leaf) const;
+        float getMaxLeafRadius() const;
+
+    protected:
+        SphereTree();
+
+        struct Node
+        {
+            Eigen::Vector3f center;
+            float radius;
+            int left; // -1 for buckets
+            int right;
+            unsigned int firstLeaf;
+            unsigned int numLeaves;
+        };
+
+        struct Piece;
+        int build(std::vector<Piece>& pieces, size_t begin, size_t end);
+
+        bool collidesLocal(const Eigen::Vector3f& point, float tolerance) const;
+        // number of leaves of a bucket that overlap the sphere
+        int overlaps(const Node& bucket, const Eigen::Vector3f& center, float radius) const;
+
+        float maxLeafRadius;
+        std::vector<Node> nodes;
+        std::vector<float> leafX;
+        std::vector<float> leafY;
+        std::vector<float> leafZ;
+        std::vector<float> leafRadius;
+    };
+
+} // namespace VirtualRobot
@@ -8,11 +8,14 @@
 #include <VirtualRobot/XML/RobotIO.h>
 #include <VirtualRobot/RuntimeEnvironment.h>
 #include <VirtualRobot/Units.h>
+#include <VirtualRobot/Tools/ParallelTools.h>
 
 #include <Eigen/Dense>
 
 #include <math.h>
 
+#include <algorithm>
+
 #include <string>
 #include <iostream>
 
@@ -51,59 +54,175 @@ VirtualRobot::Dynamics::Dynamics(RobotNodeSetPtr rns) : rns(rns)
 
     //Dynamics::toRBDLRecursive(model, root, root->getGlobalPose(), Eigen::Matrix4f::Identity());
     Dynamics::toRBDL(model, root);
+    zeroVector = Eigen::VectorXd::Zero(model->dof_count);
+
+    // the Coriolis torques are the nonlinear effects without gravity, a separate copy keeps the gravity of the model untouched
+    coriolisModel = boost::shared_ptr<RigidBodyDynamics::Model>(new Model(*model));
+    coriolisModel->gravity.setZero();
 }
 
-Eigen::VectorXd Dynamics::getInverseDynamics(Eigen::VectorXd q, Eigen::VectorXd qdot, Eigen::VectorXd qddot)
+Eigen::VectorXd Dynamics::getInverseDynamics(const Eigen::VectorXd& q, const Eigen::VectorXd& qdot, const Eigen::VectorXd& qddot)
 {
     Eigen::VectorXd tau = Eigen::VectorXd::Zero(Dynamics::model->dof_count);
-    InverseDynamics(*model.get(), q, qdot, qddot, tau);
+    getInverseDynamics(q, qdot, qddot, tau);
     return tau;
 }
 
-Eigen::VectorXd Dynamics::getForwardDynamics(Eigen::VectorXd q, Eigen::VectorXd qdot, Eigen::VectorXd tau)
+Eigen::VectorXd Dynamics::getForwardDynamics(const Eigen::VectorXd& q, const Eigen::VectorXd& qdot, const Eigen::VectorXd& tau)
 {
     Eigen::VectorXd qddot = Eigen::VectorXd::Zero(Dynamics::model->dof_count);
-    ForwardDynamics(*model.get(), q, qdot, tau, qddot);
+    getForwardDynamics(q, qdot, tau, qddot);
     return qddot;
 }
 
 
-Eigen::VectorXd Dynamics::getGravityMatrix(Eigen::VectorXd q, int nDof)
+Eigen::VectorXd Dynamics::getGravityMatrix(const Eigen::VectorXd& q, int /*nDof*/)
 {
-
-    Eigen::VectorXd qdot = Eigen::VectorXd::Zero(nDof);
-    Eigen::VectorXd qddot = Eigen::VectorXd::Zero(nDof);
-
-    Eigen::VectorXd tauGravity = Eigen::VectorXd::Zero(Dynamics::model->dof_count);
-    InverseDynamics(*model.get(), q, qdot, qddot, tauGravity);
+    Eigen::VectorXd tauGravity = Eigen::VectorXd::Zero(model->dof_count);
+    getGravityMatrix(q, tauGravity);
     return tauGravity;
 }
 
-Eigen::VectorXd Dynamics::getCoriolisMatrix(Eigen::VectorXd q, Eigen::VectorXd qdot, int nDof)
+Eigen::VectorXd Dynamics::getCoriolisMatrix(const Eigen::VectorXd& q, const Eigen::VectorXd& qdot, int /*nDof*/)
 {
+    Eigen::VectorXd tauCoriolis = Eigen::VectorXd::Zero(model->dof_count);
+    getCoriolisMatrix(q, qdot, tauCoriolis);
+    return tauCoriolis;
+}
 
-    Eigen::VectorXd qddot = Eigen::VectorXd::Zero(nDof);
-    Eigen::VectorXd tauGravity = getGravityMatrix(q, nDof);
-    Eigen::VectorXd tau = Eigen::VectorXd::Zero(Dynamics::model->dof_count);
 
-    Eigen::MatrixXd tauCoriolis = Eigen::VectorXd::Zero(Dynamics::model->dof_count);
+
+Eigen::MatrixXd Dynamics::getInertiaMatrix(const Eigen::VectorXd& q)
+{
+    Eigen::MatrixXd inertia = Eigen::MatrixXd::Zero(model->dof_count, model->dof_count);
+    getInertiaMatrix(q, inertia);
+    return inertia;
+}
+
+void Dynamics::getInverseDynamics(const Eigen::VectorXd& q, const Eigen::VectorXd& qdot, const Eigen::VectorXd& qddot, Eigen::VectorXd& tau)
+{
     InverseDynamics(*model.get(), q, qdot, qddot, tau);
-    tauCoriolis = tau - tauGravity;
-    return tauCoriolis;
 }
 
+void Dynamics::getForwardDynamics(const Eigen::VectorXd& q, const Eigen::VectorXd& qdot, const Eigen::VectorXd& tau, Eigen::VectorXd& qddot)
+{
+    ForwardDynamics(*model.get(), q, qdot, tau, qddot);
+}
 
+void Dynamics::getGravityMatrix(const Eigen::VectorXd& q, Eigen::VectorXd& tauGravity)
+{
+    THROW_VR_EXCEPTION_IF(tauGravity.rows() != (int)model->dof_count, "Output vector has to be sized to the number of DoF");
+    // without velocities, the nonlinear effects are the gravity torques
+    NonlinearEffects(*model.get(), q, zeroVector, tauGravity);
+}
 
-Eigen::MatrixXd Dynamics::getInertiaMatrix(Eigen::VectorXd q)
+void Dynamics::getCoriolisMatrix(const Eigen::VectorXd& q, const Eigen::VectorXd& qdot, Eigen::VectorXd& tauCoriolis)
 {
-    Eigen::MatrixXd inertia = Eigen::MatrixXd::Zero(model->dof_count, model->dof_count);
+    THROW_VR_EXCEPTION_IF(tauCoriolis.rows() != (int)model->dof_count, "Output vector has to be sized to the number of DoF");
+    // without gravity, the nonlinear effects are the Coriolis and centrifugal torques
+    NonlinearEffects(*coriolisModel.get(), q, qdot, tauCoriolis);
+}
+
+void Dynamics::getNonlinearEffects(const Eigen::VectorXd& q, const Eigen::VectorXd& qdot, Eigen::VectorXd& tau)
+{
+    NonlinearEffects(*model.get(), q, qdot, tau);
+}
+
+void Dynamics::getInertiaMatrix(const Eigen::VectorXd& q, Eigen::MatrixXd& inertia)
+{
+    // the CRBA only writes the non-zero entries
+    inertia.setZero();
     CompositeRigidBodyAlgorithm(*model.get(), q, inertia);
-    return inertia;
+}
+
+std::vector<Model*> Dynamics::getThreadModels(unsigned int numThreads)
+{
+    while (threadModels.size() + 1 < numThreads)
+    {
+        threadModels.push_back(boost::shared_ptr<Model>(new Model(*model)));
+    }
+
+    std::vector<Model*> result(1, model.get());
+
+    for (unsigned int i = 1; i < numThreads; i++)
+    {
+        result.push_back(threadModels[i - 1].get());
+    }
+
+    return result;
+}
+
+template<typename Function>
+void Dynamics::runBatch(size_t numSamples, unsigned int numThreads, Function f)
+{
+    numThreads = (unsigned int)std::min<size_t>(ParallelTools::getNumThreads(numThreads), numSamples);
+
+    if (numThreads <= 1)
+    {
+        f(*model.get(), 0, numSamples);
+        return;
+    }
+
+    // one block of samples per thread, block t exclusively works on model t
+    std::vector<Model*> models = getThreadModels(numThreads);
+
+    ParallelTools::runParallel(numThreads, numThreads, [&](size_t t)
+    {
+        f(*models[t], numSamples * t / numThreads, numSamples * (t + 1) / numThreads);
+    });
+}
+
+void Dynamics::getInverseDynamics(const Eigen::MatrixXd& q, const Eigen::MatrixXd& qdot, const Eigen::MatrixXd& qddot, Eigen::MatrixXd& tau, unsigned int numThreads)
+{
+    THROW_VR_EXCEPTION_IF(q.rows() != model->dof_count || qdot.rows() != q.rows() || qddot.rows() != q.rows(), "Dimension mismatch");
+    THROW_VR_EXCEPTION_IF(qdot.cols() != q.cols() || qddot.cols() != q.cols(), "Number of samples mismatch");
+    tau.resize(q.rows(), q.cols());
+
+    runBatch(q.cols(), numThreads, [&](Model & m, size_t begin, size_t end)
+    {
+        // per thread buffers, RBDL expects plain vectors
+        Eigen::VectorXd qi(q.rows()), qdoti(q.rows()), qddoti(q.rows()), taui(q.rows());
+
+        for (size_t i = begin; i < end; i++)
+        {
+            qi = q.col(i);
+            qdoti = qdot.col(i);
+            qddoti = qddot.col(i);
+            InverseDynamics(m, qi, qdoti, qddoti, taui);
+            tau.col(i) = taui;
+        }
+    });
+}
+
+void Dynamics::getForwardDynamics(const Eigen::MatrixXd& q, const Eigen::MatrixXd& qdot, const Eigen::MatrixXd& tau, Eigen::MatrixXd& qddot, unsigned int numThreads)
+{
+    THROW_VR_EXCEPTION_IF(q.rows() != model->dof_count || qdot.rows() != q.rows() || tau.rows() != q.rows(), "Dimension mismatch");
+    THROW_VR_EXCEPTION_IF(qdot.cols() != q.cols() || tau.cols() != q.cols(), "Number of samples mismatch");
+    qddot.resize(q.rows(), q.cols());
+
+    runBatch(q.cols(), numThreads, [&](Model & m, size_t begin, size_t end)
+    {
+        Eigen::VectorXd qi(q.rows()), qdoti(q.rows()), taui(q.rows()), qddoti(q.rows());
+
+        for (size_t i = begin; i < end; i++)
+        {
+            qi = q.col(i);
+            qdoti = qdot.col(i);
+            taui = tau.col(i);
+            ForwardDynamics(m, qi, qdoti, taui, qddoti);
+            qddot.col(i) = qddoti;
+        }
+    });
 }
 
 void Dynamics::setGravity(Eigen::Vector3d gravity)
 {
     model->gravity = gravity;
+
+    for (auto& m : threadModels)
+    {
+        m->gravity = gravity;
+    }
 }
 
 int Dynamics::getnDoF()
@@ -6,6 +6,8 @@
 #include "../RobotNodeSet.h"
 #include <rbdl/rbdl.h>
 
+#include <vector>
+
 
 namespace VirtualRobot
 {
@@ -23,15 +25,33 @@ namespace VirtualRobot
         ///
         Dynamics(RobotNodeSetPtr rns);
         /// Calculates the Inverse Dynamics for given motion state defined by q, qdot and qddot
-        Eigen::VectorXd getInverseDynamics(Eigen::VectorXd q, Eigen::VectorXd qdot, Eigen::VectorXd qddot);
+        Eigen::VectorXd getInverseDynamics(const Eigen::VectorXd& q, const Eigen::VectorXd& qdot, const Eigen::VectorXd& qddot);
         /// Calculates the joint space inertia matrix given a joint position vector q
-        Eigen::VectorXd getGravityMatrix(Eigen::VectorXd q, int nDof);
+        Eigen::VectorXd getGravityMatrix(const Eigen::VectorXd& q, int nDof);
         /// Calculates the joint space Gravity Matrix given a joint position vector q and Number of DOF
-        Eigen::VectorXd getCoriolisMatrix(Eigen::VectorXd q, Eigen::VectorXd qdot, int nDof);
+        Eigen::VectorXd getCoriolisMatrix(const Eigen::VectorXd& q, const Eigen::VectorXd& qdot, int nDof);
         /// Calculates the coriolis matrix given position vector q, velocity vector qdot and Number of DOF
-        Eigen::VectorXd getForwardDynamics(Eigen::VectorXd q, Eigen::VectorXd qdot, Eigen::VectorXd tau);
+        Eigen::VectorXd getForwardDynamics(const Eigen::VectorXd& q, const Eigen::VectorXd& qdot, const Eigen::VectorXd& tau);
         /// Calculates forward dynamics given position vector q velocity vector qdot and joint torques tau
-        Eigen::MatrixXd getInertiaMatrix(Eigen::VectorXd q);
+        Eigen::MatrixXd getInertiaMatrix(const Eigen::VectorXd& q);
+
+        /// In-place versions of the methods above, the results have to be sized to the number of DOF, no memory is allocated.
+        void getInverseDynamics(const Eigen::VectorXd& q, const Eigen::VectorXd& qdot, const Eigen::VectorXd& qddot, Eigen::VectorXd& tau);
+        void getForwardDynamics(const Eigen::VectorXd& q, const Eigen::VectorXd& qdot, const Eigen::VectorXd& tau, Eigen::VectorXd& qddot);
+        void getGravityMatrix(const Eigen::VectorXd& q, Eigen::VectorXd& tauGravity);
+        /// Computes the Coriolis and centrifugal torques with a single pass on a gravity free copy of the model.
+        void getCoriolisMatrix(const Eigen::VectorXd& q, const Eigen::VectorXd& qdot, Eigen::VectorXd& tauCoriolis);
+        /// Computes gravity plus Coriolis and centrifugal torques with a single pass.
+        void getNonlinearEffects(const Eigen::VectorXd& q, const Eigen::VectorXd& qdot, Eigen::VectorXd& tau);
+        void getInertiaMatrix(const Eigen::VectorXd& q, Eigen::MatrixXd& inertia);
+
+        /// Batch inverse dynamics for whole trajectories: column i of q, qdot and qddot defines sample i, column i of tau receives its torques.
+        /// The samples are distributed to numThreads threads (0: hardware concurrency), each of them works on its own copy of the RBDL model.
+        /// The copies are kept and reused by subsequent calls.
+        void getInverseDynamics(const Eigen::MatrixXd& q, const Eigen::MatrixXd& qdot, const Eigen::MatrixXd& qddot, Eigen::MatrixXd& tau, unsigned int numThreads = 0);
+        /// Batch forward dynamics, see batch inverse dynamics.
+        void getForwardDynamics(const Eigen::MatrixXd& q, const Eigen::MatrixXd& qdot, const Eigen::MatrixXd& tau, Eigen::MatrixXd& qddot, unsigned int numThreads = 0);
+
         /// Sets the gravity vector of the dynamics system
         void setGravity(Eigen::Vector3d gravity);
         /// returns the number of Degrees of Freedom of the dynamics system
@@ -51,6 +71,16 @@ namespace VirtualRobot
         std::map<std::string,  int> identifierMap;
 
         RobotNodePtr checkForConnectedMass(RobotNodePtr node);
+
+        /// Returns numThreads RBDL models, the first one is the model itself and the others are (cached) copies of it.
+        std::vector<RigidBodyDynamics::Model*> getThreadModels(unsigned int numThreads);
+
+        template<typename Function>
+        void runBatch(size_t numSamples, unsigned int numThreads, Function f);
+
+        std::vector<boost::shared_ptr<RigidBodyDynamics::Model>> threadModels;
+        boost::shared_ptr<RigidBodyDynamics::Model> coriolisModel;
+        Eigen::VectorXd zeroVector;
     private:
         void toRBDL(boost::shared_ptr<RigidBodyDynamics::Model> model, RobotNodePtr node, RobotNodePtr parentNode = RobotNodePtr(), int parentID = 0);
         void toRBDLRecursive(boost::shared_ptr<RigidBodyDynamics::Model> model, RobotNodePtr currentNode, Eigen::Matrix4f accumulatedTransformPreJoint, Eigen::Matrix4f accumulatedTransformPostJoint, RobotNodePtr jointNode = RobotNodePtr(), int parentID = 0);
@@ -11,6 +11,7 @@
 #include <VirtualRobot/RuntimeEnvironment.h>
 #include <VirtualRobot/XML/RobotIO.h>
 #include <VirtualRobot/Robot.h>
+#include <VirtualRobot/VirtualRobotException.h>
 #include <VirtualRobot/RobotNodeSet.h>
 #include <Eigen/Core>
 
@@ -35,4 +36,47 @@ BOOST_AUTO_TEST_CASE(testRBDLConvertRobot)
 
 }
 
+BOOST_AUTO_TEST_CASE(testRBDLBatchDynamics)
+{
+    std::string robFile = "robots/ArmarIII/ArmarIII.xml";
+    bool fileOK = RuntimeEnvironment::getDataFileAbsolute(robFile);
+    BOOST_REQUIRE(fileOK);
+    RobotPtr robot = RobotIO::loadRobot(robFile);
+    BOOST_REQUIRE(robot);
+    Dynamics dynamics(robot->getRobotNodeSet("LeftArm"));
+    int nDof = dynamics.getnDoF();
+    BOOST_REQUIRE_GT(nDof, 0);
+
+    const int numSamples = 200;
+    Eigen::MatrixXd q = Eigen::MatrixXd::Random(nDof, numSamples);
+    Eigen::MatrixXd qdot = Eigen::MatrixXd::Random(nDof, numSamples);
+    Eigen::MatrixXd qddot = Eigen::MatrixXd::Random(nDof, numSamples);
+
+    Eigen::MatrixXd tau;
+    dynamics.getInverseDynamics(q, qdot, qddot, tau, 4);
+    BOOST_REQUIRE_EQUAL(tau.cols(), numSamples);
+
+    Eigen::MatrixXd qddotFD;
+    dynamics.getForwardDynamics(q, qdot, tau, qddotFD, 3);
+
+    Eigen::VectorXd gravity(nDof), coriolis(nDof), nonlinear(nDof);
+
+    for (int i = 0; i < numSamples; i++)
+    {
+        Eigen::VectorXd tauSingle = dynamics.getInverseDynamics(q.col(i), qdot.col(i), qddot.col(i));
+        BOOST_CHECK_SMALL((tauSingle - tau.col(i)).norm(), 1e-9);
+        BOOST_CHECK_SMALL((qddotFD.col(i) - qddot.col(i)).norm(), 1e-6);
+
+        dynamics.getGravityMatrix(q.col(i), gravity);
+        dynamics.getCoriolisMatrix(q.col(i), qdot.col(i), coriolis);
+        dynamics.getNonlinearEffects(q.col(i), qdot.col(i), nonlinear);
+        BOOST_CHECK_SMALL((gravity + coriolis - nonlinear).norm(), 1e-9);
+        BOOST_CHECK_SMALL((gravity - dynamics.getGravityMatrix(q.col(i), nDof)).norm(), 1e-9);
+    }
+
+    Eigen::VectorXd wrongSize(nDof + 1);
+    BOOST_CHECK_THROW(dynamics.getGravityMatrix(q.col(0), wrongSize), VirtualRobotException);
+    BOOST_CHECK_THROW(dynamics.getCoriolisMatrix(q.col(0), qdot.col(0), wrongSize), VirtualRobotException);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -13,7 +13,13 @@
 #include "../SceneObject.h"
 #include "../RobotConfig.h"
 #include "../CollisionDetection/CollisionChecker.h"
+#include "../CollisionDetection/CollisionModel.h"
+#include "../Nodes/RobotNode.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <set>
 
 
 namespace VirtualRobot
@@ -24,7 +30,9 @@ namespace VirtualRobot
         actors(actorsVector),
         statics(staticPartVector),
         baseNode(baseNodePtr),
-        tcpNode(tcpNodePtr)
+        tcpNode(tcpNodePtr),
+        adaptiveClosing(false),
+        adaptiveClosingTolerance(0.002f)
     {
         THROW_VR_EXCEPTION_IF(!baseNode, "NULL base node not allowed!");
         THROW_VR_EXCEPTION_IF(!tcpNode, "NULL tcp node not allowed!");
@@ -86,6 +94,7 @@ namespace VirtualRobot
 
 
         EndEffectorPtr eef(new EndEffector(name, newActors, newStatics, newBase, newTCP, newGCP, newPreshapes));
+        eef->setAdaptiveClosing(adaptiveClosing, adaptiveClosingTolerance);
         newRobot->registerEndEffector(eef);
 
         // set current config to new eef
@@ -113,6 +122,13 @@ namespace VirtualRobot
 
     EndEffector::ContactInfoVector EndEffector::closeActors(SceneObjectSetPtr obstacles, float stepSize)
     {
+        if (adaptiveClosing && stepSize > 0)
+        {
+            // move close to the contacts with few distance queries, the remaining fine steps locate the contacts
+            advanceActors(obstacles);
+            stepSize = adaptiveClosingTolerance;
+        }
+
         std::vector<char> actorCollisionStatus(actors.size(), false);
         EndEffector::ContactInfoVector result;
 
@@ -168,6 +184,359 @@ namespace VirtualRobot
     }
 
 
+    void EndEffector::advanceActors(SceneObjectSetPtr obstacles)
+    {
+        RobotPtr robot = getRobot();
+        VR_ASSERT(robot);
+        CollisionCheckerPtr colChecker = getCollisionChecker();
+        const size_t nActors = actors.size();
+        const float tolerance = adaptiveClosingTolerance;
+
+        // A collision model that is considered while closing.
+        // The motion of its points is accumulated, it consumes the distances that were queried before.
+        struct Body
+        {
+            SceneObjectPtr object;
+            float motion;
+        };
+
+        // A link of an actor. Its points move by at most bound, when the actor moves by one unit.
+        struct Link
+        {
+            size_t body;
+            std::vector<std::pair<size_t, float> > joints;   // the joints of the actor that move the link and their lever arms
+            float bound;
+        };
+
+        // A link and a body it must not penetrate, with the last queried distance
+        struct Pair
+        {
+            size_t link;
+            size_t body;
+            int otherActor;     // the actor of body, -1 for obstacles and static parts
+            size_t otherLink;
+            float distance;
+            float motion;
+        };
+
+        std::vector<Body> bodies;
+        std::vector<std::vector<EndEffectorActor::ActorDefinition> > definitions(nActors);
+        std::vector<std::vector<Link> > links(nActors);
+        std::vector<std::vector<Pair> > pairs(nActors);
+        std::vector<size_t> obstacleBodies;
+        std::vector<size_t> staticBodies;
+
+        auto addBody = [&](const SceneObjectPtr & object)
+        {
+            bodies.push_back({object, 0.0f});
+            return bodies.size() - 1;
+        };
+
+        if (obstacles)
+        {
+            for (const SceneObjectPtr& so : obstacles->getSceneObjects())
+            {
+                if (so->getCollisionModel())
+                {
+                    obstacleBodies.push_back(addBody(so));
+                }
+            }
+        }
+
+        for (const RobotNodePtr& node : statics)
+        {
+            if (node->getCollisionModel())
+            {
+                staticBodies.push_back(addBody(node));
+            }
+        }
+
+        /*
+            A joint rotates a point by at most its distance to the joint times the angle.
+            These distances are accumulated along the kinematic chain, hence the lever arms hold for all joint values.
+        */
+        for (size_t i = 0; i < nActors; i++)
+        {
+            definitions[i] = actors[i]->getDefinition();
+
+            for (const EndEffectorActor::ActorDefinition& d : definitions[i])
+            {
+                CollisionModelPtr colModel = d.robotNode->getCollisionModel();
+
+                if (d.colMode == EndEffectorActor::eNone || !colModel)
+                {
+                    continue;
+                }
+
+                Link link;
+                link.body = addBody(d.robotNode);
+                link.bound = 0.0f;
+
+                const Eigen::Vector3f origin = d.robotNode->getGlobalPose().block<3, 1>(0, 3);
+                float radius = 0.0f;
+
+                for (const Eigen::Vector3f& corner : colModel->getBoundingBox(false).getPoints())
+                {
+                    radius = std::max(radius, ((colModel->getGlobalPose() * corner.homogeneous()).head<3>() - origin).norm());
+                }
+
+                SceneObjectPtr current = d.robotNode;
+
+                while (current)
+                {
+                    RobotNodePtr node = boost::dynamic_pointer_cast<RobotNode>(current);
+
+                    for (size_t k = 0; node && k < definitions[i].size(); k++)
+                    {
+                        if (definitions[i][k].robotNode == node && definitions[i][k].directionAndSpeed != 0.0f)
+                        {
+                            link.joints.push_back(std::make_pair(k, node->isTranslationalJoint() ? 1.0f : radius));
+                        }
+                    }
+
+                    SceneObjectPtr parent = current->getParent();
+
+                    if (!parent)
+                    {
+                        break;
+                    }
+
+                    radius += (current->getGlobalPose().block<3, 1>(0, 3) - parent->getGlobalPose().block<3, 1>(0, 3)).norm();
+
+                    if (node && node->isTranslationalJoint())
+                    {
+                        radius += std::fabs(node->getJointLimitHi() - node->getJointLimitLo());
+                    }
+
+                    current = parent;
+                }
+
+                links[i].push_back(link);
+            }
+        }
+
+        // the same pairs are checked as in EndEffectorActor::moveActorCheckCollision
+        for (size_t i = 0; i < nActors; i++)
+        {
+            size_t l = 0;
+
+            for (const EndEffectorActor::ActorDefinition& d : definitions[i])
+            {
+                if (d.colMode == EndEffectorActor::eNone || !d.robotNode->getCollisionModel())
+                {
+                    continue;
+                }
+
+                for (size_t body : obstacleBodies)
+                {
+                    pairs[i].push_back({l, body, -1, 0, -1.0f, 0.0f});
+                }
+
+                if (d.colMode & EndEffectorActor::eActors)
+                {
+                    for (size_t j = 0; j < nActors; j++)
+                    {
+                        for (size_t m = 0; j != i && m < links[j].size(); m++)
+                        {
+                            pairs[i].push_back({l, links[j][m].body, int(j), m, -1.0f, 0.0f});
+                        }
+                    }
+                }
+
+                if (d.colMode & EndEffectorActor::eStatic)
+                {
+                    for (size_t body : staticBodies)
+                    {
+                        pairs[i].push_back({l, body, -1, 0, -1.0f, 0.0f});
+                    }
+                }
+
+                l++;
+            }
+        }
+
+        // the step of the actor until the joint hits its limit
+        auto getRemainingStep = [](const EndEffectorActor::ActorDefinition& d)
+        {
+            if (d.directionAndSpeed == 0.0f)
+            {
+                return 0.0f;
+            }
+
+            float limit = d.directionAndSpeed > 0.0f ? d.robotNode->getJointLimitHi() : d.robotNode->getJointLimitLo();
+            float step = (limit - d.robotNode->getJointValue()) / d.directionAndSpeed;
+            return step > 1e-6f ? step : 0.0f;
+        };
+
+        auto updateBounds = [&](size_t i, const std::vector<char>& moving)
+        {
+            for (Link& link : links[i])
+            {
+                link.bound = 0.0f;
+
+                for (const std::pair<size_t, float>& joint : link.joints)
+                {
+                    if (moving[joint.first])
+                    {
+                        link.bound += std::fabs(definitions[i][joint.first].directionAndSpeed) * joint.second;
+                    }
+                }
+            }
+        };
+
+        std::vector<char> finished(nActors, false);
+
+        for (size_t i = 0; i < nActors; i++)
+        {
+            std::vector<char> moving(definitions[i].size());
+
+            for (size_t k = 0; k < moving.size(); k++)
+            {
+                moving[k] = getRemainingStep(definitions[i][k]) > 0.0f;
+            }
+
+            updateBounds(i, moving);
+        }
+
+        // The distance of the pair if it is below needed, otherwise a lower bound of at least needed.
+        // The exact distance is only queried if neither the bounding boxes nor the consumed cached distance exceed needed.
+        auto getDistance = [&](Pair& p, const Link& link, float needed)
+        {
+            const Body& a = bodies[link.body];
+            const Body& b = bodies[p.body];
+            float motion = a.motion + b.motion;
+
+            if (p.distance >= 0.0f && p.distance - (motion - p.motion) >= needed)
+            {
+                return p.distance - (motion - p.motion);
+            }
+
+            BoundingBox boxA = a.object->getCollisionModel()->getBoundingBox();
+            BoundingBox boxB = b.object->getCollisionModel()->getBoundingBox();
+            float boxDistance = (boxA.getMin() - boxB.getMax()).cwiseMax(boxB.getMin() - boxA.getMax()).cwiseMax(Eigen::Vector3f::Zero()).norm();
+
+            if (boxDistance >= needed)
+            {
+                return boxDistance;
+            }
+
+            p.distance = std::max(0.0f, colChecker->calculateDistance(a.object->getCollisionModel(), b.object->getCollisionModel()));
+            p.motion = motion;
+            return p.distance;
+        };
+
+        // the motion of both bodies of the pair, when the actor moves by one unit and the other actor moves as well
+        auto getPairBound = [&](const Pair& p, const Link& link)
+        {
+            bool otherMoving = p.otherActor >= 0 && !finished[p.otherActor];
+            return link.bound + (otherMoving ? links[p.otherActor][p.otherLink].bound : 0.0f);
+        };
+
+        std::vector<std::set<std::pair<size_t, size_t> > > touching(nActors);
+
+        // The actors are moved in turns, each by the largest step that is guaranteed to be collision free (conservative advancement).
+        // Links that are within tolerance of a contact block the joints that move them, the other joints of the actor keep moving.
+        while (std::find(finished.begin(), finished.end(), false) != finished.end())
+        {
+            for (size_t i = 0; i < nActors; i++)
+            {
+                if (finished[i])
+                {
+                    continue;
+                }
+
+                std::vector<char> moving(definitions[i].size());
+
+                for (size_t k = 0; k < moving.size(); k++)
+                {
+                    moving[k] = getRemainingStep(definitions[i][k]) > 0.0f;
+                }
+
+                updateBounds(i, moving);
+                touching[i].clear();
+
+                for (Pair& p : pairs[i])
+                {
+                    const Link& link = links[i][p.link];
+                    float bound = getPairBound(p, link);
+
+                    if (link.bound > 0.0f && getDistance(p, link, tolerance * bound) < tolerance * bound)
+                    {
+                        touching[i].insert(std::make_pair(link.body, p.body));
+                    }
+                }
+
+                for (const std::pair<size_t, size_t>& t : touching[i])
+                {
+                    for (const Link& link : links[i])
+                    {
+                        for (size_t j = 0; link.body == t.first && j < link.joints.size(); j++)
+                        {
+                            moving[link.joints[j].first] = false;
+                        }
+                    }
+                }
+
+                updateBounds(i, moving);
+                float step = std::numeric_limits<float>::max();
+
+                for (size_t k = 0; k < moving.size(); k++)
+                {
+                    if (moving[k])
+                    {
+                        step = std::min(step, getRemainingStep(definitions[i][k]));
+                    }
+                }
+
+                if (step == std::numeric_limits<float>::max())
+                {
+                    finished[i] = true;
+                    continue;
+                }
+
+                // the remaining pairs allow a step of at least tolerance
+                for (Pair& p : pairs[i])
+                {
+                    const Link& link = links[i][p.link];
+
+                    if (link.bound > 0.0f)
+                    {
+                        float bound = getPairBound(p, link);
+                        step = std::min(step, getDistance(p, link, step * bound) / bound);
+                    }
+                }
+
+                for (size_t k = 0; k < moving.size(); k++)
+                {
+                    const EndEffectorActor::ActorDefinition& d = definitions[i][k];
+
+                    if (moving[k])
+                    {
+                        float v = d.robotNode->getJointValue() + step * d.directionAndSpeed;
+                        robot->setJointValue(d.robotNode, std::max(d.robotNode->getJointLimitLo(), std::min(d.robotNode->getJointLimitHi(), v)));
+                    }
+                }
+
+                for (const Link& link : links[i])
+                {
+                    bodies[link.body].motion += step * link.bound;
+                }
+            }
+        }
+    }
+
+    void EndEffector::setAdaptiveClosing(bool enable, float tolerance)
+    {
+        THROW_VR_EXCEPTION_IF(enable && tolerance <= 0.0f, "The tolerance of adaptive closing must be positive");
+        adaptiveClosing = enable;
+        adaptiveClosingTolerance = tolerance;
+    }
+
+    bool EndEffector::isAdaptiveClosingEnabled() const
+    {
+        return adaptiveClosing;
+    }
+
     void EndEffector::openActors(SceneObjectSetPtr obstacles, float stepSize)
     {
         closeActors(obstacles, -stepSize);
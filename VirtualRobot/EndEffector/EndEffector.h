@@ -105,10 +105,28 @@ namespace VirtualRobot
         /*!
             Closes each actor until a joint limit is hit or a collision occurred.
             This method is intended for gripper or hand-like end-effectors.
+            If adaptive closing is enabled (see setAdaptiveClosing()), the actors are moved with distance guided steps.
         */
         ContactInfoVector closeActors(SceneObjectSetPtr obstacles = SceneObjectSetPtr(), float stepSize = 0.02);
         ContactInfoVector closeActors(SceneObjectPtr obstacle, float stepSize = 0.02);
 
+        /*!
+            Enables distance guided closing of the actors (conservative advancement).
+            By default, closeActors() moves each joint by stepSize and checks for collisions after every step, hence the
+            actors stop up to one step before the first contact. In adaptive mode, the actors are first moved in turns, all joints
+            of an actor together, by the largest step that is guaranteed to be collision free. It is derived from the distances of
+            the actor's links to the obstacles, the other actors and the static part, and an upper bound of the links' motion.
+            Distances are only queried when neither the bounding boxes nor the previously queried distances guarantee the step.
+            Links that come within tolerance of a contact block the joints that move them, the other joints keep moving.
+            Then the actors are closed with fixed steps of size tolerance, which locate the contacts after a few steps.
+            The result equals fixed steps of size tolerance, at a fraction of the collision queries.
+            In adaptive mode, stepSize is ignored. Opening (negative step sizes) always uses fixed steps.
+            \param enable Enable or disable adaptive closing.
+            \param tolerance The joint distance [rad or mm] of the stopped actors to the first contact.
+        */
+        void setAdaptiveClosing(bool enable, float tolerance = 0.002f);
+        bool isAdaptiveClosingEnabled() const;
+
         /*!
             Opens each actor until a joint limit is hit or a collision occurred.
             This method is intended for hand-like end-effectors.
@@ -182,6 +200,9 @@ namespace VirtualRobot
         int addStaticPartContacts(SceneObjectPtr obstacle, ContactInfoVector& contacts, const Eigen::Vector3f &approachDirGlobal, float maxDistance = 3.0f);
 
     private:
+        //! Moves the actors close to their contacts (see setAdaptiveClosing())
+        void advanceActors(SceneObjectSetPtr obstacles);
+
         std::string name;
         std::vector<EndEffectorActorPtr> actors;
         std::vector<RobotNodePtr> statics;
@@ -189,6 +210,9 @@ namespace VirtualRobot
         RobotNodePtr baseNode;
         RobotNodePtr tcpNode;
         RobotNodePtr gcpNode;
+
+        bool adaptiveClosing;
+        float adaptiveClosingTolerance;
     };
 
 } // namespace VirtualRobot
@@ -3,10 +3,15 @@
 #include "../RobotConfig.h"
 #include "..//Robot.h"
 #include "../VirtualRobotException.h"
+#include <atomic>
 #include <iomanip>
 
 namespace VirtualRobot
 {
+    namespace
+    {
+        std::atomic<unsigned int> nameRevision(0);
+    }
 
 
     Grasp::Grasp(const std::string& name, const std::string& robotType, const std::string& eef,
@@ -97,6 +102,12 @@ namespace VirtualRobot
     void Grasp::setName(const std::string& name)
     {
         this->name = name;
+        nameRevision++;
+    }
+
+    unsigned int Grasp::GetNameRevision()
+    {
+        return nameRevision;
     }
 
     std::string Grasp::toXML(int tabs) const
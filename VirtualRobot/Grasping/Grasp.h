@@ -60,6 +60,12 @@ namespace VirtualRobot
         void print(bool printDecoration = true) const;
 
         void setName(const std::string& name);
+
+        /*!
+            A counter, which is increased whenever a grasp is renamed. GraspSet uses it to keep its name index up to date.
+        */
+        static unsigned int GetNameRevision();
+
         void setPreshape(const std::string& preshapeName);
 
         /*!
@@ -0,0 +1,246 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+#include "GraspIndex.h"
+#include "GraspSet.h"
+#include <VirtualRobot/VirtualRobotException.h>
+#include "../DataStructures/nanoflann.hpp"
+
+#include <Eigen/Geometry>
+#include <Eigen/StdVector>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <unordered_map>
+
+namespace VirtualRobot
+{
+    namespace
+    {
+        const int dimensions = 7;
+
+        // position and weighted quaternion, the quaternion is negated if w is negative
+        void getPoint(const Eigen::Matrix4f& pose, float quaternionScale, float* point, bool negate = false)
+        {
+            Eigen::Quaternionf q(Eigen::Matrix3f(pose.block<3, 3>(0, 0)));
+            q.normalize();
+            float scale = (q.w() < 0) != negate ? -quaternionScale : quaternionScale;
+            point[0] = pose(0, 3);
+            point[1] = pose(1, 3);
+            point[2] = pose(2, 3);
+            point[3] = scale * q.x();
+            point[4] = scale * q.y();
+            point[5] = scale * q.z();
+            point[6] = scale * q.w();
+        }
+
+        float getSquaredDistance(const float* a, const float* b)
+        {
+            float result = 0.0f;
+
+            for (int i = 0; i < dimensions; i++)
+            {
+                result += (a[i] - b[i]) * (a[i] - b[i]);
+            }
+
+            return result;
+        }
+    }
+
+    // the points are stored contiguously and serve as nanoflann dataset
+    struct GraspIndex::KdTree
+    {
+        typedef nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Simple_Adaptor<float, KdTree>, KdTree, dimensions, unsigned int> Index;
+
+        std::vector<float> points;
+        std::unique_ptr<Index> index;
+
+        size_t kdtree_get_point_count() const
+        {
+            return points.size() / dimensions;
+        }
+
+        float kdtree_distance(const float* p, const size_t idx, size_t /*size*/) const
+        {
+            return getSquaredDistance(p, &points[dimensions * idx]);
+        }
+
+        float kdtree_get_pt(const size_t idx, int dim) const
+        {
+            return points[dimensions * idx + dim];
+        }
+
+        template <class BBOX>
+        bool kdtree_get_bbox(BBOX& /*bb*/) const
+        {
+            return false;
+        }
+    };
+
+
+    GraspIndex::GraspIndex(GraspSetPtr grasps, float rotationWeight)
+        : grasps(grasps), rotationWeight(rotationWeight)
+    {
+        THROW_VR_EXCEPTION_IF(!grasps, "NULL grasp set");
+        THROW_VR_EXCEPTION_IF(rotationWeight < 0, "Negative rotation weight");
+        rebuild();
+    }
+
+    GraspIndex::~GraspIndex()
+    = default;
+
+    void GraspIndex::rebuild()
+    {
+        std::vector< Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f> > poses;
+        grasps->getTcpPosesGlobal(Eigen::Matrix4f::Identity(), poses);
+
+        tree.reset(new KdTree());
+        tree->points.resize(dimensions * poses.size());
+
+        for (size_t i = 0; i < poses.size(); i++)
+        {
+            getPoint(poses[i], 2.0f * rotationWeight, &tree->points[dimensions * i]);
+        }
+
+        if (!poses.empty())
+        {
+            tree->index.reset(new KdTree::Index(dimensions, *tree, nanoflann::KDTreeSingleIndexAdaptorParams(10)));
+            tree->index->buildIndex();
+        }
+    }
+
+    GraspSetPtr GraspIndex::getGraspSet()
+    {
+        return grasps;
+    }
+
+    float GraspIndex::getRotationWeight() const
+    {
+        return rotationWeight;
+    }
+
+    unsigned int GraspIndex::getSize() const
+    {
+        return (unsigned int)tree->kdtree_get_point_count();
+    }
+
+    std::vector<GraspIndex::Neighbor> GraspIndex::getNearestGrasps(const Eigen::Matrix4f& tcpPose, size_t k) const
+    {
+        std::vector<Neighbor> result;
+        k = std::min(k, tree->kdtree_get_point_count());
+
+        if (k == 0)
+        {
+            return result;
+        }
+
+        float query[dimensions];
+        std::vector<unsigned int> indices(k);
+        std::vector<float> distances(k);
+        std::unordered_map<unsigned int, float> found;
+
+        // the stored quaternions have a positive w, the negated query quaternion is only searched if it can be closer
+        for (bool negate : {false, true})
+        {
+            getPoint(tcpPose, 2.0f * rotationWeight, query, negate);
+
+            if (negate && found.size() == k && distances[k - 1] <= query[6] * query[6])
+            {
+                break;
+            }
+
+            size_t n = tree->index->knnSearch(query, k, indices.data(), distances.data());
+
+            for (size_t i = 0; i < n; i++)
+            {
+                auto it = found.emplace(indices[i], distances[i]);
+                it.first->second = std::min(it.first->second, distances[i]);
+            }
+        }
+
+        for (const auto& f : found)
+        {
+            result.push_back({f.first, std::sqrt(f.second)});
+        }
+
+        std::sort(result.begin(), result.end(), [](const Neighbor & a, const Neighbor & b)
+        {
+            return a.distance < b.distance || (a.distance == b.distance && a.index < b.index);
+        });
+
+        result.resize(k);
+        return result;
+    }
+
+    std::vector<GraspIndex::Neighbor> GraspIndex::getNearestGrasps(const Eigen::Matrix4f& tcpPoseGlobal, const Eigen::Matrix4f& objectPose, size_t k) const
+    {
+        return getNearestGrasps(Eigen::Matrix4f(objectPose.inverse() * tcpPoseGlobal), k);
+    }
+
+    std::vector<GraspIndex::Neighbor> GraspIndex::getGraspsInRadius(const Eigen::Matrix4f& tcpPose, float radius) const
+    {
+        std::vector<Neighbor> result;
+
+        if (!tree->index || radius < 0)
+        {
+            return result;
+        }
+
+        float query[dimensions];
+        std::vector<std::pair<unsigned int, float> > matches;
+        std::unordered_map<unsigned int, float> found;
+        nanoflann::SearchParams params;
+        params.sorted = false;
+
+        for (bool negate : {false, true})
+        {
+            getPoint(tcpPose, 2.0f * rotationWeight, query, negate);
+
+            if (negate && radius * radius < query[6] * query[6])
+            {
+                break;
+            }
+
+            tree->index->radiusSearch(query, radius * radius, matches, params);
+
+            for (const auto& m : matches)
+            {
+                auto it = found.emplace(m.first, m.second);
+                it.first->second = std::min(it.first->second, m.second);
+            }
+        }
+
+        result.reserve(found.size());
+
+        for (const auto& f : found)
+        {
+            result.push_back({f.first, std::sqrt(f.second)});
+        }
+
+        std::sort(result.begin(), result.end(), [](const Neighbor & a, const Neighbor & b)
+        {
+            return a.distance < b.distance || (a.distance == b.distance && a.index < b.index);
+        });
+
+        return result;
+    }
+
+    std::vector<GraspIndex::Neighbor> GraspIndex::getGraspsInRadius(const Eigen::Matrix4f& tcpPoseGlobal, const Eigen::Matrix4f& objectPose, float radius) const
+    {
+        return getGraspsInRadius(Eigen::Matrix4f(objectPose.inverse() * tcpPoseGlobal), radius);
+    }
+
+    float GraspIndex::getDistance(const Eigen::Matrix4f& pose1, const Eigen::Matrix4f& pose2) const
+    {
+        float a[dimensions];
+        float b[dimensions];
+        float c[dimensions];
+        getPoint(pose1, 2.0f * rotationWeight, a);
+        getPoint(pose2, 2.0f * rotationWeight, b);
+        getPoint(pose2, 2.0f * rotationWeight, c, true);
+        return std::sqrt(std::min(getSquaredDistance(a, b), getSquaredDistance(a, c)));
+    }
+
+} //  namespace
@@ -0,0 +1,98 @@
+/**
+* This file is part of Simox.
+*
+* Simox is free software; you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 2 of
+* the License, or (at your option) any later version.
+*
+* Simox is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*
+*/
+#pragma once
+
+#include "../VirtualRobot.h"
+
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace VirtualRobot
+{
+
+    /*!
+        A spatial index over the tcp poses of a grasp set, which answers nearest neighbor and radius queries.
+        The tcp poses are given in the coordinate system of the object (see Grasp::getTcpPoseGlobal()).
+        Two poses are compared by their position and orientation, a rotation of 1 rad counts as rotationWeight mm:
+        \f$ d = \sqrt{|p_1 - p_2|^2 + (2 w |q_1 - q_2|)^2} \f$, with the sign of the quaternions chosen to minimize the distance.
+        For small rotations, \f$ 2 |q_1 - q_2| \f$ equals the rotation angle.
+
+        The index is a snapshot of the grasp set, call rebuild() after adding or removing grasps.
+    */
+    class VIRTUAL_ROBOT_IMPORT_EXPORT GraspIndex
+    {
+    public:
+        struct Neighbor
+        {
+            unsigned int index;         //!< The index of the grasp in the grasp set.
+            float distance;             //!< The distance of the grasp's tcp pose to the query pose.
+        };
+
+        /*!
+            Builds the index.
+            \param grasps The grasp set.
+            \param rotationWeight The distance [mm] that corresponds to a rotation of 1 rad.
+        */
+        GraspIndex(GraspSetPtr grasps, float rotationWeight = 100.0f);
+        virtual ~GraspIndex();
+
+        /*!
+            Builds the index again, e.g. after the grasp set was changed.
+        */
+        void rebuild();
+
+        GraspSetPtr getGraspSet();
+        float getRotationWeight() const;
+        unsigned int getSize() const;
+
+        /*!
+            Returns the k grasps whose tcp poses are closest to the given pose, sorted by distance.
+            \param tcpPose The tcp pose in the coordinate system of the object.
+        */
+        std::vector<Neighbor> getNearestGrasps(const Eigen::Matrix4f& tcpPose, size_t k) const;
+
+        /*!
+            Returns the k grasps whose tcp poses are closest to the given global pose, when the object is located at objectPose.
+        */
+        std::vector<Neighbor> getNearestGrasps(const Eigen::Matrix4f& tcpPoseGlobal, const Eigen::Matrix4f& objectPose, size_t k) const;
+
+        /*!
+            Returns all grasps whose tcp poses are within radius of the given pose, sorted by distance.
+            \param tcpPose The tcp pose in the coordinate system of the object.
+        */
+        std::vector<Neighbor> getGraspsInRadius(const Eigen::Matrix4f& tcpPose, float radius) const;
+        std::vector<Neighbor> getGraspsInRadius(const Eigen::Matrix4f& tcpPoseGlobal, const Eigen::Matrix4f& objectPose, float radius) const;
+
+        /*!
+            The distance of two tcp poses, as used by the index.
+        */
+        float getDistance(const Eigen::Matrix4f& pose1, const Eigen::Matrix4f& pose2) const;
+
+    protected:
+        struct KdTree;
+
+        GraspSetPtr grasps;
+        float rotationWeight;
+        boost::shared_ptr<KdTree> tree;
+    };
+
+} // namespace
@@ -7,12 +7,131 @@
 #include <vector>
 #include <VirtualRobot/VirtualRobotException.h>
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
 namespace VirtualRobot
 {
+    namespace
+    {
+        /*
+            Binary grasp set files start with a header:
+                magic, version, number of grasps, set name, robot type, eef name, string table (creation methods, preshapes and joint names)
+            followed by 4 byte aligned columns with one entry per grasp:
+                poses (16 floats, column major), qualities, creation method and preshape (string table indices),
+                configuration offsets (n + 1) and entries (joint, value), name offsets (n + 1) and names.
+        */
+        const char binaryMagic[4] = {'S', 'X', 'G', 'S'};
+        const uint32_t binaryVersion = 1;
+        const unsigned int noRow = std::numeric_limits<unsigned int>::max();
+
+        struct ConfigEntry
+        {
+            uint32_t joint;
+            float value;
+        };
+
+        template <typename T>
+        void write(std::ofstream& output, const T& value)
+        {
+            output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void writeString(std::ofstream& output, const std::string& s)
+        {
+            write(output, uint32_t(s.size()));
+            output.write(s.data(), std::streamsize(s.size()));
+        }
+
+        template <typename T>
+        void writeArray(std::ofstream& output, const std::vector<T>& values)
+        {
+            output.write(reinterpret_cast<const char*>(values.data()), std::streamsize(values.size() * sizeof(T)));
+        }
+
+        // bounds checked reading of the mapped file
+        struct Reader
+        {
+            const char* data;
+            size_t size;
+            size_t pos;
+
+            template <typename T>
+            bool read(T& value)
+            {
+                if (pos + sizeof(T) > size)
+                {
+                    return false;
+                }
+
+                std::memcpy(&value, data + pos, sizeof(T));
+                pos += sizeof(T);
+                return true;
+            }
+
+            bool readString(std::string& s)
+            {
+                uint32_t length;
+
+                if (!read(length) || pos + length > size)
+                {
+                    return false;
+                }
+
+                s.assign(data + pos, length);
+                pos += length;
+                return true;
+            }
+
+            template <typename T>
+            const T* readArray(size_t count)
+            {
+                pos = (pos + 3) & ~size_t(3);
+
+                if (pos > size || count > (size - pos) / sizeof(T))
+                {
+                    return nullptr;
+                }
+
+                const T* result = reinterpret_cast<const T*>(data + pos);
+                pos += count * sizeof(T);
+                return result;
+            }
+        };
+    }
+
+    struct GraspSet::BinaryData
+    {
+        boost::interprocess::mapped_region region;
+        std::vector<std::string> strings;
+        const float* poses;
+        const float* qualities;
+        const uint32_t* creations;
+        const uint32_t* preshapes;
+        const uint32_t* configOffsets;
+        const ConfigEntry* config;
+        const uint32_t* nameOffsets;
+        const char* names;
+
+        std::string getName(unsigned int row) const
+        {
+            return std::string(names + nameOffsets[row], names + nameOffsets[row + 1]);
+        }
+
+        Eigen::Map<const Eigen::Matrix4f> getPose(unsigned int row) const
+        {
+            return Eigen::Map<const Eigen::Matrix4f>(poses + 16 * size_t(row));
+        }
+    };
 
 
     GraspSet::GraspSet(const std::string& name, const std::string& robotType, const std::string& eef, const std::vector< GraspPtr >& grasps)
-        : grasps(grasps), name(name), robotType(robotType), eef(eef)
+        : grasps(grasps), name(name), robotType(robotType), eef(eef), indexValid(false), indexNameRevision(0)
     {
 
     }
@@ -28,38 +147,99 @@ namespace VirtualRobot
 
 
         grasps.push_back(grasp);
+
+        if (binaryData)
+        {
+            binaryRows.push_back(noRow);
+        }
+
+        if (indexValid)
+        {
+            nameIndex.emplace(grasp->getName(), grasps.size() - 1);
+            graspIndex[grasp.get()] = grasps.size() - 1;
+        }
     }
 
     bool GraspSet::hasGrasp(GraspPtr grasp)
     {
         VR_ASSERT_MESSAGE(grasp, "NULL grasp");
 
-        for (const auto & i : grasps)
-            if (i == grasp)
+        updateIndex();
+        return graspIndex.find(grasp.get()) != graspIndex.end();
+    }
+
+    bool GraspSet::hasGrasp(const std::string& name)
+    {
+        updateIndex();
+        return nameIndex.find(name) != nameIndex.end();
+    }
+
+    void GraspSet::updateIndex()
+    {
+        if (indexValid && indexNameRevision == Grasp::GetNameRevision())
+        {
+            return;
+        }
+
+        nameIndex.clear();
+        graspIndex.clear();
+        nameIndex.reserve(grasps.size());
+
+        for (size_t i = 0; i < grasps.size(); i++)
+        {
+            if (grasps[i])
             {
-                return true;
+                nameIndex.emplace(grasps[i]->getName(), i);
+                graspIndex[grasps[i].get()] = i;
+            }
+            else
+            {
+                nameIndex.emplace(binaryData->getName(binaryRows[i]), i);
             }
+        }
 
-        return false;
+        indexValid = true;
+        indexNameRevision = Grasp::GetNameRevision();
     }
 
-    bool GraspSet::hasGrasp(const std::string& name)
+    GraspPtr GraspSet::getGraspObject(size_t n)
     {
-        for (auto & grasp : grasps)
+        if (!grasps[n])
         {
-            if (grasp->getName() == name)
+            const BinaryData& d = *binaryData;
+            unsigned int row = binaryRows[n];
+            GraspPtr grasp(new Grasp(d.getName(row), robotType, eef, d.getPose(row), d.strings[d.creations[row]], d.qualities[row], d.strings[d.preshapes[row]]));
+
+            if (d.configOffsets[row] != d.configOffsets[row + 1])
             {
-                return true;
+                std::map<std::string, float> config;
+
+                for (uint32_t i = d.configOffsets[row]; i < d.configOffsets[row + 1]; i++)
+                {
+                    config[d.strings[d.config[i].joint]] = d.config[i].value;
+                }
+
+                grasp->setConfiguration(config);
+            }
+
+            grasps[n] = grasp;
+
+            if (indexValid)
+            {
+                graspIndex[grasp.get()] = n;
             }
         }
 
-        return false;
+        return grasps[n];
     }
 
 
     void GraspSet::clear()
     {
         grasps.clear();
+        binaryRows.clear();
+        binaryData.reset();
+        indexValid = false;
     }
 
     void GraspSet::includeGraspSet(GraspSetPtr grasps)
@@ -86,7 +266,7 @@ namespace VirtualRobot
         for (size_t i = 0; i < grasps.size(); i++)
         {
             cout << "** grasp " << i << ":" << endl;
-            grasps[i]->print(false);
+            getGraspObject(i)->print(false);
         }
 
         cout << endl;
@@ -119,20 +299,20 @@ namespace VirtualRobot
             return GraspPtr();
         }
 
-        return grasps[n];
+        return getGraspObject(n);
     }
 
     VirtualRobot::GraspPtr GraspSet::getGrasp(const std::string& name)
     {
-        for (auto & grasp : grasps)
+        updateIndex();
+        auto it = nameIndex.find(name);
+
+        if (it == nameIndex.end())
         {
-            if (grasp->getName() == name)
-            {
-                return grasp;
-            }
+            return GraspPtr();
         }
 
-        return GraspPtr();
+        return getGraspObject(it->second);
     }
 
 
@@ -141,6 +321,11 @@ namespace VirtualRobot
         return name;
     }
 
+    void GraspSet::setName(const std::string& name)
+    {
+        this->name = name;
+    }
+
     std::string GraspSet::getRobotType()
     {
         return robotType;
@@ -163,9 +348,9 @@ namespace VirtualRobot
 
         ss << t << "<GraspSet name='" << name << "' RobotType='" << robotType << "' EndEffector='" << eef << "'>\n";
 
-        for (auto & grasp : grasps)
+        for (size_t i = 0; i < grasps.size(); i++)
         {
-            ss << grasp->toXML(tabs + 1);
+            ss << getGraspObject(i)->toXML(tabs + 1);
         }
 
         ss << t << "</GraspSet>\n";
@@ -178,49 +363,64 @@ namespace VirtualRobot
     {
         GraspSetPtr res(new GraspSet(name, robotType, eef));
 
-        // clone grasps
+        // clone grasps, grasps that were not created yet share the binary data
+        res->grasps.reserve(grasps.size());
+
         for (auto & grasp : grasps)
         {
-            res->addGrasp(grasp->clone());
+            res->grasps.push_back(grasp ? grasp->clone() : GraspPtr());
         }
 
+        res->binaryData = binaryData;
+        res->binaryRows = binaryRows;
+
         return res;
     }
 
     bool GraspSet::removeGrasp(GraspPtr grasp)
     {
-        for (std::vector< GraspPtr >::iterator i = grasps.begin(); i != grasps.end(); i++)
+        updateIndex();
+        auto it = graspIndex.find(grasp.get());
+
+        if (it == graspIndex.end())
         {
-            if (*i == grasp)
-            {
-                grasps.erase(i);
-                return true;
-            }
+            return false;
         }
 
-        return false;
+        return removeGrasp((unsigned int)it->second);
     }
 
     bool GraspSet::removeGrasp(unsigned int i)
     {
-        GraspPtr g = getGrasp(i);
-        if (!g)
+        if (i >= (unsigned int)grasps.size())
+        {
             return false;
-        return removeGrasp(g);
+        }
+
+        grasps.erase(grasps.begin() + i);
+
+        if (binaryData)
+        {
+            binaryRows.erase(binaryRows.begin() + i);
+        }
+
+        indexValid = false;
+        return true;
     }
 
     void GraspSet::removeAllGrasps()
     {
-        grasps.clear();
+        clear();
     }
 
     std::vector< GraspPtr > GraspSet::getGrasps()
     {
         std::vector< GraspPtr > res;
+        res.reserve(grasps.size());
 
-        for (const auto & grasp : grasps)
+        for (size_t i = 0; i < grasps.size(); i++)
         {
-            res.push_back(grasp);
+            res.push_back(getGraspObject(i));
         }
 
         return res;
@@ -228,10 +428,207 @@ namespace VirtualRobot
 
     void GraspSet::setPreshape(const std::string& preshape)
     {
-        for (auto & grasp : grasps)
+        for (size_t i = 0; i < grasps.size(); i++)
+        {
+            getGraspObject(i)->setPreshape(preshape);
+        }
+    }
+
+    void GraspSet::getTcpPosesGlobal(const Eigen::Matrix4f& objectPose, std::vector< Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f> >& storePoses)
+    {
+        storePoses.resize(grasps.size());
+
+        for (size_t i = 0; i < grasps.size(); i++)
+        {
+            if (grasps[i])
+            {
+                storePoses[i] = grasps[i]->getTcpPoseGlobal(objectPose);
+            }
+            else
+            {
+                storePoses[i] = objectPose * binaryData->getPose(binaryRows[i]).inverse();
+            }
+        }
+    }
+
+    bool GraspSet::saveBinary(const std::string& filename)
+    {
+        const size_t n = grasps.size();
+        std::vector<std::string> strings;
+        std::unordered_map<std::string, uint32_t> stringIds;
+
+        auto getStringId = [&](const std::string& s)
+        {
+            auto it = stringIds.emplace(s, uint32_t(strings.size()));
+
+            if (it.second)
+            {
+                strings.push_back(s);
+            }
+
+            return it.first->second;
+        };
+
+        std::vector<float> poses(16 * n);
+        std::vector<float> qualities(n);
+        std::vector<uint32_t> creations(n);
+        std::vector<uint32_t> preshapes(n);
+        std::vector<uint32_t> configOffsets(n + 1, 0);
+        std::vector<ConfigEntry> config;
+        std::vector<uint32_t> nameOffsets(n + 1, 0);
+        std::string names;
+
+        for (size_t i = 0; i < n; i++)
+        {
+            Eigen::Map<Eigen::Matrix4f> pose(&poses[16 * i]);
+
+            // grasps that were not created yet are copied from the binary data
+            if (grasps[i])
+            {
+                const Grasp& g = *grasps[i];
+                pose = g.getTransformation();
+                qualities[i] = g.getQuality();
+                creations[i] = getStringId(g.getCreationMethod());
+                preshapes[i] = getStringId(g.getPreshapeName());
+                names += g.getName();
+
+                for (const auto& c : g.getConfiguration())
+                {
+                    config.push_back({getStringId(c.first), c.second});
+                }
+            }
+            else
+            {
+                const BinaryData& d = *binaryData;
+                unsigned int row = binaryRows[i];
+                pose = d.getPose(row);
+                qualities[i] = d.qualities[row];
+                creations[i] = getStringId(d.strings[d.creations[row]]);
+                preshapes[i] = getStringId(d.strings[d.preshapes[row]]);
+                names += d.getName(row);
+
+                for (uint32_t c = d.configOffsets[row]; c < d.configOffsets[row + 1]; c++)
+                {
+                    config.push_back({getStringId(d.strings[d.config[c].joint]), d.config[c].value});
+                }
+            }
+
+            configOffsets[i + 1] = uint32_t(config.size());
+            nameOffsets[i + 1] = uint32_t(names.size());
+        }
+
+        std::ofstream output(filename.c_str(), std::ios::binary);
+
+        if (!output)
+        {
+            VR_WARNING << "Could not write grasp set file " << filename << endl;
+            return false;
+        }
+
+        auto align = [&]()
+        {
+            const char zeros[4] = {0, 0, 0, 0};
+            output.write(zeros, (4 - output.tellp() % 4) % 4);
+        };
+
+        output.write(binaryMagic, sizeof(binaryMagic));
+        write(output, binaryVersion);
+        write(output, uint32_t(n));
+        writeString(output, name);
+        writeString(output, robotType);
+        writeString(output, eef);
+        write(output, uint32_t(strings.size()));
+
+        for (const std::string& s : strings)
+        {
+            writeString(output, s);
+        }
+
+        align();
+        writeArray(output, poses);
+        writeArray(output, qualities);
+        writeArray(output, creations);
+        writeArray(output, preshapes);
+        writeArray(output, configOffsets);
+        writeArray(output, config);
+        writeArray(output, nameOffsets);
+        output.write(names.data(), std::streamsize(names.size()));
+
+        if (!output)
+        {
+            VR_WARNING << "Could not write grasp set file " << filename << endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    GraspSetPtr GraspSet::loadBinary(const std::string& filename)
+    {
+        boost::shared_ptr<BinaryData> d(new BinaryData());
+
+        try
         {
-            grasp->setPreshape(preshape);
+            boost::interprocess::file_mapping file(filename.c_str(), boost::interprocess::read_only);
+            boost::interprocess::mapped_region(file, boost::interprocess::read_only).swap(d->region);
         }
+        catch (boost::interprocess::interprocess_exception&)
+        {
+            VR_WARNING << "Could not open grasp set file " << filename << endl;
+            return GraspSetPtr();
+        }
+
+        Reader r{static_cast<const char*>(d->region.get_address()), d->region.get_size(), 0};
+        char magic[4];
+        uint32_t version = 0;
+        uint32_t n = 0;
+        uint32_t numStrings = 0;
+        std::string setName, setRobotType, setEEF;
+
+        bool ok = r.read(magic) && std::memcmp(magic, binaryMagic, sizeof(binaryMagic)) == 0 && r.read(version) && version == binaryVersion
+                  && r.read(n) && r.readString(setName) && r.readString(setRobotType) && r.readString(setEEF) && r.read(numStrings)
+                  && numStrings <= r.size;
+
+        for (uint32_t i = 0; ok && i < numStrings; i++)
+        {
+            d->strings.emplace_back();
+            ok = r.readString(d->strings.back());
+        }
+
+        ok = ok && (d->poses = r.readArray<float>(16 * size_t(n))) && (d->qualities = r.readArray<float>(n))
+             && (d->creations = r.readArray<uint32_t>(n)) && (d->preshapes = r.readArray<uint32_t>(n))
+             && (d->configOffsets = r.readArray<uint32_t>(size_t(n) + 1)) && (d->config = r.readArray<ConfigEntry>(d->configOffsets[n]))
+             && (d->nameOffsets = r.readArray<uint32_t>(size_t(n) + 1)) && (d->names = r.readArray<char>(d->nameOffsets[n]));
+
+        // check all indices once, so accessing the grasps needs no checks
+        for (uint32_t i = 0; ok && i < n; i++)
+        {
+            ok = d->creations[i] < numStrings && d->preshapes[i] < numStrings
+                 && d->configOffsets[i] <= d->configOffsets[i + 1] && d->nameOffsets[i] <= d->nameOffsets[i + 1];
+        }
+
+        for (uint32_t i = 0; ok && i < d->configOffsets[n]; i++)
+        {
+            ok = d->config[i].joint < numStrings;
+        }
+
+        if (!ok)
+        {
+            VR_WARNING << "Invalid grasp set file " << filename << endl;
+            return GraspSetPtr();
+        }
+
+        GraspSetPtr result(new GraspSet(setName, setRobotType, setEEF));
+        result->grasps.resize(n);
+        result->binaryRows.resize(n);
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            result->binaryRows[i] = i;
+        }
+
+        result->binaryData = d;
+        return result;
     }
 
 
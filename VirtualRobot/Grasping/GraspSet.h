@@ -28,16 +28,24 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
 
 
 #include <VirtualRobot/CollisionDetection/CollisionModel.h>
 #include "Grasp.h"
 
 #include <Eigen/Core>
+#include <Eigen/StdVector>
 
 namespace VirtualRobot
 {
 
+    /*!
+        A set of grasps for one end effector.
+        Grasps are found by name or pointer with hash maps. Large grasp sets can be stored in a compact binary file (see saveBinary()),
+        which is mapped into memory on loading. The poses of such a set are read directly from the file and a Grasp object is only
+        created, when the grasp is accessed.
+    */
     class VIRTUAL_ROBOT_IMPORT_EXPORT GraspSet
     {
     public:
@@ -51,6 +59,7 @@ namespace VirtualRobot
         virtual ~GraspSet();
 
         std::string getName();
+        void setName(const std::string& name);
         std::string getRobotType();
         std::string getEndEffector();
 
@@ -88,12 +97,46 @@ namespace VirtualRobot
         //! Sets preshape string of all grasps
         void setPreshape(const std::string& preshape);
 
+        /*!
+            Computes the global tcp poses of all grasps for the given object pose (see Grasp::getTcpPoseGlobal()).
+            Grasps that were loaded from a binary file are not created.
+            \param objectPose The global pose of the object.
+            \param storePoses The tcp pose of grasp n is stored at position n.
+        */
+        void getTcpPosesGlobal(const Eigen::Matrix4f& objectPose, std::vector< Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f> >& storePoses);
+
+        /*!
+            Stores all grasps in a compact binary file, which can be loaded with loadBinary().
+        */
+        bool saveBinary(const std::string& filename);
+
+        /*!
+            Loads a grasp set that was stored with saveBinary().
+            The file is mapped into memory and remains mapped as long as the grasp set (or one of its clones) exists.
+            \return The grasp set or an empty pointer, if the file could not be read.
+        */
+        static GraspSetPtr loadBinary(const std::string& filename);
+
     protected:
-        std::vector< GraspPtr > grasps;
+        struct BinaryData;
+
+        // creates the grasp objects of grasps that were loaded from a binary file
+        GraspPtr getGraspObject(size_t n);
+        void updateIndex();
+
+        std::vector< GraspPtr > grasps;         //!< Grasps loaded from a binary file are empty until they are accessed.
         std::string name;
         std::string robotType;
         std::string eef;
 
+        boost::shared_ptr<BinaryData> binaryData;
+        std::vector< unsigned int > binaryRows; //!< The row of each grasp in binaryData, if available.
+
+        std::unordered_map<std::string, size_t> nameIndex;
+        std::unordered_map<const Grasp*, size_t> graspIndex;
+        bool indexValid;
+        unsigned int indexNameRevision;
+
     };
 
 } // namespace
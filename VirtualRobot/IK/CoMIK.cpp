@@ -1,7 +1,5 @@
 #include "CoMIK.h"
 #include "DifferentialIK.h"
-#include "../Nodes/RobotNodeRevolute.h"
-#include "../Nodes/RobotNodePrismatic.h"
 #include "../VirtualRobotException.h"
 #include "../Robot.h"
 
@@ -20,17 +18,7 @@ namespace VirtualRobot
         this->rnsBodies = rnsBodies;
         numDimensions = dimensions;
 
-        bodyNodes = rnsBodies->getAllRobotNodes();
-
-        for (auto & bodyNode : bodyNodes)
-        {
-            // get all joints that influence the body
-            std::vector<RobotNodePtr> parentsN = bodyNode->getAllParents(rns);
-            // maybe this node is joint and body
-            if (rnsJoints->hasRobotNode(bodyNode))
-                parentsN.push_back(bodyNode);
-            bodyNodeParents[bodyNode] = parentsN;
-        }
+        massProperties.reset(new MassProperties(rnsJoints, rnsBodies));
 
         if (rnsBodies->getMass() == 0)
         {
@@ -45,76 +33,6 @@ namespace VirtualRobot
         initialized = true;
     }
 
-    Eigen::MatrixXf CoMIK::getJacobianOfCoM(RobotNodePtr node)
-    {
-        // Get number of degrees of freedom
-        size_t nDoF = rns->getAllRobotNodes().size();
-
-        // Create matrices for the position and the orientation part of the jacobian.
-        Eigen::MatrixXf position = Eigen::MatrixXf::Zero(3, nDoF);
-
-        const std::vector<RobotNodePtr> parentsN = bodyNodeParents[node];
-
-        // Iterate over all degrees of freedom
-        for (size_t i = 0; i < nDoF; i++)
-        {
-            RobotNodePtr dof = rns->getNode((int)i);// bodyNodes[i];
-
-            // Check if the tcp is affected by this DOF
-            if (find(parentsN.begin(), parentsN.end(), dof) != parentsN.end())
-            {
-                // Calculus for rotational joints is different as for prismatic joints.
-                if (dof->isRotationalJoint())
-                {
-                    // get axis
-                    boost::shared_ptr<RobotNodeRevolute> revolute
-                        = boost::dynamic_pointer_cast<RobotNodeRevolute>(dof);
-                    THROW_VR_EXCEPTION_IF(!revolute, "Internal error: expecting revolute joint");
-                    // todo: find a better way of handling different joint types
-                    Eigen::Vector3f axis = revolute->getJointRotationAxis(coordSystem);
-
-                    // For CoM-Jacobians only the positional part is necessary
-                    //Eigen::Vector3f toTCP = node->getCoMLocal() + node->getGlobalPose().block(0, 3, 3, 1)
-                    //                        - dof->getGlobalPose().block(0, 3, 3, 1);
-                    Eigen::Vector3f toTCP = node->getCoMGlobal()
-                                            - dof->getGlobalPose().block(0, 3, 3, 1);
-
-                    if (convertMMtoM)
-                    {
-                        toTCP /= 1000.0f;
-                    }
-
-                    position.block(0, i, 3, 1) = axis.cross(toTCP);
-                }
-                else if (dof->isTranslationalJoint())
-                {
-                    // -> prismatic joint
-                    boost::shared_ptr<RobotNodePrismatic> prismatic
-                        = boost::dynamic_pointer_cast<RobotNodePrismatic>(dof);
-                    THROW_VR_EXCEPTION_IF(!prismatic, "Internal error: expecting prismatic joint");
-                    // todo: find a better way of handling different joint types
-                    Eigen::Vector3f axis = prismatic->getJointTranslationDirection(coordSystem);
-
-                    position.block(0, i, 3, 1) = axis;
-                }
-            }
-        }
-
-        if (target.rows() == 2)
-        {
-            Eigen::MatrixXf result(2, nDoF);
-            result.row(0) = position.row(0);
-            result.row(1) = position.row(1);
-            return result;
-        }
-        else if (target.rows() == 1)
-        {
-            VR_INFO << "One dimensional CoMs not supported." << endl;
-        }
-
-        return position;
-    }
-
     void CoMIK::convertModelScalingtoM(bool enable)
     {
         convertMMtoM = enable;
@@ -129,31 +47,22 @@ namespace VirtualRobot
 
     Eigen::MatrixXf CoMIK::getJacobianMatrix()
     {
-        Eigen::MatrixXf Jsum(0, 0);
+        // the mass weighted sum of the bodies' CoM Jacobians, computed from the joints' subtree masses and CoMs
+        massProperties->update();
+        Eigen::MatrixXf J;
+        massProperties->getCoMJacobian(J, coordSystem, convertMMtoM);
 
-        for (std::vector<RobotNodePtr>::const_iterator n = bodyNodes.begin(); n != bodyNodes.end(); n++)
+        // Depeding on the set target, the Jacobian is projected to the XY-plane
+        if (target.rows() == 2)
         {
-            // Retrieve (positional) Jacobian for this node's CoM
-            // Depeding on the set target, the Jacobian is already projected to the XY-plane
-            Eigen::MatrixXf J = getJacobianOfCoM(*n);
-
-            // Sum up the Jacobians weighted by the respective node masses
-            if (Jsum.rows() == 0)
-            {
-                Jsum = (*n)->getMass() * J;
-            }
-            else
-            {
-                Jsum += (*n)->getMass() * J;
-            }
+            return J.topRows(2);
         }
-
-        if (rnsBodies->getMass() != 0)
+        else if (target.rows() == 1)
         {
-            Jsum /= rnsBodies->getMass();
+            VR_INFO << "One dimensional CoMs not supported." << endl;
         }
 
-        return Jsum;
+        return J;
     }
 
     Eigen::VectorXf CoMIK::getError(float /*stepSize*/)
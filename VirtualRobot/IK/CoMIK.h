@@ -27,6 +27,7 @@
 #include "../RobotNodeSet.h"
 #include "JacobiProvider.h"
 #include "DifferentialIK.h"
+#include "../Tools/MassProperties.h"
 
 
 
@@ -44,7 +45,6 @@ namespace VirtualRobot
 
         void setGoal(const Eigen::VectorXf& goal, float tolerance = 5.0f);
 
-        Eigen::MatrixXf getJacobianOfCoM(RobotNodePtr node);
         Eigen::MatrixXf getJacobianMatrix() override;
         Eigen::MatrixXf getJacobianMatrix(SceneObjectPtr tcp) override; // ignored for CoM IK but needed for interface
 
@@ -70,8 +70,7 @@ namespace VirtualRobot
         RobotNodePtr coordSystem;
         RobotNodeSetPtr rnsBodies;
 
-        std::vector< RobotNodePtr > bodyNodes;
-        std::map< VirtualRobot::RobotNodePtr, std::vector<VirtualRobot::RobotNodePtr> > bodyNodeParents;
+        MassPropertiesPtr massProperties;
 
         float tolerance;
         bool checkImprovement;
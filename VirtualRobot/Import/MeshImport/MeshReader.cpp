@@ -0,0 +1,191 @@
+
+#include "MeshReader.h"
+#include "STLReader.h"
+#include <VirtualRobot/XML/BaseIO.h>
+#include <VirtualRobot/Visualization/TriMeshModel.h>
+
+#include <boost/filesystem.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace VirtualRobot
+{
+    namespace
+    {
+        std::string getExtension(const std::string& filename)
+        {
+            std::string ext = boost::filesystem::path(filename).extension().string();
+            BaseIO::getLowerCase(ext);
+            return ext;
+        }
+
+        // adds the polygon as triangle fan, the indices have to be valid
+        void addPolygon(TriMeshModel& t, const std::vector<unsigned int>& polygon)
+        {
+            for (size_t i = 2; i < polygon.size(); i++)
+            {
+                MathTools::TriangleFace f;
+                f.set(polygon[0], polygon[i - 1], polygon[i]);
+                f.normal = TriMeshModel::CreateNormal(t.vertices[f.id1], t.vertices[f.id2], t.vertices[f.id3]);
+                t.addFace(f);
+            }
+        }
+    }
+
+    bool MeshReader::isSupported(const std::string& filename)
+    {
+        std::string ext = getExtension(filename);
+        return ext == ".stl" || ext == ".stla" || ext == ".stlb" || ext == ".obj" || ext == ".off";
+    }
+
+    TriMeshModelPtr MeshReader::read(const std::string& filename)
+    {
+        std::string ext = getExtension(filename);
+        TriMeshModelPtr t(new TriMeshModel());
+        bool ok = false;
+
+        if (ext == ".stl" || ext == ".stla" || ext == ".stlb")
+        {
+            STLReader r;
+            ok = r.read(filename, t);
+        }
+        else if (ext == ".obj")
+        {
+            ok = readOBJ(filename, t);
+        }
+        else if (ext == ".off")
+        {
+            ok = readOFF(filename, t);
+        }
+
+        if (!ok || t->faces.empty())
+        {
+            VR_WARNING << "Could not read mesh from " << filename << endl;
+            return TriMeshModelPtr();
+        }
+
+        return t;
+    }
+
+    bool MeshReader::readOBJ(const std::string& filename, TriMeshModelPtr t)
+    {
+        std::ifstream input(filename.c_str());
+
+        if (!input || !t)
+        {
+            return false;
+        }
+
+        std::string line;
+        std::vector<unsigned int> polygon;
+
+        while (std::getline(input, line))
+        {
+            std::istringstream ss(line);
+            std::string tag;
+            ss >> tag;
+
+            if (tag == "v")
+            {
+                Eigen::Vector3f v;
+
+                if (!(ss >> v.x() >> v.y() >> v.z()))
+                {
+                    return false;
+                }
+
+                t->addVertex(v);
+            }
+            else if (tag == "f")
+            {
+                // vertex indices are 1-based or negative (relative to the end), texture and normal indices are ignored
+                polygon.clear();
+                std::string corner;
+
+                while (ss >> corner)
+                {
+                    long id = std::strtol(corner.c_str(), nullptr, 10);
+                    id = (id < 0) ? long(t->vertices.size()) + id : id - 1;
+
+                    if (id < 0 || id >= long(t->vertices.size()))
+                    {
+                        return false;
+                    }
+
+                    polygon.push_back((unsigned int)id);
+                }
+
+                addPolygon(*t, polygon);
+            }
+        }
+
+        return true;
+    }
+
+    bool MeshReader::readOFF(const std::string& filename, TriMeshModelPtr t)
+    {
+        std::ifstream input(filename.c_str());
+        std::string header;
+
+        if (!input || !t || !(input >> header) || header != "OFF")
+        {
+            return false;
+        }
+
+        size_t numVertices = 0;
+        size_t numFaces = 0;
+        size_t numEdges = 0;
+
+        if (!(input >> numVertices >> numFaces >> numEdges))
+        {
+            return false;
+        }
+
+        t->vertices.reserve(numVertices);
+        t->faces.reserve(numFaces);
+
+        for (size_t i = 0; i < numVertices; i++)
+        {
+            Eigen::Vector3f v;
+
+            if (!(input >> v.x() >> v.y() >> v.z()))
+            {
+                return false;
+            }
+
+            t->addVertex(v);
+        }
+
+        std::vector<unsigned int> polygon;
+        std::string rest;
+
+        for (size_t i = 0; i < numFaces; i++)
+        {
+            size_t n = 0;
+
+            if (!(input >> n))
+            {
+                return false;
+            }
+
+            polygon.resize(n);
+
+            for (unsigned int& id : polygon)
+            {
+                if (!(input >> id) || id >= numVertices)
+                {
+                    return false;
+                }
+            }
+
+            // optional face colors
+            std::getline(input, rest);
+            addPolygon(*t, polygon);
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,46 @@
+/**
+* This file is part of Simox.
+*
+* Simox is free software; you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 2 of
+* the License, or (at your option) any later version.
+*
+* Simox is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*
+*/
+
+#pragma once
+
+#include "VirtualRobot/VirtualRobot.h"
+
+#include <string>
+
+namespace VirtualRobot
+{
+    /**
+        Reads triangle meshes from STL, OBJ and OFF files without a visualization library.
+        Only the geometry is read (vertices, faces and per-face normals), polygons are triangulated as fans.
+    */
+    class VIRTUAL_ROBOT_IMPORT_EXPORT MeshReader
+    {
+    public:
+        //! Returns true if the extension of filename is one of "stl stla stlb obj off".
+        static bool isSupported(const std::string& filename);
+
+        //! Reads the file, the format is determined by its extension. Returns an empty pointer on failure.
+        static TriMeshModelPtr read(const std::string& filename);
+
+        static bool readOBJ(const std::string& filename, TriMeshModelPtr t);
+        static bool readOFF(const std::string& filename, TriMeshModelPtr t);
+    };
+}
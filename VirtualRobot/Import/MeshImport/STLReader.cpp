@@ -38,166 +38,312 @@
 #include <VirtualRobot/XML/BaseIO.h>
 #include <VirtualRobot/Visualization/TriMeshModel.h>
 
-// STL
-#include <map>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
+// STL
 #include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
-#include <stdexcept>
+#include <iterator>
 #include <string>
+#include <vector>
 
 namespace VirtualRobot
 {
 
+#ifndef DOXY_IGNORE_THIS
 
-
-    STLReader::
-    STLReader()
-        : eps_(FLT_MIN)
+    namespace
     {
-        scaling = 1.0f;
-    }
+        /*!
+            Hash grid that merges the vertices while they are read.
+            With eps <= FLT_MIN, identical vertices are merged (as the former std::map with CmpVec did),
+            otherwise the grid has a cell size of eps and the neighbouring cells are searched for a vertex
+            whose coordinates all differ by at most eps.
+            Only the vertices that are added through the grid are considered.
+        */
+        class VertexGrid
+        {
+        public:
+            VertexGrid(TriMeshModel& t, float eps, size_t expectedVertices)
+                : t(t), eps(eps), exact(eps <= FLT_MIN), numEntries(0)
+            {
+                size_t capacity = 16;
 
+                while (capacity < 2 * expectedVertices)
+                {
+                    capacity *= 2;
+                }
 
-    //-----------------------------------------------------------------------------
+                slots.assign(capacity, -1);
+            }
 
+            //! Returns the index of v in t.vertices, v is added if there is no matching vertex. -1 for invalid vertices.
+            int insert(const Eigen::Vector3f& v)
+            {
+                if (std::isnan(v[0]) || std::isnan(v[1]) || std::isnan(v[2]))
+                {
+                    return -1;
+                }
 
-    bool
-    STLReader::
-    read(const std::string& _filename, TriMeshModelPtr t)
-    {
-        bool result = false;
+                Cell c = cell(v);
 
-        STL_Type file_type = NONE;
+                if (exact)
+                {
+                    size_t slot = find(c);
 
-        if (_filename.length() >= 4)
-        {
-            std::string ending = _filename.substr(_filename.length() - 4, 4);
-            BaseIO::getLowerCase(ending);
+                    if (slots[slot] >= 0)
+                    {
+                        return slots[slot];
+                    }
+                }
+                else
+                {
+                    for (int dx = -1; dx <= 1; dx++)
+                        for (int dy = -1; dy <= 1; dy++)
+                            for (int dz = -1; dz <= 1; dz++)
+                            {
+                                Cell n = {{c.k[0] + dx, c.k[1] + dy, c.k[2] + dz}};
+                                int id = slots[find(n)];
+
+                                if (id >= 0 && ((t.vertices[id] - v).cwiseAbs().array() <= eps).all())
+                                {
+                                    return id;
+                                }
+                            }
+                }
+
+                if (2 * (numEntries + 1) > slots.size())
+                {
+                    rehash();
+                }
+
+                int id = t.addVertex(v);
+                slots[find(c)] = id;
+                numEntries++;
+                return id;
+            }
+
+        private:
+            struct Cell
+            {
+                int64_t k[3];
+            };
 
-            if (ending == ".stl")
+            Cell cell(const Eigen::Vector3f& v) const
             {
-                file_type = check_stl_type(_filename);
+                Cell c;
+
+                for (int i = 0; i < 3; i++)
+                {
+                    if (exact)
+                    {
+                        // adding 0 maps -0 to +0, so that both end up in the same cell
+                        float f = v[i] + 0.0f;
+                        uint32_t bits;
+                        std::memcpy(&bits, &f, sizeof(bits));
+                        c.k[i] = bits;
+                    }
+                    else
+                    {
+                        double k = std::floor(double(v[i]) / eps);
+                        c.k[i] = int64_t(std::max(-4e18, std::min(4e18, k)));
+                    }
+                }
+
+                return c;
             }
-            else if (ending == "stla")
+
+            // the slot of the entry with cell c, or the empty slot where it has to be inserted
+            size_t find(const Cell& c) const
             {
-                file_type = STLA;
+                uint64_t h = uint64_t(c.k[0]) * 0x9E3779B97F4A7C15ull ^ uint64_t(c.k[1]) * 0xC2B2AE3D27D4EB4Full ^ uint64_t(c.k[2]) * 0x165667B19E3779F9ull;
+                size_t mask = slots.size() - 1;
+
+                for (size_t slot = size_t(h ^ (h >> 29)) & mask; ; slot = (slot + 1) & mask)
+                {
+                    if (slots[slot] < 0)
+                    {
+                        return slot;
+                    }
+
+                    Cell other = cell(t.vertices[slots[slot]]);
+
+                    if (other.k[0] == c.k[0] && other.k[1] == c.k[1] && other.k[2] == c.k[2])
+                    {
+                        return slot;
+                    }
+                }
             }
-            else if (ending == "stlb")
+
+            void rehash()
             {
-                file_type = STLB;
+                std::vector<int> old(2 * slots.size(), -1);
+                old.swap(slots);
+
+                for (int id : old)
+                {
+                    if (id >= 0)
+                    {
+                        slots[find(cell(t.vertices[id]))] = id;
+                    }
+                }
             }
+
+            TriMeshModel& t;
+            float eps;
+            bool exact;
+            size_t numEntries;
+            std::vector<int> slots;
+        };
+
+        bool isSpace(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
         }
 
-        switch (file_type)
+        // the next whitespace separated token in [p, end)
+        bool nextToken(const char*& p, const char* end, const char*& token, size_t& length)
         {
-            case STLA:
+            while (p < end && isSpace(*p))
             {
-                result = read_stla(_filename, t);
-                break;
+                p++;
             }
 
-            case STLB:
-            {
-                result = read_stlb(_filename, t);
-                break;
-            }
+            token = p;
 
-            default:
+            while (p < end && !isSpace(*p))
             {
-                result = false;
-                break;
+                p++;
             }
-        }
-
 
-        return result;
-    }
+            length = size_t(p - token);
+            return length > 0;
+        }
 
-    bool
-    STLReader::read(std::istream& _is, STL_Type stltype, TriMeshModelPtr t)
-    {
+        bool tokenEquals(const char* token, size_t length, const char* keyword)
+        {
+            size_t i = 0;
 
-        bool result = false;
+            for (; i < length && keyword[i]; i++)
+            {
+                if (std::tolower(static_cast<unsigned char>(token[i])) != keyword[i])
+                {
+                    return false;
+                }
+            }
 
-        if (stltype == STLB)
-        {
-            result = read_stlb(_is, t);
+            return i == length && !keyword[i];
         }
-        else
+
+        bool nextFloat(const char*& p, const char* end, float& value)
         {
-            result = read_stla(_is, t);
-        }
+            const char* token;
+            size_t length;
 
-        return result;
-    }
+            // the mapped file is not null terminated, so the token is copied
+            char buffer[64];
 
+            if (!nextToken(p, end, token, length) || length >= sizeof(buffer))
+            {
+                return false;
+            }
 
-    //-----------------------------------------------------------------------------
+            std::memcpy(buffer, token, length);
+            buffer[length] = 0;
+            char* parsed;
+            value = std::strtof(buffer, &parsed);
+            return parsed == buffer + length;
+        }
 
+        void skipLine(const char*& p, const char* end)
+        {
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', size_t(end - p)));
+            p = eol ? eol + 1 : end;
+        }
 
-#ifndef DOXY_IGNORE_THIS
+        // the number of "outer" keywords, i.e. facets
+        size_t countFacets(const char* p, const char* end)
+        {
+            size_t count = 0;
 
-    class CmpVec
-    {
-    public:
+            for (; p + 5 <= end; p++)
+            {
+                if ((*p | 0x20) == 'o' && (p[1] | 0x20) == 'u' && (p[2] | 0x20) == 't' && (p[3] | 0x20) == 'e' && (p[4] | 0x20) == 'r')
+                {
+                    count++;
+                }
+            }
 
-        CmpVec(float _eps = FLT_MIN) : eps_(_eps) {}
+            return count;
+        }
 
-        bool operator()(const Eigen::Vector3f& _v0, const Eigen::Vector3f& _v1) const
+        bool addFacet(TriMeshModel& t, const int ids[3], const Eigen::Vector3f* normal)
         {
-            if (fabs(_v0[0] - _v1[0]) <= eps_)
+            // Add face only if it is valid and not degenerated
+            if (ids[0] < 0 || ids[1] < 0 || ids[2] < 0 || ids[0] == ids[1] || ids[0] == ids[2] || ids[1] == ids[2])
             {
-                if (fabs(_v0[1] - _v1[1]) <= eps_)
-                {
-                    return (_v0[2] < _v1[2] - eps_);
-                }
-                else
-                {
-                    return (_v0[1] < _v1[1] - eps_);
-                }
+                return false;
             }
-            else
+
+            MathTools::TriangleFace f;
+            f.set(ids[0], ids[1], ids[2]);
+
+            if (normal)
             {
-                return (_v0[0] < _v1[0] - eps_);
+                unsigned int noId = t.addNormal(*normal);
+                f.setNormal(noId, noId, noId);
             }
-        }
 
-    private:
-        float eps_;
-    };
+            t.addFace(f);
+            return true;
+        }
+    }
 
 #endif
 
 
-    //-----------------------------------------------------------------------------
-
-    void trimStdString(std::string& _string)
+    STLReader::
+    STLReader()
+        : eps_(FLT_MIN)
     {
-        // Trim Both leading and trailing spaces
-
-        size_t start = _string.find_first_not_of(" \t\r\n");
-        size_t end   = _string.find_last_not_of(" \t\r\n");
-
-        if ((std::string::npos == start) || (std::string::npos == end))
-        {
-            _string = "";
-        }
-        else
-        {
-            _string = _string.substr(start, end - start + 1);
-        }
+        scaling = 1.0f;
     }
 
+
     //-----------------------------------------------------------------------------
 
+
     bool
     STLReader::
-    read_stla(const std::string& _filename, TriMeshModelPtr t) const
+    read(const std::string& _filename, TriMeshModelPtr t)
     {
-        std::fstream in(_filename.c_str(), std::ios_base::in);
+        if (_filename.length() < 4)
+        {
+            return false;
+        }
+
+        std::string ending = _filename.substr(_filename.length() - 4, 4);
+        BaseIO::getLowerCase(ending);
 
-        if (!in)
+        if (ending != ".stl" && ending != "stla" && ending != "stlb")
+        {
+            return false;
+        }
+
+        // the file is mapped into memory and parsed in place
+        boost::interprocess::mapped_region region;
+
+        try
+        {
+            boost::interprocess::file_mapping file(_filename.c_str(), boost::interprocess::read_only);
+            boost::interprocess::mapped_region(file, boost::interprocess::read_only).swap(region);
+        }
+        catch (boost::interprocess::interprocess_exception&)
         {
             VR_ERROR << "[STLReader] : cannot not open file "
                      << _filename
@@ -205,133 +351,116 @@ namespace VirtualRobot
             return false;
         }
 
-        bool res = read_stla(in, t);
+        const char* data = static_cast<const char*>(region.get_address());
+        size_t size = region.get_size();
+        STL_Type file_type = (ending == "stla") ? STLA : STLB;
 
-        if (in)
+        if (ending == ".stl")
         {
-            in.close();
+            file_type = check_stl_type(data, size);
         }
 
-        return res;
+        return read(data, size, file_type, t);
     }
 
-    //-----------------------------------------------------------------------------
-
     bool
-    STLReader::
-    read_stla(std::istream& _in, TriMeshModelPtr t) const
+    STLReader::read(std::istream& _is, STL_Type stltype, TriMeshModelPtr t)
     {
+        std::string content((std::istreambuf_iterator<char>(_is)), std::istreambuf_iterator<char>());
 
-        if (!t)
+        if (_is.bad())
         {
+            VR_ERROR << "  Warning! Could not read stream properly!\n";
             return false;
         }
 
-        unsigned int               i;
-        Eigen::Vector3f            v;
-        Eigen::Vector3f            n;
-        std::vector<unsigned int> vhandles;
-
-        CmpVec comp(eps_);
-        std::map<Eigen::Vector3f, unsigned int, CmpVec>            vMap(comp);
-        std::map<Eigen::Vector3f, unsigned int, CmpVec>::iterator  vMapIt;
-
-        std::string line;
+        return read(content.data(), content.size(), stltype == STLB ? STLB : STLA, t);
+    }
 
-        bool facet_normal(false);
+    bool
+    STLReader::read(const char* data, size_t size, STL_Type stltype, TriMeshModelPtr t)
+    {
+        if (!t || !data)
+        {
+            return false;
+        }
 
-        while (_in && !_in.eof())
+        switch (stltype)
         {
+            case STLA:
+                return read_stla(data, size, *t);
 
-            // Get one line
-            std::getline(_in, line);
+            case STLB:
+                return read_stlb(data, size, *t);
 
-            if (_in.bad())
-            {
-                VR_ERROR << "  Warning! Could not read stream properly!\n";
+            default:
                 return false;
-            }
-
-            // Trim Both leading and trailing spaces
-            trimStdString(line);
-
-            // Normal found?
-            if (line.find("facet normal") != std::string::npos)
-            {
-                std::stringstream strstream(line);
-
-                std::string garbage;
+        }
+    }
 
-                // facet
-                strstream >> garbage;
 
-                // normal
-                strstream >> garbage;
+    //-----------------------------------------------------------------------------
 
-                strstream >> n[0];
-                strstream >> n[1];
-                strstream >> n[2];
+    bool
+    STLReader::
+    read_stla(const char* data, size_t size, TriMeshModel& t) const
+    {
+        const char* p = data;
+        const char* end = data + size;
+        const char* token;
+        size_t length;
+
+        // single reservation, closed meshes have about half as many vertices as faces
+        size_t numFacets = countFacets(data, end);
+        t.faces.reserve(t.faces.size() + numFacets);
+        t.normals.reserve(t.normals.size() + numFacets);
+        t.vertices.reserve(t.vertices.size() + numFacets / 2 + 3);
+        VertexGrid grid(t, eps_, numFacets / 2 + 3);
+
+        Eigen::Vector3f n;
+        bool facet_normal(false);
 
-                facet_normal = true;
+        while (nextToken(p, end, token, length))
+        {
+            if (tokenEquals(token, length, "solid") || tokenEquals(token, length, "endsolid"))
+            {
+                // the name may contain any keyword
+                skipLine(p, end);
             }
-
-            // Detected a triangle
-            if ((line.find("outer") != std::string::npos) || (line.find("OUTER") != std::string::npos))
+            else if (tokenEquals(token, length, "facet"))
             {
-
-                vhandles.clear();
-
-                for (i = 0; i < 3; ++i)
+                if (nextToken(p, end, token, length) && tokenEquals(token, length, "normal"))
                 {
-                    // Get one vertex
-                    std::getline(_in, line);
-                    trimStdString(line);
-
-                    std::stringstream strstream(line);
-
-                    std::string garbage;
-                    strstream >> garbage;
-
-                    strstream >> v[0];
-                    strstream >> v[1];
-                    strstream >> v[2];
-
-                    v *= scaling;
+                    facet_normal = nextFloat(p, end, n[0]) && nextFloat(p, end, n[1]) && nextFloat(p, end, n[2]);
+                }
+            }
+            else if (tokenEquals(token, length, "outer"))
+            {
+                // Detected a triangle
+                int ids[3];
 
-                    // has vector been referenced before?
-                    if ((vMapIt = vMap.find(v)) == vMap.end())
-                    {
-                        // No : add vertex and remember idx/vector mapping
-                        int handle = int (t->vertices.size());
-                        t->addVertex(v);//_bi.add_vertex(v);
-                        vhandles.push_back(handle);
-                        vMap[v] = handle;
-                    }
-                    else
-                        // Yes : get index from map
-                    {
-                        vhandles.push_back(vMapIt->second);
-                    }
+                if (!nextToken(p, end, token, length) || !tokenEquals(token, length, "loop"))
+                {
+                    VR_ERROR << "[STLReader] : invalid facet in ASCII STL data" << std::endl;
+                    return false;
                 }
 
-                // Add face only if it is not degenerated
-                if ((vhandles[0] != vhandles[1]) &&
-                    (vhandles[0] != vhandles[2]) &&
-                    (vhandles[1] != vhandles[2]))
+                for (int i = 0; i < 3; i++)
                 {
-                    MathTools::TriangleFace f;
-                    f.set(vhandles[0], vhandles[1], vhandles[2]);
+                    Eigen::Vector3f v;
 
-                    if (facet_normal)
+                    if (!nextToken(p, end, token, length) || !tokenEquals(token, length, "vertex")
+                        || !nextFloat(p, end, v[0]) || !nextFloat(p, end, v[1]) || !nextFloat(p, end, v[2]))
                     {
-                        unsigned int noId = t->normals.size();
-                        t->addNormal(n);
-                        f.setNormal(noId, noId, noId);
+                        VR_ERROR << "[STLReader] : invalid vertex in ASCII STL data" << std::endl;
+                        return false;
                     }
 
-                    //int fh = int(t->faces.size());
-                    t->addFace(f);
-                    //_bi.add_face(vhandles);
+                    ids[i] = grid.insert(v * scaling);
+                }
+
+                if (addFacet(t, ids, facet_normal ? &n : nullptr))
+                {
                     facet_normal = false;
                 }
             }
@@ -344,92 +473,18 @@ namespace VirtualRobot
 
     bool
     STLReader::
-    read_stlb(const std::string& _filename, TriMeshModelPtr t) const
-    {
-        std::fstream in(_filename.c_str(), std::ios_base::in | std::ios_base::binary);
-
-        if (!in)
-        {
-            VR_ERROR << "[STLReader] : cannot not open file "
-                     << _filename
-                     << std::endl;
-            return false;
-        }
-
-        bool res = read_stlb(in, t);
-
-        if (in)
-        {
-            in.close();
-        }
-
-        return res;
-    }
-
-    //-----------------------------------------------------------------------------
-
-
-
-    float STLReader::read_float(std::istream& _in, bool _swap) const
-    {
-        union u3
-        {
-            float f;
-            unsigned char c[4];
-        } fc;
-        _in.read((char*)fc.c, 4);
-
-        if (_swap)
-        {
-            std::swap(fc.c[0], fc.c[3]);
-            std::swap(fc.c[1], fc.c[2]);
-        }
-
-        return fc.f;
-    }
-
-    int STLReader::read_int(std::istream& _in, bool _swap) const
-    {
-        union u2
-        {
-            int i;
-            unsigned char c[4];
-        } ic;
-        _in.read((char*)ic.c, 4);
-
-        if (_swap)
-        {
-            std::swap(ic.c[0], ic.c[3]);
-            std::swap(ic.c[1], ic.c[2]);
-        }
-
-        return ic.i;
-    }
-
-    bool
-    STLReader::
-    read_stlb(std::istream& _in, TriMeshModelPtr t) const
+    read_stlb(const char* data, size_t size, TriMeshModel& t) const
     {
-        if (!t)
+        // check size of types
+        if ((sizeof(float) != 4) || (sizeof(uint32_t) != 4))
         {
+            VR_ERROR << "[STLReader] : wrong type size\n";
             return false;
         }
 
-        char                       dummy[100];
-        bool                       swapFlag;
-        unsigned int               i, nT;
-        Eigen::Vector3f            v, n;
-        std::vector<unsigned int> vhandles;
-
-
-        std::map<Eigen::Vector3f, unsigned int, CmpVec>  vMap;
-        std::map<Eigen::Vector3f, unsigned int, CmpVec>::iterator vMapIt;
-
-
-        // check size of types
-        if ((sizeof(float) != 4) || (sizeof(int) != 4))
+        if (size < 84)
         {
-            VR_ERROR << "[STLReader] : wrong type size\n";
+            VR_ERROR << "[STLReader] : binary STL data is too short\n";
             return false;
         }
 
@@ -440,68 +495,56 @@ namespace VirtualRobot
             unsigned char c[4];
         } endian_test;
         endian_test.i = 1;
-        swapFlag = (endian_test.c[3] == 1);
+        bool swapFlag = (endian_test.c[3] == 1);
 
         // read number of triangles
-        _in.read(dummy, 80);
-        nT = read_int(_in, swapFlag);
+        uint32_t nT;
+        std::memcpy(&nT, data + 80, 4);
 
-        // read triangles
-        while (nT)
+        if (swapFlag)
         {
-            vhandles.clear();
+            nT = ((nT & 0xff) << 24) | ((nT & 0xff00) << 8) | ((nT & 0xff0000) >> 8) | (nT >> 24);
+        }
 
-            // read triangle normal
-            n[0] = read_float(_in, swapFlag);
-            n[1] = read_float(_in, swapFlag);
-            n[2] = read_float(_in, swapFlag);
+        if (84 + size_t(nT) * 50 > size)
+        {
+            VR_WARNING << "[STLReader] : binary STL data is truncated, reading " << (size - 84) / 50 << " of " << nT << " triangles" << std::endl;
+            nT = uint32_t((size - 84) / 50);
+        }
 
-            // triangle's vertices
-            for (i = 0; i < 3; ++i)
-            {
-                v[0] = read_float(_in, swapFlag);
-                v[1] = read_float(_in, swapFlag);
-                v[2] = read_float(_in, swapFlag);
+        // single reservation, closed meshes have about half as many vertices as faces
+        t.faces.reserve(t.faces.size() + nT);
+        t.normals.reserve(t.normals.size() + nT);
+        t.vertices.reserve(t.vertices.size() + nT / 2 + 3);
+        VertexGrid grid(t, eps_, nT / 2 + 3);
 
-                v *= scaling;
+        // each facet: normal, 3 vertices and a 2 byte attribute
+        const char* facet = data + 84;
 
-                // has vector been referenced before?
-                if ((vMapIt = vMap.find(v)) == vMap.end())
-                {
-                    // No : add vertex and remember idx/vector mapping
-                    unsigned int handle = t->vertices.size();
-                    t->addVertex(v);
-                    //_bi.add_vertex(v);
-                    vhandles.push_back(handle);
-                    vMap[v] = handle;
-                }
-                else
-                    // Yes : get index from map
+        for (uint32_t i = 0; i < nT; i++, facet += 50)
+        {
+            float values[12];
+            std::memcpy(values, facet, sizeof(values));
+
+            if (swapFlag)
+            {
+                for (float& f : values)
                 {
-                    vhandles.push_back(vMapIt->second);
+                    unsigned char* c = reinterpret_cast<unsigned char*>(&f);
+                    std::swap(c[0], c[3]);
+                    std::swap(c[1], c[2]);
                 }
             }
 
+            Eigen::Vector3f n(values[0], values[1], values[2]);
+            int ids[3];
 
-            // Add face only if it is not degenerated
-            if ((vhandles[0] != vhandles[1]) &&
-                (vhandles[0] != vhandles[2]) &&
-                (vhandles[1] != vhandles[2]))
+            for (int j = 0; j < 3; j++)
             {
-                MathTools::TriangleFace f;
-                f.set(vhandles[0], vhandles[1], vhandles[2]);
-                //if (facet_normal) {
-                unsigned int noId = t->normals.size();
-                t->addNormal(n);
-                f.setNormal(noId, noId, noId);
-                //}
-                //int fh = int(t->faces.size());
-                t->addFace(f);
-                //FaceHandle fh = _bi.add_face(vhandles);
+                ids[j] = grid.insert(Eigen::Vector3f(values[3 + 3 * j], values[4 + 3 * j], values[5 + 3 * j]) * scaling);
             }
 
-            _in.read(dummy, 2);
-            --nT;
+            addFacet(t, ids, &n);
         }
 
         return true;
@@ -509,99 +552,26 @@ namespace VirtualRobot
 
     //-----------------------------------------------------------------------------
 
-    int STLReader::read_int(FILE* _in, bool _swap) const
-    {
-        union u2
-        {
-            int i;
-            unsigned char c[4];
-        } ic;
-        if(4 != std::fread((char*)ic.c, 1, 4, _in))
-        {
-            throw std::runtime_error{__FILE__ " error in line " + std::to_string(__LINE__) + " failed to read 4 bytes."};
-        }
-
-        if (_swap)
-        {
-            std::swap(ic.c[0], ic.c[3]);
-            std::swap(ic.c[1], ic.c[2]);
-        }
-
-        return ic.i;
-    }
-
-    float STLReader::read_float(FILE* _in, bool _swap) const
-    {
-        union u3
-        {
-            float f;
-            unsigned char c[4];
-        } fc;
-        if(4 != std::fread((char*)fc.c, 1, 4, _in))
-        {
-            throw std::runtime_error{__FILE__ " error in line " + std::to_string(__LINE__) + " failed to read 4 bytes."};
-        }
-
-        if (_swap)
-        {
-            std::swap(fc.c[0], fc.c[3]);
-            std::swap(fc.c[1], fc.c[2]);
-        }
-
-        return fc.f;
-    }
-
     STLReader::STL_Type
     STLReader::
-    check_stl_type(const std::string& _filename) const
+    check_stl_type(const char* data, size_t size) const
     {
         // assume it's binary stl, then file size is known from #triangles
         // if size matches, it's really binary
-
-        // open file
-        FILE* in = fopen(_filename.c_str(), "rb");
-
-        if (!in)
-        {
-            return NONE;
-        }
-
-        // determine endian mode
-        union
-        {
-            unsigned int i;
-            unsigned char c[4];
-        } endian_test;
-        endian_test.i = 1;
-        bool swapFlag = (endian_test.c[3] == 1);
-
-        // read number of triangles
-        char dummy[100];
-        if(80 != std::fread(dummy, 1, 80, in))
+        if (size < 84)
         {
-            throw std::runtime_error{__FILE__ " error in line " + std::to_string(__LINE__) + " failed to read 80 bytes."};
+            return STLA;
         }
-        size_t nT = read_int(in, swapFlag);
 
+        // the number of triangles is stored in little endian
+        const unsigned char* c = reinterpret_cast<const unsigned char*>(data + 80);
+        size_t nT = size_t(c[0]) | (size_t(c[1]) << 8) | (size_t(c[2]) << 16) | (size_t(c[3]) << 24);
 
         // compute file size from nT
         size_t binary_size = 84 + nT * 50;
 
-
-        // get actual file size
-        size_t file_size(0);
-        rewind(in);
-
-        while (!feof(in))
-        {
-            file_size += fread(dummy, 1, 100, in);
-        }
-
-        fclose(in);
-
-
         // if sizes match -> it's STLB
-        return (binary_size == file_size ? STLB : STLA);
+        return (binary_size == size ? STLB : STLA);
     }
 
     void STLReader::setScaling(float s)
@@ -613,4 +583,3 @@ namespace VirtualRobot
 
     //=============================================================================
 } // namespace
-
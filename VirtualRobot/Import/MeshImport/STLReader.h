@@ -9,6 +9,7 @@
 #include "VirtualRobot/VirtualRobot.h"
 
 #include <stdio.h>
+#include <istream>
 #include <string>
 
 
@@ -17,6 +18,7 @@ namespace VirtualRobot
 
     /**
         Implementation of the STL format reader.
+        Files are mapped into memory and parsed in place, identical vertices are merged with a hash grid while reading.
     */
     class VIRTUAL_ROBOT_IMPORT_EXPORT STLReader
     {
@@ -45,6 +47,9 @@ namespace VirtualRobot
         // read data and store it to trimesh
         bool read(std::istream& _in, STL_Type stltype, TriMeshModelPtr t);
 
+        // read data from memory and store it to trimesh
+        bool read(const char* data, size_t size, STL_Type stltype, TriMeshModelPtr t);
+
         /** Set the threshold to be used for considering two point to be equal.
             Can be used to merge small gaps */
         void set_epsilon(float _eps)
@@ -62,18 +67,10 @@ namespace VirtualRobot
 
     private:
 
-        int read_int(FILE* _in, bool _swap) const;
-        float read_float(FILE* _in, bool _swap = false) const;
-
-        float read_float(std::istream& _in, bool _swap = false) const;
-        int read_int(std::istream& _in, bool _swap = false) const;
-
-        STL_Type check_stl_type(const std::string& _filename) const;
+        STL_Type check_stl_type(const char* data, size_t size) const;
 
-        bool read_stla(const std::string& _filename, TriMeshModelPtr t) const;
-        bool read_stla(std::istream& _in, TriMeshModelPtr t) const;
-        bool read_stlb(const std::string& _filename, TriMeshModelPtr t) const;
-        bool read_stlb(std::istream& _in, TriMeshModelPtr t) const;
+        bool read_stla(const char* data, size_t size, TriMeshModel& t) const;
+        bool read_stlb(const char* data, size_t size, TriMeshModel& t) const;
 
 
     private:
@@ -581,20 +581,25 @@ namespace VirtualRobot
     {
         Eigen::Vector3f res;
         res.setZero();
+        float m = 0;
 
-        float m = getMass();
-
-        if (m <= 0)
+        for (size_t i = 0; i < this->robotNodes.size(); i++)
         {
-            return res;
+            float mi = robotNodes[i]->getMass();
+
+            if (mi != 0)
+            {
+                res += robotNodes[i]->getCoMGlobal() * mi;
+                m += mi;
+            }
         }
 
-        for (size_t i = 0; i < this->robotNodes.size(); i++)
+        if (m <= 0)
         {
-            res += robotNodes[i]->getCoMGlobal() * robotNodes[i]->getMass() / m;
+            return Eigen::Vector3f::Zero();
         }
 
-        return res;
+        return res / m;
     }
 
     float RobotNodeSet::getMass()
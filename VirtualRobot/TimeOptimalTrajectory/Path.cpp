@@ -207,6 +207,7 @@ namespace VirtualRobot
         // create list of switching point candidates, calculate total path length and absolute positions of path segments
         for(auto & pathSegment : pathSegments) {
             pathSegment->position = length;
+            segmentPositions.push_back(length);
             list<double> localSwitchingPoints = pathSegment->getSwitchingPoints();
             for(list<double>::const_iterator point = localSwitchingPoints.begin(); point != localSwitchingPoints.end(); point++) {
                 switchingPoints.push_back(make_pair(length + *point, false));
@@ -221,8 +222,10 @@ namespace VirtualRobot
 
     Path::Path(const Path &path) :
         length(path.length),
-        switchingPoints(path.switchingPoints)
+        switchingPoints(path.switchingPoints),
+        segmentPositions(path.segmentPositions)
     {
+        pathSegments.reserve(path.pathSegments.size());
         for(auto pathSegment : path.pathSegments) {
             pathSegments.push_back(pathSegment->clone());
         }
@@ -239,15 +242,11 @@ namespace VirtualRobot
     }
 
     PathSegment* Path::getPathSegment(double &s) const {
-        list<PathSegment*>::const_iterator it = pathSegments.begin();
-        list<PathSegment*>::const_iterator next = it;
-        next++;
-        while(next != pathSegments.end() && s >= (*next)->position) {
-            it = next;
-            next++;
-        }
-        s -= (*it)->position;
-        return *it;
+        // the last segment that starts at or before s
+        vector<double>::const_iterator it = upper_bound(segmentPositions.begin() + 1, segmentPositions.end(), s);
+        PathSegment* pathSegment = pathSegments[it - segmentPositions.begin() - 1];
+        s -= pathSegment->position;
+        return pathSegment;
     }
 
     VectorXd Path::getConfig(double s) const {
@@ -266,10 +265,8 @@ namespace VirtualRobot
     }
 
     double Path::getNextSwitchingPoint(double s, bool &discontinuity) const {
-        list<pair<double, bool> >::const_iterator it = switchingPoints.begin();
-        while(it != switchingPoints.end() && it->first <= s) {
-            it++;
-        }
+        vector<pair<double, bool> >::const_iterator it = upper_bound(switchingPoints.begin(), switchingPoints.end(), s,
+            [](double s, const pair<double, bool> &point) { return s < point.first; });
         if(it == switchingPoints.end()) {
             discontinuity = true;
             return length;
@@ -280,8 +277,7 @@ namespace VirtualRobot
         }
     }
 
-    list<pair<double, bool> > Path::getSwitchingPoints() const {
+    const vector<pair<double, bool> >& Path::getSwitchingPoints() const {
         return switchingPoints;
     }
 }
-
@@ -40,6 +40,7 @@
 
 #include "../VirtualRobot.h"
 #include <list>
+#include <vector>
 #include <Eigen/Core>
 
 namespace VirtualRobot
@@ -81,12 +82,14 @@ namespace VirtualRobot
         Eigen::VectorXd getTangent(double s) const;
         Eigen::VectorXd getCurvature(double s) const;
         double getNextSwitchingPoint(double s, bool &discontinuity) const;
-        std::list<std::pair<double, bool> > getSwitchingPoints() const;
+        const std::vector<std::pair<double, bool> >& getSwitchingPoints() const;
     private:
+        // finds the segment by binary search and makes s relative to it
         PathSegment* getPathSegment(double &s) const;
         double length;
-        std::list<std::pair<double, bool> > switchingPoints;
-        std::list<PathSegment*> pathSegments;
+        std::vector<std::pair<double, bool> > switchingPoints;
+        std::vector<PathSegment*> pathSegments;
+        std::vector<double> segmentPositions; // the positions of the path segments, for the search
     };
 }
 
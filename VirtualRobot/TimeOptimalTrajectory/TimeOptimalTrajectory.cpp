@@ -37,6 +37,8 @@
  */
 
 #include "TimeOptimalTrajectory.h"
+#include "../VirtualRobotException.h"
+#include <algorithm>
 #include <limits>
 #include <iostream>
 #include <fstream>
@@ -58,8 +60,7 @@ namespace VirtualRobot
         maxAcceleration(maxAcceleration),
         n(maxVelocity.size()),
         valid(true),
-        timeStep(timeStep),
-        cachedTime(numeric_limits<double>::max())
+        timeStep(timeStep)
     {
         trajectory.push_back(TimeOptimalTrajectoryStep(0.0, 0.0));
         double afterAcceleration = getMinMaxPathAcceleration(0.0, 0.0, true);
@@ -79,14 +80,9 @@ namespace VirtualRobot
 
         if(valid) {
             // calculate timing
-            list<TimeOptimalTrajectoryStep>::iterator previous = trajectory.begin();
-            list<TimeOptimalTrajectoryStep>::iterator it = previous;
-            it->time = 0.0;
-            it++;
-            while(it != trajectory.end()) {
-                it->time = previous->time + (it->pathPos - previous->pathPos) / ((it->pathVel + previous->pathVel) / 2.0);
-                previous = it;
-                it++;
+            trajectory.front().time = 0.0;
+            for(size_t i = 1; i < trajectory.size(); i++) {
+                trajectory[i].time = trajectory[i - 1].time + (trajectory[i].pathPos - trajectory[i - 1].pathPos) / ((trajectory[i].pathVel + trajectory[i - 1].pathVel) / 2.0);
             }
         }
     }
@@ -230,13 +226,13 @@ namespace VirtualRobot
     }
 
     // returns true if end of path is reached
-    bool TimeOptimalTrajectory::integrateForward(list<TimeOptimalTrajectoryStep> &trajectory, double acceleration) {
+    bool TimeOptimalTrajectory::integrateForward(vector<TimeOptimalTrajectoryStep> &trajectory, double acceleration) {
 
         double pathPos = trajectory.back().pathPos;
         double pathVel = trajectory.back().pathVel;
 
-        list<pair<double, bool> > switchingPoints = path.getSwitchingPoints();
-        list<pair<double, bool> >::iterator nextDiscontinuity = switchingPoints.begin();
+        const vector<pair<double, bool> > &switchingPoints = path.getSwitchingPoints();
+        vector<pair<double, bool> >::const_iterator nextDiscontinuity = switchingPoints.begin();
 
         while(true)
         {
@@ -320,28 +316,26 @@ namespace VirtualRobot
         }
     }
 
-    void TimeOptimalTrajectory::integrateBackward(list<TimeOptimalTrajectoryStep> &startTrajectory, double pathPos, double pathVel, double acceleration) {
-        list<TimeOptimalTrajectoryStep>::iterator start2 = startTrajectory.end();
-        start2--;
-        list<TimeOptimalTrajectoryStep>::iterator start1 = start2;
-        start1--;
-        list<TimeOptimalTrajectoryStep> trajectory;
+    void TimeOptimalTrajectory::integrateBackward(vector<TimeOptimalTrajectoryStep> &startTrajectory, double pathPos, double pathVel, double acceleration) {
+        size_t start2 = startTrajectory.size() - 1;
+        size_t start1 = start2 - 1;
+        vector<TimeOptimalTrajectoryStep> trajectory; // in reverse order, back() is the first step
         double slope;
-        assert(start1->pathPos <= pathPos);
+        assert(startTrajectory[start1].pathPos <= pathPos);
 
-        while(start1 != startTrajectory.begin() || pathPos >= 0.0)
+        while(start1 != 0 || pathPos >= 0.0)
         {
-            if(start1->pathPos <= pathPos) {
-                trajectory.push_front(TimeOptimalTrajectoryStep(pathPos, pathVel));
+            if(startTrajectory[start1].pathPos <= pathPos) {
+                trajectory.push_back(TimeOptimalTrajectoryStep(pathPos, pathVel));
                 pathVel -= timeStep * acceleration;
-                pathPos -= timeStep * 0.5 * (pathVel + trajectory.front().pathVel);
+                pathPos -= timeStep * 0.5 * (pathVel + trajectory.back().pathVel);
                 acceleration = getMinMaxPathAcceleration(pathPos, pathVel, false);
-                slope = (trajectory.front().pathVel - pathVel) / (trajectory.front().pathPos - pathPos);
+                slope = (trajectory.back().pathVel - pathVel) / (trajectory.back().pathPos - pathPos);
 
                 if(pathVel < 0.0) {
                     valid = false;
                     cout << "Error while integrating backward: Negative path velocity" << endl;
-                    endTrajectory = trajectory;
+                    endTrajectory.assign(trajectory.rbegin(), trajectory.rend());
                     return;
                 }
             }
@@ -351,20 +345,22 @@ namespace VirtualRobot
             }
 
             // check for intersection between current start trajectory and backward trajectory segments
-            const double startSlope = (start2->pathVel - start1->pathVel) / (start2->pathPos - start1->pathPos);
-            const double intersectionPathPos = (start1->pathVel - pathVel + slope * pathPos - startSlope * start1->pathPos) / (slope - startSlope);
-            if(max(start1->pathPos, pathPos) - eps <= intersectionPathPos && intersectionPathPos <= eps + min(start2->pathPos, trajectory.front().pathPos)) {
-                const double intersectionPathVel = start1->pathVel + startSlope * (intersectionPathPos - start1->pathPos);
-                startTrajectory.erase(start2, startTrajectory.end());
+            const TimeOptimalTrajectoryStep &step1 = startTrajectory[start1];
+            const TimeOptimalTrajectoryStep &step2 = startTrajectory[start2];
+            const double startSlope = (step2.pathVel - step1.pathVel) / (step2.pathPos - step1.pathPos);
+            const double intersectionPathPos = (step1.pathVel - pathVel + slope * pathPos - startSlope * step1.pathPos) / (slope - startSlope);
+            if(max(step1.pathPos, pathPos) - eps <= intersectionPathPos && intersectionPathPos <= eps + min(step2.pathPos, trajectory.back().pathPos)) {
+                const double intersectionPathVel = step1.pathVel + startSlope * (intersectionPathPos - step1.pathPos);
+                startTrajectory.resize(start2);
                 startTrajectory.push_back(TimeOptimalTrajectoryStep(intersectionPathPos, intersectionPathVel));
-                startTrajectory.splice(startTrajectory.end(), trajectory);
+                startTrajectory.insert(startTrajectory.end(), trajectory.rbegin(), trajectory.rend());
                 return;
             }
         }
 
         valid = false;
         cout << "Error while integrating backward: Did not hit start trajectory" << endl;
-        endTrajectory = trajectory;
+        endTrajectory.assign(trajectory.rbegin(), trajectory.rend());
     }
 
     double TimeOptimalTrajectory::getMinMaxPathAcceleration(double pathPos, double pathVel, bool max) {
@@ -446,50 +442,73 @@ namespace VirtualRobot
         return trajectory.back().time;
     }
 
-    list<TimeOptimalTrajectory::TimeOptimalTrajectoryStep>::const_iterator TimeOptimalTrajectory::getTrajectorySegment(double time) const {
+    size_t TimeOptimalTrajectory::getTrajectorySegment(double time) const {
         if(time >= trajectory.back().time) {
-            list<TimeOptimalTrajectoryStep>::const_iterator last = trajectory.end();
-            last--;
-            return last;
-        }
-        else {
-            if(time < cachedTime) {
-                cachedTrajectorySegment = trajectory.begin();
-            }
-            while(time >= cachedTrajectorySegment->time) {
-                cachedTrajectorySegment++;
-            }
-            cachedTime = time;
-            return cachedTrajectorySegment;
+            return trajectory.size() - 1;
         }
+        vector<TimeOptimalTrajectoryStep>::const_iterator it = upper_bound(trajectory.begin() + 1, trajectory.end(), time,
+            [](double time, const TimeOptimalTrajectoryStep &step) { return time < step.time; });
+        return it - trajectory.begin();
     }
 
-    VectorXd TimeOptimalTrajectory::getPosition(double time) const {
-        list<TimeOptimalTrajectoryStep>::const_iterator it = getTrajectorySegment(time);
-        list<TimeOptimalTrajectoryStep>::const_iterator previous = it;
-        previous--;
+    void TimeOptimalTrajectory::getPathPosAndVel(size_t segment, double time, double &pathPos, double &pathVel) const {
+        const TimeOptimalTrajectoryStep &previous = trajectory[segment - 1];
+        const TimeOptimalTrajectoryStep &next = trajectory[segment];
 
-        double timeStep = it->time - previous->time;
-        const double acceleration = 2.0 * (it->pathPos - previous->pathPos - timeStep * previous->pathVel) / (timeStep * timeStep);
+        double timeStep = next.time - previous.time;
+        const double acceleration = 2.0 * (next.pathPos - previous.pathPos - timeStep * previous.pathVel) / (timeStep * timeStep);
 
-        timeStep = time - previous->time;
-        const double pathPos = previous->pathPos + timeStep * previous->pathVel + 0.5 * timeStep * timeStep * acceleration;
+        timeStep = time - previous.time;
+        pathPos = previous.pathPos + timeStep * previous.pathVel + 0.5 * timeStep * timeStep * acceleration;
+        pathVel = previous.pathVel + timeStep * acceleration;
+    }
 
+    VectorXd TimeOptimalTrajectory::getPosition(double time) const {
+        double pathPos, pathVel;
+        getPathPosAndVel(getTrajectorySegment(time), time, pathPos, pathVel);
         return path.getConfig(pathPos);
     }
 
     VectorXd TimeOptimalTrajectory::getVelocity(double time) const {
-        list<TimeOptimalTrajectoryStep>::const_iterator it = getTrajectorySegment(time);
-        list<TimeOptimalTrajectoryStep>::const_iterator previous = it;
-        previous--;
+        double pathPos, pathVel;
+        getPathPosAndVel(getTrajectorySegment(time), time, pathPos, pathVel);
+        return path.getTangent(pathPos) * pathVel;
+    }
 
-        double timeStep = it->time - previous->time;
-        const double acceleration = 2.0 * (it->pathPos - previous->pathPos - timeStep * previous->pathVel) / (timeStep * timeStep);
+    size_t TimeOptimalTrajectory::getNumSamples(double samplePeriod) const {
+        THROW_VR_EXCEPTION_IF(samplePeriod <= 0.0, "The sample period has to be positive");
+        return size_t(getDuration() / samplePeriod) + 1;
+    }
 
-        timeStep = time - previous->time;
-        const double pathPos = previous->pathPos + timeStep * previous->pathVel + 0.5 * timeStep * timeStep * acceleration;
-        const double pathVel = previous->pathVel + timeStep * acceleration;
+    void TimeOptimalTrajectory::sample(double samplePeriod, MatrixXd &positions) const {
+        sample(samplePeriod, positions, nullptr);
+    }
 
-        return path.getTangent(pathPos) * pathVel;
+    void TimeOptimalTrajectory::sample(double samplePeriod, MatrixXd &positions, MatrixXd &velocities) const {
+        sample(samplePeriod, positions, &velocities);
+    }
+
+    void TimeOptimalTrajectory::sample(double samplePeriod, MatrixXd &positions, MatrixXd *velocities) const {
+        const size_t numSamples = getNumSamples(samplePeriod);
+        positions.resize(n, numSamples);
+        if(velocities) {
+            velocities->resize(n, numSamples);
+        }
+
+        // the sample times increase, hence the segment is found by moving forward instead of searching
+        size_t segment = 1;
+        for(size_t i = 0; i < numSamples; i++) {
+            const double time = i * samplePeriod;
+            while(segment + 1 < trajectory.size() && trajectory[segment].time <= time) {
+                segment++;
+            }
+
+            double pathPos, pathVel;
+            getPathPosAndVel(segment, time, pathPos, pathVel);
+            positions.col(i) = path.getConfig(pathPos);
+            if(velocities) {
+                velocities->col(i) = path.getTangent(pathPos) * pathVel;
+            }
+        }
     }
 }
@@ -40,6 +40,7 @@
 
 #include "../VirtualRobot.h"
 #include <Eigen/Core>
+#include <vector>
 #include "Path.h"
 
 namespace VirtualRobot
@@ -69,6 +70,14 @@ namespace VirtualRobot
         Eigen::VectorXd getPosition(double time) const;
         Eigen::VectorXd getVelocity(double time) const;
 
+        // Returns the number of samples of the trajectory at the times 0, samplePeriod, 2 * samplePeriod, ... <= getDuration().
+        size_t getNumSamples(double samplePeriod) const;
+
+        // Samples the trajectory at a fixed rate, e.g. for a 1 kHz controller, and stores one sample per column.
+        // The matrices are only resized if their size does not fit, hence they can be reused without allocations.
+        void sample(double samplePeriod, Eigen::MatrixXd &positions) const;
+        void sample(double samplePeriod, Eigen::MatrixXd &positions, Eigen::MatrixXd &velocities) const;
+
         // Outputs the phase trajectory and the velocity limit curve in 2 files for debugging purposes.
         void outputPhasePlaneTrajectory() const;
 
@@ -87,8 +96,8 @@ namespace VirtualRobot
         bool getNextSwitchingPoint(double pathPos, TimeOptimalTrajectoryStep &nextSwitchingPoint, double &beforeAcceleration, double &afterAcceleration);
         bool getNextAccelerationSwitchingPoint(double pathPos, TimeOptimalTrajectoryStep &nextSwitchingPoint, double &beforeAcceleration, double &afterAcceleration);
         bool getNextVelocitySwitchingPoint(double pathPos, TimeOptimalTrajectoryStep &nextSwitchingPoint, double &beforeAcceleration, double &afterAcceleration);
-        bool integrateForward(std::list<TimeOptimalTrajectoryStep> &trajectory, double acceleration);
-        void integrateBackward(std::list<TimeOptimalTrajectoryStep> &startTrajectory, double pathPos, double pathVel, double acceleration);
+        bool integrateForward(std::vector<TimeOptimalTrajectoryStep> &trajectory, double acceleration);
+        void integrateBackward(std::vector<TimeOptimalTrajectoryStep> &startTrajectory, double pathPos, double pathVel, double acceleration);
         double getMinMaxPathAcceleration(double pathPosition, double pathVelocity, bool max);
         double getMinMaxPhaseSlope(double pathPosition, double pathVelocity, bool max);
         double getAccelerationMaxPathVelocity(double pathPos) const;
@@ -96,21 +105,21 @@ namespace VirtualRobot
         double getAccelerationMaxPathVelocityDeriv(double pathPos);
         double getVelocityMaxPathVelocityDeriv(double pathPos);
 
-        std::list<TimeOptimalTrajectoryStep>::const_iterator getTrajectorySegment(double time) const;
+        // Returns the index of the first step after the time (by binary search), or the last step.
+        size_t getTrajectorySegment(double time) const;
+        void getPathPosAndVel(size_t segment, double time, double &pathPos, double &pathVel) const;
+        void sample(double samplePeriod, Eigen::MatrixXd &positions, Eigen::MatrixXd *velocities) const;
 
         Path path;
         Eigen::VectorXd maxVelocity;
         Eigen::VectorXd maxAcceleration;
         unsigned int n;
         bool valid;
-        std::list<TimeOptimalTrajectoryStep> trajectory;
-        std::list<TimeOptimalTrajectoryStep> endTrajectory; // non-empty only if the trajectory generation failed.
+        std::vector<TimeOptimalTrajectoryStep> trajectory;
+        std::vector<TimeOptimalTrajectoryStep> endTrajectory; // non-empty only if the trajectory generation failed.
 
         static const double eps;
         const double timeStep;
-
-        mutable double cachedTime;
-        mutable std::list<TimeOptimalTrajectoryStep>::const_iterator cachedTrajectorySegment;
     };
 }
 
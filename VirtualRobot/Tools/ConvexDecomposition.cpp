@@ -0,0 +1,1204 @@
+#include "ConvexDecomposition.h"
+
+#include "../Visualization/TriMeshModel.h"
+#include "../VirtualRobotException.h"
+
+#include <Eigen/Eigenvalues>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <queue>
+#include <sstream>
+
+using namespace VirtualRobot;
+
+namespace
+{
+    const char cacheMagic[4] = {'S', 'X', 'C', 'D'};
+    const uint32_t cacheVersion = 1;
+
+    struct HullFace
+    {
+        int v[3];
+        Eigen::Vector3d normal;
+        double offset; // normal * p = offset on the face
+        bool alive;
+    };
+
+    double distance(const HullFace& f, const Eigen::Vector3d& p)
+    {
+        return f.normal.dot(p) - f.offset;
+    }
+
+    /*!
+        The initial tetrahedron: the most distant pair of extreme points, the farthest point from their line
+        and the farthest point from their plane. Returns false if the points are (nearly) coplanar.
+    */
+    bool findSimplex(const std::vector<Eigen::Vector3d>& points, int storeIds[4], double& eps)
+    {
+        if (points.size() < 4)
+        {
+            return false;
+        }
+
+        Eigen::Vector3d minP = points[0];
+        Eigen::Vector3d maxP = points[0];
+        int extremes[6] = {0, 0, 0, 0, 0, 0};
+
+        for (size_t i = 1; i < points.size(); i++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                if (points[i][k] < minP[k])
+                {
+                    minP[k] = points[i][k];
+                    extremes[2 * k] = int(i);
+                }
+
+                if (points[i][k] > maxP[k])
+                {
+                    maxP[k] = points[i][k];
+                    extremes[2 * k + 1] = int(i);
+                }
+            }
+        }
+
+        double extent = (maxP - minP).norm();
+
+        if (extent <= 0)
+        {
+            return false;
+        }
+
+        eps = extent * 1e-6;
+        double best = -1;
+
+        for (int a = 0; a < 6; a++)
+        {
+            for (int b = a + 1; b < 6; b++)
+            {
+                double d = (points[extremes[a]] - points[extremes[b]]).squaredNorm();
+
+                if (d > best)
+                {
+                    best = d;
+                    storeIds[0] = extremes[a];
+                    storeIds[1] = extremes[b];
+                }
+            }
+        }
+
+        const Eigen::Vector3d& p0 = points[storeIds[0]];
+        Eigen::Vector3d dir = (points[storeIds[1]] - p0).normalized();
+        storeIds[2] = -1;
+        best = eps;
+
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            double d = (points[i] - p0).cross(dir).norm();
+
+            if (d > best)
+            {
+                best = d;
+                storeIds[2] = int(i);
+            }
+        }
+
+        if (storeIds[2] < 0)
+        {
+            return false;
+        }
+
+        Eigen::Vector3d planeNormal = (points[storeIds[1]] - p0).cross(points[storeIds[2]] - p0).normalized();
+        storeIds[3] = -1;
+        best = eps * 10;
+
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            double d = std::abs(planeNormal.dot(points[i] - p0));
+
+            if (d > best)
+            {
+                best = d;
+                storeIds[3] = int(i);
+            }
+        }
+
+        return storeIds[3] >= 0;
+    }
+
+    /*!
+        Incremental hull (quickhull without conflict lists), the face normals point outwards.
+        Returns false if the points are (nearly) coplanar.
+    */
+    bool buildHull(const std::vector<Eigen::Vector3d>& points, std::vector<HullFace>& faces, double& eps)
+    {
+        faces.clear();
+        int simplex[4];
+
+        if (!findSimplex(points, simplex, eps))
+        {
+            return false;
+        }
+
+        const int i0 = simplex[0], i1 = simplex[1], i2 = simplex[2], i3 = simplex[3];
+        const Eigen::Vector3d inner = (points[i0] + points[i1] + points[i2] + points[i3]) / 4.0;
+
+        auto addFace = [&](int a, int b, int c)
+        {
+            HullFace f;
+            f.normal = (points[b] - points[a]).cross(points[c] - points[a]);
+            double n = f.normal.norm();
+            f.normal = n > 0 ? Eigen::Vector3d(f.normal / n) : Eigen::Vector3d::UnitZ();
+            f.v[0] = a;
+            f.v[1] = b;
+            f.v[2] = c;
+            f.offset = f.normal.dot(points[a]);
+
+            if (distance(f, inner) > 0)
+            {
+                std::swap(f.v[1], f.v[2]);
+                f.normal = -f.normal;
+                f.offset = -f.offset;
+            }
+
+            f.alive = true;
+            faces.push_back(f);
+        };
+
+        addFace(i0, i1, i2);
+        addFace(i0, i1, i3);
+        addFace(i0, i2, i3);
+        addFace(i1, i2, i3);
+
+        // far points first, most of the remaining points are inside then
+        std::vector<std::pair<double, int> > order;
+        order.reserve(points.size());
+
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            if (int(i) != i0 && int(i) != i1 && int(i) != i2 && int(i) != i3)
+            {
+                order.push_back(std::make_pair(-(points[i] - inner).squaredNorm(), int(i)));
+            }
+        }
+
+        std::sort(order.begin(), order.end());
+
+        std::vector<size_t> visible;
+        std::map<std::pair<int, int>, int> edges;
+        size_t numAlive = faces.size();
+
+        for (const auto& o : order)
+        {
+            const Eigen::Vector3d& p = points[o.second];
+            visible.clear();
+
+            for (size_t f = 0; f < faces.size(); f++)
+            {
+                if (faces[f].alive && distance(faces[f], p) > eps)
+                {
+                    visible.push_back(f);
+                }
+            }
+
+            if (visible.empty())
+            {
+                continue;
+            }
+
+            // the horizon consists of the edges that belong to exactly one visible face
+            edges.clear();
+
+            for (size_t f : visible)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    int a = faces[f].v[k];
+                    int b = faces[f].v[(k + 1) % 3];
+                    edges[std::make_pair(std::min(a, b), std::max(a, b))]++;
+                }
+
+                faces[f].alive = false;
+            }
+
+            numAlive -= visible.size();
+
+            for (const auto& e : edges)
+            {
+                if (e.second == 1)
+                {
+                    addFace(e.first.first, e.first.second, o.second);
+                    numAlive++;
+                }
+            }
+
+            if (faces.size() > 2 * numAlive + 64)
+            {
+                faces.erase(std::remove_if(faces.begin(), faces.end(), [](const HullFace & f)
+                {
+                    return !f.alive;
+                }), faces.end());
+            }
+        }
+
+        faces.erase(std::remove_if(faces.begin(), faces.end(), [](const HullFace & f)
+        {
+            return !f.alive;
+        }), faces.end());
+        return true;
+    }
+
+    /*!
+        The volume of the convex hull. storeSlantedArea is the area of the hull weighted by the deviation of the
+        face normals from the coordinate axes (|n|_1 - |n|_inf), which is zero for axis aligned faces.
+    */
+    double hullVolume(const std::vector<Eigen::Vector3d>& points, double& storeSlantedArea)
+    {
+        std::vector<HullFace> faces;
+        double eps;
+        storeSlantedArea = 0;
+
+        if (!buildHull(points, faces, eps))
+        {
+            return 0.0;
+        }
+
+        const Eigen::Vector3d& ref = points[faces[0].v[0]];
+        double volume = 0;
+
+        for (const HullFace& f : faces)
+        {
+            Eigen::Vector3d n = (points[f.v[1]] - points[f.v[0]]).cross(points[f.v[2]] - points[f.v[0]]);
+            volume += (points[f.v[0]] - ref).dot(n);
+            storeSlantedArea += (f.normal.lpNorm<1>() - f.normal.lpNorm<Eigen::Infinity>()) * n.norm() / 2;
+        }
+
+        return volume / 6.0;
+    }
+
+    struct VoxelGrid
+    {
+        Eigen::Vector3f origin;
+        float size; // edge length of a voxel
+        int dims[3];
+        std::vector<uint8_t> state; // eUnknown: inside, eSurface, eOutside
+        std::vector<int> prefix; // 3D prefix sums of solid voxels, (dims + 1)^3
+
+        enum
+        {
+            eUnknown = 0,
+            eSurface = 1,
+            eOutside = 2
+        };
+
+        int index(int x, int y, int z) const
+        {
+            return (z * dims[1] + y) * dims[0] + x;
+        }
+
+        int prefixIndex(int x, int y, int z) const
+        {
+            return (z * (dims[1] + 1) + y) * (dims[0] + 1) + x;
+        }
+
+        bool solid(int x, int y, int z) const
+        {
+            return state[index(x, y, z)] != eOutside;
+        }
+
+        Eigen::Vector3d corner(int x, int y, int z) const
+        {
+            return (origin + Eigen::Vector3f(float(x), float(y), float(z)) * size).cast<double>();
+        }
+
+        void build(const TriMeshModel& mesh, const Eigen::Vector3f& minP, const Eigen::Vector3f& maxP, int resolution)
+        {
+            Eigen::Vector3f extent = maxP - minP;
+            size = std::max(extent.maxCoeff() / float(resolution), 1e-6f);
+            // at least one free layer on each side, so that the outside is connected
+            origin = minP - Eigen::Vector3f::Constant(1.5f * size);
+
+            for (int k = 0; k < 3; k++)
+            {
+                dims[k] = int(std::floor(extent[k] / size)) + 4;
+            }
+
+            state.assign(size_t(dims[0]) * dims[1] * dims[2], eUnknown);
+
+            // samples on (or very close to) a voxel boundary mark the voxels on both sides,
+            // otherwise rounding may leave holes in faces that are aligned with the grid
+            auto mark = [&](const Eigen::Vector3f & p)
+            {
+                Eigen::Vector3f q = (p - origin) / size;
+                int lo[3], hi[3];
+
+                for (int k = 0; k < 3; k++)
+                {
+                    lo[k] = std::min(std::max(int(std::floor(q[k] - 1e-3f)), 0), dims[k] - 1);
+                    hi[k] = std::min(std::max(int(std::floor(q[k] + 1e-3f)), 0), dims[k] - 1);
+                }
+
+                for (int z = lo[2]; z <= hi[2]; z++)
+                {
+                    for (int y = lo[1]; y <= hi[1]; y++)
+                    {
+                        for (int x = lo[0]; x <= hi[0]; x++)
+                        {
+                            state[index(x, y, z)] = eSurface;
+                        }
+                    }
+                }
+            };
+
+            for (const auto& face : mesh.faces)
+            {
+                const Eigen::Vector3f& v0 = mesh.vertices[face.id1];
+                const Eigen::Vector3f& v1 = mesh.vertices[face.id2];
+                const Eigen::Vector3f& v2 = mesh.vertices[face.id3];
+                float maxEdge = std::max((v1 - v0).norm(), std::max((v2 - v0).norm(), (v2 - v1).norm()));
+                int n = std::max(1, int(std::ceil(maxEdge / (0.5f * size))));
+
+                for (int a = 0; a <= n; a++)
+                {
+                    for (int b = 0; b <= n - a; b++)
+                    {
+                        mark(v0 + (v1 - v0) * (float(a) / n) + (v2 - v0) * (float(b) / n));
+                    }
+                }
+            }
+
+            // flood fill the outside, starting at the padding
+            std::vector<int> stack(1, 0);
+            state[0] = eOutside;
+
+            while (!stack.empty())
+            {
+                int i = stack.back();
+                stack.pop_back();
+                int x = i % dims[0];
+                int y = (i / dims[0]) % dims[1];
+                int z = i / (dims[0] * dims[1]);
+                const int neighbors[6][3] = {{x - 1, y, z}, {x + 1, y, z}, {x, y - 1, z}, {x, y + 1, z}, {x, y, z - 1}, {x, y, z + 1}};
+
+                for (const auto& n : neighbors)
+                {
+                    if (n[0] < 0 || n[1] < 0 || n[2] < 0 || n[0] >= dims[0] || n[1] >= dims[1] || n[2] >= dims[2])
+                    {
+                        continue;
+                    }
+
+                    int j = index(n[0], n[1], n[2]);
+
+                    if (state[j] == eUnknown)
+                    {
+                        state[j] = eOutside;
+                        stack.push_back(j);
+                    }
+                }
+            }
+
+            prefix.assign(size_t(dims[0] + 1) * (dims[1] + 1) * (dims[2] + 1), 0);
+
+            for (int z = 0; z < dims[2]; z++)
+            {
+                for (int y = 0; y < dims[1]; y++)
+                {
+                    for (int x = 0; x < dims[0]; x++)
+                    {
+                        prefix[prefixIndex(x + 1, y + 1, z + 1)] = int(solid(x, y, z))
+                                + prefix[prefixIndex(x, y + 1, z + 1)] + prefix[prefixIndex(x + 1, y, z + 1)] + prefix[prefixIndex(x + 1, y + 1, z)]
+                                - prefix[prefixIndex(x, y, z + 1)] - prefix[prefixIndex(x, y + 1, z)] - prefix[prefixIndex(x + 1, y, z)]
+                                + prefix[prefixIndex(x, y, z)];
+                    }
+                }
+            }
+        }
+
+        int countSolid(const int lo[3], const int hi[3]) const
+        {
+            return prefix[prefixIndex(hi[0], hi[1], hi[2])]
+                   - prefix[prefixIndex(lo[0], hi[1], hi[2])] - prefix[prefixIndex(hi[0], lo[1], hi[2])] - prefix[prefixIndex(hi[0], hi[1], lo[2])]
+                   + prefix[prefixIndex(lo[0], lo[1], hi[2])] + prefix[prefixIndex(lo[0], hi[1], lo[2])] + prefix[prefixIndex(hi[0], lo[1], lo[2])]
+                   - prefix[prefixIndex(lo[0], lo[1], lo[2])];
+        }
+
+        /*!
+            The voxel corners in the range that may lie on the convex hull of its solid voxels:
+            the lowest and highest corner of each vertical line of corners.
+        */
+        void hullCandidates(const int lo[3], const int hi[3], std::vector<Eigen::Vector3d>& storePoints) const
+        {
+            storePoints.clear();
+            const int nx = hi[0] - lo[0] + 1;
+            const int ny = hi[1] - lo[1] + 1;
+            std::vector<int> lowest(size_t(nx) * ny, std::numeric_limits<int>::max());
+            std::vector<int> highest(size_t(nx) * ny, -1);
+
+            for (int y = lo[1]; y < hi[1]; y++)
+            {
+                for (int x = lo[0]; x < hi[0]; x++)
+                {
+                    int first = -1, last = -1;
+
+                    for (int z = lo[2]; z < hi[2]; z++)
+                    {
+                        if (solid(x, y, z))
+                        {
+                            if (first < 0)
+                            {
+                                first = z;
+                            }
+
+                            last = z;
+                        }
+                    }
+
+                    if (first < 0)
+                    {
+                        continue;
+                    }
+
+                    for (int corner = 0; corner < 4; corner++)
+                    {
+                        int i = (y - lo[1] + corner / 2) * nx + (x - lo[0] + corner % 2);
+                        lowest[i] = std::min(lowest[i], first);
+                        highest[i] = std::max(highest[i], last + 1);
+                    }
+                }
+            }
+
+            for (int y = 0; y < ny; y++)
+            {
+                for (int x = 0; x < nx; x++)
+                {
+                    int i = y * nx + x;
+
+                    if (highest[i] >= 0)
+                    {
+                        storePoints.push_back(corner(lo[0] + x, lo[1] + y, lowest[i]));
+                        storePoints.push_back(corner(lo[0] + x, lo[1] + y, highest[i]));
+                    }
+                }
+            }
+        }
+    };
+
+    struct Cell
+    {
+        int lo[3];
+        int hi[3];
+        double concavity;
+
+        bool operator<(const Cell& other) const
+        {
+            return concavity < other.concavity;
+        }
+    };
+
+    class Decomposer
+    {
+    public:
+        Decomposer(const TriMeshModel& mesh, const ConvexDecomposition::Parameters& parameters) :
+            mesh(mesh), parameters(parameters)
+        {
+        }
+
+        ConvexDecomposition::PartList run()
+        {
+            ConvexDecomposition::PartList result;
+            Eigen::Vector3f minP, maxP;
+
+            if (mesh.faces.empty() || !getBounds(minP, maxP))
+            {
+                return result;
+            }
+
+            grid.build(mesh, minP, maxP, std::max(parameters.voxelResolution, 1));
+
+            Cell root;
+
+            for (int k = 0; k < 3; k++)
+            {
+                root.lo[k] = 0;
+                root.hi[k] = grid.dims[k];
+            }
+
+            totalVolume = double(grid.countSolid(root.lo, root.hi)) * std::pow(double(grid.size), 3);
+            root.concavity = concavity(root);
+
+            std::priority_queue<Cell> open;
+            open.push(root);
+            std::vector<Cell> done;
+
+            while (!open.empty())
+            {
+                Cell c = open.top();
+
+                if (c.concavity <= parameters.maxConcavity || int(open.size() + done.size()) >= parameters.maxParts)
+                {
+                    break;
+                }
+
+                open.pop();
+                Cell left, right;
+
+                if (!split(c, left, right))
+                {
+                    done.push_back(c);
+                    continue;
+                }
+
+                for (Cell* child : {&left, &right})
+                {
+                    if (grid.countSolid(child->lo, child->hi) > 0)
+                    {
+                        open.push(*child);
+                    }
+                }
+            }
+
+            while (!open.empty())
+            {
+                done.push_back(open.top());
+                open.pop();
+            }
+
+            for (const Cell& c : done)
+            {
+                ConvexDecomposition::Part part;
+
+                if (createPart(c, part))
+                {
+                    result.push_back(part);
+                }
+            }
+
+            return result;
+        }
+
+    protected:
+        bool getBounds(Eigen::Vector3f& minP, Eigen::Vector3f& maxP) const
+        {
+            bool first = true;
+
+            for (const auto& face : mesh.faces)
+            {
+                for (unsigned int id : {face.id1, face.id2, face.id3})
+                {
+                    THROW_VR_EXCEPTION_IF(id >= mesh.vertices.size(), "Invalid vertex id in mesh");
+                    const Eigen::Vector3f& v = mesh.vertices[id];
+                    minP = first ? v : Eigen::Vector3f(minP.cwiseMin(v));
+                    maxP = first ? v : Eigen::Vector3f(maxP.cwiseMax(v));
+                    first = false;
+                }
+            }
+
+            return !first;
+        }
+
+        double concavity(const Cell& c)
+        {
+            grid.hullCandidates(c.lo, c.hi, points);
+            double solidVolume = double(grid.countSolid(c.lo, c.hi)) * std::pow(double(grid.size), 3);
+            double slantedArea;
+            double volume = hullVolume(points, slantedArea);
+            // the hull of a convex object exceeds its voxels by the notches of the voxelized surface,
+            // which are tolerated on faces that are not aligned with the grid
+            return std::max(0.0, volume - solidVolume - 0.5 * grid.size * slantedArea) / std::max(totalVolume, 1e-12);
+        }
+
+        //! Tries all voxel planes (at most 32 per axis).
+        bool split(const Cell& c, Cell& storeLeft, Cell& storeRight)
+        {
+            double bestCost = -1;
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                int length = c.hi[axis] - c.lo[axis];
+                int step = std::max(1, (length + 31) / 32);
+
+                for (int position = c.lo[axis] + step; position < c.hi[axis]; position += step)
+                {
+                    Cell left = c;
+                    Cell right = c;
+                    left.hi[axis] = position;
+                    right.lo[axis] = position;
+                    left.concavity = grid.countSolid(left.lo, left.hi) > 0 ? concavity(left) : 0.0;
+                    right.concavity = grid.countSolid(right.lo, right.hi) > 0 ? concavity(right) : 0.0;
+                    double cost = left.concavity + right.concavity;
+
+                    if (bestCost < 0 || cost < bestCost)
+                    {
+                        bestCost = cost;
+                        storeLeft = left;
+                        storeRight = right;
+                    }
+                }
+            }
+
+            return bestCost >= 0;
+        }
+
+        //! Sutherland-Hodgman clipping of all triangles against the box of the cell.
+        void clipMesh(const Eigen::Vector3f& boxMin, const Eigen::Vector3f& boxMax, std::vector<Eigen::Vector3f>& storePoints) const
+        {
+            storePoints.clear();
+            std::vector<Eigen::Vector3f> polygon, clipped;
+
+            for (const auto& face : mesh.faces)
+            {
+                const Eigen::Vector3f& v0 = mesh.vertices[face.id1];
+                const Eigen::Vector3f& v1 = mesh.vertices[face.id2];
+                const Eigen::Vector3f& v2 = mesh.vertices[face.id3];
+                Eigen::Vector3f triMin = v0.cwiseMin(v1).cwiseMin(v2);
+                Eigen::Vector3f triMax = v0.cwiseMax(v1).cwiseMax(v2);
+
+                if ((triMin.array() > boxMax.array()).any() || (triMax.array() < boxMin.array()).any())
+                {
+                    continue;
+                }
+
+                polygon.assign({v0, v1, v2});
+
+                for (int plane = 0; plane < 6 && !polygon.empty(); plane++)
+                {
+                    int axis = plane / 2;
+                    float sign = plane % 2 == 0 ? 1.0f : -1.0f;
+                    float bound = plane % 2 == 0 ? boxMin[axis] : boxMax[axis];
+                    clipped.clear();
+
+                    for (size_t i = 0; i < polygon.size(); i++)
+                    {
+                        const Eigen::Vector3f& a = polygon[i];
+                        const Eigen::Vector3f& b = polygon[(i + 1) % polygon.size()];
+                        float da = sign * (a[axis] - bound);
+                        float db = sign * (b[axis] - bound);
+
+                        if (da >= 0)
+                        {
+                            clipped.push_back(a);
+                        }
+
+                        if ((da >= 0) != (db >= 0))
+                        {
+                            clipped.push_back(a + (b - a) * (da / (da - db)));
+                        }
+                    }
+
+                    polygon.swap(clipped);
+                }
+
+                storePoints.insert(storePoints.end(), polygon.begin(), polygon.end());
+            }
+        }
+
+        bool createPart(const Cell& c, ConvexDecomposition::Part& part)
+        {
+            Eigen::Vector3f boxMin = grid.origin + Eigen::Vector3f(float(c.lo[0]), float(c.lo[1]), float(c.lo[2])) * grid.size;
+            Eigen::Vector3f boxMax = grid.origin + Eigen::Vector3f(float(c.hi[0]), float(c.hi[1]), float(c.hi[2])) * grid.size;
+            std::vector<Eigen::Vector3f> clipped;
+            clipMesh(boxMin, boxMax, clipped);
+
+            MathTools::ConvexHull3DPtr hull = ConvexDecomposition::createConvexHull(clipped);
+
+            if (clipped.empty())
+            {
+                // no surface in this cell: use the solid voxels
+                grid.hullCandidates(c.lo, c.hi, points);
+                clipped.clear();
+
+                for (const auto& p : points)
+                {
+                    clipped.push_back(p.cast<float>());
+                }
+
+                hull = ConvexDecomposition::createConvexHull(clipped);
+            }
+
+            if (hull->faces.empty())
+            {
+                // a flat piece of surface, which is covered by the neighboring parts
+                return false;
+            }
+
+            part.type = ConvexDecomposition::eConvexHull;
+            part.transform = Eigen::Matrix4f::Identity();
+            part.size.setZero();
+            part.vertices = hull->vertices;
+            part.volume = hull->volume;
+
+            if (parameters.fitPrimitives)
+            {
+                ConvexDecomposition::fitPrimitive(part, parameters.primitiveTolerance);
+            }
+
+            if (parameters.maxHullVertices > 0 && part.vertices.size() > size_t(parameters.maxHullVertices))
+            {
+                part.vertices = ConvexDecomposition::reduceHullVertices(part.vertices, size_t(parameters.maxHullVertices));
+                MathTools::ConvexHull3DPtr reduced = ConvexDecomposition::createConvexHull(part.vertices);
+                part.vertices = reduced->vertices;
+                part.volume = reduced->volume;
+            }
+
+            return true;
+        }
+
+        const TriMeshModel& mesh;
+        const ConvexDecomposition::Parameters& parameters;
+        VoxelGrid grid;
+        double totalVolume;
+        std::vector<Eigen::Vector3d> points; // temporary
+    };
+
+    template <typename T>
+    void hashValue(uint64_t& hash, const T& value)
+    {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(&value);
+
+        for (size_t i = 0; i < sizeof(T); i++)
+        {
+            hash = (hash ^ p[i]) * 1099511628211ull;
+        }
+    }
+
+    template <typename T>
+    void write(std::ofstream& output, const T& value)
+    {
+        output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool read(std::ifstream& input, T& value)
+    {
+        return bool(input.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+}
+
+ConvexDecomposition::Parameters::Parameters() :
+    voxelResolution(32),
+    maxConcavity(0.05f),
+    maxParts(16),
+    maxHullVertices(32),
+    fitPrimitives(true),
+    primitiveTolerance(0.05f)
+{
+}
+
+ConvexDecomposition::PartList ConvexDecomposition::compute(const TriMeshModel& mesh, const Parameters& parameters)
+{
+    Decomposer d(mesh, parameters);
+    return d.run();
+}
+
+ConvexDecomposition::PartList ConvexDecomposition::computeCached(const TriMeshModel& mesh, const std::string& cacheDirectory, const Parameters& parameters)
+{
+    if (cacheDirectory.empty())
+    {
+        return compute(mesh, parameters);
+    }
+
+    boost::filesystem::path filename = boost::filesystem::path(cacheDirectory) / (getHash(mesh, parameters) + ".cvxd");
+    PartList parts;
+
+    if (boost::filesystem::exists(filename) && load(filename.string(), parts))
+    {
+        return parts;
+    }
+
+    parts = compute(mesh, parameters);
+    boost::system::error_code error;
+    boost::filesystem::create_directories(cacheDirectory, error);
+
+    if (error || !save(filename.string(), parts))
+    {
+        VR_WARNING << "Could not write convex decomposition cache file " << filename.string() << std::endl;
+    }
+
+    return parts;
+}
+
+std::string ConvexDecomposition::getHash(const TriMeshModel& mesh, const Parameters& parameters)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    hashValue(hash, cacheVersion);
+
+    for (const auto& v : mesh.vertices)
+    {
+        hashValue(hash, v.x());
+        hashValue(hash, v.y());
+        hashValue(hash, v.z());
+    }
+
+    for (const auto& f : mesh.faces)
+    {
+        hashValue(hash, f.id1);
+        hashValue(hash, f.id2);
+        hashValue(hash, f.id3);
+    }
+
+    hashValue(hash, parameters.voxelResolution);
+    hashValue(hash, parameters.maxConcavity);
+    hashValue(hash, parameters.maxParts);
+    hashValue(hash, parameters.maxHullVertices);
+    hashValue(hash, parameters.fitPrimitives);
+    hashValue(hash, parameters.primitiveTolerance);
+
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return ss.str();
+}
+
+bool ConvexDecomposition::save(const std::string& filename, const PartList& parts)
+{
+    std::ofstream output(filename.c_str(), std::ios::binary);
+
+    if (!output)
+    {
+        return false;
+    }
+
+    output.write(cacheMagic, sizeof(cacheMagic));
+    write(output, cacheVersion);
+    write(output, uint32_t(parts.size()));
+
+    for (const Part& part : parts)
+    {
+        write(output, uint8_t(part.type));
+        output.write(reinterpret_cast<const char*>(part.transform.data()), 16 * sizeof(float));
+        output.write(reinterpret_cast<const char*>(part.size.data()), 3 * sizeof(float));
+        write(output, part.volume);
+        write(output, uint32_t(part.vertices.size()));
+
+        for (const auto& v : part.vertices)
+        {
+            output.write(reinterpret_cast<const char*>(v.data()), 3 * sizeof(float));
+        }
+    }
+
+    return bool(output);
+}
+
+bool ConvexDecomposition::load(const std::string& filename, PartList& storeParts)
+{
+    storeParts.clear();
+    std::ifstream input(filename.c_str(), std::ios::binary);
+    char magic[sizeof(cacheMagic)];
+    uint32_t version = 0;
+    uint32_t numParts = 0;
+
+    if (!input || !input.read(magic, sizeof(magic)) || memcmp(magic, cacheMagic, sizeof(cacheMagic)) != 0
+        || !read(input, version) || version != cacheVersion || !read(input, numParts))
+    {
+        return false;
+    }
+
+    storeParts.resize(numParts);
+
+    for (Part& part : storeParts)
+    {
+        uint8_t type = 0;
+        uint32_t numVertices = 0;
+
+        if (!read(input, type) || type > eCapsule
+            || !input.read(reinterpret_cast<char*>(part.transform.data()), 16 * sizeof(float))
+            || !input.read(reinterpret_cast<char*>(part.size.data()), 3 * sizeof(float))
+            || !read(input, part.volume) || !read(input, numVertices))
+        {
+            storeParts.clear();
+            return false;
+        }
+
+        part.type = PartType(type);
+        part.vertices.resize(numVertices);
+
+        for (auto& v : part.vertices)
+        {
+            if (!input.read(reinterpret_cast<char*>(v.data()), 3 * sizeof(float)))
+            {
+                storeParts.clear();
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+MathTools::ConvexHull3DPtr ConvexDecomposition::createConvexHull(const std::vector<Eigen::Vector3f>& points)
+{
+    MathTools::ConvexHull3DPtr result(new MathTools::ConvexHull3D());
+    result->volume = 0;
+    result->maxDistFacetCenter = 0;
+    result->center.setZero();
+
+    std::vector<Eigen::Vector3d> p(points.size());
+
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        p[i] = points[i].cast<double>();
+    }
+
+    std::vector<HullFace> faces;
+    double eps;
+
+    if (!buildHull(p, faces, eps))
+    {
+        result->vertices = points;
+
+        for (const auto& v : points)
+        {
+            result->center += v;
+        }
+
+        if (!points.empty())
+        {
+            result->center /= float(points.size());
+        }
+
+        return result;
+    }
+
+    std::map<int, unsigned int> vertexIds;
+
+    for (const HullFace& f : faces)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            if (vertexIds.find(f.v[k]) == vertexIds.end())
+            {
+                vertexIds[f.v[k]] = (unsigned int)(result->vertices.size());
+                result->vertices.push_back(points[f.v[k]]);
+                result->center += points[f.v[k]];
+            }
+        }
+    }
+
+    result->center /= float(result->vertices.size());
+    const Eigen::Vector3d center = result->center.cast<double>();
+    double volume = 0;
+
+    for (const HullFace& f : faces)
+    {
+        MathTools::TriangleFace face;
+        face.set(vertexIds[f.v[0]], vertexIds[f.v[1]], vertexIds[f.v[2]]);
+        face.normal = f.normal.cast<float>();
+        result->faces.push_back(face);
+
+        volume += (p[f.v[0]] - center).dot((p[f.v[1]] - center).cross(p[f.v[2]] - center)) / 6.0;
+        double dist = std::abs(distance(f, center));
+        result->maxDistFacetCenter = std::max(result->maxDistFacetCenter, float(dist));
+    }
+
+    result->volume = float(volume);
+    return result;
+}
+
+std::vector<Eigen::Vector3f> ConvexDecomposition::reduceHullVertices(const std::vector<Eigen::Vector3f>& points, size_t maxVertices)
+{
+    if (points.size() <= maxVertices || maxVertices < 4)
+    {
+        return points;
+    }
+
+    std::vector<Eigen::Vector3d> all(points.size());
+
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        all[i] = points[i].cast<double>();
+    }
+
+    int simplex[4];
+    double eps;
+
+    if (!findSimplex(all, simplex, eps))
+    {
+        return std::vector<Eigen::Vector3f>(points.begin(), points.begin() + maxVertices);
+    }
+
+    std::vector<bool> used(points.size(), false);
+    std::vector<int> selected(simplex, simplex + 4);
+    std::vector<Eigen::Vector3d> selectedPoints;
+    std::vector<HullFace> faces;
+
+    for (int i : selected)
+    {
+        used[i] = true;
+        selectedPoints.push_back(all[i]);
+    }
+
+    while (selected.size() < maxVertices)
+    {
+        if (!buildHull(selectedPoints, faces, eps))
+        {
+            break;
+        }
+
+        int farthest = -1;
+        double farthestDist = eps;
+
+        for (size_t i = 0; i < all.size(); i++)
+        {
+            if (used[i])
+            {
+                continue;
+            }
+
+            double d = -1;
+
+            for (const HullFace& f : faces)
+            {
+                d = std::max(d, distance(f, all[i]));
+            }
+
+            if (d > farthestDist)
+            {
+                farthestDist = d;
+                farthest = int(i);
+            }
+        }
+
+        if (farthest < 0)
+        {
+            break;
+        }
+
+        used[farthest] = true;
+        selected.push_back(farthest);
+        selectedPoints.push_back(all[farthest]);
+    }
+
+    std::vector<Eigen::Vector3f> result;
+
+    for (int i : selected)
+    {
+        result.push_back(points[i]);
+    }
+
+    return result;
+}
+
+void ConvexDecomposition::fitPrimitive(Part& part, float primitiveTolerance)
+{
+    if (part.vertices.size() < 4 || part.volume <= 0)
+    {
+        return;
+    }
+
+    // principal axes of the hull vertices
+    Eigen::Vector3f mean = Eigen::Vector3f::Zero();
+
+    for (const auto& v : part.vertices)
+    {
+        mean += v;
+    }
+
+    mean /= float(part.vertices.size());
+    Eigen::Matrix3f covariance = Eigen::Matrix3f::Zero();
+
+    for (const auto& v : part.vertices)
+    {
+        covariance += (v - mean) * (v - mean).transpose();
+    }
+
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3f> solver(covariance);
+    Eigen::Matrix3f axes = solver.eigenvectors();
+
+    if (axes.determinant() < 0)
+    {
+        axes.col(2) = -axes.col(2);
+    }
+
+    std::vector<Eigen::Vector3f> local(part.vertices.size());
+    Eigen::Vector3f minP = Eigen::Vector3f::Constant(std::numeric_limits<float>::max());
+    Eigen::Vector3f maxP = -minP;
+
+    for (size_t i = 0; i < part.vertices.size(); i++)
+    {
+        local[i] = axes.transpose() * (part.vertices[i] - mean);
+        minP = minP.cwiseMin(local[i]);
+        maxP = maxP.cwiseMax(local[i]);
+    }
+
+    const Eigen::Vector3f boxSize = maxP - minP;
+    const Eigen::Vector3f boxCenter = (minP + maxP) / 2;
+
+    // symmetric volume ratio, so that neither too large nor too small primitives are accepted
+    auto fit = [&](double volume)
+    {
+        return volume > 0 ? std::min(double(part.volume), volume) / std::max(double(part.volume), volume) : 0.0;
+    };
+
+    PartType bestType = eBox;
+    double bestFit = fit(double(boxSize.prod()));
+    int bestAxis = 2;
+    float bestRadius = 0;
+    float bestLength = 0;
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+        int i = (axis + 1) % 3;
+        int j = (axis + 2) % 3;
+        float radius = 0;
+
+        for (const auto& v : local)
+        {
+            radius = std::max(radius, Eigen::Vector2f(v[i] - boxCenter[i], v[j] - boxCenter[j]).norm());
+        }
+
+        double cylinder = M_PI * radius * radius * boxSize[axis];
+        float capsuleLength = std::max(0.0f, boxSize[axis] - 2 * radius);
+        double capsule = M_PI * radius * radius * capsuleLength + 4.0 / 3.0 * M_PI * radius * radius * radius;
+
+        if (fit(cylinder) > bestFit)
+        {
+            bestFit = fit(cylinder);
+            bestType = eCylinder;
+            bestAxis = axis;
+            bestRadius = radius;
+            bestLength = boxSize[axis];
+        }
+
+        if (fit(capsule) > bestFit)
+        {
+            bestFit = fit(capsule);
+            bestType = eCapsule;
+            bestAxis = axis;
+            bestRadius = radius;
+            bestLength = capsuleLength;
+        }
+    }
+
+    if (bestFit < 1.0 - primitiveTolerance)
+    {
+        return;
+    }
+
+    Eigen::Matrix3f orientation = axes;
+
+    if (bestType == eBox)
+    {
+        part.size = boxSize;
+    }
+    else
+    {
+        // the primitive axis becomes z
+        orientation.col(0) = axes.col((bestAxis + 1) % 3);
+        orientation.col(1) = axes.col((bestAxis + 2) % 3);
+        orientation.col(2) = axes.col(bestAxis);
+        part.size = Eigen::Vector3f(bestRadius, bestRadius, bestLength);
+    }
+
+    part.type = bestType;
+    part.transform.setIdentity();
+    part.transform.block<3, 3>(0, 0) = orientation;
+    part.transform.block<3, 1>(0, 3) = mean + axes * boxCenter;
+}
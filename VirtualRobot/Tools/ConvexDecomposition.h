@@ -0,0 +1,120 @@
+/**
+* This file is part of Simox.
+*
+* Simox is free software; you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 2 of
+* the License, or (at your option) any later version.
+*
+* Simox is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*
+*/
+
+#pragma once
+
+#include "../VirtualRobot.h"
+#include "../MathTools.h"
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include <string>
+#include <vector>
+
+namespace VirtualRobot
+{
+    /*!
+        Approximate convex decomposition of triangle meshes, intended for building collision shapes of physics engines.
+
+        A single convex hull fills in all cavities of an object (the inside of a cup, the gap of a handle), which
+        results in wrong contacts. compute() splits a mesh into a small number of convex parts:
+        The mesh is voxelized and the enclosed volume is filled. Starting with the bounding box of the mesh,
+        the part with the largest concavity (the volume of its convex hull that is not covered by the object,
+        relative to the volume of the whole object) is recursively cut by the axis aligned plane that minimizes
+        the concavity of both halves, until all parts are below Parameters::maxConcavity or Parameters::maxParts is reached.
+        The convex hull of each part is built from the mesh triangles clipped to the part. Optionally, parts that are
+        well approximated by a box, cylinder or capsule are replaced by the primitive, which is considerably cheaper
+        for contact generation. Afterwards, the number of hull vertices is reduced to Parameters::maxHullVertices.
+
+        Since the decomposition takes some time for larger meshes, computeCached() stores the result in a
+        cache directory, keyed by a hash of the mesh and the parameters.
+        All values are given in the units of the mesh (usually mm).
+    */
+    class VIRTUAL_ROBOT_IMPORT_EXPORT ConvexDecomposition
+    {
+    public:
+        struct VIRTUAL_ROBOT_IMPORT_EXPORT Parameters
+        {
+            Parameters();
+
+            int voxelResolution; // number of voxels along the longest side of the bounding box
+            float maxConcavity; // accepted concavity of a part, relative to the volume of the object
+            int maxParts;
+            int maxHullVertices; // 0: no reduction
+            bool fitPrimitives; // replace parts by boxes, cylinders and capsules
+            float primitiveTolerance; // a primitive is used if its volume differs by less than this fraction from the hull volume
+        };
+
+        enum PartType
+        {
+            eConvexHull = 0,
+            eBox = 1,
+            eCylinder = 2,
+            eCapsule = 3
+        };
+
+        struct Part
+        {
+            EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+            PartType type;
+            Eigen::Matrix4f transform; // pose of the primitive in mesh coordinates, cylinders and capsules are aligned with the z axis
+            Eigen::Vector3f size; // box: edge lengths, cylinder: (radius, radius, height), capsule: (radius, radius, length of the cylindrical section)
+            std::vector<Eigen::Vector3f> vertices; // convex hull in mesh coordinates (for all types)
+            float volume; // of the convex hull
+        };
+        typedef std::vector<Part, Eigen::aligned_allocator<Part> > PartList;
+
+        static PartList compute(const TriMeshModel& mesh, const Parameters& parameters = Parameters());
+
+        /*!
+            Loads the decomposition from cacheDirectory if it has been computed before for this mesh and parameters,
+            otherwise it is computed and stored. An empty cacheDirectory disables caching.
+        */
+        static PartList computeCached(const TriMeshModel& mesh, const std::string& cacheDirectory, const Parameters& parameters = Parameters());
+
+        //! A hash of vertices, faces and parameters, used as file name by computeCached().
+        static std::string getHash(const TriMeshModel& mesh, const Parameters& parameters);
+
+        static bool save(const std::string& filename, const PartList& parts);
+        static bool load(const std::string& filename, PartList& storeParts);
+
+        /*!
+            Quickhull. Returns a hull without faces and zero volume, if the points are (nearly) coplanar.
+        */
+        static MathTools::ConvexHull3DPtr createConvexHull(const std::vector<Eigen::Vector3f>& points);
+
+        /*!
+            Selects at most maxVertices of the given points, such that their convex hull approximates the convex hull of all points.
+            Starting with a tetrahedron, the point that is farthest outside of the current hull is added until maxVertices is reached.
+        */
+        static std::vector<Eigen::Vector3f> reduceHullVertices(const std::vector<Eigen::Vector3f>& points, size_t maxVertices);
+
+        /*!
+            Fits a box, cylinder and capsule to the convex hull of a part (along its principal axes) and sets type,
+            transform and size of the part to the best primitive, if its volume is within primitiveTolerance of the hull volume.
+            Otherwise the part stays a convex hull. Expects part.vertices and part.volume to be set.
+        */
+        static void fitPrimitive(Part& part, float primitiveTolerance);
+    };
+
+} // namespace VirtualRobot
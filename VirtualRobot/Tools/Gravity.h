@@ -24,6 +24,7 @@
 #pragma once
 
 #include "../VirtualRobot.h"
+#include "MassProperties.h"
 
 namespace VirtualRobot
 {
@@ -41,23 +42,8 @@ namespace VirtualRobot
 
         void computeGravityTorque(std::vector<float> &storeValues);
     protected:
-        struct GravityData;
-        typedef boost::shared_ptr<GravityData> GravityDataPtr;
-        struct GravityData : boost::enable_shared_from_this<GravityData>
-        {
-            GravityData();
-            static GravityDataPtr create(SceneObjectPtr node, const std::vector<VirtualRobot::RobotNodePtr> &joints, const std::vector<VirtualRobot::RobotNodePtr> &bodies, std::vector<GravityDataPtr> &dataVec);
-            void init(SceneObjectPtr node, const std::vector<VirtualRobot::RobotNodePtr> &joints, const std::vector<VirtualRobot::RobotNodePtr> &bodies, std::vector<GravityDataPtr> &dataVec);
-            std::map<std::string, GravityDataPtr> children;
-            SceneObjectPtr node;
-            float massSum = 0.0f;
-            float torque = 0.0f;
-            bool computeTorque = false;
-            bool computeCoM = false;
-            void computeCoMAndTorque(Eigen::Vector3f& comPositionGlobal);
-        };
-        std::vector<GravityDataPtr> gravityDataHelperVec;
-        GravityDataPtr gravityDataHelperRoot;
+        // subtree masses and CoMs of the joints, from which the torques are computed
+        MassPropertiesPtr massProperties;
 
         VirtualRobot::RobotPtr robot;
 
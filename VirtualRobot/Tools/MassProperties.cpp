@@ -0,0 +1,208 @@
+#include "MassProperties.h"
+
+#include "../Nodes/RobotNodeRevolute.h"
+#include "../Nodes/RobotNodePrismatic.h"
+#include "../RobotNodeSet.h"
+#include "../VirtualRobotException.h"
+
+#include <algorithm>
+#include <map>
+
+using namespace VirtualRobot;
+
+namespace
+{
+    // the closest node, starting with object itself, that is contained in jointIndex
+    int findJoint(SceneObjectPtr object, const std::map<SceneObjectPtr, int>& jointIndex)
+    {
+        while (object)
+        {
+            auto it = jointIndex.find(object);
+
+            if (it != jointIndex.end())
+            {
+                return it->second;
+            }
+
+            object = object->getParent();
+        }
+
+        return -1;
+    }
+}
+
+MassProperties::MassProperties(RobotNodeSetPtr rnsJoints, RobotNodeSetPtr rnsBodies) :
+    mass(0.0f),
+    com(Eigen::Vector3f::Zero()),
+    gravity(0.0f, 0.0f, -9.81f)
+{
+    THROW_VR_EXCEPTION_IF(!rnsJoints, "!rnsJoints");
+    THROW_VR_EXCEPTION_IF(!rnsBodies, "!rnsBodies");
+
+    std::map<SceneObjectPtr, int> jointIndex;
+
+    for (const RobotNodePtr& node : rnsJoints->getAllRobotNodes())
+    {
+        Joint j;
+        j.node = node;
+        j.parent = -1;
+        j.mass = 0.0f;
+
+        if (node->isRotationalJoint())
+        {
+            RobotNodeRevolutePtr revolute = boost::dynamic_pointer_cast<RobotNodeRevolute>(node);
+            THROW_VR_EXCEPTION_IF(!revolute, "Internal error: expecting revolute joint");
+            j.type = eRevolute;
+            j.axisLocal = revolute->getJointRotationAxisInJointCoordSystem();
+        }
+        else if (node->isTranslationalJoint())
+        {
+            RobotNodePrismaticPtr prismatic = boost::dynamic_pointer_cast<RobotNodePrismatic>(node);
+            THROW_VR_EXCEPTION_IF(!prismatic, "Internal error: expecting prismatic joint");
+            j.type = ePrismatic;
+            j.axisLocal = prismatic->getJointTranslationDirectionJointCoordSystem();
+        }
+        else
+        {
+            j.type = eFixed;
+            j.axisLocal.setZero();
+        }
+
+        jointIndex[node] = int(joints.size());
+        joints.push_back(j);
+    }
+
+    std::vector<int> depth(joints.size(), 0);
+
+    for (size_t i = 0; i < joints.size(); i++)
+    {
+        joints[i].parent = findJoint(joints[i].node->getParent(), jointIndex);
+
+        for (int p = joints[i].parent; p >= 0; p = findJoint(joints[p].node->getParent(), jointIndex))
+        {
+            depth[i]++;
+        }
+
+        jointOrder.push_back(int(i));
+    }
+
+    std::stable_sort(jointOrder.begin(), jointOrder.end(), [&depth](int a, int b)
+    {
+        return depth[a] > depth[b];
+    });
+
+    for (const RobotNodePtr& node : rnsBodies->getAllRobotNodes())
+    {
+        if (node->getMass() <= 0)
+        {
+            continue;
+        }
+
+        Body b;
+        b.node = node;
+        b.mass = node->getMass();
+        b.joint = findJoint(node, jointIndex);
+        bodies.push_back(b);
+    }
+
+    gravityTorques.resize(joints.size(), 0.0f);
+    update();
+}
+
+void MassProperties::update()
+{
+    for (Joint& j : joints)
+    {
+        Eigen::Matrix4f pose = j.node->getGlobalPose();
+        j.position = pose.block<3, 1>(0, 3);
+        j.axis = pose.block<3, 3>(0, 0) * j.axisLocal;
+        j.mass = 0.0f;
+        j.moment.setZero();
+    }
+
+    Eigen::Vector3f moment = Eigen::Vector3f::Zero();
+    mass = 0.0f;
+
+    for (Body& b : bodies)
+    {
+        Eigen::Vector3f m = b.mass * b.node->getCoMGlobal();
+        moment += m;
+        mass += b.mass;
+
+        if (b.joint >= 0)
+        {
+            joints[b.joint].mass += b.mass;
+            joints[b.joint].moment += m;
+        }
+    }
+
+    com = mass > 0 ? Eigen::Vector3f(moment / mass) : Eigen::Vector3f::Zero();
+
+    for (int i : jointOrder)
+    {
+        Joint& j = joints[i];
+
+        if (j.parent >= 0)
+        {
+            joints[j.parent].mass += j.mass;
+            joints[j.parent].moment += j.moment;
+        }
+
+        if (j.type == eRevolute)
+        {
+            // r x F with r = (CoM - joint) in m and F = mass * gravity, negated for compensation
+            Eigen::Vector3f r = (j.moment - j.mass * j.position) * 0.001f;
+            gravityTorques[i] = -r.cross(gravity).dot(j.axis);
+        }
+        else
+        {
+            gravityTorques[i] = 0.0f;
+        }
+    }
+}
+
+void MassProperties::getCoMJacobian(Eigen::MatrixXf& storeJacobian, const RobotNodePtr& coordSystem, bool convertMMtoM) const
+{
+    storeJacobian.setZero(3, joints.size());
+
+    if (mass <= 0)
+    {
+        return;
+    }
+
+    Eigen::Matrix3f toCoordSystem = Eigen::Matrix3f::Identity();
+
+    if (coordSystem)
+    {
+        toCoordSystem = coordSystem->getGlobalPose().block<3, 3>(0, 0).transpose();
+    }
+
+    for (size_t i = 0; i < joints.size(); i++)
+    {
+        const Joint& j = joints[i];
+        Eigen::Vector3f axis = toCoordSystem * j.axis;
+
+        if (j.type == eRevolute)
+        {
+            // sum over the subtree of mass * (axis x (CoM - joint))
+            Eigen::Vector3f r = j.moment - j.mass * j.position;
+
+            if (convertMMtoM)
+            {
+                r /= 1000.0f;
+            }
+
+            storeJacobian.col(i) = axis.cross(r) / mass;
+        }
+        else if (j.type == ePrismatic)
+        {
+            storeJacobian.col(i) = axis * (j.mass / mass);
+        }
+    }
+}
+
+Eigen::Vector3f MassProperties::getSubtreeCoM(size_t joint) const
+{
+    const Joint& j = joints[joint];
+    return j.mass > 0 ? Eigen::Vector3f(j.moment / j.mass) : j.position;
+}
@@ -0,0 +1,142 @@
+/**
+* This file is part of Simox.
+*
+* Simox is free software; you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 2 of
+* the License, or (at your option) any later version.
+*
+* Simox is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*
+*/
+
+#pragma once
+
+#include "../VirtualRobot.h"
+
+#include <Eigen/Core>
+
+#include <vector>
+
+namespace VirtualRobot
+{
+    /*!
+        Mass properties of a set of bodies with respect to a set of joints: total mass and CoM, the CoM Jacobian
+        and the torques needed to counteract gravity.
+
+        The kinematic structure is flattened on construction: each body is assigned to its closest joint
+        and the joints are stored in an order in which children precede their parents.
+        update() reads the poses computed by the last forward kinematics update of the robot and accumulates
+        mass and first moment of each joint's subtree in a single pass over the bodies and joints.
+        The CoM Jacobian and the gravity torques follow from these subtree values, without visiting the bodies again.
+    */
+    class VIRTUAL_ROBOT_IMPORT_EXPORT MassProperties
+    {
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        /*!
+            \param rnsJoints The joints. Nodes that are neither revolute nor prismatic get zero entries.
+            \param rnsBodies The bodies, nodes without mass are ignored.
+        */
+        MassProperties(RobotNodeSetPtr rnsJoints, RobotNodeSetPtr rnsBodies);
+
+        /*!
+            Updates all values from the current poses of the robot nodes.
+            Has to be called after the joint values have been changed.
+        */
+        void update();
+
+        float getMass() const
+        {
+            return mass;
+        }
+
+        //! The global center of mass in mm.
+        const Eigen::Vector3f& getCoM() const
+        {
+            return com;
+        }
+
+        /*!
+            The 3 x nJoints Jacobian of the CoM, one column for each joint of rnsJoints.
+            \param coordSystem If set, the joint axes are expressed in this coordinate system (as done by CoMIK).
+            \param convertMMtoM Compute the positional part in meters instead of mm.
+        */
+        void getCoMJacobian(Eigen::MatrixXf& storeJacobian, const RobotNodePtr& coordSystem = RobotNodePtr(), bool convertMMtoM = false) const;
+
+        /*!
+            The torques (in Nm) that compensate gravity, one for each joint of rnsJoints.
+            Prismatic joints and fixed nodes get zero torque.
+        */
+        const std::vector<float>& getGravityTorques() const
+        {
+            return gravityTorques;
+        }
+
+        //! The mass of all bodies that are moved by the given joint.
+        float getSubtreeMass(size_t joint) const
+        {
+            return joints[joint].mass;
+        }
+
+        //! The global CoM of all bodies that are moved by the given joint.
+        Eigen::Vector3f getSubtreeCoM(size_t joint) const;
+
+        void setGravity(const Eigen::Vector3f& gravity)
+        {
+            this->gravity = gravity;
+        }
+
+    protected:
+        struct Body
+        {
+            RobotNodePtr node;
+            float mass;
+            int joint;                  // closest joint that moves the body, -1 if none
+        };
+
+        enum JointType
+        {
+            eRevolute,
+            ePrismatic,
+            eFixed
+        };
+
+        struct Joint
+        {
+            EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+            RobotNodePtr node;
+            int parent;                 // closest joint that moves this joint, -1 if none
+            JointType type;
+            Eigen::Vector3f axisLocal;  // rotation axis or translation direction in the joint's coordinate system
+
+            // updated values
+            Eigen::Vector3f position;
+            Eigen::Vector3f axis;
+            float mass;
+            Eigen::Vector3f moment;     // sum of mass * CoM of the subtree
+        };
+
+        std::vector<Body> bodies;
+        std::vector<Joint, Eigen::aligned_allocator<Joint>> joints;
+        std::vector<int> jointOrder;    // children before parents
+
+        float mass;
+        Eigen::Vector3f com;
+        Eigen::Vector3f gravity;
+        std::vector<float> gravityTorques;
+    };
+
+    typedef boost::shared_ptr<MassProperties> MassPropertiesPtr;
+}
@@ -0,0 +1,336 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+#include "MeshDistance.h"
+
+#include "../Visualization/TriMeshModel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+
+namespace VirtualRobot
+{
+
+    MeshDistance::MeshDistance(const std::vector<Eigen::Vector3f>& meshVertices, const std::vector<std::array<unsigned int, 3> >& meshTriangles)
+    {
+        init(meshVertices, meshTriangles);
+    }
+
+    MeshDistance::MeshDistance(const TriMeshModel& mesh)
+    {
+        std::vector<std::array<unsigned int, 3> > meshTriangles;
+        meshTriangles.reserve(mesh.faces.size());
+
+        for (const MathTools::TriangleFace& f : mesh.faces)
+        {
+            meshTriangles.push_back({f.id1, f.id2, f.id3});
+        }
+
+        init(mesh.vertices, meshTriangles);
+    }
+
+    void MeshDistance::init(const std::vector<Eigen::Vector3f>& meshVertices, const std::vector<std::array<unsigned int, 3> >& meshTriangles)
+    {
+        // merge vertices at equal positions, so that neighboring triangles share their edges
+        auto less = [](const Eigen::Vector3f & a, const Eigen::Vector3f & b)
+        {
+            return std::lexicographical_compare(a.data(), a.data() + 3, b.data(), b.data() + 3);
+        };
+        std::map<Eigen::Vector3f, unsigned int, decltype(less), Eigen::aligned_allocator<std::pair<const Eigen::Vector3f, unsigned int> > > vertexIds(less);
+        std::vector<unsigned int> newIds(meshVertices.size());
+
+        for (size_t i = 0; i < meshVertices.size(); i++)
+        {
+            auto it = vertexIds.emplace(meshVertices[i], (unsigned int)vertices.size());
+
+            if (it.second)
+            {
+                vertices.push_back(meshVertices[i]);
+            }
+
+            newIds[i] = it.first->second;
+        }
+
+        // degenerated triangles have no normal and are skipped
+        for (const std::array<unsigned int, 3>& t : meshTriangles)
+        {
+            Triangle tri;
+            tri.v = {newIds.at(t[0]), newIds.at(t[1]), newIds.at(t[2])};
+            Eigen::Vector3f n = (vertices[tri.v[1]] - vertices[tri.v[0]]).cross(vertices[tri.v[2]] - vertices[tri.v[0]]);
+
+            if (n.norm() > 1e-12f)
+            {
+                tri.normal = n.normalized();
+                triangles.push_back(tri);
+            }
+        }
+
+        // angle weighted vertex normals and edge normals (sum of the two face normals)
+        vertexNormals.assign(vertices.size(), Eigen::Vector3f::Zero());
+        std::map<std::pair<unsigned int, unsigned int>, Eigen::Vector3f, std::less<std::pair<unsigned int, unsigned int> >,
+            Eigen::aligned_allocator<std::pair<const std::pair<unsigned int, unsigned int>, Eigen::Vector3f> > > edgeNormals;
+
+        for (const Triangle& t : triangles)
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                unsigned int v0 = t.v[i], v1 = t.v[(i + 1) % 3], v2 = t.v[(i + 2) % 3];
+                Eigen::Vector3f e1 = (vertices[v1] - vertices[v0]).normalized();
+                Eigen::Vector3f e2 = (vertices[v2] - vertices[v0]).normalized();
+                vertexNormals[v0] += std::acos(std::max(-1.0f, std::min(1.0f, e1.dot(e2)))) * t.normal;
+
+                auto it = edgeNormals.emplace(std::make_pair(std::min(v0, v1), std::max(v0, v1)), Eigen::Vector3f::Zero());
+                it.first->second += t.normal;
+            }
+        }
+
+        for (Triangle& t : triangles)
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                unsigned int v0 = t.v[i], v1 = t.v[(i + 1) % 3];
+                t.edgeNormals[i] = edgeNormals.at(std::make_pair(std::min(v0, v1), std::max(v0, v1)));
+            }
+        }
+
+        if (!triangles.empty())
+        {
+            std::vector<unsigned int> order(triangles.size());
+
+            for (size_t i = 0; i < order.size(); i++)
+            {
+                order[i] = (unsigned int)i;
+            }
+
+            build(order, 0, order.size());
+            std::vector<Triangle> sorted;
+            sorted.reserve(triangles.size());
+
+            for (unsigned int i : order)
+            {
+                sorted.push_back(triangles[i]);
+            }
+
+            triangles.swap(sorted);
+        }
+    }
+
+    bool MeshDistance::empty() const
+    {
+        return triangles.empty();
+    }
+
+    float MeshDistance::getSignedDistance(const Eigen::Vector3f& p, float bound) const
+    {
+        if (nodes.empty())
+        {
+            return bound;
+        }
+
+        float bestSquared = bound * bound;
+        Eigen::Vector3f bestDiff = Eigen::Vector3f::Zero();
+        Eigen::Vector3f bestNormal = Eigen::Vector3f::UnitZ();
+        bool found = false;
+
+        unsigned int stack[64];
+        int stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const unsigned int nodeIndex = stack[--stackSize];
+            const Node& node = nodes[nodeIndex];
+
+            if (squaredDistance(node, p) >= bestSquared)
+            {
+                continue;
+            }
+
+            if (node.count > 0)
+            {
+                for (unsigned int i = node.first; i < node.first + node.count; i++)
+                {
+                    const Triangle& t = triangles[i];
+                    Feature feature;
+                    Eigen::Vector3f closest = closestPointOnTriangle(p, vertices[t.v[0]], vertices[t.v[1]], vertices[t.v[2]], feature);
+                    Eigen::Vector3f diff = p - closest;
+                    float squared = diff.squaredNorm();
+
+                    if (squared < bestSquared)
+                    {
+                        bestSquared = squared;
+                        bestDiff = diff;
+                        bestNormal = getPseudoNormal(t, feature);
+                        found = true;
+                    }
+                }
+            }
+            else
+            {
+                // visit the closer child first
+                unsigned int left = nodeIndex + 1;
+                unsigned int right = node.first;
+
+                if (squaredDistance(nodes[left], p) < squaredDistance(nodes[right], p))
+                {
+                    std::swap(left, right);
+                }
+
+                stack[stackSize++] = left;
+                stack[stackSize++] = right;
+            }
+        }
+
+        if (!found)
+        {
+            return bound;
+        }
+
+        float distance = std::sqrt(bestSquared);
+        return bestDiff.dot(bestNormal) < 0 ? -distance : distance;
+    }
+
+    // (Ericson, Real-Time Collision Detection, 5.1.5)
+    Eigen::Vector3f MeshDistance::closestPointOnTriangle(const Eigen::Vector3f& p, const Eigen::Vector3f& a, const Eigen::Vector3f& b, const Eigen::Vector3f& c, Feature& feature)
+    {
+        const Eigen::Vector3f ab = b - a;
+        const Eigen::Vector3f ac = c - a;
+        const Eigen::Vector3f ap = p - a;
+        const float d1 = ab.dot(ap);
+        const float d2 = ac.dot(ap);
+
+        if (d1 <= 0 && d2 <= 0)
+        {
+            feature = eVertex0;
+            return a;
+        }
+
+        const Eigen::Vector3f bp = p - b;
+        const float d3 = ab.dot(bp);
+        const float d4 = ac.dot(bp);
+
+        if (d3 >= 0 && d4 <= d3)
+        {
+            feature = eVertex1;
+            return b;
+        }
+
+        const float vc = d1 * d4 - d3 * d2;
+
+        if (vc <= 0 && d1 >= 0 && d3 <= 0)
+        {
+            feature = eEdge01;
+            return a + d1 / (d1 - d3) * ab;
+        }
+
+        const Eigen::Vector3f cp = p - c;
+        const float d5 = ab.dot(cp);
+        const float d6 = ac.dot(cp);
+
+        if (d6 >= 0 && d5 <= d6)
+        {
+            feature = eVertex2;
+            return c;
+        }
+
+        const float vb = d5 * d2 - d1 * d6;
+
+        if (vb <= 0 && d2 >= 0 && d6 <= 0)
+        {
+            feature = eEdge20;
+            return a + d2 / (d2 - d6) * ac;
+        }
+
+        const float va = d3 * d6 - d5 * d4;
+
+        if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0)
+        {
+            feature = eEdge12;
+            return b + (d4 - d3) / ((d4 - d3) + (d5 - d6)) * (c - b);
+        }
+
+        feature = eFace;
+        const float denom = 1 / (va + vb + vc);
+        return a + ab * (vb * denom) + ac * (vc * denom);
+    }
+
+    float MeshDistance::squaredDistance(const Node& node, const Eigen::Vector3f& p)
+    {
+        return (node.min - p).cwiseMax(p - node.max).cwiseMax(0.0f).squaredNorm();
+    }
+
+    Eigen::Vector3f MeshDistance::getPseudoNormal(const Triangle& t, Feature feature) const
+    {
+        switch (feature)
+        {
+            case eVertex0:
+            case eVertex1:
+            case eVertex2:
+                return vertexNormals[t.v[feature - eVertex0]];
+
+            case eEdge01:
+            case eEdge12:
+            case eEdge20:
+                return t.edgeNormals[feature - eEdge01];
+
+            default:
+                return t.normal;
+        }
+    }
+
+    void MeshDistance::build(std::vector<unsigned int>& order, size_t begin, size_t end)
+    {
+        const size_t index = nodes.size();
+        nodes.emplace_back();
+        Node node;
+        node.min = Eigen::Vector3f::Constant(std::numeric_limits<float>::max());
+        node.max = Eigen::Vector3f::Constant(-std::numeric_limits<float>::max());
+        Eigen::Vector3f centerMin = node.min;
+        Eigen::Vector3f centerMax = node.max;
+
+        for (size_t i = begin; i < end; i++)
+        {
+            const Triangle& t = triangles[order[i]];
+            Eigen::Vector3f center = Eigen::Vector3f::Zero();
+
+            for (unsigned int v : t.v)
+            {
+                node.min = node.min.cwiseMin(vertices[v]);
+                node.max = node.max.cwiseMax(vertices[v]);
+                center += vertices[v] / 3;
+            }
+
+            centerMin = centerMin.cwiseMin(center);
+            centerMax = centerMax.cwiseMax(center);
+        }
+
+        if (end - begin <= 4)
+        {
+            node.first = (unsigned int)begin;
+            node.count = (unsigned int)(end - begin);
+            nodes[index] = node;
+            return;
+        }
+
+        int axis;
+        (centerMax - centerMin).maxCoeff(&axis);
+        const size_t middle = (begin + end) / 2;
+        std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [&](unsigned int a, unsigned int b)
+        {
+            const Triangle& ta = triangles[a];
+            const Triangle& tb = triangles[b];
+            return vertices[ta.v[0]][axis] + vertices[ta.v[1]][axis] + vertices[ta.v[2]][axis]
+                   < vertices[tb.v[0]][axis] + vertices[tb.v[1]][axis] + vertices[tb.v[2]][axis];
+        });
+
+        build(order, begin, middle);
+        node.first = (unsigned int)nodes.size();
+        node.count = 0;
+        build(order, middle, end);
+        nodes[index] = node;
+    }
+
+} // namespace VirtualRobot
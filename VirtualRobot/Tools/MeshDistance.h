@@ -0,0 +1,89 @@
+/**
+* This file is part of Simox.
+*
+* Simox is free software; you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 2 of
+* the License, or (at your option) any later version.
+*
+* Simox is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*
+*/
+#pragma once
+
+#include "../VirtualRobot.h"
+
+#include <Eigen/Core>
+
+#include <array>
+#include <vector>
+
+namespace VirtualRobot
+{
+    /*!
+        Exact signed distances to a closed triangle mesh, e.g. to build a SignedDistanceField or to measure the deviation of two meshes.
+
+        The triangles are stored in a bounding volume hierarchy. The sign is taken from the angle weighted pseudo normal
+        of the closest feature (Baerentzen and Aanaes), points inside of the mesh have negative distances.
+    */
+    class VIRTUAL_ROBOT_IMPORT_EXPORT MeshDistance
+    {
+    public:
+        //! Vertices at equal positions are merged, degenerated triangles are skipped.
+        MeshDistance(const std::vector<Eigen::Vector3f>& meshVertices, const std::vector<std::array<unsigned int, 3> >& meshTriangles);
+        MeshDistance(const TriMeshModel& mesh);
+
+        //! True, if the mesh has no (non degenerated) triangles.
+        bool empty() const;
+
+        //! The signed distance to the closest triangle, if it is closer than bound, bound otherwise.
+        float getSignedDistance(const Eigen::Vector3f& p, float bound) const;
+
+    protected:
+        enum Feature
+        {
+            eFace, eVertex0, eVertex1, eVertex2, eEdge01, eEdge12, eEdge20
+        };
+
+        struct Triangle
+        {
+            std::array<unsigned int, 3> v;
+            Eigen::Vector3f normal;
+            Eigen::Vector3f edgeNormals[3];
+        };
+
+        // leaves store the triangles [first, first + count), inner nodes the index of the right child in first
+        struct Node
+        {
+            Eigen::Vector3f min;
+            Eigen::Vector3f max;
+            unsigned int first;
+            unsigned int count;
+        };
+
+        void init(const std::vector<Eigen::Vector3f>& meshVertices, const std::vector<std::array<unsigned int, 3> >& meshTriangles);
+
+        static Eigen::Vector3f closestPointOnTriangle(const Eigen::Vector3f& p, const Eigen::Vector3f& a, const Eigen::Vector3f& b, const Eigen::Vector3f& c, Feature& feature);
+        static float squaredDistance(const Node& node, const Eigen::Vector3f& p);
+        Eigen::Vector3f getPseudoNormal(const Triangle& t, Feature feature) const;
+
+        // builds the subtree over order[begin, end) by splitting at the median of the longest axis
+        void build(std::vector<unsigned int>& order, size_t begin, size_t end);
+
+        std::vector<Eigen::Vector3f> vertices;
+        std::vector<Eigen::Vector3f> vertexNormals;
+        std::vector<Triangle> triangles;
+        // stored in depth first order, the left child of an inner node follows it
+        std::vector<Node> nodes;
+    };
+
+} // namespace VirtualRobot
@@ -0,0 +1,538 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+
+#include "MeshSimplification.h"
+#include "MeshDistance.h"
+#include "../Visualization/TriMeshModel.h"
+#include "../VirtualRobotException.h"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <iterator>
+#include <map>
+#include <queue>
+
+namespace VirtualRobot
+{
+
+    namespace
+    {
+        typedef Eigen::Matrix<double, 4, 4> Quadric;
+
+        // collapses that tilt a face by more than this are rejected, this includes flipped faces
+        const double minNormalCosine = 0.2;
+
+        // conservative results are inflated at most this often, each time by the remaining deviation
+        const int maxInflations = 8;
+
+        struct Collapse
+        {
+            double cost;
+            unsigned int u;
+            unsigned int v;
+            unsigned int versionU;
+            unsigned int versionV;
+            Eigen::Vector3d position;
+
+            bool operator<(const Collapse& other) const
+            {
+                // std::priority_queue returns the largest element
+                return cost > other.cost;
+            }
+        };
+
+        class Decimation
+        {
+        public:
+            Decimation(const TriMeshModel& mesh)
+            {
+                // merge vertices at equal positions
+                std::map<std::array<float, 3>, unsigned int> ids;
+                std::vector<unsigned int> vertexMap(mesh.vertices.size());
+
+                for (size_t i = 0; i < mesh.vertices.size(); i++)
+                {
+                    const Eigen::Vector3f& p = mesh.vertices[i];
+                    auto it = ids.insert(std::make_pair(std::array<float, 3> {{p.x(), p.y(), p.z()}}, (unsigned int)positions.size()));
+
+                    if (it.second)
+                    {
+                        positions.push_back(p.cast<double>());
+                    }
+
+                    vertexMap[i] = it.first->second;
+                }
+
+                quadrics.assign(positions.size(), Quadric::Zero());
+                vertexFaces.resize(positions.size());
+
+                for (const MathTools::TriangleFace& f : mesh.faces)
+                {
+                    std::array<unsigned int, 3> face {{vertexMap.at(f.id1), vertexMap.at(f.id2), vertexMap.at(f.id3)}};
+                    Eigen::Vector3d normal = (positions[face[1]] - positions[face[0]]).cross(positions[face[2]] - positions[face[0]]);
+
+                    // degenerated faces have no plane, leaving them out opens the mesh there
+                    if (face[0] == face[1] || face[1] == face[2] || face[2] == face[0] || normal.norm() <= 0)
+                    {
+                        continue;
+                    }
+
+                    normal.normalize();
+                    Eigen::Vector4d plane(normal.x(), normal.y(), normal.z(), -normal.dot(positions[face[0]]));
+
+                    for (unsigned int id : face)
+                    {
+                        quadrics[id] += plane * plane.transpose();
+                        vertexFaces[id].push_back((unsigned int)faces.size());
+                    }
+
+                    faces.push_back(face);
+                }
+
+                faceRemoved.assign(faces.size(), false);
+                vertexRemoved.assign(positions.size(), false);
+                versions.assign(positions.size(), 0);
+                numFaces = faces.size();
+
+                // vertices on open borders or non-manifold edges stay in place
+                std::map<std::pair<unsigned int, unsigned int>, int> edgeUses;
+
+                for (const std::array<unsigned int, 3>& face : faces)
+                {
+                    for (int i = 0; i < 3; i++)
+                    {
+                        edgeUses[std::make_pair(std::min(face[i], face[(i + 1) % 3]), std::max(face[i], face[(i + 1) % 3]))]++;
+                    }
+                }
+
+                locked.assign(positions.size(), false);
+
+                for (const auto& edge : edgeUses)
+                {
+                    if (edge.second != 2)
+                    {
+                        locked[edge.first.first] = true;
+                        locked[edge.first.second] = true;
+                    }
+                }
+            }
+
+            void run(double maxCost, size_t minFaces)
+            {
+                for (unsigned int u = 0; u < positions.size(); u++)
+                {
+                    for (unsigned int v : neighbors(u))
+                    {
+                        if (u < v)
+                        {
+                            push(u, v);
+                        }
+                    }
+                }
+
+                while (!queue.empty() && numFaces > minFaces)
+                {
+                    Collapse c = queue.top();
+                    queue.pop();
+
+                    if (c.cost > maxCost)
+                    {
+                        break;
+                    }
+
+                    if (vertexRemoved[c.u] || vertexRemoved[c.v] || versions[c.u] != c.versionU || versions[c.v] != c.versionV)
+                    {
+                        continue;
+                    }
+
+                    if (isValid(c.u, c.v, c.position))
+                    {
+                        collapse(c.u, c.v, c.position);
+                    }
+                }
+            }
+
+            TriMeshModelPtr createMesh() const
+            {
+                TriMeshModelPtr result(new TriMeshModel());
+                std::vector<unsigned int> ids(positions.size(), UINT_MAX);
+
+                for (size_t i = 0; i < faces.size(); i++)
+                {
+                    if (faceRemoved[i])
+                    {
+                        continue;
+                    }
+
+                    MathTools::TriangleFace face;
+                    unsigned int* faceIds[3] = {&face.id1, &face.id2, &face.id3};
+
+                    for (int j = 0; j < 3; j++)
+                    {
+                        unsigned int& id = ids[faces[i][j]];
+
+                        if (id == UINT_MAX)
+                        {
+                            id = (unsigned int)result->addVertex(positions[faces[i][j]].cast<float>());
+                        }
+
+                        *faceIds[j] = id;
+                    }
+
+                    face.normal = TriMeshModel::CreateNormal(result->vertices[face.id1], result->vertices[face.id2], result->vertices[face.id3]);
+                    result->addFace(face);
+                }
+
+                return result;
+            }
+
+        protected:
+            std::vector<unsigned int> neighbors(unsigned int u) const
+            {
+                std::vector<unsigned int> result;
+
+                for (unsigned int f : vertexFaces[u])
+                {
+                    for (unsigned int id : faces[f])
+                    {
+                        if (id != u)
+                        {
+                            result.push_back(id);
+                        }
+                    }
+                }
+
+                std::sort(result.begin(), result.end());
+                result.erase(std::unique(result.begin(), result.end()), result.end());
+                return result;
+            }
+
+            double cost(const Quadric& q, const Eigen::Vector3d& p) const
+            {
+                Eigen::Vector4d h(p.x(), p.y(), p.z(), 1);
+                return std::max(0.0, h.dot(q * h));
+            }
+
+            void push(unsigned int u, unsigned int v)
+            {
+                if (locked[u] && locked[v])
+                {
+                    return;
+                }
+
+                Quadric q = quadrics[u] + quadrics[v];
+                Collapse c;
+                c.u = u;
+                c.v = v;
+                c.versionU = versions[u];
+                c.versionV = versions[v];
+
+                if (locked[u] || locked[v])
+                {
+                    c.position = locked[u] ? positions[u] : positions[v];
+                    c.cost = cost(q, c.position);
+                }
+                else
+                {
+                    // the minimum of the quadric, if it is well defined and close to the edge
+                    Eigen::Vector3d mid = (positions[u] + positions[v]) / 2;
+                    double length = (positions[u] - positions[v]).norm();
+                    Eigen::FullPivLU<Eigen::Matrix3d> lu(q.topLeftCorner<3, 3>());
+                    lu.setThreshold(1e-6);
+                    bool optimal = false;
+
+                    if (lu.isInvertible())
+                    {
+                        c.position = lu.solve(-q.block<3, 1>(0, 3));
+                        optimal = (c.position - mid).norm() <= length;
+                    }
+
+                    if (optimal)
+                    {
+                        c.cost = cost(q, c.position);
+                    }
+                    else
+                    {
+                        c.position = mid;
+                        c.cost = cost(q, mid);
+
+                        for (const Eigen::Vector3d& p : {positions[u], positions[v]})
+                        {
+                            double pCost = cost(q, p);
+
+                            if (pCost < c.cost)
+                            {
+                                c.cost = pCost;
+                                c.position = p;
+                            }
+                        }
+                    }
+                }
+
+                queue.push(c);
+            }
+
+            bool isValid(unsigned int u, unsigned int v, const Eigen::Vector3d& position) const
+            {
+                // link condition: the common neighbors of u and v are the opposite vertices of the faces of the edge
+                std::vector<unsigned int> nu = neighbors(u);
+                std::vector<unsigned int> nv = neighbors(v);
+                std::vector<unsigned int> common;
+                std::set_intersection(nu.begin(), nu.end(), nv.begin(), nv.end(), std::back_inserter(common));
+                size_t edgeFaces = 0;
+
+                for (unsigned int f : vertexFaces[u])
+                {
+                    if (contains(f, v))
+                    {
+                        edgeFaces++;
+                    }
+                }
+
+                if (common.size() != edgeFaces)
+                {
+                    return false;
+                }
+
+                // the faces that remain must not flip and must not coincide with another face (e.g. when collapsing a tetrahedron)
+                for (unsigned int moved : {u, v})
+                {
+                    unsigned int other = (moved == u) ? v : u;
+
+                    for (unsigned int f : vertexFaces[moved])
+                    {
+                        if (contains(f, other))
+                        {
+                            continue;
+                        }
+
+                        std::array<Eigen::Vector3d, 3> p;
+
+                        for (int i = 0; i < 3; i++)
+                        {
+                            p[i] = (faces[f][i] == moved) ? position : positions[faces[f][i]];
+                        }
+
+                        Eigen::Vector3d before = (positions[faces[f][1]] - positions[faces[f][0]]).cross(positions[faces[f][2]] - positions[faces[f][0]]);
+                        Eigen::Vector3d after = (p[1] - p[0]).cross(p[2] - p[0]);
+
+                        if (after.norm() <= 0 || before.normalized().dot(after.normalized()) < minNormalCosine)
+                        {
+                            return false;
+                        }
+
+                        if (moved == v)
+                        {
+                            for (unsigned int g : vertexFaces[u])
+                            {
+                                if (!contains(g, v) && sameVertices(g, f, v, u))
+                                {
+                                    return false;
+                                }
+                            }
+                        }
+                    }
+                }
+
+                return true;
+            }
+
+            void collapse(unsigned int u, unsigned int v, const Eigen::Vector3d& position)
+            {
+                positions[u] = position;
+                quadrics[u] += quadrics[v];
+                locked[u] = locked[u] || locked[v];
+                vertexRemoved[v] = true;
+                versions[u]++;
+                versions[v]++;
+
+                std::vector<unsigned int> uFaces;
+
+                for (unsigned int f : vertexFaces[u])
+                {
+                    if (contains(f, v))
+                    {
+                        faceRemoved[f] = true;
+                        numFaces--;
+
+                        for (unsigned int id : faces[f])
+                        {
+                            if (id != u && id != v)
+                            {
+                                removeFace(id, f);
+                            }
+                        }
+                    }
+                    else
+                    {
+                        uFaces.push_back(f);
+                    }
+                }
+
+                for (unsigned int f : vertexFaces[v])
+                {
+                    if (!faceRemoved[f])
+                    {
+                        std::replace(faces[f].begin(), faces[f].end(), v, u);
+                        uFaces.push_back(f);
+                    }
+                }
+
+                vertexFaces[u].swap(uFaces);
+                vertexFaces[v].clear();
+
+                // the entries of the edges at u are outdated by its version
+                for (unsigned int w : neighbors(u))
+                {
+                    push(u, w);
+                }
+            }
+
+            bool contains(unsigned int face, unsigned int vertex) const
+            {
+                return std::find(faces[face].begin(), faces[face].end(), vertex) != faces[face].end();
+            }
+
+            // compares the vertices of faces a and b, with vertex "from" of b replaced by "to"
+            bool sameVertices(unsigned int a, unsigned int b, unsigned int from, unsigned int to) const
+            {
+                std::array<unsigned int, 3> va = faces[a];
+                std::array<unsigned int, 3> vb = faces[b];
+                std::replace(vb.begin(), vb.end(), from, to);
+                std::sort(va.begin(), va.end());
+                std::sort(vb.begin(), vb.end());
+                return va == vb;
+            }
+
+            void removeFace(unsigned int vertex, unsigned int face)
+            {
+                std::vector<unsigned int>& list = vertexFaces[vertex];
+                list.erase(std::remove(list.begin(), list.end(), face), list.end());
+            }
+
+            std::vector<Eigen::Vector3d> positions;
+            std::vector<Quadric, Eigen::aligned_allocator<Quadric>> quadrics;
+            std::vector<std::vector<unsigned int>> vertexFaces;
+            std::vector<std::array<unsigned int, 3>> faces;
+            std::vector<bool> faceRemoved;
+            std::vector<bool> vertexRemoved;
+            std::vector<bool> locked;
+            std::vector<unsigned int> versions;
+            size_t numFaces;
+            std::priority_queue<Collapse> queue;
+        };
+
+        // moves the vertices along their normals, such that the planes of all adjacent faces move at least by offset
+        void inflate(TriMeshModel& mesh, float offset)
+        {
+            std::vector<Eigen::Vector3f> normals(mesh.vertices.size(), Eigen::Vector3f::Zero());
+
+            for (const MathTools::TriangleFace& f : mesh.faces)
+            {
+                unsigned int ids[3] = {f.id1, f.id2, f.id3};
+
+                for (int i = 0; i < 3; i++)
+                {
+                    const Eigen::Vector3f& p = mesh.vertices[ids[i]];
+                    float angle = MathTools::getAngle(mesh.vertices[ids[(i + 1) % 3]] - p, mesh.vertices[ids[(i + 2) % 3]] - p);
+                    normals[ids[i]] += f.normal * angle;
+                }
+            }
+
+            std::vector<float> minCosine(mesh.vertices.size(), 1.0f);
+
+            for (Eigen::Vector3f& n : normals)
+            {
+                n.normalize();
+            }
+
+            for (const MathTools::TriangleFace& f : mesh.faces)
+            {
+                for (unsigned int id : {f.id1, f.id2, f.id3})
+                {
+                    minCosine[id] = std::min(minCosine[id], normals[id].dot(f.normal));
+                }
+            }
+
+            mesh.boundingBox.clear();
+
+            for (size_t i = 0; i < mesh.vertices.size(); i++)
+            {
+                // at very sharp corners the offset is limited
+                mesh.vertices[i] += normals[i] * offset / std::max(minCosine[i], 0.25f);
+                mesh.boundingBox.addPoint(mesh.vertices[i]);
+            }
+
+            for (MathTools::TriangleFace& f : mesh.faces)
+            {
+                f.normal = TriMeshModel::CreateNormal(mesh.vertices[f.id1], mesh.vertices[f.id2], mesh.vertices[f.id3]);
+            }
+        }
+
+        // the largest signed distance of the vertices of the original faces to the result, it is positive if a vertex lies outside
+        float getMaxDeviation(const TriMeshModel& original, const TriMeshModel& result)
+        {
+            MeshDistance distance(result);
+            std::vector<bool> checked(original.vertices.size(), false);
+            float maxDistance = -FLT_MAX;
+
+            for (const MathTools::TriangleFace& f : original.faces)
+            {
+                for (unsigned int id : {f.id1, f.id2, f.id3})
+                {
+                    if (!checked[id])
+                    {
+                        checked[id] = true;
+                        maxDistance = std::max(maxDistance, distance.getSignedDistance(original.vertices[id], FLT_MAX));
+                    }
+                }
+            }
+
+            return maxDistance;
+        }
+    }
+
+    MeshSimplification::Parameters::Parameters()
+    {
+        maxError = 1.0f;
+        minFaces = 4;
+        conservative = false;
+    }
+
+    TriMeshModelPtr MeshSimplification::simplify(const TriMeshModel& mesh, const Parameters& parameters)
+    {
+        THROW_VR_EXCEPTION_IF(parameters.maxError < 0, "The maximum error must not be negative");
+
+        Decimation decimation(mesh);
+        decimation.run(double(parameters.maxError) * parameters.maxError, std::max<size_t>(parameters.minFaces, 4));
+        TriMeshModelPtr result = decimation.createMesh();
+
+        if (parameters.conservative)
+        {
+            // a small margin, such that the original vertices are not left on the surface due to rounding
+            const float margin = 1e-5f * (result->boundingBox.getMax() - result->boundingBox.getMin()).norm();
+            float deviation = getMaxDeviation(mesh, *result);
+
+            for (int i = 0; i < maxInflations && deviation > 0; i++)
+            {
+                inflate(*result, deviation + margin);
+                deviation = getMaxDeviation(mesh, *result);
+            }
+
+            if (deviation > 0)
+            {
+                VR_WARNING << "The simplified mesh does not enclose the original vertices, the largest distance outside is " << deviation << endl;
+            }
+        }
+
+        return result;
+    }
+
+} // namespace VirtualRobot
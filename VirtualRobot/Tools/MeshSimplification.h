@@ -0,0 +1,65 @@
+/**
+* This file is part of Simox.
+*
+* Simox is free software; you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 2 of
+* the License, or (at your option) any later version.
+*
+* Simox is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*
+*/
+#pragma once
+
+#include "../VirtualRobot.h"
+
+#include <cstddef>
+
+namespace VirtualRobot
+{
+    /*!
+        Decimation of triangle meshes by edge collapses with the quadric error metric (Garland and Heckbert),
+        e.g. to reduce the number of triangles of collision models.
+
+        Each vertex accumulates the planes of the faces it replaces. An edge collapse moves both vertices to the point
+        that minimizes the sum of squared distances to their planes. Since this sum is at least the squared distance to
+        each plane, a vertex never moves farther than Parameters::maxError from the planes of the original faces around it.
+        Collapses that would flip a face or make the mesh non-manifold are rejected, open borders are kept in place.
+
+        Note that maxError bounds the distance to the planes of the original faces, not to the original surface itself.
+
+        With Parameters::conservative, the largest distance of the original vertices outside of the result is measured (see MeshDistance).
+        The vertices of the result are moved along their angle weighted normals, such that the planes of all adjacent faces move outwards
+        by at least this distance, which is repeated until the result encloses all vertices of the original mesh.
+        Since only the vertices are checked, edges of the original mesh may still cut through concave regions of the result.
+        All values are given in the units of the mesh (usually mm).
+    */
+    class VIRTUAL_ROBOT_IMPORT_EXPORT MeshSimplification
+    {
+    public:
+        struct VIRTUAL_ROBOT_IMPORT_EXPORT Parameters
+        {
+            Parameters();
+
+            float maxError; // distance of the vertices to the original planes
+            size_t minFaces; // stop when the mesh has this number of faces
+            bool conservative; // inflate the result until it encloses the original vertices
+        };
+
+        /*!
+            Returns the simplified mesh. Vertices at equal positions are merged beforehand.
+            Colors, materials and vertex normals are not transferred, the faces get their geometric normals.
+        */
+        static TriMeshModelPtr simplify(const TriMeshModel& mesh, const Parameters& parameters = Parameters());
+    };
+
+} // namespace VirtualRobot
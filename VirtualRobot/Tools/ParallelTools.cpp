@@ -0,0 +1,72 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+
+#include "ParallelTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace VirtualRobot
+{
+
+    unsigned int ParallelTools::getNumThreads(unsigned int numThreads)
+    {
+        return numThreads > 0 ? numThreads : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    void ParallelTools::runParallel(size_t numTasks, unsigned int numThreads, const std::function<void(size_t)>& task)
+    {
+        numThreads = (unsigned int)std::min<size_t>(getNumThreads(numThreads), std::max<size_t>(1, numTasks));
+
+        std::atomic<size_t> nextTask(0);
+        std::exception_ptr error;
+        std::mutex errorMutex;
+        auto worker = [&]()
+        {
+            for (size_t i = nextTask++; i < numTasks; i = nextTask++)
+            {
+                try
+                {
+                    task(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+
+                    nextTask = numTasks;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+
+        for (unsigned int t = 1; t < numThreads; t++)
+        {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+
+        for (std::thread& t : threads)
+        {
+            t.join();
+        }
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+} // namespace VirtualRobot
@@ -0,0 +1,42 @@
+/**
+* This file is part of Simox.
+*
+* Simox is free software; you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 2 of
+* the License, or (at your option) any later version.
+*
+* Simox is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*
+*/
+#pragma once
+
+#include "../VirtualRobot.h"
+
+#include <cstddef>
+#include <functional>
+
+namespace VirtualRobot
+{
+    namespace ParallelTools
+    {
+        //! The number of threads to use for a requested number, 0 selects one thread per core.
+        unsigned int VIRTUAL_ROBOT_IMPORT_EXPORT getNumThreads(unsigned int numThreads);
+
+        /*!
+            Runs task(0) ... task(numTasks - 1) on up to numThreads threads (0: one per core), the calling thread takes part.
+            The tasks are handed out one at a time. If a task throws, the remaining tasks are skipped and the first exception is rethrown.
+        */
+        void VIRTUAL_ROBOT_IMPORT_EXPORT runParallel(size_t numTasks, unsigned int numThreads, const std::function<void(size_t)>& task);
+    }
+
+} // namespace VirtualRobot
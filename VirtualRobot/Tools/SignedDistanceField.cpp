@@ -0,0 +1,316 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+#include "SignedDistanceField.h"
+#include "MeshDistance.h"
+#include "ParallelTools.h"
+
+#include "../CollisionDetection/CollisionModel.h"
+#include "../SceneObject.h"
+#include "../SceneObjectSet.h"
+#include "../VirtualRobotException.h"
+#include "../Visualization/TriMeshModel.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace VirtualRobot
+{
+    namespace
+    {
+        /*
+            Binary files consist of a header (magic, version, size, origin, resolution) and the values, x changing fastest.
+        */
+        const char binaryMagic[4] = {'S', 'X', 'D', 'F'};
+        const uint32_t binaryVersion = 1;
+
+        struct BinaryHeader
+        {
+            char magic[4];
+            uint32_t version;
+            int32_t size[3];
+            float origin[3];
+            float resolution;
+        };
+    }
+
+    struct SignedDistanceField::MappedFile
+    {
+        boost::interprocess::mapped_region region;
+    };
+
+
+    SignedDistanceField::SignedDistanceField(const Eigen::Vector3f& origin, float resolution, const Eigen::Vector3i& size)
+        : origin(origin), resolution(resolution), size(size), values(nullptr)
+    {
+    }
+
+    SignedDistanceField::~SignedDistanceField()
+    = default;
+
+    SignedDistanceFieldPtr SignedDistanceField::Create(const TriMeshModelPtr& mesh, float resolution, float padding, unsigned int numThreads)
+    {
+        THROW_VR_EXCEPTION_IF(!mesh, "NULL mesh");
+        THROW_VR_EXCEPTION_IF(resolution <= 0, "The resolution has to be positive");
+        THROW_VR_EXCEPTION_IF(mesh->faces.empty(), "The mesh has no faces");
+
+        std::vector<std::array<unsigned int, 3> > triangles;
+        Eigen::Vector3f min = Eigen::Vector3f::Constant(std::numeric_limits<float>::max());
+        Eigen::Vector3f max = -min;
+
+        for (const MathTools::TriangleFace& f : mesh->faces)
+        {
+            triangles.push_back({f.id1, f.id2, f.id3});
+
+            for (unsigned int id : triangles.back())
+            {
+                THROW_VR_EXCEPTION_IF(id >= mesh->vertices.size(), "Invalid vertex index in mesh");
+                min = min.cwiseMin(mesh->vertices[id]);
+                max = max.cwiseMax(mesh->vertices[id]);
+            }
+        }
+
+        MeshDistance meshDistance(mesh->vertices, triangles);
+        THROW_VR_EXCEPTION_IF(meshDistance.empty(), "The mesh has only degenerated faces");
+
+        min -= Eigen::Vector3f::Constant(std::max(padding, 0.0f));
+        max += Eigen::Vector3f::Constant(std::max(padding, 0.0f));
+        Eigen::Vector3i size;
+
+        for (int i = 0; i < 3; i++)
+        {
+            size[i] = std::max(2, int(std::ceil((max[i] - min[i]) / resolution)) + 1);
+        }
+
+        SignedDistanceFieldPtr result(new SignedDistanceField(min, resolution, size));
+        result->ownValues.resize(size_t(size.x()) * size.y() * size.z());
+        result->values = result->ownValues.data();
+        const float unbounded = std::numeric_limits<float>::max();
+
+        ParallelTools::runParallel(size.z(), numThreads, [&](int z)
+        {
+            float* slice = &result->ownValues[size_t(z) * size.x() * size.y()];
+
+            for (int y = 0; y < size.y(); y++)
+            {
+                // the distance of the previous grid point bounds the search
+                float previous = unbounded;
+
+                for (int x = 0; x < size.x(); x++)
+                {
+                    Eigen::Vector3f p = min + resolution * Eigen::Vector3f(x, y, z);
+                    float bound = previous == unbounded ? unbounded : std::abs(previous) + resolution * 1.001f;
+                    previous = meshDistance.getSignedDistance(p, bound);
+                    slice[y * size.x() + x] = previous;
+                }
+            }
+        });
+
+        return result;
+    }
+
+    SignedDistanceFieldPtr SignedDistanceField::Create(const SceneObjectSetPtr& objects, float resolution, float padding, unsigned int numThreads)
+    {
+        THROW_VR_EXCEPTION_IF(!objects, "NULL object set");
+        TriMeshModelPtr mesh(new TriMeshModel());
+
+        for (const SceneObjectPtr& object : objects->getSceneObjects())
+        {
+            CollisionModelPtr collisionModel = object->getCollisionModel();
+
+            if (!collisionModel || !collisionModel->getTriMeshModel())
+            {
+                continue;
+            }
+
+            TriMeshModelPtr objectMesh = collisionModel->getTriMeshModel();
+            Eigen::Matrix4f pose = collisionModel->getGlobalPose();
+            unsigned int offset = (unsigned int)mesh->vertices.size();
+
+            for (const Eigen::Vector3f& v : objectMesh->vertices)
+            {
+                mesh->vertices.push_back(pose.block<3, 3>(0, 0) * v + pose.block<3, 1>(0, 3));
+            }
+
+            for (const MathTools::TriangleFace& f : objectMesh->faces)
+            {
+                MathTools::TriangleFace face;
+                face.set(f.id1 + offset, f.id2 + offset, f.id3 + offset);
+                mesh->faces.push_back(face);
+            }
+        }
+
+        return Create(mesh, resolution, padding, numThreads);
+    }
+
+    float SignedDistanceField::getDistance(const Eigen::Vector3f& position) const
+    {
+        Eigen::Vector3f gridPosition = (position - origin) / resolution;
+        Eigen::Vector3f clamped = gridPosition.cwiseMax(0.0f).cwiseMin((size - Eigen::Vector3i::Ones()).cast<float>());
+        return interpolate(clamped, nullptr) + (gridPosition - clamped).norm() * resolution;
+    }
+
+    float SignedDistanceField::getDistance(const Eigen::Vector3f& position, Eigen::Vector3f& storeGradient) const
+    {
+        Eigen::Vector3f gridPosition = (position - origin) / resolution;
+        Eigen::Vector3f clamped = gridPosition.cwiseMax(0.0f).cwiseMin((size - Eigen::Vector3i::Ones()).cast<float>());
+        float result = interpolate(clamped, &storeGradient);
+        Eigen::Vector3f outside = (gridPosition - clamped) * resolution;
+        float outsideDistance = outside.norm();
+
+        // along the clamped axes, the distance changes with the distance to the grid
+        if (outsideDistance > 0)
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                if (outside[i] != 0)
+                {
+                    storeGradient[i] = outside[i] / outsideDistance;
+                }
+            }
+        }
+
+        return result + outsideDistance;
+    }
+
+    Eigen::Vector3f SignedDistanceField::getGradient(const Eigen::Vector3f& position) const
+    {
+        Eigen::Vector3f gradient;
+        getDistance(position, gradient);
+        return gradient;
+    }
+
+    float SignedDistanceField::interpolate(const Eigen::Vector3f& gridPosition, Eigen::Vector3f* storeGradient) const
+    {
+        int x = std::min(int(gridPosition.x()), size.x() - 2);
+        int y = std::min(int(gridPosition.y()), size.y() - 2);
+        int z = std::min(int(gridPosition.z()), size.z() - 2);
+        float tx = gridPosition.x() - x;
+        float ty = gridPosition.y() - y;
+        float tz = gridPosition.z() - z;
+
+        const size_t strideY = size_t(size.x());
+        const size_t strideZ = strideY * size.y();
+        const float* v = values + x + y * strideY + z * strideZ;
+        float v000 = v[0], v100 = v[1], v010 = v[strideY], v110 = v[strideY + 1];
+        float v001 = v[strideZ], v101 = v[strideZ + 1], v011 = v[strideZ + strideY], v111 = v[strideZ + strideY + 1];
+
+        float v00 = v000 + tx * (v100 - v000);
+        float v10 = v010 + tx * (v110 - v010);
+        float v01 = v001 + tx * (v101 - v001);
+        float v11 = v011 + tx * (v111 - v011);
+        float v0 = v00 + ty * (v10 - v00);
+        float v1 = v01 + ty * (v11 - v01);
+
+        if (storeGradient)
+        {
+            float dx0 = (1 - ty) * (v100 - v000) + ty * (v110 - v010);
+            float dx1 = (1 - ty) * (v101 - v001) + ty * (v111 - v011);
+            (*storeGradient)[0] = ((1 - tz) * dx0 + tz * dx1) / resolution;
+            (*storeGradient)[1] = ((1 - tz) * (v10 - v00) + tz * (v11 - v01)) / resolution;
+            (*storeGradient)[2] = (v1 - v0) / resolution;
+        }
+
+        return v0 + tz * (v1 - v0);
+    }
+
+    float SignedDistanceField::getValue(int x, int y, int z) const
+    {
+        THROW_VR_EXCEPTION_IF(x < 0 || y < 0 || z < 0 || x >= size.x() || y >= size.y() || z >= size.z(), "Grid index out of bounds");
+        return values[x + size_t(size.x()) * (y + size_t(size.y()) * z)];
+    }
+
+    const Eigen::Vector3f& SignedDistanceField::getOrigin() const
+    {
+        return origin;
+    }
+
+    float SignedDistanceField::getResolution() const
+    {
+        return resolution;
+    }
+
+    Eigen::Vector3i SignedDistanceField::getSize() const
+    {
+        return size;
+    }
+
+    bool SignedDistanceField::save(const std::string& filename) const
+    {
+        BinaryHeader header;
+        std::memcpy(header.magic, binaryMagic, sizeof(binaryMagic));
+        header.version = binaryVersion;
+
+        for (int i = 0; i < 3; i++)
+        {
+            header.size[i] = size[i];
+            header.origin[i] = origin[i];
+        }
+
+        header.resolution = resolution;
+
+        std::ofstream output(filename.c_str(), std::ios::binary);
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        output.write(reinterpret_cast<const char*>(values), std::streamsize(sizeof(float) * size.x() * size.y() * size.z()));
+
+        if (!output)
+        {
+            VR_WARNING << "Could not write signed distance field file " << filename << endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    SignedDistanceFieldPtr SignedDistanceField::load(const std::string& filename)
+    {
+        boost::shared_ptr<MappedFile> file(new MappedFile());
+
+        try
+        {
+            boost::interprocess::file_mapping mapping(filename.c_str(), boost::interprocess::read_only);
+            boost::interprocess::mapped_region(mapping, boost::interprocess::read_only).swap(file->region);
+        }
+        catch (boost::interprocess::interprocess_exception&)
+        {
+            VR_WARNING << "Could not open signed distance field file " << filename << endl;
+            return SignedDistanceFieldPtr();
+        }
+
+        const char* data = static_cast<const char*>(file->region.get_address());
+        const size_t fileSize = file->region.get_size();
+        BinaryHeader header;
+        bool ok = fileSize >= sizeof(header);
+
+        if (ok)
+        {
+            std::memcpy(&header, data, sizeof(header));
+            ok = std::memcmp(header.magic, binaryMagic, sizeof(binaryMagic)) == 0 && header.version == binaryVersion
+                 && header.size[0] >= 2 && header.size[1] >= 2 && header.size[2] >= 2 && header.resolution > 0
+                 // the file holds all values, divided step by step to avoid an overflow
+                 && (fileSize - sizeof(header)) / sizeof(float) / size_t(header.size[0]) / size_t(header.size[1]) / size_t(header.size[2]) >= 1;
+        }
+
+        if (!ok)
+        {
+            VR_WARNING << "Invalid signed distance field file " << filename << endl;
+            return SignedDistanceFieldPtr();
+        }
+
+        SignedDistanceFieldPtr result(new SignedDistanceField(Eigen::Vector3f(header.origin[0], header.origin[1], header.origin[2]), header.resolution,
+                                      Eigen::Vector3i(header.size[0], header.size[1], header.size[2])));
+        result->file = file;
+        result->values = reinterpret_cast<const float*>(data + sizeof(header));
+        return result;
+    }
+
+} //  namespace
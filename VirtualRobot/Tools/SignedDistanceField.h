@@ -0,0 +1,115 @@
+/**
+* This file is part of Simox.
+*
+* Simox is free software; you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 2 of
+* the License, or (at your option) any later version.
+*
+* Simox is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*
+*/
+#pragma once
+
+#include "../VirtualRobot.h"
+
+#include <Eigen/Core>
+
+#include <string>
+#include <vector>
+
+namespace VirtualRobot
+{
+
+    /*!
+        A regular grid of signed Euclidean distances [mm] to static geometry, negative inside of the meshes.
+        Values between the grid points are interpolated trilinearly, the gradient is the one of the interpolation.
+
+        Each grid point stores the exact distance to the closest triangle, which is searched in a bounding volume hierarchy
+        over the triangles. The grid is split into z-slices that are computed in parallel. The sign is taken from the angle
+        weighted pseudo normal of the closest feature (face, edge or vertex), hence the meshes should be closed and consistently oriented.
+
+        Fields can be stored in a binary file, which is memory mapped on loading.
+    */
+    class VIRTUAL_ROBOT_IMPORT_EXPORT SignedDistanceField
+    {
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        /*!
+            Computes the field of a mesh.
+            \param mesh The mesh. Vertices at equal positions are merged, so meshes with duplicated vertices (e.g. from STL files) can be used.
+            \param resolution The distance of the grid points [mm].
+            \param padding The grid covers the bounding box of the mesh, enlarged by padding on each side.
+            \param numThreads The number of threads, 0 uses one thread per core.
+        */
+        static SignedDistanceFieldPtr Create(const TriMeshModelPtr& mesh, float resolution, float padding, unsigned int numThreads = 0);
+
+        /*!
+            Computes the field of the collision models of the objects, at their current global poses.
+            Objects without collision model are ignored.
+        */
+        static SignedDistanceFieldPtr Create(const SceneObjectSetPtr& objects, float resolution, float padding, unsigned int numThreads = 0);
+
+        virtual ~SignedDistanceField();
+
+        /*!
+            The interpolated signed distance at a position.
+            Outside of the grid, the distance to the grid is added to the value at the closest grid position.
+        */
+        float getDistance(const Eigen::Vector3f& position) const;
+
+        /*!
+            The interpolated signed distance and its gradient.
+        */
+        float getDistance(const Eigen::Vector3f& position, Eigen::Vector3f& storeGradient) const;
+
+        Eigen::Vector3f getGradient(const Eigen::Vector3f& position) const;
+
+        //! The value of a grid point, x is the fastest changing index.
+        float getValue(int x, int y, int z) const;
+
+        //! The position of the first grid point.
+        const Eigen::Vector3f& getOrigin() const;
+        float getResolution() const;
+        //! The number of grid points along each axis.
+        Eigen::Vector3i getSize() const;
+
+        /*!
+            Writes the field to a binary file.
+        */
+        bool save(const std::string& filename) const;
+
+        /*!
+            Maps a file written by save() into memory. The values are read from the file on access.
+            \return The field or an empty pointer if the file could not be read.
+        */
+        static SignedDistanceFieldPtr load(const std::string& filename);
+
+    protected:
+        SignedDistanceField(const Eigen::Vector3f& origin, float resolution, const Eigen::Vector3i& size);
+
+        // trilinear interpolation at a position within the grid, in grid coordinates
+        float interpolate(const Eigen::Vector3f& gridPosition, Eigen::Vector3f* storeGradient) const;
+
+        struct MappedFile;
+
+        Eigen::Vector3f origin;
+        float resolution;
+        Eigen::Vector3i size;
+
+        std::vector<float> ownValues;
+        boost::shared_ptr<MappedFile> file;
+        const float* values;
+    };
+
+} // namespace
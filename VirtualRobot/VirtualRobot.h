@@ -204,6 +204,7 @@ namespace VirtualRobot
     class RobotConfig;
     class Grasp;
     class GraspSet;
+    class GraspIndex;
     class ManipulationObject;
     class CDManager;
     class Reachability;
@@ -219,6 +220,9 @@ namespace VirtualRobot
     class ForceTorqueSensor;
     class ContactSensor;
     class LocalRobot;
+    class SignedDistanceField;
+    class SphereTree;
+    class PointCloudObstacle;
 
     typedef boost::shared_ptr<CoMIK> CoMIKPtr;
     typedef boost::shared_ptr<HierarchicalIK> HierarchicalIKPtr;
@@ -258,6 +262,7 @@ namespace VirtualRobot
     typedef boost::shared_ptr<RobotConfig> RobotConfigPtr;
     typedef boost::shared_ptr<Grasp> GraspPtr;
     typedef boost::shared_ptr<GraspSet> GraspSetPtr;
+    typedef boost::shared_ptr<GraspIndex> GraspIndexPtr;
     typedef boost::shared_ptr<ManipulationObject> ManipulationObjectPtr;
     typedef boost::shared_ptr<CDManager> CDManagerPtr;
     typedef boost::shared_ptr<PoseQualityMeasurement> PoseQualityMeasurementPtr;
@@ -269,6 +274,9 @@ namespace VirtualRobot
     typedef boost::shared_ptr<ForceTorqueSensor> ForceTorqueSensorPtr;
     typedef boost::shared_ptr<ContactSensor> ContactSensorPtr;
     typedef boost::shared_ptr<LocalRobot> LocalRobotPtr;
+    typedef boost::shared_ptr<SignedDistanceField> SignedDistanceFieldPtr;
+    typedef boost::shared_ptr<SphereTree> SphereTreePtr;
+    typedef boost::shared_ptr<PointCloudObstacle> PointCloudObstaclePtr;
 
     /*
      * Predefine for MathTools.h
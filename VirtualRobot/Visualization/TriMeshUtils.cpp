@@ -23,6 +23,8 @@
  */
 #include "TriMeshUtils.h"
 
+#include <cmath>
+
 namespace VirtualRobot {
 
 void TriMeshUtils::CreateBoxTriangles(std::vector<TriMeshModel::triangle> &triangles, const Eigen::Matrix4f &globalPose, float width, float height, float depth)
@@ -148,4 +150,112 @@ TriMeshModelPtr TriMeshUtils::CreateSparseBoxGrid(const Eigen::Matrix4f &globalP
     return mesh;
 }
 
+TriMeshModelPtr TriMeshUtils::CreateSphere(const Eigen::Matrix4f &globalPose, float radius, int slices, int stacks)
+{
+    TriMeshModelPtr mesh(new TriMeshModel());
+    // the seam and the poles are evaluated exactly, hence adjacent triangles have equal vertices
+    auto point = [&](int stack, int slice)
+    {
+        float theta = float(M_PI) * stack / stacks;
+        float phi = 2.0f * float(M_PI) * (slice % slices) / slices;
+        float r = (stack == 0 || stack == stacks) ? 0.0f : radius * std::sin(theta);
+        float y = stack == 0 ? radius : (stack == stacks ? -radius : radius * std::cos(theta));
+        Eigen::Vector3f p(r * std::cos(phi), y, r * std::sin(phi));
+        return Eigen::Vector3f(globalPose.block<3,3>(0,0) * p + globalPose.block<3,1>(0,3));
+    };
+    for (int i = 0; i < stacks; i++)
+    {
+        for (int j = 0; j < slices; j++)
+        {
+            Eigen::Vector3f a = point(i, j), b = point(i, j + 1), c = point(i + 1, j), d = point(i + 1, j + 1);
+            if (i > 0)
+            {
+                mesh->addTriangleWithFace(a, b, c);
+            }
+            if (i < stacks - 1)
+            {
+                mesh->addTriangleWithFace(b, d, c);
+            }
+        }
+    }
+    return mesh;
+}
+
+TriMeshModelPtr TriMeshUtils::CreateCylinder(const Eigen::Matrix4f &globalPose, float radius, float height, int sides)
+{
+    TriMeshModelPtr mesh(new TriMeshModel());
+    auto point = [&](int side, float y)
+    {
+        float phi = 2.0f * float(M_PI) * (side % sides) / sides;
+        Eigen::Vector3f p(radius * std::cos(phi), y, -radius * std::sin(phi));
+        return Eigen::Vector3f(globalPose.block<3,3>(0,0) * p + globalPose.block<3,1>(0,3));
+    };
+    Eigen::Vector3f top = (globalPose * Eigen::Vector4f(0, height / 2, 0, 1)).head<3>();
+    Eigen::Vector3f bottom = (globalPose * Eigen::Vector4f(0, -height / 2, 0, 1)).head<3>();
+    for (int i = 0; i < sides; i++)
+    {
+        Eigen::Vector3f a = point(i, -height / 2), b = point(i + 1, -height / 2);
+        Eigen::Vector3f c = point(i, height / 2), d = point(i + 1, height / 2);
+        mesh->addTriangleWithFace(a, b, d);
+        mesh->addTriangleWithFace(a, d, c);
+        mesh->addTriangleWithFace(c, d, top);
+        mesh->addTriangleWithFace(b, a, bottom);
+    }
+    return mesh;
+}
+
+TriMeshModelPtr TriMeshUtils::CreateOpenBox(const Eigen::Matrix4f &globalPose, float width, float height, float depth, float wallThickness)
+{
+    TriMeshModelPtr mesh(new TriMeshModel());
+    auto addBox = [&](float x, float y, float z, float w, float h, float d)
+    {
+        Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+        pose.block<3,1>(0,3) = Eigen::Vector3f(x, y, z);
+        mesh->addMesh(*CreateBox(globalPose * pose, w, h, d));
+    };
+    const float t = wallThickness;
+    addBox(0, 0, t / 2, width, height, t);
+    addBox(-(width - t) / 2, 0, depth / 2, t, height, depth);
+    addBox((width - t) / 2, 0, depth / 2, t, height, depth);
+    addBox(0, -(height - t) / 2, depth / 2, width - 2 * t, t, depth);
+    addBox(0, (height - t) / 2, depth / 2, width - 2 * t, t, depth);
+    return mesh;
+}
+
+TriMeshModelPtr TriMeshUtils::CreateTessellatedBox(const Eigen::Matrix4f &globalPose, float width, float height, float depth, int subdivisions)
+{
+    TriMeshModelPtr mesh(new TriMeshModel());
+    const Eigen::Vector3f halfSize(width / 2, height / 2, depth / 2);
+    const int n = subdivisions;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        for (float side : {-1.0f, 1.0f})
+        {
+            Eigen::Vector3f normal = Eigen::Vector3f::Zero();
+            normal[axis] = side;
+            Eigen::Vector3f u = Eigen::Vector3f::Zero();
+            u[(axis + 1) % 3] = 1;
+            Eigen::Vector3f v = normal.cross(u);
+            Eigen::Vector3f c = normal.cwiseProduct(halfSize);
+            u = u.cwiseProduct(halfSize);
+            v = v.cwiseProduct(halfSize);
+            // symmetric coordinates, hence the points on the edges of adjacent sides are equal
+            auto point = [&](int i, int j)
+            {
+                Eigen::Vector3f p = c + u * (float(2 * i - n) / n) + v * (float(2 * j - n) / n);
+                return Eigen::Vector3f(globalPose.block<3,3>(0,0) * p + globalPose.block<3,1>(0,3));
+            };
+            for (int i = 0; i < n; i++)
+            {
+                for (int j = 0; j < n; j++)
+                {
+                    mesh->addTriangleWithFace(point(i, j), point(i + 1, j), point(i + 1, j + 1));
+                    mesh->addTriangleWithFace(point(i, j), point(i + 1, j + 1), point(i, j + 1));
+                }
+            }
+        }
+    }
+    return mesh;
+}
+
 } // namespace VirtualRobot
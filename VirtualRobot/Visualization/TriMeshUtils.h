@@ -38,6 +38,14 @@ public:
                                                float width = 50.f, float height = 50.f, float depth = 50.f,
                                                const VisualizationFactory::Color &color = VisualizationFactory::Color::Gray(),
                                                const std::vector<VisualizationFactory::Color>& colors = {});
+    //! A UV sphere with the given number of subdivisions along latitude (stacks) and longitude (slices).
+    static TriMeshModelPtr CreateSphere(const Eigen::Matrix4f &globalPose, float radius, int slices = 16, int stacks = 8);
+    //! A closed cylinder along the y axis (as in Coin3D), centered at the origin of globalPose.
+    static TriMeshModelPtr CreateCylinder(const Eigen::Matrix4f &globalPose, float radius, float height, int sides = 16);
+    //! A box that is open towards +z, built from a bottom and four walls. The origin of globalPose is the center of the bottom face.
+    static TriMeshModelPtr CreateOpenBox(const Eigen::Matrix4f &globalPose, float width, float height, float depth, float wallThickness);
+    //! A box centered at the origin of globalPose, each side is split into subdivisions x subdivisions squares.
+    static TriMeshModelPtr CreateTessellatedBox(const Eigen::Matrix4f &globalPose, float width, float height, float depth, int subdivisions);
 
 };
 
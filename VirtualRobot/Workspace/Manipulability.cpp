@@ -675,11 +675,12 @@ namespace VirtualRobot
 
         GraspSetPtr result(new GraspSet(grasps->getName(), grasps->getRobotType(), grasps->getEndEffector()));
 
+        std::vector< Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f> > tcpPoses;
+        grasps->getTcpPosesGlobal(object->getGlobalPose(), tcpPoses);
+
         for (unsigned int i = 0; i < grasps->getSize(); i++)
         {
-            Eigen::Matrix4f m = grasps->getGrasp(i)->getTcpPoseGlobal(object->getGlobalPose());
-
-            if (isCovered(m))
+            if (isCovered(tcpPoses[i]))
             {
                 result->addGrasp(grasps->getGrasp(i));
             }
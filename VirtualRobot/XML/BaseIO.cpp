@@ -11,14 +11,22 @@
 #include "../Nodes/RobotNodeFactory.h"
 #include "../Nodes/RobotNodeFixedFactory.h"
 #include "../Transformation/DHParameter.h"
+#include "../CollisionDetection/CollisionModelCache.h"
+#include "../Import/MeshImport/MeshReader.h"
+#include "../Tools/ParallelTools.h"
+#include "../Visualization/TriMeshModel.h"
+#include "../Visualization/TriMeshUtils.h"
 #include "../Visualization/VisualizationFactory.h"
 #include "rapidxml.hpp"
 
+#include <algorithm>
+
 namespace VirtualRobot
 {
 
 
     boost::mutex BaseIO::mutex;
+    std::atomic<unsigned int> BaseIO::numLoadingThreads(0);
 
     BaseIO::BaseIO()
     = default;
@@ -1023,66 +1031,363 @@ namespace VirtualRobot
         return visualizationNode;
     }
 
-    CollisionModelPtr BaseIO::processCollisionTag(rapidxml::xml_node<char>* colXMLNode, const std::string& tagName, const std::string& basePath)
+    CollisionModelPtr BaseIO::processCollisionTag(rapidxml::xml_node<char>* colXMLNode, const std::string& tagName, const std::string& basePath, bool createVisualization)
     {
-        rapidxml::xml_attribute<>* attr;
-        std::string collisionFileType = "";
-        VisualizationNodePtr visualizationNode;
-        CollisionModelPtr collisionModel;
-        std::vector<Primitive::PrimitivePtr> primitives;
-        std::vector<VisualizationNodePtr> visuNodes;
-        bool enableCol = true;
+        rapidxml::xml_attribute<>* attr = colXMLNode->first_attribute("enable", 0, false);
 
-        attr = colXMLNode->first_attribute("enable", 0, false);
+        if (attr && !isTrue(attr->value()))
+        {
+            return CollisionModelPtr();
+        }
 
-        if (attr)
+        std::string colModelName = tagName;
+        colModelName += "_ColModel";
+
+        if (!createVisualization)
+        {
+            return processCollisionMeshes(colXMLNode, colModelName, basePath);
+        }
+
+        VisualizationNodePtr visualizationNode;
+        std::string cacheKey;
+        CollisionModelPtr collisionModel = processCollisionVisualization(colXMLNode, tagName, basePath, visualizationNode, cacheKey);
+
+        if (!collisionModel && visualizationNode)
         {
-            enableCol = isTrue(attr->value());
+            // todo: ID?
+            collisionModel.reset(new CollisionModel(visualizationNode, colModelName, CollisionCheckerPtr()));
+
+            if (!cacheKey.empty())
+            {
+                CollisionModelCache::store(cacheKey, collisionModel);
+            }
         }
 
-        if (enableCol)
+        return collisionModel;
+    }
+
+    CollisionModelPtr BaseIO::processCollisionVisualization(rapidxml::xml_node<char>* colXMLNode, const std::string& tagName, const std::string& basePath,
+                                                            VisualizationNodePtr& storeVisualization, std::string& storeCacheKey)
+    {
+        std::string collisionFileType = "";
+        std::string colModelName = tagName;
+        colModelName += "_ColModel";
+        storeVisualization.reset();
+        storeCacheKey.clear();
+
+        if (CollisionModelCache::isEnabled())
         {
+            storeCacheKey = getCollisionCacheKey(colXMLNode, basePath, collisionFileType);
+            CollisionModelPtr collisionModel = CollisionModelCache::createCollisionModel(storeCacheKey, VisualizationFactory::fromName(collisionFileType, NULL), colModelName);
+
+            if (collisionModel)
+            {
+                return collisionModel;
+            }
+
+            collisionFileType = "";
+        }
 
-            visuNodes = processVisuFiles(colXMLNode, basePath, collisionFileType);
-            primitives = processPrimitives(colXMLNode);
-            THROW_VR_EXCEPTION_IF(primitives.size() != 0 && visuNodes.size() != 0, "Multiple collision model sources defined (file and primitives)" << endl);
+        std::vector<VisualizationNodePtr> visuNodes = processVisuFiles(colXMLNode, basePath, collisionFileType);
+        std::vector<Primitive::PrimitivePtr> primitives = processPrimitives(colXMLNode);
+        THROW_VR_EXCEPTION_IF(primitives.size() != 0 && visuNodes.size() != 0, "Multiple collision model sources defined (file and primitives)" << endl);
 
-            if (visuNodes.size() != 0)
+        if (visuNodes.size() != 0)
+        {
+            if (visuNodes.size() == 1)
             {
-                if (visuNodes.size() == 1)
+                storeVisualization = visuNodes.at(0);
+            }
+            else
+            {
+                VisualizationFactoryPtr visualizationFactory = VisualizationFactory::fromName(collisionFileType, NULL);
+
+                if (visualizationFactory)
                 {
-                    visualizationNode = visuNodes.at(0);
+                    storeVisualization = visualizationFactory->createUnitedVisualization(visuNodes);
                 }
                 else
                 {
-                    VisualizationFactoryPtr visualizationFactory = VisualizationFactory::fromName(collisionFileType, NULL);
+                    VR_WARNING << "VisualizationFactory of type '" << collisionFileType << "' not present. Ignoring Visualization data in Robot Node <" << tagName << ">" << endl;
+                }
+            }
+        }
+        else if (primitives.size() != 0)
+        {
+            VisualizationFactoryPtr visualizationFactory = VisualizationFactory::first(NULL);
+            storeVisualization = visualizationFactory->getVisualizationFromPrimitives(primitives);
+        }
 
-                    if (visualizationFactory)
-                    {
-                        visualizationNode = visualizationFactory->createUnitedVisualization(visuNodes);
-                    }
-                    else
+        return CollisionModelPtr();
+    }
+
+    BaseIO::CollisionModelMap BaseIO::processCollisionTags(const std::vector<CollisionTag>& tags, const std::string& basePath, bool createVisualization)
+    {
+        std::vector<CollisionModelPtr> collisionModels(tags.size());
+
+        if (!createVisualization)
+        {
+            // no visualization library involved, the tags are processed completely in parallel
+            runParallel(tags.size(), [&](size_t i)
+            {
+                collisionModels[i] = processCollisionTag(tags[i].first, tags[i].second, basePath, false);
+            });
+        }
+        else
+        {
+            // the visualization library is not thread safe: the files are loaded and the meshes are extracted sequentially,
+            // only the collision hierarchies are built in parallel
+            std::vector<VisualizationNodePtr> visualizations(tags.size());
+            std::vector<TriMeshModelPtr> meshes(tags.size());
+            std::vector<InternalCollisionModelPtr> hierarchies(tags.size());
+            std::vector<std::string> cacheKeys(tags.size());
+
+            for (size_t i = 0; i < tags.size(); i++)
+            {
+                rapidxml::xml_attribute<>* attr = tags[i].first->first_attribute("enable", 0, false);
+
+                if (attr && !isTrue(attr->value()))
+                {
+                    continue;
+                }
+
+                collisionModels[i] = processCollisionVisualization(tags[i].first, tags[i].second, basePath, visualizations[i], cacheKeys[i]);
+
+                if (!collisionModels[i] && visualizations[i])
+                {
+                    meshes[i] = visualizations[i]->getTriMeshModel();
+                }
+            }
+
+            runParallel(tags.size(), [&](size_t i)
+            {
+                if (meshes[i])
+                {
+#if defined(VR_COLLISION_DETECTION_PQP)
+                    hierarchies[i].reset(new CollisionModelPQP(meshes[i], CollisionCheckerPtr(), 666));
+#else
+                    hierarchies[i].reset(new CollisionModelDummy(CollisionCheckerPtr()));
+#endif
+                }
+            });
+
+            for (size_t i = 0; i < tags.size(); i++)
+            {
+                if (hierarchies[i])
+                {
+                    collisionModels[i].reset(new CollisionModel(visualizations[i], meshes[i], hierarchies[i], tags[i].second + "_ColModel"));
+
+                    if (!cacheKeys[i].empty())
                     {
-                        VR_WARNING << "VisualizationFactory of type '" << collisionFileType << "' not present. Ignoring Visualization data in Robot Node <" << tagName << ">" << endl;
+                        CollisionModelCache::store(cacheKeys[i], collisionModels[i]);
                     }
                 }
             }
-            else if (primitives.size() != 0)
+        }
+
+        CollisionModelMap result;
+
+        for (size_t i = 0; i < tags.size(); i++)
+        {
+            result[tags[i].first] = collisionModels[i];
+        }
+
+        return result;
+    }
+
+    void BaseIO::setNumLoadingThreads(unsigned int numThreads)
+    {
+        numLoadingThreads = numThreads;
+    }
+
+    unsigned int BaseIO::getNumLoadingThreads()
+    {
+        return ParallelTools::getNumThreads(numLoadingThreads);
+    }
+
+    void BaseIO::runParallel(size_t numTasks, const std::function<void(size_t)>& task)
+    {
+        unsigned int numThreads = getNumLoadingThreads();
+
+        if (numThreads > 1 && numTasks > 1)
+        {
+            // the data paths are initialized lazily, which is not thread safe
+            RuntimeEnvironment::getDataPaths();
+        }
+
+        ParallelTools::runParallel(numTasks, numThreads, task);
+    }
+
+    bool BaseIO::isUsedAsCollisionModel(rapidxml::xml_node<char>* visuXMLNode)
+    {
+        rapidxml::xml_attribute<>* attr = visuXMLNode->first_attribute("useascollisionmodel", 0, false);
+        return (attr && isTrue(attr->value())) || visuXMLNode->first_node("useascollisionmodel", 0, false);
+    }
+
+    CollisionModelPtr BaseIO::processCollisionMeshes(rapidxml::xml_node<char>* colXMLNode, const std::string& colModelName, const std::string& basePath)
+    {
+        rapidxml::xml_attribute<>* attr = colXMLNode->first_attribute("enable", 0, false);
+
+        if (attr && !isTrue(attr->value()))
+        {
+            return CollisionModelPtr();
+        }
+
+        TriMeshModelPtr mesh(new TriMeshModel());
+        bool boundingBox = false;
+        std::vector<std::string> unsupportedFiles;
+        rapidxml::xml_node<>* fileXMLNode = colXMLNode->first_node("file", 0, false);
+
+        while (fileXMLNode)
+        {
+            attr = fileXMLNode->first_attribute("boundingbox", 0, false);
+            boundingBox = boundingBox || (attr && isTrue(attr->value()));
+            std::string file = processFileNode(fileXMLNode, basePath);
+
+            if (MeshReader::isSupported(file))
             {
-                VisualizationFactoryPtr visualizationFactory = VisualizationFactory::first(NULL);
-                visualizationNode = visualizationFactory->getVisualizationFromPrimitives(primitives);
+                TriMeshModelPtr m = MeshReader::read(file);
+
+                if (m)
+                {
+                    appendMesh(*mesh, *m);
+                }
             }
+            else if (!file.empty())
+            {
+                unsupportedFiles.push_back(file);
+            }
+
+            fileXMLNode = fileXMLNode->next_sibling("file", 0, false);
+        }
+
+        if (!unsupportedFiles.empty())
+        {
+            // other formats need a visualization library, unless they have been cached before
+            std::string fileType;
+            CollisionModelPtr cached = CollisionModelCache::createCollisionModel(getCollisionCacheKey(colXMLNode, basePath, fileType), VisualizationFactoryPtr(), colModelName);
 
-            if (visualizationNode)
+            if (cached)
             {
-                std::string colModelName = tagName;
-                colModelName += "_ColModel";
-                // todo: ID?
-                collisionModel.reset(new CollisionModel(visualizationNode, colModelName, CollisionCheckerPtr()));
+                return cached;
             }
+
+            VR_WARNING << "Ignoring collision model file " << unsupportedFiles[0] << ": without visualization, only STL, OBJ and OFF files or cached collision models can be loaded" << endl;
         }
 
-        return collisionModel;
+        Eigen::Matrix4f currentTransform = Eigen::Matrix4f::Identity();
+
+        for (const Primitive::PrimitivePtr& p : processPrimitives(colXMLNode))
+        {
+            // transformations are concatenated, as in VisualizationFactory::getVisualizationFromPrimitives
+            currentTransform *= p->transform;
+            TriMeshModelPtr m;
+
+            if (p->type == Primitive::Box::TYPE)
+            {
+                Primitive::Box* box = boost::dynamic_pointer_cast<Primitive::Box>(p).get();
+                m = TriMeshUtils::CreateBox(currentTransform, box->width, box->height, box->depth);
+            }
+            else if (p->type == Primitive::Sphere::TYPE)
+            {
+                m = TriMeshUtils::CreateSphere(currentTransform, boost::dynamic_pointer_cast<Primitive::Sphere>(p)->radius);
+            }
+            else if (p->type == Primitive::Cylinder::TYPE)
+            {
+                Primitive::Cylinder* cylinder = boost::dynamic_pointer_cast<Primitive::Cylinder>(p).get();
+                m = TriMeshUtils::CreateCylinder(currentTransform, cylinder->radius, cylinder->height);
+            }
+
+            if (m)
+            {
+                appendMesh(*mesh, *m);
+            }
+        }
+
+        if (mesh->faces.empty())
+        {
+            return CollisionModelPtr();
+        }
+
+        if (boundingBox)
+        {
+            Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+            pose.block<3, 1>(0, 3) = 0.5f * (mesh->boundingBox.getMin() + mesh->boundingBox.getMax());
+            Eigen::Vector3f size = mesh->boundingBox.getMax() - mesh->boundingBox.getMin();
+            mesh = TriMeshUtils::CreateBox(pose, size.x(), size.y(), size.z());
+        }
+
+        return CollisionModelPtr(new CollisionModel(mesh, colModelName));
+    }
+
+    void BaseIO::appendMesh(TriMeshModel& mesh, const TriMeshModel& other)
+    {
+        unsigned int offset = static_cast<unsigned int>(mesh.vertices.size());
+        mesh.vertices.reserve(mesh.vertices.size() + other.vertices.size());
+        mesh.faces.reserve(mesh.faces.size() + other.faces.size());
+
+        for (const Eigen::Vector3f& v : other.vertices)
+        {
+            mesh.addVertex(v);
+        }
+
+        for (const MathTools::TriangleFace& f : other.faces)
+        {
+            MathTools::TriangleFace face;
+            face.set(f.id1 + offset, f.id2 + offset, f.id3 + offset);
+            face.normal = f.normal;
+            mesh.addFace(face);
+        }
+    }
+
+    std::string BaseIO::getCollisionCacheKey(rapidxml::xml_node<char>* colXMLNode, const std::string& basePath, std::string& fileType)
+    {
+        std::vector<std::string> files;
+        std::stringstream options;
+        rapidxml::xml_node<>* fileXMLNode = colXMLNode->first_node("file", 0, false);
+
+        while (fileXMLNode)
+        {
+            rapidxml::xml_attribute<>* attr = fileXMLNode->first_attribute("type", 0, false);
+            std::string tmpFileType;
+
+            if (attr)
+            {
+                tmpFileType = attr->value();
+            }
+            else if (VisualizationFactory::first(NULL))
+            {
+                tmpFileType = VisualizationFactory::first(NULL)->getDescription();
+            }
+
+            getLowerCase(tmpFileType);
+
+            if (fileType == "")
+            {
+                fileType = tmpFileType;
+            }
+
+            attr = fileXMLNode->first_attribute("boundingbox", 0, false);
+            options << tmpFileType << ";" << (attr && isTrue(attr->value())) << ";";
+
+            std::string file = processFileNode(fileXMLNode, basePath);
+
+            if (file.empty())
+            {
+                return std::string();
+            }
+
+            files.push_back(file);
+            fileXMLNode = fileXMLNode->next_sibling("file", 0, false);
+        }
+
+        // primitives are not cached
+        if (files.empty() || colXMLNode->first_node("primitives", 0, false))
+        {
+            return std::string();
+        }
+
+        return CollisionModelCache::getKey(files, options.str());
     }
 
     std::vector<VisualizationNodePtr> BaseIO::processVisuFiles(rapidxml::xml_node<char>* visualizationXMLNode, const std::string& basePath, std::string& fileType)
@@ -34,6 +34,8 @@
 #include <vector>
 #include <map>
 #include <fstream>
+#include <atomic>
+#include <functional>
 
 
 
@@ -53,6 +55,10 @@ namespace VirtualRobot
     class VIRTUAL_ROBOT_IMPORT_EXPORT BaseIO
     {
     public:
+        //! A collision model (or visualization) tag together with the name that is passed to processCollisionTag().
+        typedef std::pair<rapidxml::xml_node<char>*, std::string> CollisionTag;
+        typedef std::map<rapidxml::xml_node<char>*, CollisionModelPtr> CollisionModelMap;
+
         static void makeAbsolutePath(const std::string& basePath, std::string& filename);
         static void makeRelativePath(const std::string& basePath, std::string& filename);
 
@@ -88,7 +94,38 @@ namespace VirtualRobot
         static std::string processStringAttribute(const std::string& attributeName, rapidxml::xml_node<char>* node, bool allowOtherAttributes = false);
 
         static VisualizationNodePtr processVisualizationTag(rapidxml::xml_node<char>* visuXMLNode, const std::string& tagName, const std::string& basePath, bool& useAsColModel);
-        static CollisionModelPtr processCollisionTag(rapidxml::xml_node<char>* colXMLNode, const std::string& tagName, const std::string& basePath);
+        /*!
+            \param createVisualization If false, the collision model is built directly from the mesh files without a visualization (see processCollisionMeshes()).
+        */
+        static CollisionModelPtr processCollisionTag(rapidxml::xml_node<char>* colXMLNode, const std::string& tagName, const std::string& basePath, bool createVisualization = true);
+        /*!
+            Creates a collision model without visualization from the files and primitives of a collision model (or visualization) tag.
+            STL, OBJ and OFF files are read directly, other formats are only supported if they are stored in the CollisionModelCache.
+            No visualization library is involved.
+        */
+        static CollisionModelPtr processCollisionMeshes(rapidxml::xml_node<char>* colXMLNode, const std::string& colModelName, const std::string& basePath);
+        //! True if the visualization tag has a UseAsCollisionModel attribute or tag.
+        static bool isUsedAsCollisionModel(rapidxml::xml_node<char>* visuXMLNode);
+        /*!
+            Processes several collision tags with processCollisionTag() and returns the collision models by tag.
+            The tags are independent, so the work is distributed over getNumLoadingThreads() threads.
+            With a visualization, the files are still loaded sequentially since the visualization libraries are not
+            thread safe, but the collision hierarchies are built in parallel.
+            The result does not depend on the number of threads.
+        */
+        static CollisionModelMap processCollisionTags(const std::vector<CollisionTag>& tags, const std::string& basePath, bool createVisualization = true);
+
+        /*!
+            The number of threads that are used for loading collision models (see processCollisionTags()).
+            0 uses one thread per core (default), 1 loads everything sequentially.
+        */
+        static void setNumLoadingThreads(unsigned int numThreads);
+        static unsigned int getNumLoadingThreads();
+        /*!
+            The CollisionModelCache key of the mesh files of a collision model tag.
+            Returns an empty string for primitives or if a file can not be read. fileType is set to the type of the first file.
+        */
+        static std::string getCollisionCacheKey(rapidxml::xml_node<char>* colXMLNode, const std::string& basePath, std::string& fileType);
         static std::vector<Primitive::PrimitivePtr> processPrimitives(rapidxml::xml_node<char>* primitivesXMLNode);
         static void processPhysicsTag(rapidxml::xml_node<char>* physicsXMLNode, const std::string& nodeName, SceneObject::Physics& physics);
         static RobotNodeSetPtr processRobotNodeSet(rapidxml::xml_node<char>* setXMLNode, RobotPtr robo, const std::string& robotRootNode, int& robotNodeSetCounter);
@@ -104,12 +141,23 @@ namespace VirtualRobot
 
         static std::vector<VisualizationNodePtr> processVisuFiles(rapidxml::xml_node<char>* visualizationXMLNode, const std::string& basePath, std::string& fileType);
     protected:
+        static void appendMesh(TriMeshModel& mesh, const TriMeshModel& other);
+        /*!
+            The visualization part of processCollisionTag(): Returns the collision model if it is found in the CollisionModelCache,
+            otherwise the visualization of the collision model is loaded and stored in storeVisualization.
+        */
+        static CollisionModelPtr processCollisionVisualization(rapidxml::xml_node<char>* colXMLNode, const std::string& tagName, const std::string& basePath,
+                                                               VisualizationNodePtr& storeVisualization, std::string& storeCacheKey);
+        //! Runs task(0) ... task(numTasks - 1) on getNumLoadingThreads() threads, the first exception is rethrown.
+        static void runParallel(size_t numTasks, const std::function<void(size_t)>& task);
+
         // instantiation not allowed
         BaseIO();
         virtual ~BaseIO();
 
 
         static boost::mutex mutex;
+        static std::atomic<unsigned int> numLoadingThreads;
     };
 
 }
@@ -25,7 +25,7 @@ namespace VirtualRobot
     ObjectIO::~ObjectIO()
     = default;
 
-    VirtualRobot::ObstaclePtr ObjectIO::loadObstacle(const std::string& xmlFile)
+    VirtualRobot::ObstaclePtr ObjectIO::loadObstacle(const std::string& xmlFile, bool createVisualization)
     {
         // load file
         std::ifstream in(xmlFile.c_str());
@@ -35,13 +35,13 @@ namespace VirtualRobot
         boost::filesystem::path filenameBaseComplete(xmlFile);
         boost::filesystem::path filenameBasePath = filenameBaseComplete.branch_path();
         std::string basePath = filenameBasePath.string();
-        VirtualRobot::ObstaclePtr res = loadObstacle(in, basePath);
+        VirtualRobot::ObstaclePtr res = loadObstacle(in, basePath, createVisualization);
         THROW_VR_EXCEPTION_IF(!res, "Error while parsing file " << xmlFile);
         res->setFilename(xmlFile);
         return res;
     }
 
-    VirtualRobot::ObstaclePtr ObjectIO::loadObstacle(const std::ifstream& xmlFile, const std::string& basePath /*= ""*/)
+    VirtualRobot::ObstaclePtr ObjectIO::loadObstacle(const std::ifstream& xmlFile, const std::string& basePath /*= ""*/, bool createVisualization)
     {
         // load file
         THROW_VR_EXCEPTION_IF(!xmlFile.is_open(), "Could not open XML file");
@@ -50,13 +50,13 @@ namespace VirtualRobot
         buffer << xmlFile.rdbuf();
         std::string objectXML(buffer.str());
 
-        VirtualRobot::ObstaclePtr res = createObstacleFromString(objectXML, basePath);
+        VirtualRobot::ObstaclePtr res = createObstacleFromString(objectXML, basePath, createVisualization);
         THROW_VR_EXCEPTION_IF(!res, "Error while parsing file.");
         return res;
     }
 
 
-    VirtualRobot::ManipulationObjectPtr ObjectIO::loadManipulationObject(const std::string& xmlFile)
+    VirtualRobot::ManipulationObjectPtr ObjectIO::loadManipulationObject(const std::string& xmlFile, bool createVisualization)
     {
         // load file
         std::ifstream in(xmlFile.c_str());
@@ -66,13 +66,13 @@ namespace VirtualRobot
         boost::filesystem::path filenameBaseComplete(xmlFile);
         boost::filesystem::path filenameBasePath = filenameBaseComplete.branch_path();
         std::string basePath = filenameBasePath.string();
-        VirtualRobot::ManipulationObjectPtr res = loadManipulationObject(in, basePath);
+        VirtualRobot::ManipulationObjectPtr res = loadManipulationObject(in, basePath, createVisualization);
         THROW_VR_EXCEPTION_IF(!res, "Error while parsing file " << xmlFile);
         res->setFilename(xmlFile);
         return res;
     }
 
-    VirtualRobot::ManipulationObjectPtr ObjectIO::loadManipulationObject(const std::ifstream& xmlFile, const std::string& basePath /*= ""*/)
+    VirtualRobot::ManipulationObjectPtr ObjectIO::loadManipulationObject(const std::ifstream& xmlFile, const std::string& basePath /*= ""*/, bool createVisualization)
     {
         // load file
         THROW_VR_EXCEPTION_IF(!xmlFile.is_open(), "Could not open XML file");
@@ -81,7 +81,7 @@ namespace VirtualRobot
         buffer << xmlFile.rdbuf();
         std::string objectXML(buffer.str());
 
-        VirtualRobot::ManipulationObjectPtr res = createManipulationObjectFromString(objectXML, basePath);
+        VirtualRobot::ManipulationObjectPtr res = createManipulationObjectFromString(objectXML, basePath, createVisualization);
         res->initialize();
         THROW_VR_EXCEPTION_IF(!res, "Error while parsing file.");
         return res;
@@ -194,7 +194,7 @@ namespace VirtualRobot
     }
 
 
-    GraspSetPtr ObjectIO::processGraspSet(rapidxml::xml_node<char>* graspSetXMLNode, const std::string& objName)
+    GraspSetPtr ObjectIO::processGraspSet(rapidxml::xml_node<char>* graspSetXMLNode, const std::string& objName, const std::string& basePath)
     {
         THROW_VR_EXCEPTION_IF(!graspSetXMLNode, "No <GraspSet> tag ?!");
 
@@ -208,6 +208,22 @@ namespace VirtualRobot
             THROW_VR_EXCEPTION("GraspSet tags must have valid attributes 'Name', 'RobotType' and 'EndEffector'");
         }
 
+        // the grasps may be stored in a binary file (see GraspSet::saveBinary)
+        rapidxml::xml_node<>* fileNode = graspSetXMLNode->first_node("file", 0, false);
+
+        if (fileNode)
+        {
+            std::string fileName = processFileNode(fileNode, basePath);
+            GraspSetPtr grasps = GraspSet::loadBinary(fileName);
+            THROW_VR_EXCEPTION_IF(!grasps, "Could not load grasp set file '" << fileName << "' in '" << objName << "'." << endl);
+            THROW_VR_EXCEPTION_IF(grasps->getRobotType() != gsRobotType || grasps->getEndEffector() != gsEEF,
+                                  "Grasp set file '" << fileName << "' does not match RobotType and EndEffector of GraspSet <" << gsName << ">." << endl);
+            THROW_VR_EXCEPTION_IF(fileNode->next_sibling() || fileNode->previous_sibling(), "Grasp set <" << gsName << "> must either define a file or grasps." << endl);
+
+            grasps->setName(gsName);
+            return grasps;
+        }
+
         GraspSetPtr result(new GraspSet(gsName, gsRobotType, gsEEF));
 
         rapidxml::xml_node<>* node = graspSetXMLNode->first_node();
@@ -233,7 +249,7 @@ namespace VirtualRobot
         return result;
     }
 
-    ManipulationObjectPtr ObjectIO::processManipulationObject(rapidxml::xml_node<char>* objectXMLNode, const std::string& basePath)
+    ManipulationObjectPtr ObjectIO::processManipulationObject(rapidxml::xml_node<char>* objectXMLNode, const std::string& basePath, bool createVisualization, const CollisionModelMap& collisionModels)
     {
         THROW_VR_EXCEPTION_IF(!objectXMLNode, "No <ManipulationObject> tag in XML definition");
 
@@ -256,7 +272,7 @@ namespace VirtualRobot
         if (xmlFileNode)
         {
             std::string xmlFile = processFileNode(xmlFileNode, basePath);
-            ManipulationObjectPtr result = loadManipulationObject(xmlFile);
+            ManipulationObjectPtr result = loadManipulationObject(xmlFile, createVisualization);
 
             if (!result)
             {
@@ -290,7 +306,20 @@ namespace VirtualRobot
         {
             std::string nodeName = getLowerCase(node->name());
 
-            if (nodeName == "visualization")
+            if (nodeName == "visualization" && !createVisualization)
+            {
+                THROW_VR_EXCEPTION_IF(visuProcessed, "Two visualization tags defined in ManipulationObject '" << objName << "'." << endl);
+                visuProcessed = true;
+
+                if (isUsedAsCollisionModel(node))
+                {
+                    THROW_VR_EXCEPTION_IF(colProcessed, "Two collision tags defined in ManipulationObject '" << objName << "'." << endl);
+                    CollisionModelMap::const_iterator preloaded = collisionModels.find(node);
+                    collisionModel = (preloaded != collisionModels.end()) ? preloaded->second : processCollisionTag(node, objName + "_VISU", basePath, false);
+                    colProcessed = true;
+                }
+            }
+            else if (nodeName == "visualization")
             {
                 THROW_VR_EXCEPTION_IF(visuProcessed, "Two visualization tags defined in ManipulationObject '" << objName << "'." << endl);
                 visualizationNode = processVisualizationTag(node, objName, basePath, useAsColModel);
@@ -309,7 +338,8 @@ namespace VirtualRobot
             else if (nodeName == "collisionmodel")
             {
                 THROW_VR_EXCEPTION_IF(colProcessed, "Two collision tags defined in ManipulationObject '" << objName << "'." << endl);
-                collisionModel = processCollisionTag(node, objName, basePath);
+                CollisionModelMap::const_iterator preloaded = collisionModels.find(node);
+                collisionModel = (preloaded != collisionModels.end()) ? preloaded->second : processCollisionTag(node, objName, basePath, createVisualization);
                 colProcessed = true;
             }
             else if (nodeName == "physics")
@@ -320,7 +350,7 @@ namespace VirtualRobot
             }
             else if (nodeName == "graspset")
             {
-                GraspSetPtr gs = processGraspSet(node, objName);
+                GraspSetPtr gs = processGraspSet(node, objName, basePath);
                 THROW_VR_EXCEPTION_IF(!gs, "Invalid grasp set in '" << objName << "'." << endl);
                 graspSets.push_back(gs);
 
@@ -352,7 +382,39 @@ namespace VirtualRobot
         return object;
     }
 
-    ObstaclePtr ObjectIO::processObstacle(rapidxml::xml_node<char>* objectXMLNode, const std::string& basePath)
+    BaseIO::CollisionModelMap ObjectIO::loadCollisionModels(const std::vector<rapidxml::xml_node<char>*>& objectXMLNodes, const std::string& basePath, bool createVisualization)
+    {
+        std::vector<CollisionTag> tags;
+
+        for (rapidxml::xml_node<char>* objectXMLNode : objectXMLNodes)
+        {
+            // objects from files and objects without name are handled by processObstacle() and processManipulationObject()
+            std::string objName = processNameAttribute(objectXMLNode);
+
+            if (objectXMLNode->first_node("file", 0, false) || objName.empty())
+            {
+                continue;
+            }
+
+            for (rapidxml::xml_node<>* node = objectXMLNode->first_node(); node; node = node->next_sibling())
+            {
+                std::string tagName = getLowerCase(node->name());
+
+                if (tagName == "collisionmodel")
+                {
+                    tags.push_back(CollisionTag(node, objName));
+                }
+                else if (tagName == "visualization" && !createVisualization && isUsedAsCollisionModel(node))
+                {
+                    tags.push_back(CollisionTag(node, objName + "_VISU"));
+                }
+            }
+        }
+
+        return processCollisionTags(tags, basePath, createVisualization);
+    }
+
+    ObstaclePtr ObjectIO::processObstacle(rapidxml::xml_node<char>* objectXMLNode, const std::string& basePath, bool createVisualization, const CollisionModelMap& collisionModels)
     {
         THROW_VR_EXCEPTION_IF(!objectXMLNode, "No <Obstacle> tag in XML definition");
 
@@ -374,7 +436,7 @@ namespace VirtualRobot
         if (xmlFileNode)
         {
             std::string xmlFile = processFileNode(xmlFileNode, basePath);
-            ObstaclePtr result = loadObstacle(xmlFile);
+            ObstaclePtr result = loadObstacle(xmlFile, createVisualization);
 
             if (!result)
             {
@@ -407,7 +469,20 @@ namespace VirtualRobot
         {
             std::string nodeName = getLowerCase(node->name());
 
-            if (nodeName == "visualization")
+            if (nodeName == "visualization" && !createVisualization)
+            {
+                THROW_VR_EXCEPTION_IF(visuProcessed, "Two visualization tags defined in Obstacle '" << objName << "'." << endl);
+                visuProcessed = true;
+
+                if (isUsedAsCollisionModel(node))
+                {
+                    THROW_VR_EXCEPTION_IF(colProcessed, "Two collision tags defined in Obstacle '" << objName << "'." << endl);
+                    CollisionModelMap::const_iterator preloaded = collisionModels.find(node);
+                    collisionModel = (preloaded != collisionModels.end()) ? preloaded->second : processCollisionTag(node, objName + "_VISU", basePath, false);
+                    colProcessed = true;
+                }
+            }
+            else if (nodeName == "visualization")
             {
                 THROW_VR_EXCEPTION_IF(visuProcessed, "Two visualization tags defined in Obstacle '" << objName << "'." << endl);
                 visualizationNode = processVisualizationTag(node, objName, basePath, useAsColModel);
@@ -426,7 +501,8 @@ namespace VirtualRobot
             else if (nodeName == "collisionmodel")
             {
                 THROW_VR_EXCEPTION_IF(colProcessed, "Two collision tags defined in Obstacle '" << objName << "'." << endl);
-                collisionModel = processCollisionTag(node, objName, basePath);
+                CollisionModelMap::const_iterator preloaded = collisionModels.find(node);
+                collisionModel = (preloaded != collisionModels.end()) ? preloaded->second : processCollisionTag(node, objName, basePath, createVisualization);
                 colProcessed = true;
             }
             else if (nodeName == "physics")
@@ -455,7 +531,7 @@ namespace VirtualRobot
 
 
 
-    VirtualRobot::ManipulationObjectPtr ObjectIO::createManipulationObjectFromString(const std::string& xmlString, const std::string& basePath /*= ""*/)
+    VirtualRobot::ManipulationObjectPtr ObjectIO::createManipulationObjectFromString(const std::string& xmlString, const std::string& basePath /*= ""*/, bool createVisualization)
     {
         // copy string content to char array
         char* y = new char[xmlString.size() + 1];
@@ -469,7 +545,7 @@ namespace VirtualRobot
             doc.parse<0>(y);    // 0 means default parse flags
             rapidxml::xml_node<char>* objectXMLNode = doc.first_node("ManipulationObject");
 
-            obj = processManipulationObject(objectXMLNode, basePath);
+            obj = processManipulationObject(objectXMLNode, basePath, createVisualization);
 
 
 
@@ -507,7 +583,7 @@ namespace VirtualRobot
     }
 
 
-    VirtualRobot::ObstaclePtr ObjectIO::createObstacleFromString(const std::string& xmlString, const std::string& basePath /*= ""*/)
+    VirtualRobot::ObstaclePtr ObjectIO::createObstacleFromString(const std::string& xmlString, const std::string& basePath /*= ""*/, bool createVisualization)
     {
         // copy string content to char array
         char* y = new char[xmlString.size() + 1];
@@ -521,7 +597,7 @@ namespace VirtualRobot
             doc.parse<0>(y);    // 0 means default parse flags
             rapidxml::xml_node<char>* objectXMLNode = doc.first_node("Obstacle");
 
-            obj = processObstacle(objectXMLNode, basePath);
+            obj = processObstacle(objectXMLNode, basePath, createVisualization);
 
 
 
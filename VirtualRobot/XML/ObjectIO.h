@@ -46,9 +46,10 @@ namespace VirtualRobot
         /*!
             Load Obstacle from file.
             @param xmlFile The file
+            @param createVisualization If false, no visualization is created and the collision model is built directly from the mesh files (see BaseIO::processCollisionMeshes).
             @return Returns an empty pointer, when file access failed.
         */
-        static ObstaclePtr loadObstacle(const std::string& xmlFile);
+        static ObstaclePtr loadObstacle(const std::string& xmlFile, bool createVisualization = true);
 
         /*!
             Load Obstacle from a file stream.
@@ -56,14 +57,15 @@ namespace VirtualRobot
             @param basePath If file tags are given, the base path for searching the object files can be specified.
             @return Returns an empty pointer, when file access failed.
         */
-        static ObstaclePtr loadObstacle(const std::ifstream& xmlFile, const std::string& basePath = "");
+        static ObstaclePtr loadObstacle(const std::ifstream& xmlFile, const std::string& basePath = "", bool createVisualization = true);
 
         /*!
             Load ManipulationObject from file.
             @param xmlFile The file
+            @param createVisualization If false, no visualization is created and the collision model is built directly from the mesh files (see BaseIO::processCollisionMeshes).
             @return Returns an empty pointer, when file access failed.
         */
-        static ManipulationObjectPtr loadManipulationObject(const std::string& xmlFile);
+        static ManipulationObjectPtr loadManipulationObject(const std::string& xmlFile, bool createVisualization = true);
 
         /*!
             Load ManipulationObject from a file stream.
@@ -71,7 +73,7 @@ namespace VirtualRobot
             @param basePath If file tags are given, the base path for searching the object files can be specified.
             @return Returns an empty pointer, when file access failed.
         */
-        static ManipulationObjectPtr loadManipulationObject(const std::ifstream& xmlFile, const std::string& basePath = "");
+        static ManipulationObjectPtr loadManipulationObject(const std::ifstream& xmlFile, const std::string& basePath = "", bool createVisualization = true);
 
         /*!
             Save ManipulationObject to file.
@@ -86,18 +88,28 @@ namespace VirtualRobot
             @param xmlString The input string.
             @param basePath If file tags are given, the base path for searching the object files can be specified.
         */
-        static ManipulationObjectPtr createManipulationObjectFromString(const std::string& xmlString, const std::string& basePath = "");
+        static ManipulationObjectPtr createManipulationObjectFromString(const std::string& xmlString, const std::string& basePath = "", bool createVisualization = true);
 
         /*!
             Creates Obstacle from string.
             @param xmlString The input string.
             @param basePath If file tags are given, the base path for searching the object files can be specified.
         */
-        static ObstaclePtr createObstacleFromString(const std::string& xmlString, const std::string& basePath = "");
+        static ObstaclePtr createObstacleFromString(const std::string& xmlString, const std::string& basePath = "", bool createVisualization = true);
 
-        static ObstaclePtr processObstacle(rapidxml::xml_node<char>* objectXMLNode, const std::string& basePath);
-        static ManipulationObjectPtr processManipulationObject(rapidxml::xml_node<char>* objectXMLNode, const std::string& basePath);
-        static GraspSetPtr processGraspSet(rapidxml::xml_node<char>* graspSetXMLNode, const std::string& objName);
+        /*!
+            \param collisionModels Preloaded collision models (see loadCollisionModels()), the collision tags of the object are only processed if they are not contained.
+        */
+        static ObstaclePtr processObstacle(rapidxml::xml_node<char>* objectXMLNode, const std::string& basePath, bool createVisualization = true,
+                                           const CollisionModelMap& collisionModels = CollisionModelMap());
+        static ManipulationObjectPtr processManipulationObject(rapidxml::xml_node<char>* objectXMLNode, const std::string& basePath, bool createVisualization = true,
+                                                               const CollisionModelMap& collisionModels = CollisionModelMap());
+        /*!
+            Loads the collision models of several Obstacle or ManipulationObject tags in parallel with processCollisionTags().
+            Only objects that are defined inline are considered, objects that are loaded from a file are skipped.
+        */
+        static CollisionModelMap loadCollisionModels(const std::vector<rapidxml::xml_node<char>*>& objectXMLNodes, const std::string& basePath, bool createVisualization = true);
+        static GraspSetPtr processGraspSet(rapidxml::xml_node<char>* graspSetXMLNode, const std::string& objName, const std::string& basePath = "");
         static GraspPtr processGrasp(rapidxml::xml_node<char>* graspXMLNode, const std::string& robotType, const std::string& eef, const std::string& objName);
 
         /*!
@@ -609,7 +609,8 @@ namespace VirtualRobot
                                            std::vector< std::string >& childrenNames,
                                            std::vector< ChildFromRobotDef >& childrenFromRobot,
                                            RobotDescription loadMode,
-                                           RobotNode::RobotNodeType rntype)
+                                           RobotNode::RobotNodeType rntype,
+                                           const CollisionModelMap& collisionModels)
     {
         childrenFromRobot.clear();
         THROW_VR_EXCEPTION_IF(!robotNodeXMLNode, "NULL data in processRobotNode");
@@ -685,14 +686,23 @@ namespace VirtualRobot
                         collisionModel.reset(new CollisionModel(visualizationNodeCM, colModelName, CollisionCheckerPtr()));
                         colProcessed = true;
                     }
+                }
+                else if (loadMode == eCollisionModelNoVisualization && isUsedAsCollisionModel(node))
+                {
+                    useAsColModel = true;
+                    THROW_VR_EXCEPTION_IF(colProcessed, "Two collision tags defined in RobotNode '" << robotNodeName << "'." << endl);
+                    CollisionModelMap::const_iterator preloaded = collisionModels.find(node);
+                    collisionModel = (preloaded != collisionModels.end()) ? preloaded->second : processCollisionTag(node, robotNodeName + "_VISU", basePath, false);
+                    colProcessed = true;
                 }// else silently ignore tag
             }
             else if (nodeName == "collisionmodel")
             {
-                if (loadMode == eFull || loadMode == eCollisionModel)
+                if (loadMode == eFull || loadMode == eCollisionModel || loadMode == eCollisionModelNoVisualization)
                 {
                     THROW_VR_EXCEPTION_IF(colProcessed, "Two collision tags defined in RobotNode '" << robotNodeName << "'." << endl);
-                    collisionModel = processCollisionTag(node, robotNodeName, basePath);
+                    CollisionModelMap::const_iterator preloaded = collisionModels.find(node);
+                    collisionModel = (preloaded != collisionModels.end()) ? preloaded->second : processCollisionTag(node, robotNodeName, basePath, loadMode != eCollisionModelNoVisualization);
                     colProcessed = true;
                 } // else silently ignore tag
             }
@@ -980,6 +990,50 @@ namespace VirtualRobot
     }
 
 
+    BaseIO::CollisionModelMap RobotIO::loadCollisionModels(rapidxml::xml_node<char>* robotXMLNode, const std::string& basePath, RobotDescription loadMode)
+    {
+        std::vector<CollisionTag> tags;
+
+        if (loadMode == eStructure)
+        {
+            return CollisionModelMap();
+        }
+
+        for (rapidxml::xml_node<>* XMLNode = robotXMLNode->first_node(nullptr, 0, false); XMLNode; XMLNode = XMLNode->next_sibling(nullptr, 0, false))
+        {
+            std::string nodeName = getLowerCase(XMLNode->name());
+
+            if (nodeName != "robotnode" && nodeName != "jointnode" && nodeName != "transformationnode" && nodeName != "bodynode" && nodeName != "modelnode")
+            {
+                continue;
+            }
+
+            // nodes without name are handled by processRobotNode()
+            std::string robotNodeName = processNameAttribute(XMLNode);
+
+            if (robotNodeName.empty())
+            {
+                continue;
+            }
+
+            for (rapidxml::xml_node<>* node = XMLNode->first_node(); node; node = node->next_sibling())
+            {
+                std::string tagName = getLowerCase(node->name());
+
+                if (tagName == "collisionmodel")
+                {
+                    tags.push_back(CollisionTag(node, robotNodeName));
+                }
+                else if (tagName == "visualization" && loadMode == eCollisionModelNoVisualization && isUsedAsCollisionModel(node))
+                {
+                    tags.push_back(CollisionTag(node, robotNodeName + "_VISU"));
+                }
+            }
+        }
+
+        return processCollisionTags(tags, basePath, loadMode != eCollisionModelNoVisualization);
+    }
+
     void RobotIO::processRobotChildNodes(rapidxml::xml_node<char>* robotXMLNode,
                                          RobotPtr robo,
                                          const std::string& robotRoot,
@@ -995,6 +1049,9 @@ namespace VirtualRobot
         RobotNodePtr rootNode;
         int robotNodeCounter = 0; // used for robotnodes without names
 
+        // the collision models of all robot nodes are independent and loaded in parallel
+        CollisionModelMap collisionModels = loadCollisionModels(robotXMLNode, basePath, loadMode);
+
         //std::vector<rapidxml::xml_node<>* > robotNodeSetNodes;
         //std::vector<rapidxml::xml_node<>* > endeffectorNodes;
         rapidxml::xml_node<>* XMLNode = robotXMLNode->first_node(nullptr, 0, false);
@@ -1026,7 +1083,7 @@ namespace VirtualRobot
                     rntype = RobotNode::Transform;
                 }
 
-                RobotNodePtr n = processRobotNode(XMLNode, robo, basePath, robotNodeCounter, childrenNames, childrenFromRobot, loadMode, rntype);
+                RobotNodePtr n = processRobotNode(XMLNode, robo, basePath, robotNodeCounter, childrenNames, childrenFromRobot, loadMode, rntype, collisionModels);
 
                 if (!n)
                 {
@@ -54,7 +54,8 @@ namespace VirtualRobot
         {
             eFull,              // load complete robot definition
             eCollisionModel,    // skip visualization tags and load only collision model
-            eStructure          // load only the structure of the robot, ignore visualization and collision tags -> faster access when robot is only used for coordinate transformations
+            eStructure,         // load only the structure of the robot, ignore visualization and collision tags -> faster access when robot is only used for coordinate transformations
+            eCollisionModelNoVisualization // load only collision models, directly from the mesh files without any visualization (see BaseIO::processCollisionMeshes) -> for processes that never render
         };
 
         /*!
@@ -126,7 +127,13 @@ namespace VirtualRobot
                                              std::vector< std::string >& childrenNames,
                                              std::vector< ChildFromRobotDef >& childrenFromRobot,
                                              RobotDescription loadMode = eFull,
-                                             RobotNode::RobotNodeType rntype = RobotNode::Generic);
+                                             RobotNode::RobotNodeType rntype = RobotNode::Generic,
+                                             const CollisionModelMap& collisionModels = CollisionModelMap());
+        /*!
+            Loads the collision models of all robot nodes with processCollisionTags().
+            The result is passed to processRobotNode(), which uses the preloaded collision model of a tag if available.
+        */
+        static CollisionModelMap loadCollisionModels(rapidxml::xml_node<char>* robotXMLNode, const std::string& basePath, RobotDescription loadMode);
         static EndEffectorPtr processEndeffectorNode(rapidxml::xml_node<char>* endeffectorXMLNode, RobotPtr robo);
         static EndEffectorActorPtr processEndeffectorActorNode(rapidxml::xml_node<char>* endeffectorActorXMLNode, RobotPtr robo);
         static void processEndeffectorStaticNode(rapidxml::xml_node<char>* endeffectorStaticXMLNode, RobotPtr robo, std::vector<RobotNodePtr>& staticNodesList);
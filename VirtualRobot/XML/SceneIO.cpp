@@ -19,7 +19,7 @@ namespace VirtualRobot
     SceneIO::~SceneIO()
     = default;
 
-    VirtualRobot::ScenePtr SceneIO::loadScene(const std::string& xmlFile)
+    VirtualRobot::ScenePtr SceneIO::loadScene(const std::string& xmlFile, RobotIO::RobotDescription loadMode)
     {
         // load file
         std::ifstream in(xmlFile.c_str());
@@ -35,7 +35,7 @@ namespace VirtualRobot
 
         in.close();
 
-        VirtualRobot::ScenePtr res = createSceneFromString(robotXML, basePath);
+        VirtualRobot::ScenePtr res = createSceneFromString(robotXML, basePath, loadMode);
         THROW_VR_EXCEPTION_IF(!res, "Error while parsing file " << xmlFile);
 
         return res;
@@ -55,7 +55,7 @@ namespace VirtualRobot
     }
 
 
-    bool SceneIO::processSceneRobot(rapidxml::xml_node<char>* sceneXMLNode, ScenePtr scene, const std::string& basePath)
+    bool SceneIO::processSceneRobot(rapidxml::xml_node<char>* sceneXMLNode, ScenePtr scene, const std::string& basePath, RobotIO::RobotDescription loadMode)
     {
         THROW_VR_EXCEPTION_IF(!sceneXMLNode, "NULL data in processSceneRobot");
 
@@ -113,7 +113,7 @@ namespace VirtualRobot
 
         // create & register robot
         THROW_VR_EXCEPTION_IF(fileName.empty(), "Missing file definition in scene's robot tag '" << robotName << "'." << endl);
-        RobotPtr robot = RobotIO::loadRobot(fileName);
+        RobotPtr robot = RobotIO::loadRobot(fileName, loadMode);
         THROW_VR_EXCEPTION_IF(!robot, "Invalid robot file in scene's robot tag '" << robotName << "'." << endl);
         robot->setGlobalPose(globalPose);
         scene->registerRobot(robot);
@@ -198,11 +198,11 @@ namespace VirtualRobot
     }
 
 
-    bool SceneIO::processSceneManipulationObject(rapidxml::xml_node<char>* sceneXMLNode, ScenePtr scene, const std::string& basePath)
+    bool SceneIO::processSceneManipulationObject(rapidxml::xml_node<char>* sceneXMLNode, ScenePtr scene, const std::string& basePath, bool createVisualization, const CollisionModelMap& collisionModels)
     {
         THROW_VR_EXCEPTION_IF(!sceneXMLNode, "NULL data in processSceneManipulationObject");
 
-        ManipulationObjectPtr o = ObjectIO::processManipulationObject(sceneXMLNode, basePath);
+        ManipulationObjectPtr o = ObjectIO::processManipulationObject(sceneXMLNode, basePath, createVisualization, collisionModels);
 
         if (!o)
         {
@@ -214,11 +214,11 @@ namespace VirtualRobot
     }
 
 
-    bool SceneIO::processSceneObstacle(rapidxml::xml_node<char>* sceneXMLNode, ScenePtr scene, const std::string& basePath)
+    bool SceneIO::processSceneObstacle(rapidxml::xml_node<char>* sceneXMLNode, ScenePtr scene, const std::string& basePath, bool createVisualization, const CollisionModelMap& collisionModels)
     {
         THROW_VR_EXCEPTION_IF(!sceneXMLNode, "NULL data in processSceneObstacle");
 
-        ObstaclePtr o = ObjectIO::processObstacle(sceneXMLNode, basePath);
+        ObstaclePtr o = ObjectIO::processObstacle(sceneXMLNode, basePath, createVisualization, collisionModels);
 
         if (!o)
         {
@@ -245,7 +245,7 @@ namespace VirtualRobot
         return true;
     }
 
-    ScenePtr SceneIO::processScene(rapidxml::xml_node<char>* sceneXMLNode, const std::string& basePath)
+    ScenePtr SceneIO::processScene(rapidxml::xml_node<char>* sceneXMLNode, const std::string& basePath, RobotIO::RobotDescription loadMode)
     {
         THROW_VR_EXCEPTION_IF(!sceneXMLNode, "No <Scene> tag in XML definition");
 
@@ -256,7 +256,21 @@ namespace VirtualRobot
         // process xml nodes
         std::vector<rapidxml::xml_node<char>* > sceneSetNodes;
         std::vector<rapidxml::xml_node<char>* > trajectoryNodes;
+        std::vector<rapidxml::xml_node<char>* > objectNodes;
+        bool createVisualization = (loadMode != RobotIO::eCollisionModelNoVisualization);
 
+        for (rapidxml::xml_node<>* node = sceneXMLNode->first_node(nullptr, 0, false); node; node = node->next_sibling(nullptr, 0, false))
+        {
+            std::string nodeName = getLowerCase(node->name());
+
+            if (nodeName == "obstacle" || nodeName == "manipulationobject")
+            {
+                objectNodes.push_back(node);
+            }
+        }
+
+        // the collision models of all objects are independent and loaded in parallel
+        CollisionModelMap collisionModels = ObjectIO::loadCollisionModels(objectNodes, basePath, createVisualization);
 
         rapidxml::xml_node<>* XMLNode = sceneXMLNode->first_node(nullptr, 0, false);
 
@@ -267,7 +281,7 @@ namespace VirtualRobot
 
             if (nodeName == "robot")
             {
-                bool r = processSceneRobot(XMLNode, scene, basePath);
+                bool r = processSceneRobot(XMLNode, scene, basePath, loadMode);
 
                 if (!r)
                 {
@@ -278,7 +292,7 @@ namespace VirtualRobot
             }
             else if (nodeName == "obstacle")
             {
-                bool r = processSceneObstacle(XMLNode, scene, basePath);
+                bool r = processSceneObstacle(XMLNode, scene, basePath, createVisualization, collisionModels);
 
                 if (!r)
                 {
@@ -288,7 +302,7 @@ namespace VirtualRobot
             }
             else if (nodeName == "manipulationobject")
             {
-                bool r = processSceneManipulationObject(XMLNode, scene, basePath);
+                bool r = processSceneManipulationObject(XMLNode, scene, basePath, createVisualization, collisionModels);
 
                 if (!r)
                 {
@@ -343,7 +357,7 @@ namespace VirtualRobot
 
 
 
-    VirtualRobot::ScenePtr SceneIO::createSceneFromString(const std::string& xmlString, const std::string& basePath /*= ""*/)
+    VirtualRobot::ScenePtr SceneIO::createSceneFromString(const std::string& xmlString, const std::string& basePath /*= ""*/, RobotIO::RobotDescription loadMode)
     {
         // copy string content to char array
         char* y = new char[xmlString.size() + 1];
@@ -356,7 +370,7 @@ namespace VirtualRobot
             rapidxml::xml_document<char> doc;    // character type defaults to char
             doc.parse<0>(y);    // 0 means default parse flags
             rapidxml::xml_node<char>* sceneXMLNode = doc.first_node("Scene");
-            scene = processScene(sceneXMLNode, basePath);
+            scene = processScene(sceneXMLNode, basePath, loadMode);
         }
         catch (rapidxml::parse_error& e)
         {
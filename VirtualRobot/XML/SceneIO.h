@@ -24,6 +24,7 @@
 
 #include "../VirtualRobot.h"
 #include "BaseIO.h"
+#include "RobotIO.h"
 #include "../Scene.h"
 
 // using forward declarations here, so that the rapidXML header does not have to be parsed when this file is included
@@ -43,9 +44,10 @@ namespace VirtualRobot
         /*!
             Load scene from file.
             \param xmlFile The file.
+            \param loadMode The load mode of the robots. With RobotIO::eCollisionModelNoVisualization, no visualizations are created for the robots and objects of the scene.
             \return Returns an empty pointer, when file access failed.
         */
-        static ScenePtr loadScene(const std::string& xmlFile);
+        static ScenePtr loadScene(const std::string& xmlFile, RobotIO::RobotDescription loadMode = RobotIO::eFull);
 
         /*!
             Save a scene to file.
@@ -59,20 +61,23 @@ namespace VirtualRobot
             Creates scene from string.
             \param xmlString The input.
             \param basePath If any robot tags are given, the base path for searching the robot files can be specified.
+            \param loadMode The load mode of the robots, see loadScene().
         */
-        static ScenePtr createSceneFromString(const std::string& xmlString, const std::string& basePath = "");
+        static ScenePtr createSceneFromString(const std::string& xmlString, const std::string& basePath = "", RobotIO::RobotDescription loadMode = RobotIO::eFull);
 
     protected:
 
         // instantiation not allowed
         SceneIO();
         ~SceneIO() override;
-        static ScenePtr processScene(rapidxml::xml_node<char>* sceneXMLNode, const std::string& basePath);
+        static ScenePtr processScene(rapidxml::xml_node<char>* sceneXMLNode, const std::string& basePath, RobotIO::RobotDescription loadMode = RobotIO::eFull);
         static ScenePtr processSceneAttributes(rapidxml::xml_node<char>* sceneXMLNode);
-        static bool processSceneRobot(rapidxml::xml_node<char>* sceneXMLNode, ScenePtr scene, const std::string& basePath);
-        static bool processSceneObstacle(rapidxml::xml_node<char>* sceneXMLNode, ScenePtr scene, const std::string& basePath);
+        static bool processSceneRobot(rapidxml::xml_node<char>* sceneXMLNode, ScenePtr scene, const std::string& basePath, RobotIO::RobotDescription loadMode = RobotIO::eFull);
+        static bool processSceneObstacle(rapidxml::xml_node<char>* sceneXMLNode, ScenePtr scene, const std::string& basePath, bool createVisualization = true,
+                                         const CollisionModelMap& collisionModels = CollisionModelMap());
         static bool processSceneTrajectory(rapidxml::xml_node<char>* sceneXMLNode, ScenePtr scene);
-        static bool processSceneManipulationObject(rapidxml::xml_node<char>* sceneXMLNode, ScenePtr scene, const std::string& basePath);
+        static bool processSceneManipulationObject(rapidxml::xml_node<char>* sceneXMLNode, ScenePtr scene, const std::string& basePath, bool createVisualization = true,
+                                                   const CollisionModelMap& collisionModels = CollisionModelMap());
         static bool processSceneObjectSet(rapidxml::xml_node<char>* sceneXMLNode, ScenePtr scene);
     };
 
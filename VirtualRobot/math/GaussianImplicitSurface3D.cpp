@@ -20,13 +20,43 @@
  */
 
 #include "GaussianImplicitSurface3D.h"
+#include "../DataStructures/nanoflann.hpp"
+#include "../DataStructures/KdTreePointCloud.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
 using namespace math;
 
+// kd-tree of the samples, used to find the samples within the support radius of compactly supported kernels
+struct GaussianImplicitSurface3D::Neighbors
+{
+    typedef nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Simple_Adaptor<float, VirtualRobot::PointCloud<float> >, VirtualRobot::PointCloud<float>, 3> KdTree;
+
+    VirtualRobot::PointCloud<float> cloud;
+    std::unique_ptr<KdTree> tree;
+
+    Neighbors(const Eigen::Matrix3Xf& points)
+    {
+        cloud.pts.reserve(points.cols());
+        for (Eigen::Index i = 0; i < points.cols(); i++)
+        {
+            cloud.pts.push_back({points(0, i), points(1, i), points(2, i)});
+        }
+        tree.reset(new KdTree(3, cloud, nanoflann::KDTreeSingleIndexAdaptorParams(10)));
+        tree->buildIndex();
+    }
+
+    void Find(const Eigen::Vector3f& pos, float radius, std::vector<std::pair<size_t, float> >& result) const
+    {
+        nanoflann::SearchParams params;
+        params.sorted = false;
+        tree->radiusSearch(pos.data(), radius * radius, result, params);
+    }
+};
+
 GaussianImplicitSurface3D::GaussianImplicitSurface3D(std::unique_ptr<KernelWithDerivatives> kernel)
-    : kernel(std::move(kernel)) {}
+    : useQr(false), R(0), kernel(std::move(kernel)) {}
 
 
 void GaussianImplicitSurface3D::Calculate(const std::vector<DataR3R1>& samples, float noise)
@@ -41,29 +71,35 @@ void GaussianImplicitSurface3D::Calculate(const std::vector<DataR3R1>& samples,
 
 void GaussianImplicitSurface3D::Calculate(const std::vector<DataR3R2>& samples)
 {
-    this->samples = samples;
-    std::vector<Eigen::Vector3f> points;
+    points.resize(3, samples.size());
     Eigen::VectorXd values(samples.size());
     std::vector<float> noise;
     int i = 0;
 
     for(const auto& d: samples){
-        points.push_back(d.Position());
+        points.col(i) = d.Position();
         values(i++) = d.Value1();
         noise.push_back(d.Value2());
     }
 
     R = 0;
 
-    for (const Eigen::Vector3f& p1 : points) {
-        for (const Eigen::Vector3f& p2 : points) {
-            R = std::max(R, (p1 - p2).squaredNorm());
-        }
+    for (Eigen::Index j = 0; j < points.cols(); j++)
+    {
+        R = std::max(R, (points.rightCols(points.cols() - j).colwise() - points.col(j)).colwise().squaredNorm().maxCoeff());
     }
     R = std::sqrt(R);
 
-    CalculateCovariance(points, R, noise);
-    MatrixInvert(values);
+    neighbors.reset();
+
+    if (kernel->SupportRadius() < R)
+    {
+        CalculateSparseCovariance(noise, values);
+    }
+    else
+    {
+        CalculateCovariance(noise, values);
+    }
 }
 
 float GaussianImplicitSurface3D::Get(Eigen::Vector3f pos)
@@ -71,51 +107,161 @@ float GaussianImplicitSurface3D::Get(Eigen::Vector3f pos)
     return Predict(pos);
 }
 
-float GaussianImplicitSurface3D::GetVariance(const Eigen::Vector3f& pos)
+std::vector<float> GaussianImplicitSurface3D::GetBatch(const std::vector<Eigen::Vector3f>& positions)
 {
-    Eigen::VectorXd Cux(samples.size());
-    int i = 0;
-    for (const auto& d : samples)
+    std::vector<float> result(positions.size());
+
+    if (neighbors)
     {
-        Cux(i++) = kernel->Kernel(pos, d.Position(), R);
+        for (size_t i = 0; i < positions.size(); i++)
+        {
+            result[i] = Predict(positions[i]);
+        }
+        return result;
     }
 
-    return kernel->Kernel(pos, pos, R) - Cux.dot(covariance_inv * Cux);
+    // the kernel values of a block of positions are calculated at once, the prediction is a matrix vector product
+    const size_t blockSize = 64;
+    Eigen::MatrixXd block(points.cols(), blockSize);
+
+    for (size_t start = 0; start < positions.size(); start += blockSize)
+    {
+        const size_t count = std::min(blockSize, positions.size() - start);
+        for (size_t j = 0; j < count; j++)
+        {
+            Eigen::Ref<Eigen::VectorXd> column = block.col(j);
+            kernel->KernelRow(positions[start + j], points, R, column);
+        }
+        const Eigen::VectorXd values = block.leftCols(count).transpose() * alpha;
+        for (size_t j = 0; j < count; j++)
+        {
+            result[start + j] = float(values(j));
+        }
+    }
+    return result;
 }
 
-float GaussianImplicitSurface3D::Predict(const Eigen::Vector3f& pos) const
+float GaussianImplicitSurface3D::GetVariance(const Eigen::Vector3f& pos)
 {
-    Eigen::VectorXd Cux(samples.size());
-    int i = 0;
-    for (const auto& d : samples)
+    const Eigen::VectorXd Cux = GetCux(pos);
+    const double prior = kernel->Kernel(pos, pos, R);
+
+    if (neighbors)
+    {
+        const Eigen::VectorXd x = sparseLlt.solve(Cux);
+        return prior - Cux.dot(x);
+    }
+    if (useQr)
     {
-        Cux(i++) = kernel->Kernel(pos, d.Position(), R);
+        const Eigen::VectorXd x = qr.solve(Cux);
+        return prior - Cux.dot(x);
     }
-    return Cux.dot(alpha);
+    // Cux^T C^-1 Cux = |L^-1 Cux|^2
+    const Eigen::VectorXd v = llt.matrixL().solve(Cux);
+    return prior - v.squaredNorm();
 }
 
-void GaussianImplicitSurface3D::CalculateCovariance(const std::vector<Eigen::Vector3f>& points, float R, const std::vector<float>& noise)
+Eigen::VectorXd GaussianImplicitSurface3D::GetCux(const Eigen::Vector3f& pos) const
 {
-    covariance = Eigen::MatrixXd(points.size(), points.size());
+    Eigen::VectorXd Cux(points.cols());
 
-    for (size_t i = 0; i < points.size(); i++)
+    if (neighbors)
     {
-        for (size_t j = i; j < points.size(); j++)
+        Cux.setZero();
+        std::vector<std::pair<size_t, float> > found;
+        neighbors->Find(pos, kernel->SupportRadius(), found);
+        for (const auto& f : found)
         {
-            float cov = kernel->Kernel(points.at(i), points.at(j), R);
-            covariance(i, j) = cov;
-            covariance(j, i) = cov;
+            Cux(f.first) = kernel->Kernel(pos, points.col(f.first), R);
         }
     }
-    for (size_t i = 0; i < points.size(); i++)
+    else
+    {
+        kernel->KernelRow(pos, points, R, Cux);
+    }
+    return Cux;
+}
+
+float GaussianImplicitSurface3D::Predict(const Eigen::Vector3f& pos) const
+{
+    if (neighbors)
+    {
+        std::vector<std::pair<size_t, float> > found;
+        neighbors->Find(pos, kernel->SupportRadius(), found);
+        double result = 0;
+        for (const auto& f : found)
+        {
+            result += kernel->Kernel(pos, points.col(f.first), R) * alpha(f.first);
+        }
+        return result;
+    }
+    return GetCux(pos).dot(alpha);
+}
+
+void GaussianImplicitSurface3D::CalculateCovariance(const std::vector<float>& noise, const Eigen::VectorXd& b)
+{
+    const Eigen::Index n = points.cols();
+    Eigen::MatrixXd covariance(n, n);
+
+    // the decompositions only read the lower triangle
+    for (Eigen::Index i = 0; i < n; i++)
     {
+        Eigen::Ref<Eigen::VectorXd> column = covariance.col(i).tail(n - i);
+        kernel->KernelRow(points.col(i), points.rightCols(n - i), R, column);
         covariance(i, i) += noise.at(i) * noise.at(i);
     }
+
+    // kernels that are not positive definite (e.g. WilliamsPlusKernel) are solved with QR
+    llt.compute(covariance);
+    useQr = llt.info() != Eigen::Success;
+
+    if (useQr)
+    {
+        llt = Eigen::LLT<Eigen::MatrixXd>();
+        qr.compute(covariance.selfadjointView<Eigen::Lower>());
+        alpha = qr.solve(b);
+    }
+    else
+    {
+        qr = Eigen::ColPivHouseholderQR<Eigen::MatrixXd>();
+        alpha = llt.solve(b);
+    }
 }
 
-void GaussianImplicitSurface3D::MatrixInvert(const Eigen::VectorXd& b)
+void GaussianImplicitSurface3D::CalculateSparseCovariance(const std::vector<float>& noise, const Eigen::VectorXd& b)
 {
-    Eigen::ColPivHouseholderQR<Eigen::MatrixXd> qr = covariance.colPivHouseholderQr();
-    covariance_inv = qr.inverse();
-    alpha = covariance_inv * b;
+    const Eigen::Index n = points.cols();
+    neighbors = std::make_shared<Neighbors>(points);
+
+    // lower triangle of the covariance, samples further apart than the support radius are uncorrelated
+    std::vector<Eigen::Triplet<double> > triplets;
+    std::vector<std::pair<size_t, float> > found;
+    for (Eigen::Index i = 0; i < n; i++)
+    {
+        neighbors->Find(points.col(i), kernel->SupportRadius(), found);
+        for (const auto& f : found)
+        {
+            const Eigen::Index j = Eigen::Index(f.first);
+            if (j > i)
+            {
+                triplets.emplace_back(j, i, kernel->Kernel(points.col(j), points.col(i), R));
+            }
+        }
+        triplets.emplace_back(i, i, kernel->Kernel(points.col(i), points.col(i), R) + noise.at(i) * noise.at(i));
+    }
+
+    Eigen::SparseMatrix<double> covariance(n, n);
+    covariance.setFromTriplets(triplets.begin(), triplets.end());
+    sparseLlt.compute(covariance);
+
+    if (sparseLlt.info() != Eigen::Success)
+    {
+        VR_WARNING << "Sparse covariance is not positive definite, using the dense decomposition" << std::endl;
+        neighbors.reset();
+        CalculateCovariance(noise, b);
+        return;
+    }
+
+    useQr = false;
+    alpha = sparseLlt.solve(b);
 }
@@ -27,11 +27,18 @@
 #include "DataR3R2.h"
 #include "SimpleAbstractFunctionR3R1.h"
 #include "Kernels.h"
+#include <Eigen/SparseCholesky>
 #include <memory>
 
 namespace math
 {
 
+/**
+ * Gaussian process regression of an implicit surface.
+ * The covariance is factorized with a Cholesky decomposition (with a QR fallback for kernels that are not positive definite).
+ * For kernels with compact support (e.g. WendlandKernel) the covariance is stored as sparse matrix and predictions only
+ * consider the samples within the support radius, which scales to several thousand samples.
+ */
 class VIRTUAL_ROBOT_IMPORT_EXPORT GaussianImplicitSurface3D :
         public SimpleAbstractFunctionR3R1
 {
@@ -40,20 +47,27 @@ public:
     void Calculate(const std::vector<DataR3R1>& samples, float noise);
     void Calculate(const std::vector<DataR3R2>& samples);
     float Get(Eigen::Vector3f pos) override;
+    // evaluates blocks of positions at once, which is considerably faster than calling Get() for each position
+    std::vector<float> GetBatch(const std::vector<Eigen::Vector3f>& positions) override;
     float GetVariance(const Eigen::Vector3f& pos);
 
 private:
-    Eigen::MatrixXd covariance;
-    Eigen::MatrixXd covariance_inv;
+    struct Neighbors;
+
+    Eigen::Matrix3Xf points;
     Eigen::VectorXd alpha;
-    std::vector<DataR3R2> samples;
+    Eigen::LLT<Eigen::MatrixXd> llt;
+    Eigen::ColPivHouseholderQR<Eigen::MatrixXd> qr;
+    Eigen::SimplicialLLT<Eigen::SparseMatrix<double>> sparseLlt;
+    std::shared_ptr<Neighbors> neighbors;
+    bool useQr;
     float R;
     
     std::unique_ptr<KernelWithDerivatives> kernel;
 
     float Predict(const Eigen::Vector3f& pos) const;
-    void CalculateCovariance(const std::vector<Eigen::Vector3f>& points, float R, const std::vector<float>& noise);
-    void MatrixInvert(const Eigen::VectorXd& b);
+    Eigen::VectorXd GetCux(const Eigen::Vector3f& pos) const;
+    void CalculateCovariance(const std::vector<float>& noise, const Eigen::VectorXd& b);
+    void CalculateSparseCovariance(const std::vector<float>& noise, const Eigen::VectorXd& b);
 };
 }
-
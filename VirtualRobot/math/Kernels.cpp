@@ -23,6 +23,7 @@
 #include "Helpers.h"
 #include <cmath>
 #include <iostream>
+#include <limits>
 
 using namespace math;
 
@@ -86,6 +87,19 @@ void KernelWithDerivatives::swap(float &x, float &y, float &z, int index) const
     }
 }
 
+void KernelWithDerivatives::KernelRow(const Eigen::Vector3f& p1, const Eigen::Ref<const Eigen::Matrix3Xf>& points, float R, Eigen::Ref<Eigen::VectorXd> result) const
+{
+    for (Eigen::Index i = 0; i < points.cols(); i++)
+    {
+        result(i) = Kernel(p1, points.col(i), R);
+    }
+}
+
+float KernelWithDerivatives::SupportRadius() const
+{
+    return std::numeric_limits<float>::infinity();
+}
+
 GaussianKernel::GaussianKernel(float lengthScale)
     : lengthScale(lengthScale) {}
 
@@ -96,6 +110,12 @@ float GaussianKernel::Kernel(const Eigen::Vector3f& p1, const Eigen::Vector3f& p
     return std::exp(-tmp);
 }
 
+void GaussianKernel::KernelRow(const Eigen::Vector3f& p1, const Eigen::Ref<const Eigen::Matrix3Xf>& points, float /*R*/, Eigen::Ref<Eigen::VectorXd> result) const
+{
+    const Eigen::ArrayXf tmp = (points.colwise() - p1).colwise().squaredNorm().transpose().array() / (2*lengthScale*lengthScale);
+    result = (-tmp).exp().cast<double>().matrix();
+}
+
 float GaussianKernel::Kernel_dx(float /*x*/, float /*y*/, float /*z*/, float /*r*/, float /*R*/) const
 {
     throw std::runtime_error("function not implemented");
@@ -118,6 +138,12 @@ float WilliamsPlusKernel::Kernel(const Eigen::Vector3f& p1, const Eigen::Vector3
     return 2 * r*r*r + 3 * R * r*r + R*R*R;
 }
 
+void WilliamsPlusKernel::KernelRow(const Eigen::Vector3f& p1, const Eigen::Ref<const Eigen::Matrix3Xf>& points, float R, Eigen::Ref<Eigen::VectorXd> result) const
+{
+    const Eigen::ArrayXf r = (points.colwise() - p1).colwise().norm().transpose().array();
+    result = (2 * r*r*r + 3 * R * r*r + R*R*R).cast<double>().matrix();
+}
+
 float WilliamsPlusKernel::Kernel_dx(float x, float /*y*/, float /*z*/, float r, float R) const
 {
     return 6 * x * (r + R);
@@ -141,6 +167,12 @@ float WilliamsMinusKernel::Kernel(const Eigen::Vector3f& p1, const Eigen::Vector
     return 2 * r*r*r - 3 * R * r*r + R*R*R;
 }
 
+void WilliamsMinusKernel::KernelRow(const Eigen::Vector3f& p1, const Eigen::Ref<const Eigen::Matrix3Xf>& points, float R, Eigen::Ref<Eigen::VectorXd> result) const
+{
+    const Eigen::ArrayXf r = (points.colwise() - p1).colwise().norm().transpose().array();
+    result = (2 * r*r*r - 3 * R * r*r + R*R*R).cast<double>().matrix();
+}
+
 float WilliamsMinusKernel::Kernel_dx(float x, float /*y*/, float /*z*/, float r, float R) const
 {
     return 6 * x * (r - R);
@@ -157,3 +189,52 @@ float WilliamsMinusKernel::Kernel_dxdy(float x, float y, float /*z*/, float r, f
     if (r == 0) return 0;
     return -6 * x * y / r;
 }
+
+WendlandKernel::WendlandKernel(float supportRadius)
+    : supportRadius(supportRadius) {}
+
+float WendlandKernel::Kernel(const Eigen::Vector3f& p1, const Eigen::Vector3f& p2, float /*R*/) const
+{
+    const float t = (p1 - p2).norm() / supportRadius;
+    if (t >= 1) return 0;
+    const float s = 1 - t;
+    return s*s*s*s * (4 * t + 1);
+}
+
+float WendlandKernel::Kernel_dx(float x, float /*y*/, float /*z*/, float r, float /*R*/) const
+{
+    const float t = r / supportRadius;
+    if (t >= 1) return 0;
+    const float s = 1 - t;
+    return -20 * x * s*s*s / (supportRadius * supportRadius);
+}
+
+float WendlandKernel::Kernel_ddx(float x, float /*y*/, float /*z*/, float r, float /*R*/) const
+{
+    const float t = r / supportRadius;
+    if (t >= 1) return 0;
+    const float s = 1 - t;
+    const float s2 = supportRadius * supportRadius;
+    if (r == 0) return -20 / s2;
+    return -20 * s*s*s / s2 + 60 * x * x * s*s / (r * s2 * supportRadius);
+}
+
+float WendlandKernel::Kernel_dxdy(float x, float y, float /*z*/, float r, float /*R*/) const
+{
+    const float t = r / supportRadius;
+    if (t >= 1 || r == 0) return 0;
+    const float s = 1 - t;
+    return 60 * x * y * s*s / (r * supportRadius * supportRadius * supportRadius);
+}
+
+void WendlandKernel::KernelRow(const Eigen::Vector3f& p1, const Eigen::Ref<const Eigen::Matrix3Xf>& points, float /*R*/, Eigen::Ref<Eigen::VectorXd> result) const
+{
+    const Eigen::ArrayXf t = ((points.colwise() - p1).colwise().norm().transpose().array() / supportRadius).min(1.f);
+    const Eigen::ArrayXf s = 1 - t;
+    result = (s.square().square() * (4 * t + 1)).cast<double>().matrix();
+}
+
+float WendlandKernel::SupportRadius() const
+{
+    return supportRadius;
+}
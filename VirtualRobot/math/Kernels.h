@@ -31,6 +31,7 @@ namespace math
 class VIRTUAL_ROBOT_IMPORT_EXPORT KernelWithDerivatives
 {
 public:
+    virtual ~KernelWithDerivatives() = default;
     virtual float Kernel(const Eigen::Vector3f& p1, const Eigen::Vector3f& p2, float R) const = 0;
     virtual float Kernel_dx(float x, float y, float z, float r, float R) const = 0;
     virtual float Kernel_ddx(float x, float y, float z, float r, float R) const = 0;
@@ -41,6 +42,12 @@ public:
     float Kernel_dj(const Eigen::Vector3f& p1, const Eigen::Vector3f& p2, float R, int j) const;
     float Kernel_didj(const Eigen::Vector3f& p1, const Eigen::Vector3f& p2, float R, int i, int j) const;
     void swap(float &x, float &y, float &z, int index) const;
+
+    // evaluates the kernel between p1 and each column of points, kernels override this with a vectorized version
+    virtual void KernelRow(const Eigen::Vector3f& p1, const Eigen::Ref<const Eigen::Matrix3Xf>& points, float R, Eigen::Ref<Eigen::VectorXd> result) const;
+
+    // the kernel is zero for points that are further apart, infinity for kernels with global support
+    virtual float SupportRadius() const;
 };
 
 class VIRTUAL_ROBOT_IMPORT_EXPORT GaussianKernel : public KernelWithDerivatives {
@@ -50,6 +57,7 @@ public:
     float Kernel_dx(float x, float y, float z, float r, float R) const override;
     float Kernel_ddx(float x, float y, float z, float r, float R) const override;
     float Kernel_dxdy(float x, float y, float z, float r, float R) const override;
+    void KernelRow(const Eigen::Vector3f& p1, const Eigen::Ref<const Eigen::Matrix3Xf>& points, float R, Eigen::Ref<Eigen::VectorXd> result) const override;
 
 private:
     float lengthScale;
@@ -60,6 +68,7 @@ class VIRTUAL_ROBOT_IMPORT_EXPORT WilliamsPlusKernel : public KernelWithDerivati
     float Kernel_dx(float x, float y, float z, float r, float R) const override;
     float Kernel_ddx(float x, float y, float z, float r, float R) const override;
     float Kernel_dxdy(float x, float y, float z, float r, float R) const override;
+    void KernelRow(const Eigen::Vector3f& p1, const Eigen::Ref<const Eigen::Matrix3Xf>& points, float R, Eigen::Ref<Eigen::VectorXd> result) const override;
 };
 
 class VIRTUAL_ROBOT_IMPORT_EXPORT WilliamsMinusKernel : public KernelWithDerivatives {
@@ -67,6 +76,23 @@ class VIRTUAL_ROBOT_IMPORT_EXPORT WilliamsMinusKernel : public KernelWithDerivat
     float Kernel_dx(float x, float y, float z, float r, float R) const override;
     float Kernel_ddx(float x, float y, float z, float r, float R) const override;
     float Kernel_dxdy(float x, float y, float z, float r, float R) const override;
+    void KernelRow(const Eigen::Vector3f& p1, const Eigen::Ref<const Eigen::Matrix3Xf>& points, float R, Eigen::Ref<Eigen::VectorXd> result) const override;
+};
+
+// Wendland's compactly supported kernel (1 - r/s)^4 (4 r/s + 1), which is zero beyond the support radius s.
+// The covariance of samples is sparse, if the support radius is small compared to the sampled object.
+class VIRTUAL_ROBOT_IMPORT_EXPORT WendlandKernel : public KernelWithDerivatives {
+public:
+    WendlandKernel(float supportRadius);
+    float Kernel(const Eigen::Vector3f& p1, const Eigen::Vector3f& p2, float R) const override;
+    float Kernel_dx(float x, float y, float z, float r, float R) const override;
+    float Kernel_ddx(float x, float y, float z, float r, float R) const override;
+    float Kernel_dxdy(float x, float y, float z, float r, float R) const override;
+    void KernelRow(const Eigen::Vector3f& p1, const Eigen::Ref<const Eigen::Matrix3Xf>& points, float R, Eigen::Ref<Eigen::VectorXd> result) const override;
+    float SupportRadius() const override;
+
+private:
+    float supportRadius;
 };
 
 }
@@ -28,6 +28,13 @@
 #include "SimpleAbstractFunctionR3R1.h"
 #include "stdio.h"
 #include "GridCacheFloat3.h"
+#include "../Tools/ParallelTools.h"
+#include "../Visualization/TriMeshModel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
 
 using namespace math;
 
@@ -151,6 +158,210 @@ PrimitivePtr MarchingCubes::Calculate(Eigen::Vector3f center, Eigen::Vector3f st
 }
 
 
+namespace
+{
+    // the grid edge of each cube edge: offset of its lower sample and axis
+    const int cubeEdges[12][4] = {{0, 0, 0, 0}, {1, 0, 0, 1}, {0, 1, 0, 0}, {0, 0, 0, 1},
+                                  {0, 0, 1, 0}, {1, 0, 1, 1}, {0, 1, 1, 0}, {0, 0, 1, 1},
+                                  {0, 0, 0, 2}, {1, 0, 0, 2}, {1, 1, 0, 2}, {0, 1, 0, 2}};
+
+    // the slab of cells along x (and the blocks of the narrow band)
+    const int blockSize = 8;
+}
+
+VirtualRobot::TriMeshModelPtr MarchingCubes::CalculateMesh(Eigen::Vector3f center, int steps, float stepLength, SimpleAbstractFunctionR3R1Ptr modelPtr,
+                                                           float isolevel, float narrowBand, unsigned int numThreads)
+{
+    const int cells = steps * 2;
+    const int n = cells + 1;
+    const int numBlocks = (cells + blockSize - 1) / blockSize;
+    const Eigen::Vector3f origin = center - Eigen::Vector3f(1, 1, 1) * stepLength * steps;
+    auto sampleIndex = [n](int x, int y, int z) { return (int64_t(x) * n + y) * n + z; };
+    auto blockIndex = [numBlocks](int x, int y, int z) { return (x * numBlocks + y) * numBlocks + z; };
+
+    // blocks of cells that are evaluated and polygonised
+    std::vector<char> activeBlocks(numBlocks * numBlocks * numBlocks, 1);
+
+    if (narrowBand > 0)
+    {
+        auto corner = [cells](int b) { return std::min(b * blockSize, cells); };
+        std::vector<Eigen::Vector3f> positions;
+        for (int x = 0; x <= numBlocks; x++)
+            for (int y = 0; y <= numBlocks; y++)
+                for (int z = 0; z <= numBlocks; z++)
+                {
+                    positions.push_back(origin + stepLength * Eigen::Vector3f(corner(x), corner(y), corner(z)));
+                }
+        const std::vector<float> values = modelPtr->GetBatch(positions);
+        auto value = [&](int x, int y, int z) { return values.at((x * (numBlocks + 1) + y) * (numBlocks + 1) + z); };
+
+        for (int x = 0; x < numBlocks; x++)
+            for (int y = 0; y < numBlocks; y++)
+                for (int z = 0; z < numBlocks; z++)
+                {
+                    int above = 0;
+                    bool near = false;
+                    for (int c = 0; c < 8; c++)
+                    {
+                        float v = value(x + (c & 1), y + ((c >> 1) & 1), z + (c >> 2));
+                        above += v > isolevel ? 1 : 0;
+                        near |= std::abs(v - isolevel) < narrowBand;
+                    }
+                    activeBlocks[blockIndex(x, y, z)] = near || (above > 0 && above < 8);
+                }
+    }
+
+    // a cell is processed if its block is active, a sample is evaluated if one of its cells is processed
+    auto isCellActive = [&](int x, int y, int z)
+    {
+        return x >= 0 && y >= 0 && z >= 0 && x < cells && y < cells && z < cells
+               && activeBlocks[blockIndex(x / blockSize, y / blockSize, z / blockSize)];
+    };
+
+    std::vector<float> values(size_t(n) * n * n, 0.f);
+    std::vector<char> evaluated(values.size(), 0);
+
+    // slab s owns the samples and cells with x in [s * blockSize, (s + 1) * blockSize), the last slab also owns x = cells
+    auto slabEnd = [&](int s) { return s == numBlocks - 1 ? n : (s + 1) * blockSize; };
+    auto slabOf = [&](int x) { return std::min(x / blockSize, numBlocks - 1); };
+
+    VirtualRobot::ParallelTools::runParallel(numBlocks, numThreads, [&](int s)
+    {
+        std::vector<Eigen::Vector3f> positions;
+        std::vector<int> zs;
+        for (int x = s * blockSize; x < slabEnd(s); x++)
+        {
+            for (int y = 0; y < n; y++)
+            {
+                // the samples of one z-column are evaluated at once
+                positions.clear();
+                zs.clear();
+                for (int z = 0; z < n; z++)
+                {
+                    bool needed = false;
+                    for (int c = 0; c < 8 && !needed; c++)
+                    {
+                        needed = isCellActive(x - (c & 1), y - ((c >> 1) & 1), z - (c >> 2));
+                    }
+                    if (needed)
+                    {
+                        positions.push_back(origin + stepLength * Eigen::Vector3f(x, y, z));
+                        zs.push_back(z);
+                    }
+                }
+                if (positions.empty())
+                {
+                    continue;
+                }
+                const std::vector<float> column = modelPtr->GetBatch(positions);
+                for (size_t i = 0; i < zs.size(); i++)
+                {
+                    values[sampleIndex(x, y, zs[i])] = column.at(i);
+                    evaluated[sampleIndex(x, y, zs[i])] = 1;
+                }
+            }
+        }
+    });
+
+    // vertices on the grid edges that cross the isosurface, each slab creates the vertices of the edges starting at its samples
+    std::vector<std::vector<Eigen::Vector3f>> slabVertices(numBlocks);
+    std::vector<std::unordered_map<int64_t, unsigned int>> slabVertexIds(numBlocks);
+
+    VirtualRobot::ParallelTools::runParallel(numBlocks, numThreads, [&](int s)
+    {
+        for (int x = s * blockSize; x < slabEnd(s); x++)
+            for (int y = 0; y < n; y++)
+                for (int z = 0; z < n; z++)
+                {
+                    const int64_t i0 = sampleIndex(x, y, z);
+                    if (!evaluated[i0])
+                    {
+                        continue;
+                    }
+                    for (int axis = 0; axis < 3; axis++)
+                    {
+                        int x1 = x + (axis == 0), y1 = y + (axis == 1), z1 = z + (axis == 2);
+                        if (x1 >= n || y1 >= n || z1 >= n || !evaluated[sampleIndex(x1, y1, z1)]
+                            || (values[i0] > isolevel) == (values[sampleIndex(x1, y1, z1)] > isolevel))
+                        {
+                            continue;
+                        }
+                        // the four cells around the edge
+                        bool used = false;
+                        for (int c = 0; c < 4 && !used; c++)
+                        {
+                            int a = c & 1, b = c >> 1;
+                            used = isCellActive(x - (axis != 0 ? a : 0), y - (axis == 0 ? a : (axis == 2 ? b : 0)), z - (axis != 2 ? b : 0));
+                        }
+                        if (!used)
+                        {
+                            continue;
+                        }
+                        slabVertexIds[s][3 * i0 + axis] = slabVertices[s].size();
+                        slabVertices[s].push_back(origin + stepLength * VertexInterp(isolevel, Eigen::Vector3f(x, y, z), Eigen::Vector3f(x1, y1, z1),
+                                                                                     values[i0], values[sampleIndex(x1, y1, z1)]));
+                    }
+                }
+    });
+
+    std::vector<unsigned int> vertexOffsets(numBlocks + 1, 0);
+    for (int s = 0; s < numBlocks; s++)
+    {
+        vertexOffsets[s + 1] = vertexOffsets[s] + slabVertices[s].size();
+    }
+
+    // faces of each slab, the vertices of other slabs are only read
+    std::vector<std::vector<unsigned int>> slabFaces(numBlocks);
+
+    VirtualRobot::ParallelTools::runParallel(numBlocks, numThreads, [&](int s)
+    {
+        for (int x = s * blockSize; x < std::min(slabEnd(s), cells); x++)
+            for (int y = 0; y < cells; y++)
+                for (int z = 0; z < cells; z++)
+                {
+                    if (!isCellActive(x, y, z))
+                    {
+                        continue;
+                    }
+                    unsigned int cubeindex = 0;
+                    for (int c = 0; c < 8; c++)
+                    {
+                        // corner order of GridCell::P
+                        int cx = x + ((c + 1) >> 1 & 1), cy = y + (c >> 1 & 1), cz = z + (c >> 2);
+                        if (values[sampleIndex(cx, cy, cz)] > isolevel)
+                        {
+                            cubeindex |= 1 << c;
+                        }
+                    }
+                    for (int i = 0; _triTable[cubeindex][i] != -1; i++)
+                    {
+                        const int* e = cubeEdges[static_cast<std::size_t>(_triTable[cubeindex][i])];
+                        const int ex = x + e[0];
+                        const int owner = slabOf(ex);
+                        slabFaces[s].push_back(vertexOffsets[owner] + slabVertexIds[owner].at(3 * sampleIndex(ex, y + e[1], z + e[2]) + e[3]));
+                    }
+                }
+    });
+
+    VirtualRobot::TriMeshModelPtr result(new VirtualRobot::TriMeshModel());
+    result->vertices.reserve(vertexOffsets.back());
+    for (const std::vector<Eigen::Vector3f>& vertices : slabVertices)
+    {
+        result->vertices.insert(result->vertices.end(), vertices.begin(), vertices.end());
+    }
+    for (const std::vector<unsigned int>& faces : slabFaces)
+    {
+        for (size_t i = 0; i < faces.size(); i += 3)
+        {
+            VirtualRobot::MathTools::TriangleFace face;
+            face.set(faces[i], faces[i + 1], faces[i + 2]);
+            face.normal = VirtualRobot::TriMeshModel::CreateNormal(result->vertices[face.id1], result->vertices[face.id2], result->vertices[face.id3]);
+            result->faces.push_back(face);
+        }
+    }
+    return result;
+}
+
 float MarchingCubes::GetVal(int x, int y, int z, int i)
 {
     switch (i)
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include "../VirtualRobot.h"
 #include "MathForwardDefinitions.h"
 #include "Array3D.h"
 #include "Triangle.h"
@@ -41,6 +42,19 @@ namespace math
         void ProcessSingleSurfaceOptimized(float isolevel, PrimitivePtr primitive, Index3 start);
         static PrimitivePtr Calculate(Eigen::Vector3f center, Eigen::Vector3f start, int steps, float stepLength, SimpleAbstractFunctionR3R1Ptr modelPtr, float isolevel);
 
+        /**
+         * Meshes the isosurface within the cube of 2 * steps cells around center. Cells share their vertices, the faces point
+         * towards increasing values of the model.
+         * The model is evaluated in z-columns through SimpleAbstractFunctionR3R1::GetBatch(). The grid is split into slabs along x,
+         * which are evaluated and polygonised in parallel, hence the model has to allow concurrent calls (use numThreads = 1 otherwise).
+         * If narrowBand is positive, the model is first evaluated at the corners of blocks of 8^3 cells. Only blocks whose corners are
+         * closer than narrowBand to the isolevel, or lie on both sides of it, are evaluated and polygonised. narrowBand should therefore
+         * exceed the variation of the model within a block.
+         * \param numThreads The number of threads, 0 uses one thread per core.
+         */
+        static VirtualRobot::TriMeshModelPtr CalculateMesh(Eigen::Vector3f center, int steps, float stepLength, SimpleAbstractFunctionR3R1Ptr modelPtr,
+                                                           float isolevel, float narrowBand = 0, unsigned int numThreads = 0);
+
     private:
       struct GridCell{
           public:
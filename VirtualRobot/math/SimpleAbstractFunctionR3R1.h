@@ -32,6 +32,18 @@ namespace math
     public:
         virtual float Get(Eigen::Vector3f pos) = 0;
 
+        // evaluates several positions at once, functions may override this with a vectorized version
+        virtual std::vector<float> GetBatch(const std::vector<Eigen::Vector3f>& positions)
+        {
+            std::vector<float> result;
+            result.reserve(positions.size());
+            for (const Eigen::Vector3f& pos : positions)
+            {
+                result.push_back(Get(pos));
+            }
+            return result;
+        }
+
     private:
     };
 }
@@ -9,6 +9,7 @@
 #include <VirtualRobot/VirtualRobotTest.h>
 #include <VirtualRobot/math/GaussianImplicitSurface3D.h>
 #include <VirtualRobot/math/Helpers.h>
+#include <chrono>
 #include <string>
 #include <stdio.h>
 
@@ -68,5 +69,124 @@ BOOST_AUTO_TEST_CASE(testGPISNoise)
 
 }
 
+namespace
+{
+    // samples on the surface (0), inside (-1) and outside (+1) of a unit sphere
+    std::vector<DataR3R2> CreateSphereSamples(int count, float offset, float noise)
+    {
+        std::vector<DataR3R2> samples;
+        for (int i = 0; i < count; i++)
+        {
+            // fibonacci sphere
+            float z = 1 - 2 * (i + 0.5f) / count;
+            float phi = i * float(M_PI) * (3 - std::sqrt(5.f));
+            Vec3 n(std::sqrt(1 - z * z) * std::cos(phi), std::sqrt(1 - z * z) * std::sin(phi), z);
+            samples.push_back(DataR3R2(n, 0, noise));
+            samples.push_back(DataR3R2(n * (1 - offset), -1, noise));
+            samples.push_back(DataR3R2(n * (1 + offset), 1, noise));
+        }
+        return samples;
+    }
+
+    double ElapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testGPISBatchAndVariance)
+{
+    std::vector<DataR3R2> samples = CreateSphereSamples(50, 0.2f, 0.05f);
+    std::vector<Vec3> positions;
+    for (int i = 0; i < 100; i++)
+    {
+        positions.push_back(Vec3(0.03f * i - 1.5f, 0.2f, -0.1f));
+    }
+
+    GaussianImplicitSurface3D gaussian(std::unique_ptr<GaussianKernel>(new GaussianKernel(0.5f)));
+    gaussian.Calculate(samples);
+    GaussianImplicitSurface3D williams(std::unique_ptr<WilliamsPlusKernel>(new WilliamsPlusKernel));
+    williams.Calculate(samples);
+
+    for (GaussianImplicitSurface3D* gpis : {&gaussian, &williams})
+    {
+        std::vector<float> values = gpis->GetBatch(positions);
+        BOOST_REQUIRE_EQUAL(values.size(), positions.size());
+        for (size_t i = 0; i < positions.size(); i++)
+        {
+            BOOST_CHECK_SMALL(values[i] - gpis->Get(positions[i]), 1e-3f);
+        }
+        for (const DataR3R2& s : samples)
+        {
+            BOOST_CHECK_LE(fabs(s.Value1() - gpis->Get(s.Position())), 0.1);
+        }
+    }
+
+    // the variance is small at the samples and grows with the distance to them
+    float nearVariance = gaussian.GetVariance(samples.at(0).Position());
+    BOOST_CHECK_GE(nearVariance, -1e-4f);
+    BOOST_CHECK_LT(nearVariance, gaussian.GetVariance(Vec3(5, 0, 0)));
+}
+
+BOOST_AUTO_TEST_CASE(testGPISCompactSupport)
+{
+    std::vector<DataR3R2> samples = CreateSphereSamples(1000, 0.1f, 0.01f);
+
+    auto start = std::chrono::steady_clock::now();
+    GaussianImplicitSurface3D sparse(std::unique_ptr<WendlandKernel>(new WendlandKernel(0.3f)));
+    sparse.Calculate(samples);
+    double sparseFitMs = ElapsedMs(start);
+
+    for (const DataR3R2& s : samples)
+    {
+        BOOST_CHECK_LE(fabs(s.Value1() - sparse.Get(s.Position())), 0.1);
+    }
+
+    std::vector<Vec3> positions;
+    for (int i = 0; i < 20; i++)
+    {
+        Vec3 dir = Helpers::CreateVectorFromCylinderCoords(1, Helpers::Lerp(0, 2 * M_PI, 0, 20, i), 0.3f).normalized();
+        BOOST_CHECK_LT(sparse.Get(dir * 0.95f), 0);
+        BOOST_CHECK_GT(sparse.Get(dir * 1.05f), 0);
+        BOOST_CHECK_SMALL(sparse.Get(dir), 0.1f);
+        BOOST_CHECK_GE(sparse.GetVariance(dir), -1e-4f);
+        BOOST_CHECK_LT(sparse.GetVariance(dir), sparse.GetVariance(dir * 0.5f));
+    }
+
+    for (int x = 0; x < 20; x++)
+    {
+        for (int y = 0; y < 20; y++)
+        {
+            for (int z = 0; z < 20; z++)
+            {
+                positions.push_back(Vec3(x, y, z) * 0.12f - Vec3(1.2f, 1.2f, 1.2f));
+            }
+        }
+    }
+
+    start = std::chrono::steady_clock::now();
+    std::vector<float> sparseValues = sparse.GetBatch(positions);
+    double sparseGetMs = ElapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    GaussianImplicitSurface3D dense(std::unique_ptr<GaussianKernel>(new GaussianKernel(0.3f)));
+    dense.Calculate(samples);
+    double denseFitMs = ElapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    std::vector<float> denseValues = dense.GetBatch(positions);
+    double denseGetMs = ElapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        BOOST_CHECK_SMALL(denseValues[i] - dense.Get(positions[i]), 1e-3f);
+    }
+    double denseSingleMs = ElapsedMs(start);
+
+    BOOST_TEST_MESSAGE(samples.size() << " samples: Wendland kernel fitted in " << sparseFitMs << " ms, " << positions.size() << " predictions in "
+                       << sparseGetMs << " ms; Gaussian kernel fitted in " << denseFitMs << " ms, predictions in " << denseGetMs
+                       << " ms in blocks and " << denseSingleMs << " ms one by one");
+}
 
 BOOST_AUTO_TEST_SUITE_END()
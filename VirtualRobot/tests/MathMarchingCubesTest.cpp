@@ -0,0 +1,191 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+
+#define BOOST_TEST_MODULE VirtualRobot_MathMarchingCubesTest
+
+#include <VirtualRobot/VirtualRobotTest.h>
+#include <VirtualRobot/math/GaussianImplicitSurface3D.h>
+#include <VirtualRobot/math/MarchingCubes.h>
+#include <VirtualRobot/math/Primitive.h>
+#include <VirtualRobot/math/SimpleAbstractFunctionR3R1.h>
+#include <VirtualRobot/Visualization/TriMeshModel.h>
+
+#include <chrono>
+#include <set>
+#include <utility>
+
+BOOST_AUTO_TEST_SUITE(MathMarchingCubes)
+
+using namespace math;
+
+typedef Eigen::Vector3f Vec3;
+
+namespace
+{
+    // the signed distance to a sphere
+    class SphereFunction : public SimpleAbstractFunctionR3R1
+    {
+    public:
+        SphereFunction(Vec3 center, float radius) : center(center), radius(radius) {}
+        float Get(Eigen::Vector3f pos) override
+        {
+            return (pos - center).norm() - radius;
+        }
+
+    private:
+        Vec3 center;
+        float radius;
+    };
+
+    // a GPIS of the residual to a spherical prior, far from the samples it equals the prior instead of the isolevel
+    class GPISWithPrior : public SimpleAbstractFunctionR3R1
+    {
+    public:
+        GPISWithPrior(const std::vector<DataR3R2>& samples)
+            : gpis(std::unique_ptr<WendlandKernel>(new WendlandKernel(0.3f)))
+        {
+            std::vector<DataR3R2> residuals;
+            for (const DataR3R2& s : samples)
+            {
+                residuals.push_back(DataR3R2(s.Position(), s.Value1() - Prior(s.Position()), s.Value2()));
+            }
+            gpis.Calculate(residuals);
+        }
+        float Get(Eigen::Vector3f pos) override
+        {
+            return gpis.Get(pos) + Prior(pos);
+        }
+        std::vector<float> GetBatch(const std::vector<Eigen::Vector3f>& positions) override
+        {
+            std::vector<float> result = gpis.GetBatch(positions);
+            for (size_t i = 0; i < positions.size(); i++)
+            {
+                result[i] += Prior(positions[i]);
+            }
+            return result;
+        }
+
+    private:
+        static float Prior(const Vec3& pos)
+        {
+            return pos.norm() - 1;
+        }
+        GaussianImplicitSurface3D gpis;
+    };
+
+    // vertices - edges + faces
+    int EulerCharacteristic(const VirtualRobot::TriMeshModel& mesh)
+    {
+        std::set<std::pair<unsigned int, unsigned int>> edges;
+        for (const VirtualRobot::MathTools::TriangleFace& f : mesh.faces)
+        {
+            unsigned int ids[3] = {f.id1, f.id2, f.id3};
+            for (int i = 0; i < 3; i++)
+            {
+                edges.insert(std::make_pair(std::min(ids[i], ids[(i + 1) % 3]), std::max(ids[i], ids[(i + 1) % 3])));
+            }
+        }
+        return int(mesh.vertices.size()) - int(edges.size()) + int(mesh.faces.size());
+    }
+
+    double ElapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSphere)
+{
+    const Vec3 center(0.1f, -0.2f, 0.05f);
+    SimpleAbstractFunctionR3R1Ptr sphere(new SphereFunction(center, 1.f));
+
+    PrimitivePtr triangles = MarchingCubes::Calculate(Vec3::Zero(), Vec3(1.1f, 0, 0), 20, 0.07f, sphere, 0);
+    VirtualRobot::TriMeshModelPtr mesh = MarchingCubes::CalculateMesh(Vec3::Zero(), 20, 0.07f, sphere, 0, 0, 1);
+
+    BOOST_CHECK_EQUAL(mesh->faces.size(), triangles->size());
+    BOOST_CHECK_EQUAL(EulerCharacteristic(*mesh), 2);
+
+    for (const Vec3& v : mesh->vertices)
+    {
+        BOOST_CHECK_SMALL((v - center).norm() - 1.f, 0.01f);
+    }
+    for (const VirtualRobot::MathTools::TriangleFace& f : mesh->faces)
+    {
+        Vec3 centroid = (mesh->vertices[f.id1] + mesh->vertices[f.id2] + mesh->vertices[f.id3]) / 3;
+        BOOST_CHECK_GT(f.normal.dot(centroid - center), 0.9f);
+    }
+
+    // the narrow band and the number of threads do not change the mesh
+    for (unsigned int numThreads : {1u, 4u})
+    {
+        VirtualRobot::TriMeshModelPtr other = MarchingCubes::CalculateMesh(Vec3::Zero(), 20, 0.07f, sphere, 0, 0.8f, numThreads);
+        BOOST_REQUIRE_EQUAL(other->vertices.size(), mesh->vertices.size());
+        BOOST_REQUIRE_EQUAL(other->faces.size(), mesh->faces.size());
+        for (size_t i = 0; i < mesh->vertices.size(); i++)
+        {
+            BOOST_CHECK_EQUAL(other->vertices[i], mesh->vertices[i]);
+        }
+        for (size_t i = 0; i < mesh->faces.size(); i++)
+        {
+            BOOST_CHECK_EQUAL(other->faces[i].id1, mesh->faces[i].id1);
+            BOOST_CHECK_EQUAL(other->faces[i].id2, mesh->faces[i].id2);
+            BOOST_CHECK_EQUAL(other->faces[i].id3, mesh->faces[i].id3);
+        }
+    }
+
+    // a surface outside of the grid is not meshed
+    SimpleAbstractFunctionR3R1Ptr far(new SphereFunction(Vec3(10, 0, 0), 1.f));
+    BOOST_CHECK(MarchingCubes::CalculateMesh(Vec3::Zero(), 10, 0.1f, far, 0, 0.5f)->faces.empty());
+}
+
+BOOST_AUTO_TEST_CASE(testGPISBenchmark)
+{
+    // samples on, inside and outside of a unit sphere
+    std::vector<DataR3R2> samples;
+    const int count = 1000;
+    for (int i = 0; i < count; i++)
+    {
+        float z = 1 - 2 * (i + 0.5f) / count;
+        float phi = i * float(M_PI) * (3 - std::sqrt(5.f));
+        Vec3 n(std::sqrt(1 - z * z) * std::cos(phi), std::sqrt(1 - z * z) * std::sin(phi), z);
+        samples.push_back(DataR3R2(n, 0, 0.01f));
+        samples.push_back(DataR3R2(n * 0.9f, -1, 0.01f));
+        samples.push_back(DataR3R2(n * 1.1f, 1, 0.01f));
+    }
+
+    SimpleAbstractFunctionR3R1Ptr gpis(new GPISWithPrior(samples));
+
+    const int steps = 48;
+    const float stepLength = 0.03f;
+
+    auto start = std::chrono::steady_clock::now();
+    PrimitivePtr triangles = MarchingCubes::Calculate(Vec3::Zero(), Vec3(1, 0, 0), steps, stepLength, gpis, 0);
+    double singleSurfaceMs = ElapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    VirtualRobot::TriMeshModelPtr serial = MarchingCubes::CalculateMesh(Vec3::Zero(), steps, stepLength, gpis, 0, 0, 1);
+    double serialMs = ElapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    VirtualRobot::TriMeshModelPtr parallel = MarchingCubes::CalculateMesh(Vec3::Zero(), steps, stepLength, gpis, 0, 0, 0);
+    double parallelMs = ElapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    VirtualRobot::TriMeshModelPtr narrow = MarchingCubes::CalculateMesh(Vec3::Zero(), steps, stepLength, gpis, 0, 0.3f, 0);
+    double narrowMs = ElapsedMs(start);
+
+    BOOST_CHECK_GT(serial->faces.size(), 0u);
+    BOOST_CHECK_EQUAL(parallel->faces.size(), serial->faces.size());
+    BOOST_CHECK_EQUAL(narrow->faces.size(), serial->faces.size());
+    BOOST_CHECK_EQUAL(serial->faces.size(), triangles->size());
+    BOOST_CHECK_EQUAL(EulerCharacteristic(*serial), 2);
+
+    BOOST_TEST_MESSAGE("GPIS of " << samples.size() << " samples on a grid of " << 2 * steps << "^3 cells: Calculate " << singleSurfaceMs
+                       << " ms (" << triangles->size() << " triangles), CalculateMesh " << serialMs << " ms on one thread, " << parallelMs
+                       << " ms in parallel, " << narrowMs << " ms in parallel with narrow band (" << narrow->faces.size() << " faces, "
+                       << narrow->vertices.size() << " vertices)");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
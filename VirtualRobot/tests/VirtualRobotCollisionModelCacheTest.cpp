@@ -0,0 +1,170 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+
+#define BOOST_TEST_MODULE VirtualRobot_VirtualRobotCollisionModelCacheTest
+
+#include <VirtualRobot/VirtualRobotTest.h>
+#include <VirtualRobot/CollisionDetection/CollisionChecker.h>
+#include <VirtualRobot/CollisionDetection/CollisionModel.h>
+#include <VirtualRobot/CollisionDetection/CollisionModelCache.h>
+#include <VirtualRobot/Visualization/TriMeshModel.h>
+#include <VirtualRobot/Visualization/VisualizationFactory.h>
+#include <VirtualRobot/Import/MeshImport/STLReader.h>
+#include <VirtualRobot/XML/RobotIO.h>
+#include <VirtualRobot/Robot.h>
+#include <VirtualRobot/RuntimeEnvironment.h>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+
+using namespace VirtualRobot;
+
+BOOST_AUTO_TEST_SUITE(CollisionModelCacheTest)
+
+namespace
+{
+    TriMeshModelPtr loadPiggy()
+    {
+        std::string filename = "objects/stl/Piggy6.stl";
+        BOOST_REQUIRE(RuntimeEnvironment::getDataFileAbsolute(filename));
+
+        STLReaderPtr r(new STLReader());
+        TriMeshModelPtr mesh(new TriMeshModel());
+        BOOST_REQUIRE(r->read(filename, mesh));
+        return mesh;
+    }
+
+    double elapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSaveLoad)
+{
+    TriMeshModelPtr mesh = loadPiggy();
+    CollisionCheckerPtr checker = CollisionChecker::getGlobalCollisionChecker();
+
+    auto start = std::chrono::steady_clock::now();
+    InternalCollisionModelPtr built(new InternalCollisionModel(mesh, checker, 1));
+    double buildMs = elapsedMs(start);
+
+    boost::filesystem::path file = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%.sxcm");
+    BOOST_REQUIRE(CollisionModelCache::save(file.string(), *mesh, built));
+
+    TriMeshModelPtr loadedMesh;
+    InternalCollisionModelPtr loaded;
+    start = std::chrono::steady_clock::now();
+    BOOST_REQUIRE(CollisionModelCache::load(file.string(), loadedMesh, loaded, checker, 2));
+    double loadMs = elapsedMs(start);
+    boost::filesystem::remove(file);
+
+    BOOST_TEST_MESSAGE("Piggy6.stl: " << mesh->faces.size() << " triangles, building the collision model: " << buildMs
+                       << " ms, loading from the cache: " << loadMs << " ms");
+
+    BOOST_REQUIRE(loadedMesh && loaded);
+    BOOST_CHECK_EQUAL(loadedMesh->vertices.size(), mesh->vertices.size());
+    BOOST_CHECK_EQUAL(loadedMesh->faces.size(), mesh->faces.size());
+    BOOST_CHECK_EQUAL(loadedMesh->faces.back().id3, mesh->faces.back().id3);
+    BOOST_CHECK(loadedMesh->boundingBox.getMin().isApprox(mesh->boundingBox.getMin()));
+    BOOST_CHECK(loadedMesh->boundingBox.getMax().isApprox(mesh->boundingBox.getMax()));
+
+    // the loaded hierarchy gives the same results as the built one
+    CollisionModelPtr a(new CollisionModel(VisualizationNodePtr(), mesh, built, "built", checker, 1));
+    CollisionModelPtr b(new CollisionModel(VisualizationNodePtr(), loadedMesh, loaded, "loaded", checker, 2));
+    CollisionModelPtr other(new CollisionModel(VisualizationNodePtr(), mesh, InternalCollisionModelPtr(new InternalCollisionModel(mesh, checker, 3)), "other", checker, 3));
+
+    a->setGlobalPose(Eigen::Matrix4f::Identity());
+    b->setGlobalPose(Eigen::Matrix4f::Identity());
+    Eigen::Vector3f size = mesh->boundingBox.getMax() - mesh->boundingBox.getMin();
+
+    for (int i = 0; i < 20; i++)
+    {
+        Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+        pose.block<3, 3>(0, 0) = Eigen::AngleAxisf(0.3f * i, Eigen::Vector3f(1, 2, 3).normalized()).toRotationMatrix();
+        pose.block<3, 1>(0, 3) = size * (0.06f * i);
+        other->setGlobalPose(pose);
+
+        BOOST_CHECK_EQUAL(checker->checkCollision(a, other), checker->checkCollision(b, other));
+        BOOST_CHECK_CLOSE(checker->calculateDistance(a, other) + 1.0f, checker->calculateDistance(b, other) + 1.0f, 1e-3f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testInvalidFile)
+{
+    boost::filesystem::path file = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%.sxcm");
+    TriMeshModelPtr mesh;
+    InternalCollisionModelPtr model;
+    BOOST_CHECK(!CollisionModelCache::load(file.string(), mesh, model));
+
+    std::ofstream(file.string().c_str()) << "SXCM";
+    BOOST_CHECK(!CollisionModelCache::load(file.string(), mesh, model));
+    BOOST_CHECK(!mesh && !model);
+    boost::filesystem::remove(file);
+}
+
+BOOST_AUTO_TEST_CASE(testKey)
+{
+    boost::filesystem::path file = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%.wrl");
+    std::ofstream(file.string().c_str()) << "#VRML V2.0 utf8\n";
+    std::vector<std::string> files(1, file.string());
+
+    std::string key = CollisionModelCache::getKey(files, "inventor;0;");
+    BOOST_CHECK_EQUAL(key.size(), 16);
+    BOOST_CHECK_EQUAL(key, CollisionModelCache::getKey(files, "inventor;0;"));
+    BOOST_CHECK_NE(key, CollisionModelCache::getKey(files, "inventor;1;"));
+
+    std::ofstream(file.string().c_str(), std::ios::app) << "Shape {}\n";
+    BOOST_CHECK_NE(key, CollisionModelCache::getKey(files, "inventor;0;"));
+
+    boost::filesystem::remove(file);
+    BOOST_CHECK(CollisionModelCache::getKey(files, "inventor;0;").empty());
+}
+
+BOOST_AUTO_TEST_CASE(testRobotLoadTime)
+{
+    std::string filename = "robots/ArmarIII/ArmarIII.xml";
+    BOOST_REQUIRE(RuntimeEnvironment::getDataFileAbsolute(filename));
+
+    boost::filesystem::path directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    CollisionModelCache::setCacheDirectory(directory.string());
+    CollisionModelCache::resetStatistics();
+
+    auto start = std::chrono::steady_clock::now();
+    RobotPtr cold = RobotIO::loadRobot(filename);
+    double coldMs = elapsedMs(start);
+    BOOST_REQUIRE(cold);
+
+    start = std::chrono::steady_clock::now();
+    RobotPtr warm = RobotIO::loadRobot(filename);
+    double warmMs = elapsedMs(start);
+    BOOST_REQUIRE(warm);
+
+    BOOST_TEST_MESSAGE("ArmarIII.xml: cold load " << coldMs << " ms, warm load " << warmMs << " ms, "
+                       << CollisionModelCache::getNumHits() << " cache hits, " << CollisionModelCache::getNumMisses() << " misses");
+
+    if (VisualizationFactory::first(NULL))
+    {
+        BOOST_CHECK_GT(CollisionModelCache::getNumHits(), 0);
+
+        for (RobotNodePtr node : cold->getRobotNodes())
+        {
+            if (node->getCollisionModel())
+            {
+                RobotNodePtr warmNode = warm->getRobotNode(node->getName());
+                BOOST_REQUIRE(warmNode->getCollisionModel());
+                BOOST_CHECK_EQUAL(warmNode->getCollisionModel()->getTriMeshModel()->faces.size(), node->getCollisionModel()->getTriMeshModel()->faces.size());
+            }
+        }
+    }
+
+    CollisionModelCache::setCacheDirectory("");
+    boost::filesystem::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
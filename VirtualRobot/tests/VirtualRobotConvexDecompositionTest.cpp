@@ -0,0 +1,239 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+
+#define BOOST_TEST_MODULE VirtualRobot_VirtualRobotConvexDecompositionTest
+
+#include <VirtualRobot/VirtualRobotTest.h>
+#include <VirtualRobot/Tools/ConvexDecomposition.h>
+#include <VirtualRobot/Visualization/TriMeshModel.h>
+#include <VirtualRobot/Visualization/TriMeshUtils.h>
+#include <VirtualRobot/Import/MeshImport/STLReader.h>
+#include <VirtualRobot/RuntimeEnvironment.h>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <string>
+
+using namespace VirtualRobot;
+
+BOOST_AUTO_TEST_SUITE(ConvexDecomposition)
+
+namespace
+{
+    Eigen::Matrix4f translation(float x, float y, float z)
+    {
+        Eigen::Matrix4f m = Eigen::Matrix4f::Identity();
+        m.block<3, 1>(0, 3) = Eigen::Vector3f(x, y, z);
+        return m;
+    }
+
+    // an open box (200 x 200 x 100 mm, walls of 20 mm)
+    TriMeshModelPtr createBowl()
+    {
+        return TriMeshUtils::CreateOpenBox(Eigen::Matrix4f::Identity(), 200, 200, 100, 20);
+    }
+
+    // a cylinder along the z axis
+    TriMeshModelPtr createCylinder(float radius, float height, int sides)
+    {
+        Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+        pose.block<3, 3>(0, 0) = Eigen::AngleAxisf(float(M_PI / 2), Eigen::Vector3f::UnitX()).toRotationMatrix();
+        return TriMeshUtils::CreateCylinder(pose, radius, height, sides);
+    }
+
+    float totalVolume(const VirtualRobot::ConvexDecomposition::PartList& parts)
+    {
+        float volume = 0;
+
+        for (const auto& p : parts)
+        {
+            volume += p.volume;
+        }
+
+        return volume;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testConvexHull)
+{
+    std::vector<Eigen::Vector3f> points;
+
+    for (int i = 0; i < 8; i++)
+    {
+        points.push_back(Eigen::Vector3f(i & 1 ? 100.0f : 0.0f, i & 2 ? 100.0f : 0.0f, i & 4 ? 100.0f : 0.0f));
+    }
+
+    // inner points and points on the faces are no vertices
+    points.push_back(Eigen::Vector3f(50, 50, 50));
+    points.push_back(Eigen::Vector3f(50, 50, 100));
+    points.push_back(Eigen::Vector3f(20, 70, 30));
+
+    MathTools::ConvexHull3DPtr hull = VirtualRobot::ConvexDecomposition::createConvexHull(points);
+    BOOST_REQUIRE(hull);
+    BOOST_CHECK_EQUAL(hull->vertices.size(), 8);
+    BOOST_CHECK_EQUAL(hull->faces.size(), 12);
+    BOOST_CHECK_CLOSE(hull->volume, 1e6f, 1e-3f);
+
+    for (const auto& f : hull->faces)
+    {
+        // outward normals
+        BOOST_CHECK_GT(f.normal.dot(hull->vertices[f.id1] - Eigen::Vector3f(50, 50, 50)), 0.0f);
+    }
+
+    // coplanar points
+    std::vector<Eigen::Vector3f> flat(points.begin(), points.begin() + 4);
+    hull = VirtualRobot::ConvexDecomposition::createConvexHull(flat);
+    BOOST_CHECK(hull->faces.empty());
+    BOOST_CHECK_EQUAL(hull->volume, 0.0f);
+}
+
+BOOST_AUTO_TEST_CASE(testReduceHullVertices)
+{
+    TriMeshModelPtr cylinder = createCylinder(50, 100, 64);
+    MathTools::ConvexHull3DPtr hull = VirtualRobot::ConvexDecomposition::createConvexHull(cylinder->vertices);
+    // the centers of the caps may remain as vertices of the initial tetrahedron
+    BOOST_REQUIRE_GE(hull->vertices.size(), 128);
+    BOOST_REQUIRE_LE(hull->vertices.size(), 130);
+
+    std::vector<Eigen::Vector3f> reduced = VirtualRobot::ConvexDecomposition::reduceHullVertices(hull->vertices, 24);
+    BOOST_CHECK_EQUAL(reduced.size(), 24);
+    MathTools::ConvexHull3DPtr reducedHull = VirtualRobot::ConvexDecomposition::createConvexHull(reduced);
+    BOOST_CHECK_LE(reducedHull->volume, hull->volume);
+    BOOST_CHECK_GT(reducedHull->volume, 0.75f * hull->volume);
+}
+
+BOOST_AUTO_TEST_CASE(testPrimitives)
+{
+    VirtualRobot::ConvexDecomposition::Parameters parameters;
+
+    TriMeshModelPtr box = TriMeshUtils::CreateBox(translation(10, 20, 30), 100, 60, 40);
+    VirtualRobot::ConvexDecomposition::PartList parts = VirtualRobot::ConvexDecomposition::compute(*box, parameters);
+    BOOST_REQUIRE_EQUAL(parts.size(), 1);
+    BOOST_CHECK_EQUAL(parts[0].type, VirtualRobot::ConvexDecomposition::eBox);
+    BOOST_CHECK_CLOSE(parts[0].size.prod(), 100.0f * 60.0f * 40.0f, 1e-2f);
+    BOOST_CHECK_CLOSE(parts[0].size.maxCoeff(), 100.0f, 1e-2f);
+    BOOST_CHECK_LT((parts[0].transform.block<3, 1>(0, 3) - Eigen::Vector3f(10, 20, 30)).norm(), 1e-3f);
+
+    TriMeshModelPtr cylinder = createCylinder(30, 150, 32);
+    parts = VirtualRobot::ConvexDecomposition::compute(*cylinder, parameters);
+    BOOST_REQUIRE_EQUAL(parts.size(), 1);
+    BOOST_CHECK_EQUAL(parts[0].type, VirtualRobot::ConvexDecomposition::eCylinder);
+    BOOST_CHECK_CLOSE(parts[0].size.x(), 30.0f, 1.0f);
+    BOOST_CHECK_CLOSE(parts[0].size.z(), 150.0f, 1.0f);
+    // the cylinder axis is the z axis of the part
+    BOOST_CHECK_GT(std::abs(parts[0].transform(2, 2)), 0.999f);
+
+    parameters.fitPrimitives = false;
+    parts = VirtualRobot::ConvexDecomposition::compute(*cylinder, parameters);
+    BOOST_REQUIRE_EQUAL(parts.size(), 1);
+    BOOST_CHECK_EQUAL(parts[0].type, VirtualRobot::ConvexDecomposition::eConvexHull);
+    BOOST_CHECK_LE(parts[0].vertices.size(), size_t(parameters.maxHullVertices));
+}
+
+BOOST_AUTO_TEST_CASE(testConcaveDecomposition)
+{
+    TriMeshModelPtr bowl = createBowl();
+    VirtualRobot::ConvexDecomposition::Parameters parameters;
+    parameters.fitPrimitives = false;
+
+    VirtualRobot::ConvexDecomposition::PartList parts = VirtualRobot::ConvexDecomposition::compute(*bowl, parameters);
+    MathTools::ConvexHull3DPtr hull = VirtualRobot::ConvexDecomposition::createConvexHull(bowl->vertices);
+
+    // bottom and four walls: 200*200*20 + 2*20*200*80 + 2*160*20*80
+    const float volume = 800000.0f + 640000.0f + 512000.0f;
+    BOOST_CHECK_GT(parts.size(), 1);
+    BOOST_CHECK_LE(parts.size(), size_t(parameters.maxParts));
+    BOOST_CHECK_CLOSE(hull->volume, 4e6f, 1e-3f);
+    // the single hull fills the cavity, the parts cover little more than the walls
+    BOOST_CHECK_LT(totalVolume(parts), 1.25f * volume);
+    BOOST_CHECK_GT(totalVolume(parts), 0.9f * volume);
+
+    for (const auto& p : parts)
+    {
+        BOOST_CHECK_LE(p.vertices.size(), size_t(parameters.maxHullVertices));
+    }
+
+    // the walls are boxes
+    parameters.fitPrimitives = true;
+    parts = VirtualRobot::ConvexDecomposition::compute(*bowl, parameters);
+    int boxes = 0;
+
+    for (const auto& p : parts)
+    {
+        boxes += p.type == VirtualRobot::ConvexDecomposition::eBox ? 1 : 0;
+    }
+
+    BOOST_CHECK_GT(boxes, 0);
+}
+
+BOOST_AUTO_TEST_CASE(testCache)
+{
+    TriMeshModelPtr bowl = createBowl();
+    VirtualRobot::ConvexDecomposition::Parameters parameters;
+
+    std::string hash = VirtualRobot::ConvexDecomposition::getHash(*bowl, parameters);
+    BOOST_CHECK_EQUAL(hash.size(), 16);
+    BOOST_CHECK_EQUAL(hash, VirtualRobot::ConvexDecomposition::getHash(*createBowl(), parameters));
+    parameters.maxParts = 8;
+    BOOST_CHECK_NE(hash, VirtualRobot::ConvexDecomposition::getHash(*bowl, parameters));
+    bowl->vertices[0].x() += 1.0f;
+    BOOST_CHECK_NE(VirtualRobot::ConvexDecomposition::getHash(*bowl, parameters), VirtualRobot::ConvexDecomposition::getHash(*createBowl(), parameters));
+
+    boost::filesystem::path directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("simox-decomposition-%%%%-%%%%");
+    VirtualRobot::ConvexDecomposition::PartList parts = VirtualRobot::ConvexDecomposition::computeCached(*bowl, directory.string(), parameters);
+    boost::filesystem::path file = directory / (VirtualRobot::ConvexDecomposition::getHash(*bowl, parameters) + ".cvxd");
+    BOOST_REQUIRE(boost::filesystem::exists(file));
+
+    VirtualRobot::ConvexDecomposition::PartList cached = VirtualRobot::ConvexDecomposition::computeCached(*bowl, directory.string(), parameters);
+    BOOST_REQUIRE_EQUAL(cached.size(), parts.size());
+
+    for (size_t i = 0; i < parts.size(); i++)
+    {
+        BOOST_CHECK_EQUAL(cached[i].type, parts[i].type);
+        BOOST_CHECK(cached[i].transform.isApprox(parts[i].transform));
+        BOOST_CHECK_EQUAL(cached[i].volume, parts[i].volume);
+        BOOST_CHECK_EQUAL(cached[i].vertices.size(), parts[i].vertices.size());
+    }
+
+    // corrupt files are recomputed
+    VirtualRobot::ConvexDecomposition::PartList loaded;
+    boost::filesystem::resize_file(file, 10);
+    BOOST_CHECK(!VirtualRobot::ConvexDecomposition::load(file.string(), loaded));
+    cached = VirtualRobot::ConvexDecomposition::computeCached(*bowl, directory.string(), parameters);
+    BOOST_CHECK_EQUAL(cached.size(), parts.size());
+
+    boost::filesystem::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_CASE(testHouseholdMesh)
+{
+    std::string filename = "objects/stl/Piggy6.stl";
+    BOOST_REQUIRE(RuntimeEnvironment::getDataFileAbsolute(filename));
+
+    STLReaderPtr r(new STLReader());
+    TriMeshModelPtr mesh(new TriMeshModel());
+    BOOST_REQUIRE(r->read(filename, mesh));
+
+    auto start = std::chrono::steady_clock::now();
+    VirtualRobot::ConvexDecomposition::PartList parts = VirtualRobot::ConvexDecomposition::compute(*mesh);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    MathTools::ConvexHull3DPtr hull = VirtualRobot::ConvexDecomposition::createConvexHull(mesh->vertices);
+    BOOST_TEST_MESSAGE("Piggy6.stl: " << mesh->faces.size() << " triangles, " << hull->vertices.size() << " hull vertices, decomposed into "
+                       << parts.size() << " parts in " << ms << " ms");
+
+    BOOST_REQUIRE_GE(parts.size(), 1);
+    BOOST_CHECK_LE(parts.size(), 16);
+    BOOST_CHECK_GT(totalVolume(parts), 0.5f * hull->volume);
+
+    for (const auto& p : parts)
+    {
+        BOOST_CHECK_LE(p.vertices.size(), 32);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
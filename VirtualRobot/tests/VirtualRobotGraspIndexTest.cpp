@@ -0,0 +1,207 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+
+#define BOOST_TEST_MODULE VirtualRobot_VirtualRobotGraspIndexTest
+
+#include <VirtualRobot/VirtualRobotTest.h>
+#include <VirtualRobot/Grasping/Grasp.h>
+#include <VirtualRobot/Grasping/GraspIndex.h>
+#include <VirtualRobot/Grasping/GraspSet.h>
+#include <VirtualRobot/MathTools.h>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <string>
+
+using namespace VirtualRobot;
+
+BOOST_AUTO_TEST_SUITE(GraspIndexTest)
+
+namespace
+{
+    Eigen::Matrix4f randomPose(std::mt19937& gen)
+    {
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> angle(-float(M_PI), float(M_PI));
+        Eigen::Matrix4f pose;
+        MathTools::posrpy2eigen4f(position(gen), position(gen), position(gen), angle(gen), angle(gen), angle(gen), pose);
+        return pose;
+    }
+
+    GraspSetPtr createGraspSet(int size, std::mt19937& gen)
+    {
+        GraspSetPtr grasps(new GraspSet("Grasps", "Armar", "Hand"));
+
+        for (int i = 0; i < size; i++)
+        {
+            // the grasp stores the object pose in tcp coordinates
+            Eigen::Matrix4f tcpPose = randomPose(gen);
+            grasps->addGrasp(GraspPtr(new Grasp("Grasp " + std::to_string(i), "Armar", "Hand", tcpPose.inverse())));
+        }
+
+        return grasps;
+    }
+
+    // all grasps sorted by their distance to the tcp pose
+    std::vector<GraspIndex::Neighbor> bruteForce(const GraspIndex& index, GraspSetPtr grasps, const Eigen::Matrix4f& tcpPose)
+    {
+        std::vector<GraspIndex::Neighbor> result;
+
+        for (unsigned int i = 0; i < grasps->getSize(); i++)
+        {
+            result.push_back({i, index.getDistance(tcpPose, grasps->getGrasp(i)->getTcpPoseGlobal(Eigen::Matrix4f::Identity()))});
+        }
+
+        std::sort(result.begin(), result.end(), [](const GraspIndex::Neighbor & a, const GraspIndex::Neighbor & b)
+        {
+            return a.distance < b.distance;
+        });
+        return result;
+    }
+
+    double elapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testDistance)
+{
+    GraspIndex index(GraspSetPtr(new GraspSet("Grasps", "Armar", "Hand")), 100.0f);
+    BOOST_CHECK_EQUAL(index.getSize(), 0u);
+    BOOST_CHECK(index.getNearestGrasps(Eigen::Matrix4f::Identity(), 5).empty());
+    BOOST_CHECK(index.getGraspsInRadius(Eigen::Matrix4f::Identity(), 5.0f).empty());
+
+    Eigen::Matrix4f a = Eigen::Matrix4f::Identity();
+    Eigen::Matrix4f b = a;
+    b(0, 3) = 3.0f;
+    b(1, 3) = 4.0f;
+    BOOST_CHECK_CLOSE(index.getDistance(a, b), 5.0f, 1e-3f);
+
+    // small rotations count with the rotation weight, q and -q are the same rotation
+    b = Eigen::Matrix4f::Identity();
+    b.block<3, 3>(0, 0) = Eigen::AngleAxisf(0.01f, Eigen::Vector3f::UnitZ()).toRotationMatrix();
+    BOOST_CHECK_CLOSE(index.getDistance(a, b), 1.0f, 0.1f);
+    a.block<3, 3>(0, 0) = Eigen::AngleAxisf(float(M_PI) - 0.005f, Eigen::Vector3f::UnitX()).toRotationMatrix();
+    b.block<3, 3>(0, 0) = Eigen::AngleAxisf(-float(M_PI) + 0.005f, Eigen::Vector3f::UnitX()).toRotationMatrix();
+    BOOST_CHECK_CLOSE(index.getDistance(a, b), 1.0f, 0.1f);
+}
+
+BOOST_AUTO_TEST_CASE(testQueries)
+{
+    std::mt19937 gen(42);
+    GraspSetPtr grasps = createGraspSet(5000, gen);
+    GraspIndex index(grasps, 50.0f);
+    BOOST_REQUIRE_EQUAL(index.getSize(), 5000u);
+
+    for (int q = 0; q < 50; q++)
+    {
+        Eigen::Matrix4f query = randomPose(gen);
+        std::vector<GraspIndex::Neighbor> expected = bruteForce(index, grasps, query);
+
+        std::vector<GraspIndex::Neighbor> nearest = index.getNearestGrasps(query, 10);
+        BOOST_REQUIRE_EQUAL(nearest.size(), 10u);
+
+        for (size_t i = 0; i < nearest.size(); i++)
+        {
+            BOOST_CHECK_CLOSE(nearest[i].distance, expected[i].distance, 1e-2f);
+            BOOST_CHECK_CLOSE(nearest[i].distance, index.getDistance(query, grasps->getGrasp(nearest[i].index)->getTcpPoseGlobal(Eigen::Matrix4f::Identity())), 1e-2f);
+        }
+
+        float radius = 0.5f * (expected[19].distance + expected[20].distance);
+        std::vector<GraspIndex::Neighbor> inRadius = index.getGraspsInRadius(query, radius);
+        BOOST_CHECK_EQUAL(inRadius.size(), 20u);
+
+        for (size_t i = 0; i < inRadius.size(); i++)
+        {
+            BOOST_CHECK_EQUAL(inRadius[i].index, expected[i].index);
+        }
+
+        // global queries equal queries in object coordinates
+        Eigen::Matrix4f objectPose = randomPose(gen);
+        std::vector<GraspIndex::Neighbor> global = index.getNearestGrasps(Eigen::Matrix4f(objectPose * query), objectPose, 10);
+        BOOST_REQUIRE_EQUAL(global.size(), 10u);
+        BOOST_CHECK_EQUAL(global[0].index, nearest[0].index);
+        BOOST_CHECK_EQUAL(index.getGraspsInRadius(Eigen::Matrix4f(objectPose * query), objectPose, radius).size(), 20u);
+    }
+
+    // the index is rebuilt after changing the grasp set
+    Eigen::Matrix4f query = randomPose(gen);
+    grasps->addGrasp(GraspPtr(new Grasp("Target", "Armar", "Hand", query.inverse())));
+    index.rebuild();
+    std::vector<GraspIndex::Neighbor> nearest = index.getNearestGrasps(query, 1);
+    BOOST_REQUIRE_EQUAL(nearest.size(), 1u);
+    BOOST_CHECK_EQUAL(grasps->getGrasp(nearest[0].index)->getName(), "Target");
+    BOOST_CHECK_SMALL(nearest[0].distance, 1e-2f);
+}
+
+BOOST_AUTO_TEST_CASE(testQueryBenchmark)
+{
+    std::mt19937 gen(7);
+    const int numGrasps = 100000;
+    GraspSetPtr grasps = createGraspSet(numGrasps, gen);
+
+    auto start = std::chrono::steady_clock::now();
+    GraspIndex index(grasps, 100.0f);
+    double buildMs = elapsedMs(start);
+
+    const int numQueries = 1000;
+    std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f> > queries;
+
+    for (int i = 0; i < numQueries; i++)
+    {
+        queries.push_back(randomPose(gen));
+    }
+
+    start = std::chrono::steady_clock::now();
+    size_t found = 0;
+
+    for (const Eigen::Matrix4f& query : queries)
+    {
+        found += index.getNearestGrasps(query, 10).size();
+    }
+
+    double knnMs = elapsedMs(start);
+    BOOST_CHECK_EQUAL(found, size_t(10 * numQueries));
+
+    start = std::chrono::steady_clock::now();
+    found = 0;
+
+    for (const Eigen::Matrix4f& query : queries)
+    {
+        found += index.getGraspsInRadius(query, 80.0f).size();
+    }
+
+    double radiusMs = elapsedMs(start);
+
+    // the linear scan, which computes all tcp poses at once
+    std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f> > poses;
+    start = std::chrono::steady_clock::now();
+    float minDistance = 0.0f;
+
+    for (int i = 0; i < numQueries / 100; i++)
+    {
+        grasps->getTcpPosesGlobal(Eigen::Matrix4f::Identity(), poses);
+        float best = std::numeric_limits<float>::max();
+
+        for (const Eigen::Matrix4f& pose : poses)
+        {
+            best = std::min(best, index.getDistance(queries[i], pose));
+        }
+
+        minDistance += best;
+    }
+
+    double linearMs = elapsedMs(start) * 100.0;
+    BOOST_CHECK_GT(minDistance, 0.0f);
+
+    BOOST_TEST_MESSAGE(numGrasps << " grasps: index built in " << buildMs << " ms, 10 nearest grasps in " << knnMs * 1000.0 / numQueries
+                       << " us, radius queries in " << radiusMs * 1000.0 / numQueries << " us (" << found / numQueries
+                       << " grasps found), linear scan " << linearMs * 1000.0 / numQueries << " us per query");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
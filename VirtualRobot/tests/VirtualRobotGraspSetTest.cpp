@@ -0,0 +1,242 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+
+#define BOOST_TEST_MODULE VirtualRobot_VirtualRobotGraspSetTest
+
+#include <VirtualRobot/VirtualRobotTest.h>
+#include <VirtualRobot/Grasping/Grasp.h>
+#include <VirtualRobot/Grasping/GraspSet.h>
+#include <VirtualRobot/ManipulationObject.h>
+#include <VirtualRobot/MathTools.h>
+#include <VirtualRobot/XML/ObjectIO.h>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+
+using namespace VirtualRobot;
+
+BOOST_AUTO_TEST_SUITE(GraspSetTest)
+
+namespace
+{
+    const std::string robotType = "Armar";
+    const std::string eefName = "Hand";
+
+    GraspSetPtr createGraspSet(int size)
+    {
+        GraspSetPtr grasps(new GraspSet("Grasps", robotType, eefName));
+
+        for (int i = 0; i < size; i++)
+        {
+            Eigen::Matrix4f pose;
+            MathTools::posrpy2eigen4f(float(i % 100), float(i % 7) * 10.0f, float(i % 13), 0.01f * float(i % 300), 0.1f, -0.02f * float(i % 50), pose);
+            GraspPtr g(new Grasp("Grasp " + std::to_string(i), robotType, eefName, pose, i % 2 ? "GraspPlanner" : "Manual",
+                                 0.001f * float(i % 1000), i % 3 ? "Open" : ""));
+
+            if (i % 5 == 0)
+            {
+                std::map<std::string, float> config;
+                config["Thumb"] = 0.01f * float(i % 100);
+                config["Index"] = 0.5f;
+                g->setConfiguration(config);
+            }
+
+            grasps->addGrasp(g);
+        }
+
+        return grasps;
+    }
+
+    void checkEqual(const GraspPtr& a, const GraspPtr& b)
+    {
+        BOOST_REQUIRE(a && b);
+        BOOST_CHECK_EQUAL(a->getName(), b->getName());
+        BOOST_CHECK_EQUAL(a->getRobotType(), b->getRobotType());
+        BOOST_CHECK_EQUAL(a->getEefName(), b->getEefName());
+        BOOST_CHECK_EQUAL(a->getCreationMethod(), b->getCreationMethod());
+        BOOST_CHECK_EQUAL(a->getPreshapeName(), b->getPreshapeName());
+        BOOST_CHECK_EQUAL(a->getQuality(), b->getQuality());
+        BOOST_CHECK(a->getTransformation() == b->getTransformation());
+        BOOST_CHECK(a->getConfiguration() == b->getConfiguration());
+    }
+
+    std::string tempFile(const std::string& pattern)
+    {
+        return (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path(pattern)).string();
+    }
+
+    double elapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testNameIndex)
+{
+    GraspSetPtr grasps = createGraspSet(1000);
+
+    BOOST_CHECK(grasps->hasGrasp("Grasp 500"));
+    BOOST_CHECK(!grasps->hasGrasp("Grasp 1000"));
+    GraspPtr g = grasps->getGrasp("Grasp 500");
+    BOOST_REQUIRE(g);
+    BOOST_CHECK(g == grasps->getGrasp(500));
+    BOOST_CHECK(grasps->hasGrasp(g));
+
+    // the index follows renamed grasps
+    g->setName("Renamed");
+    BOOST_CHECK(!grasps->hasGrasp("Grasp 500"));
+    BOOST_CHECK(grasps->getGrasp("Renamed") == g);
+
+    // removing keeps the order of the remaining grasps
+    BOOST_CHECK(grasps->removeGrasp(g));
+    BOOST_CHECK(!grasps->hasGrasp(g));
+    BOOST_CHECK(!grasps->removeGrasp(g));
+    BOOST_CHECK_EQUAL(grasps->getSize(), 999u);
+    BOOST_CHECK_EQUAL(grasps->getGrasp(500)->getName(), "Grasp 501");
+    BOOST_CHECK(grasps->getGrasp("Grasp 501") == grasps->getGrasp(500));
+    BOOST_CHECK(grasps->removeGrasp(0u));
+    BOOST_CHECK_EQUAL(grasps->getGrasp("Grasp 999")->getName(), "Grasp 999");
+    BOOST_CHECK(grasps->getGrasp(997) == grasps->getGrasp("Grasp 999"));
+}
+
+BOOST_AUTO_TEST_CASE(testBinarySaveLoad)
+{
+    GraspSetPtr grasps = createGraspSet(1000);
+    std::string file = tempFile("%%%%-%%%%.sxgs");
+    BOOST_REQUIRE(grasps->saveBinary(file));
+
+    GraspSetPtr loaded = GraspSet::loadBinary(file);
+    BOOST_REQUIRE(loaded);
+    BOOST_CHECK_EQUAL(loaded->getName(), grasps->getName());
+    BOOST_CHECK_EQUAL(loaded->getRobotType(), robotType);
+    BOOST_CHECK_EQUAL(loaded->getEndEffector(), eefName);
+    BOOST_REQUIRE_EQUAL(loaded->getSize(), grasps->getSize());
+
+    // the poses are read without creating the grasps
+    Eigen::Matrix4f objectPose;
+    MathTools::posrpy2eigen4f(100.0f, -200.0f, 300.0f, 0.3f, -0.2f, 1.0f, objectPose);
+    std::vector< Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f> > poses;
+    loaded->getTcpPosesGlobal(objectPose, poses);
+    BOOST_REQUIRE_EQUAL(poses.size(), grasps->getSize());
+
+    for (unsigned int i = 0; i < grasps->getSize(); i += 37)
+    {
+        BOOST_CHECK(poses[i].isApprox(grasps->getGrasp(i)->getTcpPoseGlobal(objectPose)));
+    }
+
+    BOOST_CHECK(loaded->hasGrasp("Grasp 123"));
+    checkEqual(loaded->getGrasp("Grasp 123"), grasps->getGrasp(123));
+
+    // a clone shares the file, modified grasps are stored again
+    GraspSetPtr cloned = loaded->clone();
+    cloned->getGrasp(5)->setQuality(0.75f);
+    cloned->removeGrasp(0u);
+    cloned->addGrasp(grasps->getGrasp(0)->clone());
+    std::string file2 = tempFile("%%%%-%%%%.sxgs");
+    BOOST_REQUIRE(cloned->saveBinary(file2));
+    GraspSetPtr loaded2 = GraspSet::loadBinary(file2);
+    BOOST_REQUIRE(loaded2);
+    BOOST_REQUIRE_EQUAL(loaded2->getSize(), grasps->getSize());
+    BOOST_CHECK_EQUAL(loaded2->getGrasp(4)->getQuality(), 0.75f);
+    BOOST_CHECK_EQUAL(loaded->getGrasp(5)->getQuality(), grasps->getGrasp(5)->getQuality());
+
+    for (unsigned int i = 1; i < grasps->getSize(); i++)
+    {
+        checkEqual(loaded->getGrasp(i), grasps->getGrasp(i));
+
+        if (i != 5)
+        {
+            checkEqual(loaded2->getGrasp(i - 1), grasps->getGrasp(i));
+        }
+    }
+
+    checkEqual(loaded2->getGrasp(grasps->getSize() - 1), grasps->getGrasp(0));
+
+    // truncated and invalid files are rejected
+    std::ifstream input(file.c_str(), std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    std::ofstream(file.c_str(), std::ios::binary | std::ios::trunc).write(content.data(), std::streamsize(content.size() / 2));
+    BOOST_CHECK(!GraspSet::loadBinary(file));
+    std::ofstream(file.c_str(), std::ios::binary | std::ios::trunc) << "no grasps";
+    BOOST_CHECK(!GraspSet::loadBinary(file));
+    BOOST_CHECK(!GraspSet::loadBinary(file + ".missing"));
+
+    boost::filesystem::remove(file);
+    boost::filesystem::remove(file2);
+}
+
+BOOST_AUTO_TEST_CASE(testObjectIOGraspSetFile)
+{
+    GraspSetPtr grasps = createGraspSet(100);
+    std::string file = tempFile("%%%%-%%%%.sxgs");
+    BOOST_REQUIRE(grasps->saveBinary(file));
+
+    std::string objectString =
+        "<ManipulationObject name='Object'>"
+        "  <GraspSet name='Stored' RobotType='" + robotType + "' EndEffector='" + eefName + "'>"
+        "    <File>" + boost::filesystem::path(file).filename().string() + "</File>"
+        "  </GraspSet>"
+        "</ManipulationObject>";
+
+    ManipulationObjectPtr object = ObjectIO::createManipulationObjectFromString(objectString, boost::filesystem::path(file).parent_path().string(), false);
+    BOOST_REQUIRE(object);
+    GraspSetPtr loaded = object->getGraspSet("Stored");
+    BOOST_REQUIRE(loaded);
+    BOOST_REQUIRE_EQUAL(loaded->getSize(), 100u);
+    checkEqual(loaded->getGrasp(42), grasps->getGrasp(42));
+
+    boost::filesystem::remove(file);
+}
+
+BOOST_AUTO_TEST_CASE(testLoadBenchmark)
+{
+    const int numGrasps = 50000;
+    GraspSetPtr grasps = createGraspSet(numGrasps);
+
+    std::string objectString = "<ManipulationObject name='Object'>\n" + grasps->getXMLString() + "</ManipulationObject>\n";
+    auto start = std::chrono::steady_clock::now();
+    ManipulationObjectPtr object = ObjectIO::createManipulationObjectFromString(objectString, "", false);
+    double xmlMs = elapsedMs(start);
+    BOOST_REQUIRE(object && object->getGraspSet("Grasps"));
+    BOOST_CHECK_EQUAL(object->getGraspSet("Grasps")->getSize(), (unsigned int)numGrasps);
+
+    std::string file = tempFile("%%%%-%%%%.sxgs");
+    start = std::chrono::steady_clock::now();
+    BOOST_REQUIRE(grasps->saveBinary(file));
+    double saveMs = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    GraspSetPtr loaded = GraspSet::loadBinary(file);
+    double loadMs = elapsedMs(start);
+    BOOST_REQUIRE(loaded);
+
+    Eigen::Matrix4f objectPose = Eigen::Matrix4f::Identity();
+    std::vector< Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f> > poses;
+    start = std::chrono::steady_clock::now();
+    loaded->getTcpPosesGlobal(objectPose, poses);
+    double transformMs = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    int found = 0;
+
+    for (int i = 0; i < numGrasps; i += 10)
+    {
+        found += loaded->hasGrasp("Grasp " + std::to_string(i)) ? 1 : 0;
+    }
+
+    double lookupMs = elapsedMs(start);
+    BOOST_CHECK_EQUAL(found, numGrasps / 10);
+
+    BOOST_TEST_MESSAGE(numGrasps << " grasps: XML " << objectString.size() / 1024 << " KB parsed in " << xmlMs << " ms, binary "
+                       << boost::filesystem::file_size(file) / 1024 << " KB saved in " << saveMs << " ms and loaded in " << loadMs
+                       << " ms, tcp poses in " << transformMs << " ms, " << numGrasps / 10 << " name lookups in " << lookupMs << " ms");
+
+    boost::filesystem::remove(file);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
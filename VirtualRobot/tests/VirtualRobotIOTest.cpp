@@ -15,6 +15,13 @@
 #include <VirtualRobot/Nodes/PositionSensor.h>
 #include <VirtualRobot/RuntimeEnvironment.h>
 #include <VirtualRobot/ManipulationObject.h>
+#include <VirtualRobot/Obstacle.h>
+#include <VirtualRobot/CollisionDetection/CollisionChecker.h>
+#include <VirtualRobot/CollisionDetection/CollisionModel.h>
+#include <VirtualRobot/Visualization/TriMeshModel.h>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <fstream>
 #include <string>
 
 
@@ -92,5 +99,148 @@ BOOST_AUTO_TEST_CASE(testLoadStoreManipulationObjectPhysics)
 }
 
 
+namespace
+{
+    // resident set size of this process in kB, 0 if not available
+    long getResidentSetSize()
+    {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+
+        while (std::getline(status, line))
+        {
+            if (line.compare(0, 6, "VmRSS:") == 0)
+            {
+                return std::stol(line.substr(6));
+            }
+        }
+
+        return 0;
+    }
+
+    double elapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testLoadObstacleNoVisualization)
+{
+    std::string filename("objects/VitalisWithPrimitives.xml");
+    BOOST_REQUIRE(RuntimeEnvironment::getDataFileAbsolute(filename));
+
+    ManipulationObjectPtr object = ObjectIO::loadManipulationObject(filename, false);
+    BOOST_REQUIRE(object);
+    BOOST_CHECK(!object->getVisualization());
+    BOOST_REQUIRE(object->getCollisionModel());
+    BOOST_CHECK(!object->getCollisionModel()->getVisualization());
+    BOOST_REQUIRE(object->getCollisionModel()->getTriMeshModel());
+    BOOST_CHECK_EQUAL(object->getCollisionModel()->getTriMeshModel()->faces.size(), 12);
+
+    // the box primitive is 136 x 190 x 40 mm
+    BoundingBox bbox = object->getCollisionModel()->getTriMeshModel()->boundingBox;
+    BOOST_CHECK(bbox.getMax().isApprox(Eigen::Vector3f(68.0f, 95.0f, 20.0f)));
+    BOOST_CHECK(bbox.getMin().isApprox(Eigen::Vector3f(-68.0f, -95.0f, -20.0f)));
+
+    std::string stlFile("objects/stl/Piggy6.stl");
+    BOOST_REQUIRE(RuntimeEnvironment::getDataFileAbsolute(stlFile));
+    std::string obstacleString =
+        "<Obstacle name='Piggy'>"
+        "  <Visualization>"
+        "    <File type='inventor'>" + stlFile + "</File>"
+        "    <UseAsCollisionModel/>"
+        "  </Visualization>"
+        "</Obstacle>";
+
+    ObstaclePtr obstacle = ObjectIO::createObstacleFromString(obstacleString, "", false);
+    BOOST_REQUIRE(obstacle);
+    BOOST_CHECK(!obstacle->getVisualization());
+    BOOST_REQUIRE(obstacle->getCollisionModel());
+    BOOST_CHECK_GT(obstacle->getCollisionModel()->getTriMeshModel()->faces.size(), 20);
+
+    // the collision model can be used without visualization
+    CollisionCheckerPtr checker = CollisionChecker::getGlobalCollisionChecker();
+    ObstaclePtr other = ObjectIO::createObstacleFromString(obstacleString, "", false);
+    BOOST_CHECK(checker->checkCollision(obstacle->getCollisionModel(), other->getCollisionModel()));
+    Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+    pose(0, 3) = 10000.0f;
+    other->setGlobalPose(pose);
+    BOOST_CHECK(!checker->checkCollision(obstacle->getCollisionModel(), other->getCollisionModel()));
+
+    ObstaclePtr clone = obstacle->clone("clone");
+    BOOST_REQUIRE(clone && clone->getCollisionModel());
+    BOOST_CHECK(!clone->getCollisionModel()->getVisualization());
+}
+
+BOOST_AUTO_TEST_CASE(testRobotLoadNoVisualization)
+{
+    std::string stlFile("objects/stl/Piggy6.stl");
+    BOOST_REQUIRE(RuntimeEnvironment::getDataFileAbsolute(stlFile));
+    std::string robotString =
+        "<Robot Type='NoVisu' RootNode='Joint1'>"
+        "  <RobotNode name='Joint1'>"
+        "    <Joint type='revolute'>"
+        "      <Limits unit='degree' lo='-90' hi='90'/>"
+        "      <Axis x='0' y='0' z='1'/>"
+        "    </Joint>"
+        "    <Visualization enable='true' useascollisionmodel='true'>"
+        "      <File type='inventor'>" + stlFile + "</File>"
+        "    </Visualization>"
+        "    <Child name='Joint2'/>"
+        "  </RobotNode>"
+        "  <RobotNode name='Joint2'>"
+        "    <Transform>"
+        "      <Translation x='500' y='0' z='0'/>"
+        "    </Transform>"
+        "    <CollisionModel>"
+        "      <Primitives>"
+        "        <Box width='100' height='100' depth='100'/>"
+        "        <Sphere radius='50'>"
+        "          <Transform><Translation x='200' y='0' z='0'/></Transform>"
+        "        </Sphere>"
+        "      </Primitives>"
+        "    </CollisionModel>"
+        "  </RobotNode>"
+        "</Robot>";
+
+    RobotPtr robot = RobotIO::createRobotFromString(robotString, "", RobotIO::eCollisionModelNoVisualization);
+    BOOST_REQUIRE(robot);
+
+    RobotNodePtr joint1 = robot->getRobotNode("Joint1");
+    RobotNodePtr joint2 = robot->getRobotNode("Joint2");
+    BOOST_REQUIRE(joint1->getCollisionModel() && joint2->getCollisionModel());
+    BOOST_CHECK(!joint1->getVisualization());
+    BOOST_CHECK(!joint1->getCollisionModel()->getVisualization());
+    BOOST_CHECK(!joint2->getCollisionModel()->getVisualization());
+    BOOST_CHECK_GT(joint1->getCollisionModel()->getTriMeshModel()->faces.size(), 20);
+
+    BoundingBox bbox = joint2->getCollisionModel()->getTriMeshModel()->boundingBox;
+    BOOST_CHECK(bbox.getMin().isApprox(Eigen::Vector3f(-50.0f, -50.0f, -50.0f)));
+    BOOST_CHECK(bbox.getMax().isApprox(Eigen::Vector3f(250.0f, 50.0f, 50.0f), 1e-3f));
+
+    // the global bounding box follows the robot node
+    BoundingBox globalBox = joint2->getCollisionModel()->getBoundingBox(true);
+    BOOST_CHECK_CLOSE(globalBox.getMin().x(), 450.0f, 1e-3f);
+
+    RobotPtr clone = robot->clone("clone");
+    BOOST_REQUIRE(clone);
+    BOOST_REQUIRE(clone->getRobotNode("Joint2")->getCollisionModel());
+    BOOST_CHECK_EQUAL(clone->getRobotNode("Joint2")->getCollisionModel()->getTriMeshModel()->faces.size(),
+                      joint2->getCollisionModel()->getTriMeshModel()->faces.size());
+
+    // compare with the regular loading modes
+    std::string filename = "robots/ArmarIII/ArmarIII.xml";
+    BOOST_REQUIRE(RuntimeEnvironment::getDataFileAbsolute(filename));
+
+    for (RobotIO::RobotDescription mode : {RobotIO::eCollisionModelNoVisualization, RobotIO::eCollisionModel, RobotIO::eFull})
+    {
+        long rss = getResidentSetSize();
+        auto start = std::chrono::steady_clock::now();
+        RobotPtr r = RobotIO::loadRobot(filename, mode);
+        double ms = elapsedMs(start);
+        BOOST_REQUIRE(r);
+        BOOST_TEST_MESSAGE("ArmarIII.xml, load mode " << mode << ": " << ms << " ms, resident set size +" << (getResidentSetSize() - rss) << " kB");
+    }
+}
 
 BOOST_AUTO_TEST_SUITE_END()
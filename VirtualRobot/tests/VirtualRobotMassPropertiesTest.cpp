@@ -0,0 +1,239 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+
+#define BOOST_TEST_MODULE VirtualRobot_VirtualRobotMassPropertiesTest
+
+#include <VirtualRobot/VirtualRobotTest.h>
+#include <VirtualRobot/VirtualRobot.h>
+#include <VirtualRobot/XML/RobotIO.h>
+#include <VirtualRobot/Robot.h>
+#include <VirtualRobot/RobotNodeSet.h>
+#include <VirtualRobot/Nodes/RobotNode.h>
+#include <VirtualRobot/Nodes/RobotNodeRevolute.h>
+#include <VirtualRobot/Tools/MassProperties.h>
+#include <VirtualRobot/Tools/Gravity.h>
+#include <VirtualRobot/IK/CoMIK.h>
+
+#include <Eigen/Core>
+
+#include <chrono>
+#include <cmath>
+#include <string>
+
+using namespace VirtualRobot;
+
+BOOST_AUTO_TEST_SUITE(MassProperties)
+
+namespace
+{
+    std::string physics(float mass, float x, float y, float z)
+    {
+        return "  <Physics>"
+               "   <Mass value='" + std::to_string(mass) + "' units='kg'/>"
+               "   <CoM location='joint' x='" + std::to_string(x) + "' y='" + std::to_string(y) + "' z='" + std::to_string(z) + "' units='mm'/>"
+               "  </Physics>";
+    }
+
+    // a branching chain with revolute and prismatic joints and a fixed, massive base
+    RobotPtr createRobot()
+    {
+        const std::string robotString =
+            "<Robot Type='MassRobot' RootNode='Base'>"
+            " <RobotNode name='Base'>"
+            + physics(5.0f, 0.0f, 0.0f, 20.0f) +
+            "  <Child name='Joint1'/>"
+            " </RobotNode>"
+
+            " <RobotNode name='Joint1'>"
+            + physics(2.0f, 30.0f, 0.0f, 10.0f) +
+            "  <Transform><Translation x='0' y='0' z='100'/></Transform>"
+            "  <Joint type='revolute'>"
+            "   <Limits unit='degree' lo='-180' hi='180'/>"
+            "   <Axis x='0' y='0' z='1'/>"
+            "  </Joint>"
+            "  <Child name='Joint2'/>"
+            "  <Child name='Joint4'/>"
+            " </RobotNode>"
+
+            " <RobotNode name='Joint2'>"
+            + physics(1.5f, 0.0f, 50.0f, 0.0f) +
+            "  <Transform><Translation x='100' y='0' z='0'/></Transform>"
+            "  <Joint type='revolute'>"
+            "   <Limits unit='degree' lo='-180' hi='180'/>"
+            "   <Axis x='1' y='0' z='0'/>"
+            "  </Joint>"
+            "  <Child name='Joint3'/>"
+            " </RobotNode>"
+
+            " <RobotNode name='Joint3'>"
+            + physics(1.0f, 0.0f, 20.0f, -10.0f) +
+            "  <Transform><Translation x='0' y='150' z='0'/></Transform>"
+            "  <Joint type='prismatic'>"
+            "   <Limits unit='mm' lo='-100' hi='100'/>"
+            "   <TranslationDirection x='0' y='1' z='0'/>"
+            "  </Joint>"
+            " </RobotNode>"
+
+            " <RobotNode name='Joint4'>"
+            + physics(3.0f, 0.0f, 0.0f, 80.0f) +
+            "  <Transform><Translation x='0' y='-150' z='50'/></Transform>"
+            "  <Joint type='revolute'>"
+            "   <Limits unit='degree' lo='-180' hi='180'/>"
+            "   <Axis x='0' y='1' z='0'/>"
+            "  </Joint>"
+            "  <Child name='Leaf'/>"
+            " </RobotNode>"
+
+            " <RobotNode name='Leaf'>"
+            + physics(0.5f, 10.0f, 0.0f, 0.0f) +
+            "  <Transform><Translation x='0' y='0' z='200'/></Transform>"
+            " </RobotNode>"
+            "</Robot>";
+        return RobotIO::createRobotFromString(robotString);
+    }
+
+    RobotNodeSetPtr createSet(RobotPtr robot, const std::string& name, const std::vector<std::string>& names)
+    {
+        return RobotNodeSet::createRobotNodeSet(robot, name, names, "", "", true);
+    }
+
+    // reference gravity torque, summing up the contribution of each body
+    float referenceTorque(RobotNodeRevolutePtr joint, const std::vector<RobotNodePtr>& bodies)
+    {
+        Eigen::Vector3f axis = joint->getJointRotationAxis();
+        Eigen::Vector3f pos = joint->getGlobalPose().block<3, 1>(0, 3);
+        float torque = 0.0f;
+
+        for (const auto& body : bodies)
+        {
+            if (body == joint || joint->hasChild(body, true))
+            {
+                Eigen::Vector3f r = (body->getCoMGlobal() - pos) * 0.001f;
+                Eigen::Vector3f F(0.0f, 0.0f, -9.81f * body->getMass());
+                torque -= r.cross(F).dot(axis);
+            }
+        }
+
+        return torque;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testMassPropertiesCoMAndJacobian)
+{
+    RobotPtr robot;
+    BOOST_REQUIRE_NO_THROW(robot = createRobot());
+    BOOST_REQUIRE(robot);
+
+    RobotNodeSetPtr joints = createSet(robot, "Joints", {"Joint1", "Joint2", "Joint3", "Joint4"});
+    RobotNodeSetPtr bodies = createSet(robot, "Bodies", {"Base", "Joint1", "Joint2", "Joint3", "Joint4", "Leaf"});
+
+    std::vector<float> config = {0.3f, -0.7f, 40.0f, 1.1f};
+    robot->setJointValues(joints, config);
+
+    VirtualRobot::MassProperties props(joints, bodies);
+    BOOST_CHECK_CLOSE(props.getMass(), 13.0f, 1e-3f);
+    BOOST_CHECK_CLOSE(props.getSubtreeMass(0), 8.0f, 1e-3f);
+    BOOST_CHECK_CLOSE(props.getSubtreeMass(1), 2.5f, 1e-3f);
+    BOOST_CHECK_CLOSE(props.getSubtreeMass(3), 3.5f, 1e-3f);
+    BOOST_CHECK_LT((props.getCoM() - bodies->getCoM()).norm(), 1e-3f);
+
+    Eigen::MatrixXf J;
+    props.getCoMJacobian(J);
+    BOOST_REQUIRE_EQUAL(J.rows(), 3);
+    BOOST_REQUIRE_EQUAL(J.cols(), 4);
+
+    // compare against central differences of the CoM
+    for (size_t i = 0; i < config.size(); i++)
+    {
+        const float h = (i == 2) ? 0.1f : 1e-3f;
+        std::vector<float> q = config;
+        q[i] = config[i] + h;
+        robot->setJointValues(joints, q);
+        Eigen::Vector3f plus = bodies->getCoM();
+        q[i] = config[i] - h;
+        robot->setJointValues(joints, q);
+        Eigen::Vector3f minus = bodies->getCoM();
+        Eigen::Vector3f diff = (plus - minus) / (2.0f * h);
+        BOOST_CHECK_LT((diff - J.col(i)).norm(), 0.05f);
+    }
+
+    robot->setJointValues(joints, config);
+    props.update();
+
+    // CoMIK expresses the joint axes in its coordinate system
+    RobotNodePtr coordSystem = robot->getRobotNode("Joint1");
+    CoMIK ik(joints, bodies, coordSystem, 3);
+    Eigen::MatrixXf Jcs;
+    props.getCoMJacobian(Jcs, coordSystem);
+    BOOST_CHECK_LT((ik.getJacobianMatrix() - Jcs).norm(), 1e-4f);
+}
+
+BOOST_AUTO_TEST_CASE(testMassPropertiesGravityTorques)
+{
+    RobotPtr robot;
+    BOOST_REQUIRE_NO_THROW(robot = createRobot());
+    BOOST_REQUIRE(robot);
+
+    RobotNodeSetPtr joints = createSet(robot, "RevoluteJoints", {"Joint1", "Joint2", "Joint4"});
+    RobotNodeSetPtr bodies = createSet(robot, "Bodies", {"Base", "Joint1", "Joint2", "Joint3", "Joint4", "Leaf"});
+    std::vector<RobotNodePtr> bodyNodes = bodies->getAllRobotNodes();
+
+    Gravity gravity(robot, joints, bodies);
+    VirtualRobot::MassProperties props(joints, bodies);
+
+    std::vector<std::vector<float>> configs = {{0.0f, 0.0f, 0.0f}, {0.3f, -0.7f, 1.1f}, {-2.0f, 1.5f, -0.4f}};
+
+    for (const auto& config : configs)
+    {
+        robot->setJointValues(joints, config);
+        props.update();
+        std::vector<float> torques;
+        gravity.computeGravityTorque(torques);
+        BOOST_REQUIRE_EQUAL(torques.size(), 3);
+
+        for (size_t i = 0; i < torques.size(); i++)
+        {
+            RobotNodeRevolutePtr joint = boost::dynamic_pointer_cast<RobotNodeRevolute>(joints->getNode(int(i)));
+            float expected = referenceTorque(joint, bodyNodes);
+            BOOST_CHECK_SMALL(props.getGravityTorques()[i] - expected, 1e-3f);
+            BOOST_CHECK_SMALL(torques[i] - expected, 1e-3f);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testMassPropertiesBalanceLoopBenchmark)
+{
+    RobotPtr robot;
+    BOOST_REQUIRE_NO_THROW(robot = createRobot());
+    BOOST_REQUIRE(robot);
+
+    RobotNodeSetPtr joints = createSet(robot, "Joints", {"Joint1", "Joint2", "Joint3", "Joint4"});
+    RobotNodeSetPtr bodies = createSet(robot, "Bodies", {"Base", "Joint1", "Joint2", "Joint3", "Joint4", "Leaf"});
+    VirtualRobot::MassProperties props(joints, bodies);
+
+    // one balance loop iteration: CoM, CoM Jacobian and gravity torques
+    const int loops = 2000;
+    std::vector<float> q(4);
+    Eigen::MatrixXf J;
+    float checksum = 0.0f;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < loops; i++)
+    {
+        q = {0.001f * i, -0.002f * i, float(i % 100), 0.0005f * i};
+        robot->setJointValues(joints, q);
+        props.update();
+        props.getCoMJacobian(J);
+        checksum += props.getCoM().x() + J(0, 0) + props.getGravityTorques()[0];
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(end - start).count() / loops;
+    BOOST_TEST_MESSAGE("balance loop iteration (incl. forward kinematics): " << us << " us, checksum " << checksum);
+    BOOST_CHECK(std::isfinite(checksum));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
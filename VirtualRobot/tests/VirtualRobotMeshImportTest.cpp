@@ -8,9 +8,17 @@
 
 #include <VirtualRobot/VirtualRobotTest.h>
 #include <VirtualRobot/Import/MeshImport/STLReader.h>
+#include <VirtualRobot/Import/MeshImport/MeshReader.h>
 #include <VirtualRobot/Visualization/TriMeshModel.h>
 #include <VirtualRobot/RuntimeEnvironment.h>
 
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <string>
 #include <sstream>
 
@@ -136,6 +144,176 @@ BOOST_AUTO_TEST_CASE(testLoadSTL)
     BOOST_REQUIRE(t);
     BOOST_CHECK_GT(int(t->vertices.size()), 20);
     BOOST_CHECK_GT(int(t->faces.size()), 20);
+
+    // identical vertices are merged, every facet has a normal
+    BOOST_CHECK_EQUAL(t->vertices.size(), 5579);
+    BOOST_CHECK_EQUAL(t->faces.size(), 11180);
+    BOOST_CHECK_EQUAL(t->normals.size(), 11180);
+}
+
+namespace
+{
+    // binary STL of a height field with 2 * (n - 1)^2 triangles
+    std::string createHeightFieldSTL(int n)
+    {
+        uint32_t numTriangles = uint32_t(2 * (n - 1) * (n - 1));
+        std::string data(84 + size_t(numTriangles) * 50, 0);
+        std::memcpy(&data[80], &numTriangles, 4);
+        char* facet = &data[84];
+
+        auto vertex = [](int x, int y)
+        {
+            return Eigen::Vector3f(float(x), float(y), float(std::sin(0.1 * x) * std::cos(0.1 * y)));
+        };
+
+        for (int y = 0; y + 1 < n; y++)
+        {
+            for (int x = 0; x + 1 < n; x++)
+            {
+                Eigen::Vector3f quad[2][3] = {{vertex(x, y), vertex(x + 1, y), vertex(x + 1, y + 1)},
+                                              {vertex(x, y), vertex(x + 1, y + 1), vertex(x, y + 1)}};
+
+                for (auto& triangle : quad)
+                {
+                    Eigen::Vector3f normal = (triangle[1] - triangle[0]).cross(triangle[2] - triangle[0]).normalized();
+                    std::memcpy(facet, normal.data(), 12);
+
+                    for (int i = 0; i < 3; i++)
+                    {
+                        std::memcpy(facet + 12 + 12 * i, triangle[i].data(), 12);
+                    }
+
+                    facet += 50;
+                }
+            }
+        }
+
+        return data;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSTLVertexMerging)
+{
+    std::string data = createHeightFieldSTL(50);
+    STLReader r;
+    TriMeshModelPtr t(new TriMeshModel());
+    BOOST_REQUIRE(r.read(data.data(), data.size(), STLReader::STLB, t));
+    BOOST_CHECK_EQUAL(t->vertices.size(), 50 * 50);
+    BOOST_CHECK_EQUAL(t->faces.size(), 2 * 49 * 49);
+    BOOST_CHECK_EQUAL(t->normals.size(), t->faces.size());
+    BOOST_CHECK(t->boundingBox.getMax().head<2>().isApprox(Eigen::Vector2f(49.0f, 49.0f)));
+
+    for (const MathTools::TriangleFace& f : t->faces)
+    {
+        BOOST_REQUIRE(f.id1 < t->vertices.size() && f.id2 < t->vertices.size() && f.id3 < t->vertices.size());
+    }
+
+    // the same mesh as ASCII STL
+    std::stringstream ascii;
+    ascii << "solid outer\n";
+
+    for (const MathTools::TriangleFace& f : t->faces)
+    {
+        ascii << "facet normal " << t->normals[f.idNormal1].transpose() << "\n outer loop\n";
+
+        for (unsigned int id : {f.id1, f.id2, f.id3})
+        {
+            ascii << "  vertex " << t->vertices[id].x() << " " << t->vertices[id].y() << " " << t->vertices[id].z() << "\n";
+        }
+
+        ascii << " endloop\nendfacet\n";
+    }
+
+    ascii << "endsolid outer\n";
+    TriMeshModelPtr t2(new TriMeshModel());
+    BOOST_REQUIRE(r.read(ascii, STLReader::STLA, t2));
+    BOOST_CHECK_EQUAL(t2->vertices.size(), t->vertices.size());
+    BOOST_CHECK_EQUAL(t2->faces.size(), t->faces.size());
+    BOOST_CHECK_EQUAL(t2->faces.back().id3, t->faces.back().id3);
+
+    // with epsilon, close vertices are merged
+    data = createHeightFieldSTL(3);
+    float shifted = 1.0f + 1e-4f;
+    std::memcpy(&data[84 + 50 * 7 + 12 + 24], &shifted, 4);
+    TriMeshModelPtr exact(new TriMeshModel());
+    BOOST_REQUIRE(r.read(data.data(), data.size(), STLReader::STLB, exact));
+    BOOST_CHECK_EQUAL(exact->vertices.size(), 10);
+
+    r.set_epsilon(1e-3f);
+    TriMeshModelPtr merged(new TriMeshModel());
+    BOOST_REQUIRE(r.read(data.data(), data.size(), STLReader::STLB, merged));
+    BOOST_CHECK_EQUAL(merged->vertices.size(), 9);
+    BOOST_CHECK_EQUAL(merged->faces.size(), 8);
+
+    // truncated data
+    TriMeshModelPtr truncated(new TriMeshModel());
+    BOOST_CHECK(r.read(data.data(), 84 + 50 * 3 + 10, STLReader::STLB, truncated));
+    BOOST_CHECK_EQUAL(truncated->faces.size(), 3);
+    BOOST_CHECK(!r.read(data.data(), 50, STLReader::STLB, truncated));
+}
+
+BOOST_AUTO_TEST_CASE(testLoadLargeSTL)
+{
+    // a binary STL file of 80000 triangles (4 MB), which is mapped and merged by the reader as larger files are.
+    // The scan sized benchmark with two million triangles (100 MB) only runs if VIRTUAL_ROBOT_BENCHMARKS is set.
+    const int n = std::getenv("VIRTUAL_ROBOT_BENCHMARKS") ? 1001 : 201;
+    boost::filesystem::path file = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%.stl");
+    {
+        std::string data = createHeightFieldSTL(n);
+        std::ofstream(file.string().c_str(), std::ios::binary).write(data.data(), std::streamsize(data.size()));
+    }
+
+    STLReader r;
+    TriMeshModelPtr t(new TriMeshModel());
+    auto start = std::chrono::steady_clock::now();
+    BOOST_REQUIRE(r.read(file.string(), t));
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    boost::filesystem::remove(file);
+
+    BOOST_TEST_MESSAGE("Binary STL with " << t->faces.size() << " triangles: " << ms << " ms, "
+                       << t->faces.size() / ms * 1000.0 << " triangles/s");
+    BOOST_CHECK_EQUAL(t->faces.size(), size_t(2 * (n - 1) * (n - 1)));
+    BOOST_CHECK_EQUAL(t->vertices.size(), size_t(n * n));
+}
+
+BOOST_AUTO_TEST_CASE(testLoadOBJAndOFF)
+{
+    // a unit square as quad and a triangle, the quad is split into two triangles
+    boost::filesystem::path objFile = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%.obj");
+    std::ofstream(objFile.string().c_str()) <<
+            "# comment\n"
+            "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 0 0 1\n"
+            "vn 0 0 1\n"
+            "f 1//1 2//1 3//1 4//1\n"
+            "f -5 -4 -1\n";
+
+    TriMeshModelPtr t = MeshReader::read(objFile.string());
+    boost::filesystem::remove(objFile);
+    BOOST_REQUIRE(t);
+    BOOST_CHECK_EQUAL(t->vertices.size(), 5);
+    BOOST_CHECK_EQUAL(t->faces.size(), 3);
+    BOOST_CHECK_EQUAL(t->faces[2].id3, 4);
+    BOOST_CHECK(t->faces[0].normal.isApprox(Eigen::Vector3f::UnitZ()));
+
+    boost::filesystem::path offFile = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%.off");
+    std::ofstream(offFile.string().c_str()) <<
+            "OFF\n5 2 0\n"
+            "0 0 0\n1 0 0\n1 1 0\n0 1 0\n0 0 1\n"
+            "4 0 1 2 3 255 0 0\n"
+            "3 0 1 4\n";
+
+    t = MeshReader::read(offFile.string());
+    BOOST_REQUIRE(t);
+    BOOST_CHECK_EQUAL(t->vertices.size(), 5);
+    BOOST_CHECK_EQUAL(t->faces.size(), 3);
+
+    // invalid indices
+    std::ofstream(offFile.string().c_str()) << "OFF\n3 1 0\n0 0 0\n1 0 0\n1 1 0\n3 0 1 3\n";
+    BOOST_CHECK(!MeshReader::read(offFile.string()));
+    boost::filesystem::remove(offFile);
+
+    BOOST_CHECK(MeshReader::isSupported("a/b/Mesh.STL"));
+    BOOST_CHECK(!MeshReader::isSupported("a/b/mesh.wrl"));
 }
 
 
@@ -0,0 +1,264 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+
+#define BOOST_TEST_MODULE VirtualRobot_VirtualRobotMeshSimplificationTest
+
+#include <VirtualRobot/VirtualRobotTest.h>
+#include <VirtualRobot/CollisionDetection/CollisionChecker.h>
+#include <VirtualRobot/CollisionDetection/CollisionModel.h>
+#include <VirtualRobot/Tools/MeshDistance.h>
+#include <VirtualRobot/Tools/MeshSimplification.h>
+#include <VirtualRobot/Visualization/TriMeshModel.h>
+#include <VirtualRobot/Visualization/TriMeshUtils.h>
+#include <VirtualRobot/VirtualRobotException.h>
+
+#include <chrono>
+#include <random>
+#include <set>
+#include <utility>
+
+using namespace VirtualRobot;
+
+BOOST_AUTO_TEST_SUITE(MeshSimplificationTest)
+
+namespace
+{
+    // vertices - edges + faces
+    int eulerCharacteristic(const TriMeshModel& mesh)
+    {
+        std::set<std::pair<unsigned int, unsigned int>> edges;
+
+        for (const MathTools::TriangleFace& f : mesh.faces)
+        {
+            unsigned int ids[3] = {f.id1, f.id2, f.id3};
+
+            for (int i = 0; i < 3; i++)
+            {
+                edges.insert(std::make_pair(std::min(ids[i], ids[(i + 1) % 3]), std::max(ids[i], ids[(i + 1) % 3])));
+            }
+        }
+
+        return int(mesh.vertices.size()) - int(edges.size()) + int(mesh.faces.size());
+    }
+
+    double elapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testPlanarFaces)
+{
+    // the sides of a box are collapsed without error
+    const Eigen::Vector3f halfSize(100, 50, 25);
+    TriMeshModelPtr box = TriMeshUtils::CreateTessellatedBox(Eigen::Matrix4f::Identity(), 2 * halfSize.x(), 2 * halfSize.y(), 2 * halfSize.z(), 10);
+    MeshSimplification::Parameters parameters;
+    parameters.maxError = 0.01f;
+    TriMeshModelPtr simplified = MeshSimplification::simplify(*box, parameters);
+
+    BOOST_CHECK_LT(simplified->faces.size(), box->faces.size() / 20);
+    BOOST_CHECK_EQUAL(eulerCharacteristic(*simplified), 2);
+
+    for (const Eigen::Vector3f& v : simplified->vertices)
+    {
+        Eigen::Vector3f q = v.cwiseAbs() - halfSize;
+        BOOST_CHECK_SMALL(q.maxCoeff(), 1e-3f);
+    }
+
+    for (const MathTools::TriangleFace& f : simplified->faces)
+    {
+        Eigen::Vector3f centroid = (simplified->vertices[f.id1] + simplified->vertices[f.id2] + simplified->vertices[f.id3]) / 3;
+        BOOST_CHECK_GT(f.normal.dot(centroid.cwiseQuotient(halfSize)), 0.5f);
+    }
+
+    BOOST_CHECK(simplified->boundingBox.getMin().isApprox(-halfSize, 1e-4f));
+    BOOST_CHECK(simplified->boundingBox.getMax().isApprox(halfSize, 1e-4f));
+
+    // the original vertices lie on the faces of the result, the conservative result is inflated by a small margin only
+    parameters.conservative = true;
+    TriMeshModelPtr conservative = MeshSimplification::simplify(*box, parameters);
+    MeshDistance distance(*conservative);
+
+    for (const Eigen::Vector3f& v : box->vertices)
+    {
+        BOOST_CHECK_LE(distance.getSignedDistance(v, 100), 0.0f);
+    }
+
+    BOOST_CHECK(conservative->boundingBox.getMax().isApprox(halfSize, 1e-3f));
+    parameters.conservative = false;
+
+    // the minimum number of faces is kept
+    parameters.maxError = 1000;
+    parameters.minFaces = 100;
+    simplified = MeshSimplification::simplify(*box, parameters);
+    BOOST_CHECK_GE(simplified->faces.size(), 100u);
+    BOOST_CHECK_LE(simplified->faces.size(), 101u);
+
+    parameters.maxError = -1;
+    BOOST_CHECK_THROW(MeshSimplification::simplify(*box, parameters), VirtualRobotException);
+}
+
+BOOST_AUTO_TEST_CASE(testErrorBound)
+{
+    const float radius = 80;
+    TriMeshModelPtr sphere = TriMeshUtils::CreateSphere(Eigen::Matrix4f::Identity(), radius, 120, 60);
+    size_t lastFaces = sphere->faces.size();
+
+    for (float maxError : {0.1f, 0.5f, 2.0f})
+    {
+        MeshSimplification::Parameters parameters;
+        parameters.maxError = maxError;
+        TriMeshModelPtr simplified = MeshSimplification::simplify(*sphere, parameters);
+
+        BOOST_CHECK_LT(simplified->faces.size(), lastFaces);
+        BOOST_CHECK_EQUAL(eulerCharacteristic(*simplified), 2);
+        lastFaces = simplified->faces.size();
+
+        // the original faces are chords, their distance to the sphere is below 0.03 mm
+        for (const Eigen::Vector3f& v : simplified->vertices)
+        {
+            BOOST_CHECK_SMALL(v.norm() - radius, maxError + 0.03f);
+        }
+
+        // the conservative mesh encloses the original vertices
+        parameters.conservative = true;
+        TriMeshModelPtr conservative = MeshSimplification::simplify(*sphere, parameters);
+        BOOST_CHECK_EQUAL(conservative->faces.size(), simplified->faces.size());
+        MeshDistance distance(*conservative);
+        float maxDistance = -radius;
+
+        for (const Eigen::Vector3f& v : sphere->vertices)
+        {
+            maxDistance = std::max(maxDistance, distance.getSignedDistance(v, radius));
+        }
+
+        float maxOffset = 0;
+
+        for (const Eigen::Vector3f& v : conservative->vertices)
+        {
+            maxOffset = std::max(maxOffset, v.norm() - radius);
+        }
+
+        BOOST_CHECK_LE(maxDistance, 0.0f);
+        BOOST_CHECK_LT(maxOffset, maxError + 0.1f);
+        BOOST_TEST_MESSAGE("maximum error " << maxError << " mm: " << simplified->faces.size() << " of " << sphere->faces.size()
+                           << " faces, original vertices at least " << -maxDistance << " mm inside of the conservative mesh, "
+                           << "its vertices at most " << maxOffset << " mm outside of the sphere");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testCollisionModelLevelsBenchmark)
+{
+    const float radius = 80;
+    CollisionModelPtr obstacle(new CollisionModel(TriMeshUtils::CreateSphere(Eigen::Matrix4f::Identity(), radius, 180, 90), "Sphere"));
+    obstacle->setGlobalPose(Eigen::Matrix4f::Identity());
+
+    const std::vector<float> errors {0.1f, 0.5f, 2.0f};
+    std::vector<double> buildMs;
+
+    for (float maxError : errors)
+    {
+        auto start = std::chrono::steady_clock::now();
+        BOOST_CHECK_EQUAL(obstacle->addLevelOfDetail(maxError), buildMs.size());
+        buildMs.push_back(elapsedMs(start));
+    }
+
+    BOOST_REQUIRE_EQUAL(obstacle->getNumLevelsOfDetail(), errors.size());
+    BOOST_CHECK_THROW(obstacle->getLevelOfDetail(errors.size()), VirtualRobotException);
+
+    // the levels follow the pose and are cloned
+    Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+    pose.block<3, 1>(0, 3) = Eigen::Vector3f(10, 20, 30);
+    obstacle->setGlobalPose(pose);
+    BOOST_CHECK(obstacle->getLevelOfDetail(1)->getGlobalPose().isApprox(pose));
+    CollisionModelPtr clone = obstacle->clone();
+    BOOST_REQUIRE_EQUAL(clone->getNumLevelsOfDetail(), errors.size());
+    BOOST_CHECK_EQUAL(clone->getLevelOfDetailError(2), 2.0f);
+    BOOST_CHECK_EQUAL(clone->getLevelOfDetail(2)->getNumFaces(), obstacle->getLevelOfDetail(2)->getNumFaces());
+    BOOST_CHECK(clone->getLevelOfDetail(2) != obstacle->getLevelOfDetail(2));
+    obstacle->setGlobalPose(Eigen::Matrix4f::Identity());
+
+    // a box as probe with its center outside of the sphere, larger than the inflation of the levels,
+    // since the triangles are checked for intersections but not the enclosed volumes
+    CollisionModelPtr probe(new CollisionModel(TriMeshUtils::CreateBox(Eigen::Matrix4f::Identity(), 20, 20, 20), "Probe"));
+    std::mt19937 gen(5);
+    std::normal_distribution<float> direction;
+    std::uniform_real_distribution<float> distance(radius, radius + 25);
+    std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f>> poses;
+
+    for (int i = 0; i < 2000; i++)
+    {
+        pose = Eigen::Matrix4f::Identity();
+        pose.block<3, 1>(0, 3) = Eigen::Vector3f(direction(gen), direction(gen), direction(gen)).normalized() * distance(gen);
+        poses.push_back(pose);
+    }
+
+    CollisionCheckerPtr checker = CollisionChecker::getGlobalCollisionChecker();
+    std::vector<bool> collisions;
+    std::vector<float> distances;
+
+    for (size_t level = 0; level <= errors.size(); level++)
+    {
+        CollisionModelPtr model = (level == 0) ? obstacle : obstacle->getLevelOfDetail(level - 1);
+        int numCollisions = 0;
+        int missed = 0;
+        float maxDeviation = 0;
+        float maxCloser = 0;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < poses.size(); i++)
+        {
+            probe->setGlobalPose(poses[i]);
+            bool collision = checker->checkCollision(probe, model);
+            numCollisions += collision ? 1 : 0;
+
+            if (level == 0)
+            {
+                collisions.push_back(collision);
+            }
+            else if (collisions[i] && !collision)
+            {
+                missed++;
+            }
+        }
+
+        double collisionMs = elapsedMs(start);
+        start = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < poses.size(); i++)
+        {
+            probe->setGlobalPose(poses[i]);
+            float d = checker->calculateDistance(probe, model);
+
+            if (level == 0)
+            {
+                distances.push_back(d);
+            }
+            else if (!collisions[i])
+            {
+                maxDeviation = std::max(maxDeviation, std::abs(d - distances[i]));
+                maxCloser = std::max(maxCloser, distances[i] - d);
+            }
+        }
+
+        double distanceMs = elapsedMs(start);
+
+        BOOST_CHECK_EQUAL(missed, 0);
+
+        if (level > 0)
+        {
+            // the conservative levels are inflated by the measured deviation, which is below the error
+            BOOST_CHECK_LT(maxDeviation, errors[level - 1] + 0.1f);
+        }
+
+        BOOST_TEST_MESSAGE("level " << level << " (" << (level == 0 ? 0.0f : errors[level - 1]) << " mm, " << model->getNumFaces() << " faces, "
+                           << (level == 0 ? 0.0 : buildMs[level - 1]) << " ms to build): checkCollision "
+                           << collisionMs * 1000.0 / poses.size() << " us (" << numCollisions << " collisions, " << missed << " missed), calculateDistance "
+                           << distanceMs * 1000.0 / poses.size() << " us (max. deviation " << maxDeviation << " mm, " << maxCloser << " mm closer)");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,404 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+
+#define BOOST_TEST_MODULE VirtualRobot_VirtualRobotPQPTest
+
+#include <VirtualRobot/VirtualRobotTest.h>
+#include <VirtualRobot/CollisionDetection/PQP/PQP++/PQP.h>
+#include <VirtualRobot/CollisionDetection/CollisionChecker.h>
+#include <VirtualRobot/CollisionDetection/CollisionModel.h>
+#include <VirtualRobot/CollisionDetection/PQP/CompactBVH.h>
+#include <VirtualRobot/Visualization/TriMeshModel.h>
+#include <VirtualRobot/Visualization/TriMeshUtils.h>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace PQP;
+using VirtualRobot::CompactBVH;
+using VirtualRobot::TriMeshModel;
+
+namespace
+{
+    // triangulated ellipsoid, roughly the size and resolution of a robot link mesh
+    std::vector<Eigen::Vector3f> createEllipsoid(float rx, float ry, float rz, int slices, int stacks)
+    {
+        std::vector<Eigen::Vector3f> tris;
+        auto point = [&](int i, int j)
+        {
+            float phi = float(M_PI) * float(j) / float(stacks);
+            float theta = 2.0f * float(M_PI) * float(i) / float(slices);
+            return Eigen::Vector3f(rx * std::sin(phi) * std::cos(theta), ry * std::sin(phi) * std::sin(theta), rz * std::cos(phi));
+        };
+
+        for (int j = 0; j < stacks; j++)
+        {
+            for (int i = 0; i < slices; i++)
+            {
+                Eigen::Vector3f a = point(i, j), b = point(i + 1, j), c = point(i + 1, j + 1), d = point(i, j + 1);
+                tris.insert(tris.end(), {a, b, c});
+                tris.insert(tris.end(), {a, c, d});
+            }
+        }
+
+        return tris;
+    }
+
+    std::unique_ptr<PQP_Model> createModel(const std::vector<Eigen::Vector3f>& tris, size_t first, size_t count)
+    {
+        std::unique_ptr<PQP_Model> m(new PQP_Model());
+        m->BeginModel(int(count));
+
+        for (size_t t = first; t < first + count; t++)
+        {
+            m->AddTri(tris[3 * t].data(), tris[3 * t + 1].data(), tris[3 * t + 2].data(), int(t));
+        }
+
+        m->EndModel();
+        return m;
+    }
+
+    void toPQP(const Eigen::Matrix4f& pose, PQP_REAL R[3][3], PQP_REAL T[3])
+    {
+        for (int r = 0; r < 3; r++)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                R[r][c] = pose(r, c);
+            }
+
+            T[r] = pose(r, 3);
+        }
+    }
+
+    // unindexed triangle soup, as loaded from STL files
+    TriMeshModel createTriMesh(const std::vector<Eigen::Vector3f>& tris)
+    {
+        TriMeshModel model;
+
+        for (size_t t = 0; t < tris.size(); t += 3)
+        {
+            model.addTriangleWithFace(tris[t], tris[t + 1], tris[t + 2]);
+        }
+
+        return model;
+    }
+
+    Eigen::Matrix4f randomPose(std::mt19937& gen, float range)
+    {
+        std::uniform_real_distribution<float> pos(-range, range);
+        std::uniform_real_distribution<float> angle(-float(M_PI), float(M_PI));
+        Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+        pose.block<3, 3>(0, 0) = (Eigen::AngleAxisf(angle(gen), Eigen::Vector3f::UnitZ())
+                                  * Eigen::AngleAxisf(angle(gen), Eigen::Vector3f::UnitY())
+                                  * Eigen::AngleAxisf(angle(gen), Eigen::Vector3f::UnitX())).toRotationMatrix();
+        pose.block<3, 1>(0, 3) = Eigen::Vector3f(pos(gen), pos(gen), pos(gen));
+        return pose;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(PQPTest)
+
+#ifdef PQP_USE_SSE
+BOOST_AUTO_TEST_CASE(testOBBDisjointSSEMatchesScalar)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dim(0.1f, 50.0f);
+    OBB_Processor obb;
+    int overlapping = 0;
+
+    for (int i = 0; i < 200000; i++)
+    {
+        Eigen::Matrix4f pose = randomPose(gen, 80.0f);
+        PQP_REAL B[3][3], T[3];
+        toPQP(pose, B, T);
+        PQP_REAL a[3] = {dim(gen), dim(gen), dim(gen)};
+        PQP_REAL b[3] = {dim(gen), dim(gen), dim(gen)};
+
+        int scalar = obb.obb_disjoint_scalar(B, T, a, b);
+        BOOST_REQUIRE_EQUAL(obb.obb_disjoint_sse(B, T, a, b), scalar);
+        overlapping += (scalar == 0);
+    }
+
+    // make sure both outcomes have been exercised
+    BOOST_CHECK_GT(overlapping, 1000);
+    BOOST_CHECK_LT(overlapping, 199000);
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(testCollideReportsAllTrianglePairs)
+{
+    std::vector<Eigen::Vector3f> tris1 = createEllipsoid(40.0f, 30.0f, 20.0f, 10, 6);
+    std::vector<Eigen::Vector3f> tris2 = createEllipsoid(25.0f, 35.0f, 15.0f, 8, 5);
+    size_t n1 = tris1.size() / 3;
+    size_t n2 = tris2.size() / 3;
+    std::unique_ptr<PQP_Model> m1 = createModel(tris1, 0, n1);
+    std::unique_ptr<PQP_Model> m2 = createModel(tris2, 0, n2);
+
+    std::vector<std::unique_ptr<PQP_Model>> single1, single2;
+
+    for (size_t i = 0; i < n1; i++)
+    {
+        single1.push_back(createModel(tris1, i, 1));
+    }
+
+    for (size_t i = 0; i < n2; i++)
+    {
+        single2.push_back(createModel(tris2, i, 1));
+    }
+
+    PQP_Checker checker;
+    std::mt19937 gen(7);
+
+    for (int q = 0; q < 20; q++)
+    {
+        PQP_REAL R1[3][3], T1[3], R2[3][3], T2[3];
+        toPQP(randomPose(gen, 20.0f), R1, T1);
+        toPQP(randomPose(gen, 20.0f), R2, T2);
+
+        PQP_CollideResult all;
+        checker.PQP_Collide(&all, R1, T1, m1.get(), R2, T2, m2.get(), PQP_ALL_CONTACTS);
+
+        // brute force: every triangle pair in its own model
+        int expected = 0;
+
+        for (auto& s1 : single1)
+        {
+            for (auto& s2 : single2)
+            {
+                PQP_CollideResult r;
+                checker.PQP_Collide(&r, R1, T1, s1.get(), R2, T2, s2.get(), PQP_FIRST_CONTACT);
+                expected += r.NumPairs();
+            }
+        }
+
+        BOOST_CHECK_EQUAL(all.NumPairs(), expected);
+
+        PQP_CollideResult first;
+        checker.PQP_Collide(&first, R1, T1, m1.get(), R2, T2, m2.get(), PQP_FIRST_CONTACT);
+        BOOST_CHECK_EQUAL(first.Colliding(), all.Colliding());
+        BOOST_CHECK_LE(first.NumBVTests(), all.NumBVTests());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testCompactBVHMatchesPQP)
+{
+    std::vector<Eigen::Vector3f> tris1 = createEllipsoid(60.0f, 40.0f, 150.0f, 20, 12);
+    std::vector<Eigen::Vector3f> tris2 = createEllipsoid(50.0f, 50.0f, 120.0f, 16, 10);
+    std::unique_ptr<PQP_Model> m1 = createModel(tris1, 0, tris1.size() / 3);
+    std::unique_ptr<PQP_Model> m2 = createModel(tris2, 0, tris2.size() / 3);
+    CompactBVH c1(createTriMesh(tris1));
+    CompactBVH c2(createTriMesh(tris2));
+
+    BOOST_CHECK_EQUAL(c1.getNumTriangles(), size_t(m1->num_tris));
+    BOOST_CHECK_EQUAL(c1.getNumNodes(), size_t(m1->num_bvs));
+    // poles and the seam are shared, so far fewer vertices than 3 per triangle remain
+    BOOST_CHECK_LT(c1.getNumVertices(), c1.getNumTriangles());
+
+    PQP_Checker checker;
+    CompactBVH::CollideStack stack;
+    std::mt19937 gen(3);
+    int colliding = 0;
+
+    for (int q = 0; q < 5000; q++)
+    {
+        Eigen::Matrix4f pose1 = randomPose(gen, 100.0f);
+        Eigen::Matrix4f pose2 = randomPose(gen, 100.0f);
+        PQP_REAL R1[3][3], T1[3], R2[3][3], T2[3];
+        toPQP(pose1, R1, T1);
+        toPQP(pose2, R2, T2);
+
+        PQP_CollideResult result;
+        checker.PQP_Collide(&result, R1, T1, m1.get(), R2, T2, m2.get(), PQP_FIRST_CONTACT);
+        bool compact = CompactBVH::Collide(checker, stack, c1, pose1, c2, pose2);
+        BOOST_REQUIRE_EQUAL(compact, result.Colliding() != 0);
+        colliding += compact;
+    }
+
+    BOOST_CHECK_GT(colliding, 100);
+    BOOST_CHECK_LT(colliding, 4900);
+}
+
+BOOST_AUTO_TEST_CASE(testCompactBVHDistanceAndMixedQueries)
+{
+    using namespace VirtualRobot;
+
+    CollisionModelPtr box1(new CollisionModel(TriMeshUtils::CreateBox(Eigen::Matrix4f::Identity(), 100, 100, 100), "Box1"));
+    CollisionModelPtr box2(new CollisionModel(TriMeshUtils::CreateBox(Eigen::Matrix4f::Identity(), 100, 100, 100), "Box2"));
+    Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+    pose(0, 3) = 150;
+    box1->setGlobalPose(Eigen::Matrix4f::Identity());
+    box2->setGlobalPose(pose);
+    CollisionCheckerPtr checker = CollisionChecker::getGlobalCollisionChecker();
+    BOOST_CHECK_CLOSE(checker->calculateDistance(box1, box2), 50.0f, 1e-3f);
+
+    // a compact model checked against a PQP model, e.g. an obstacle loaded before compact hierarchies were enabled
+    box1->getCollisionModelImplementation()->setCompactBVH(true);
+    size_t compactMemory = box1->getCollisionModelImplementation()->getCompactBVH()->getMemoryUsage();
+    BOOST_CHECK_EQUAL(box1->getCollisionModelImplementation()->getMemoryUsage(), compactMemory);
+    BOOST_CHECK(!checker->checkCollision(box1, box2));
+    BOOST_CHECK_GT(box1->getCollisionModelImplementation()->getMemoryUsage(), compactMemory);
+    pose(0, 3) = 90;
+    box2->setGlobalPose(pose);
+    BOOST_CHECK(checker->checkCollision(box1, box2));
+    BOOST_CHECK(checker->checkCollision(box2, box1));
+
+    // two compact models use the compact hierarchies, distance and point queries build the PQP models on demand
+    box1->getCollisionModelImplementation()->setCompactBVH(false);
+    box1->getCollisionModelImplementation()->setCompactBVH(true);
+    box2->getCollisionModelImplementation()->setCompactBVH(true);
+    BOOST_CHECK(checker->checkCollision(box1, box2));
+    pose(0, 3) = 150;
+    box2->setGlobalPose(pose);
+    BOOST_CHECK(!checker->checkCollision(box1, box2));
+    BOOST_CHECK_EQUAL(box1->getCollisionModelImplementation()->getMemoryUsage(), compactMemory);
+
+    Eigen::Vector3f p1, p2;
+    BOOST_CHECK_CLOSE(checker->calculateDistance(box1, box2, p1, p2), 50.0f, 1e-3f);
+    BOOST_CHECK_CLOSE(p1.x(), 50.0f, 1e-3f);
+    BOOST_CHECK_CLOSE(p2.x(), 100.0f, 1e-3f);
+    BOOST_CHECK(checker->checkCollision(box1, Eigen::Vector3f(55, 0, 0), 10.0f));
+    BOOST_CHECK(!checker->checkCollision(box1, Eigen::Vector3f(70, 0, 0), 10.0f));
+
+    // the PQP models are kept alongside the compact hierarchies
+    BOOST_CHECK(box1->getCollisionModelImplementation()->getCompactBVH());
+    BOOST_CHECK_GT(box1->getCollisionModelImplementation()->getMemoryUsage(), compactMemory);
+    BOOST_CHECK(!checker->checkCollision(box1, box2));
+}
+
+BOOST_AUTO_TEST_CASE(testPointCollisionTolerance)
+{
+    using namespace VirtualRobot;
+
+    CollisionModelPtr box(new CollisionModel(TriMeshUtils::CreateBox(Eigen::Matrix4f::Identity(), 100, 200, 300), "Box"));
+    box->setGlobalPose(Eigen::Matrix4f::Identity());
+    CollisionCheckerPtr checker = CollisionChecker::getGlobalCollisionChecker();
+
+    // the point is 10 mm away from the side at x = 50, the result depends on the given tolerance only
+    BOOST_CHECK(checker->checkCollision(box, Eigen::Vector3f(60, 0, 0), 20.0f));
+    BOOST_CHECK(!checker->checkCollision(box, Eigen::Vector3f(60, 0, 0), 5.0f));
+    BOOST_CHECK(!checker->checkCollision(box, Eigen::Vector3f(90, 0, 0), 20.0f));
+    BOOST_CHECK(checker->checkCollision(box, Eigen::Vector3f(0, 0, 190), 50.0f));
+    BOOST_CHECK(!checker->checkCollision(box, Eigen::Vector3f(0, 0, 190), 30.0f));
+}
+
+BOOST_AUTO_TEST_CASE(benchmarkCollide)
+{
+    // two link-sized meshes with ~2000 triangles each
+    std::vector<Eigen::Vector3f> tris1 = createEllipsoid(60.0f, 40.0f, 150.0f, 40, 25);
+    std::vector<Eigen::Vector3f> tris2 = createEllipsoid(50.0f, 50.0f, 120.0f, 40, 25);
+    std::unique_ptr<PQP_Model> m1 = createModel(tris1, 0, tris1.size() / 3);
+    std::unique_ptr<PQP_Model> m2 = createModel(tris2, 0, tris2.size() / 3);
+
+    const int numQueries = 20000;
+    std::mt19937 gen(1);
+    std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f>> poses;
+
+    for (int i = 0; i < numQueries; i++)
+    {
+        poses.push_back(randomPose(gen, 250.0f));
+    }
+
+    PQP_Checker checker;
+    PQP_REAL R1[3][3], T1[3];
+    toPQP(Eigen::Matrix4f::Identity(), R1, T1);
+    long bvTests = 0;
+    int colliding = 0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (const Eigen::Matrix4f& pose : poses)
+    {
+        PQP_REAL R2[3][3], T2[3];
+        toPQP(pose, R2, T2);
+        PQP_CollideResult result;
+        checker.PQP_Collide(&result, R1, T1, m1.get(), R2, T2, m2.get(), PQP_FIRST_CONTACT);
+        bvTests += result.NumBVTests();
+        colliding += result.Colliding();
+    }
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    double us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    std::cout << "PQP_Collide (" << m1->num_tris << " x " << m2->num_tris << " tris): "
+              << us / numQueries << " us/query, " << double(bvTests) / numQueries << " BV tests/query, "
+              << colliding << "/" << numQueries << " colliding" << std::endl;
+
+    // same queries on the compact hierarchy
+    CompactBVH c1(createTriMesh(tris1));
+    CompactBVH c2(createTriMesh(tris2));
+    CompactBVH::CollideStack stack;
+    long compactTests = 0;
+    int compactColliding = 0;
+    start = std::chrono::steady_clock::now();
+
+    for (const Eigen::Matrix4f& pose : poses)
+    {
+        int tests;
+        compactColliding += CompactBVH::Collide(checker, stack, c1, Eigen::Matrix4f::Identity(), c2, pose, &tests);
+        compactTests += tests;
+    }
+
+    end = std::chrono::steady_clock::now();
+    double compactUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    std::cout << "CompactBVH::Collide: " << compactUs / numQueries << " us/query, "
+              << double(compactTests) / numQueries << " BV tests/query, "
+              << compactColliding << "/" << numQueries << " colliding" << std::endl;
+    std::cout << "Memory: PQP_Model " << m1->MemUsage(0) << " bytes, CompactBVH " << c1.getMemoryUsage() << " bytes" << std::endl;
+    BOOST_CHECK_EQUAL(compactColliding, colliding);
+    BOOST_CHECK_LT(c1.getMemoryUsage(), size_t(m1->MemUsage(0)) / 2);
+
+#ifdef PQP_USE_SSE
+    // isolated OBB test throughput, scalar vs. SSE
+    std::vector<std::array<PQP_REAL, 18>> boxes(numQueries);
+    std::uniform_real_distribution<float> dim(1.0f, 50.0f);
+
+    for (int i = 0; i < numQueries; i++)
+    {
+        PQP_REAL B[3][3], T[3];
+        toPQP(poses[i], B, T);
+        std::copy(&B[0][0], &B[0][0] + 9, boxes[i].begin());
+        std::copy(T, T + 3, boxes[i].begin() + 9);
+
+        for (int j = 12; j < 18; j++)
+        {
+            boxes[i][j] = dim(gen);
+        }
+    }
+
+    OBB_Processor obb;
+    auto run = [&](bool sse)
+    {
+        int sum = 0;
+        std::chrono::steady_clock::time_point s = std::chrono::steady_clock::now();
+
+        for (int rep = 0; rep < 50; rep++)
+        {
+            for (auto& box : boxes)
+            {
+                PQP_REAL(*B)[3] = reinterpret_cast<PQP_REAL(*)[3]>(box.data());
+                sum += sse ? obb.obb_disjoint_sse(B, box.data() + 9, box.data() + 12, box.data() + 15)
+                       : obb.obb_disjoint_scalar(B, box.data() + 9, box.data() + 12, box.data() + 15);
+            }
+        }
+
+        std::chrono::steady_clock::time_point e = std::chrono::steady_clock::now();
+        BOOST_CHECK_GE(sum, 0);
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(e - s).count() / (50.0 * numQueries);
+    };
+
+    std::cout << "obb_disjoint: scalar " << run(false) << " ns, SSE " << run(true) << " ns" << std::endl;
+#endif
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,294 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+
+#define BOOST_TEST_MODULE VirtualRobot_VirtualRobotPointCloudObstacleTest
+
+#include <VirtualRobot/VirtualRobotTest.h>
+#include <VirtualRobot/CollisionDetection/CDManager.h>
+#include <VirtualRobot/CollisionDetection/CollisionModel.h>
+#include <VirtualRobot/CollisionDetection/PointCloudObstacle.h>
+#include <VirtualRobot/CollisionDetection/SphereTree.h>
+#include <VirtualRobot/Obstacle.h>
+#include <VirtualRobot/Visualization/TriMeshModel.h>
+#include <VirtualRobot/Visualization/TriMeshUtils.h>
+#include <VirtualRobot/VirtualRobotException.h>
+
+#include <chrono>
+#include <cmath>
+#include <random>
+
+using namespace VirtualRobot;
+
+BOOST_AUTO_TEST_SUITE(PointCloudObstacleTest)
+
+namespace
+{
+    CollisionModelPtr createBoxModel(float halfSize, float x, float y, float z)
+    {
+        CollisionModelPtr model(new CollisionModel(TriMeshUtils::CreateBox(Eigen::Matrix4f::Identity(), 2 * halfSize, 2 * halfSize, 2 * halfSize), "Box"));
+        Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+        pose.block<3, 1>(0, 3) = Eigen::Vector3f(x, y, z);
+        model->setGlobalPose(pose);
+        return model;
+    }
+
+    // a depth image like frame: a wavy surface of width x height points in front of the origin
+    std::vector<Eigen::Vector3f> createFrame(int width, int height, float phase)
+    {
+        std::vector<Eigen::Vector3f> points;
+        points.reserve(width * height);
+
+        for (int v = 0; v < height; v++)
+        {
+            for (int u = 0; u < width; u++)
+            {
+                float x = 4.0f * (u - width / 2);
+                float y = 4.0f * (v - height / 2);
+                points.push_back(Eigen::Vector3f(x, y, 1500.0f + 100.0f * std::sin(x / 200.0f + phase) * std::cos(y / 300.0f)));
+            }
+        }
+
+        return points;
+    }
+
+    double elapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testInsertRemove)
+{
+    BOOST_CHECK_THROW(PointCloudObstacle(0.0f), VirtualRobotException);
+
+    PointCloudObstacle cloud(10.0f, "Cloud");
+    BOOST_CHECK_EQUAL(cloud.getName(), "Cloud");
+
+    std::vector<Eigen::Vector3f> points;
+    points.push_back(Eigen::Vector3f(1, 1, 1));
+    points.push_back(Eigen::Vector3f(2, 2, 2));
+    points.push_back(Eigen::Vector3f(-1, -1, -1));
+    points.push_back(Eigen::Vector3f(-75, 100, 1000));
+    points.push_back(Eigen::Vector3f(NAN, 0, 0));
+    cloud.insert(points);
+
+    BOOST_CHECK_EQUAL(cloud.getNumPoints(), 4u);
+    BOOST_CHECK_EQUAL(cloud.getNumVoxels(), 3u);
+    BOOST_CHECK(cloud.isOccupied(Eigen::Vector3f(9, 9, 9)));
+    BOOST_CHECK(cloud.isOccupied(Eigen::Vector3f(-9, -9, -9)));
+    BOOST_CHECK(cloud.isOccupied(Eigen::Vector3f(-71, 109, 1001)));
+    BOOST_CHECK(!cloud.isOccupied(Eigen::Vector3f(11, 9, 9)));
+    BOOST_CHECK(!cloud.isOccupied(Eigen::Vector3f(-81, 109, 1001)));
+
+    // the voxel stays occupied until all its points are removed
+    cloud.remove(std::vector<Eigen::Vector3f>(1, points[0]));
+    BOOST_CHECK(cloud.isOccupied(Eigen::Vector3f(9, 9, 9)));
+    cloud.remove(std::vector<Eigen::Vector3f>(2, points[1]));
+    BOOST_CHECK(!cloud.isOccupied(Eigen::Vector3f(9, 9, 9)));
+    BOOST_CHECK_EQUAL(cloud.getNumPoints(), 2u);
+    BOOST_CHECK_EQUAL(cloud.getNumVoxels(), 2u);
+
+    cloud.clear();
+    BOOST_CHECK_EQUAL(cloud.getNumPoints(), 0u);
+    BOOST_CHECK(!cloud.isOccupied(Eigen::Vector3f(-9, -9, -9)));
+
+    // the threads are used for the same result
+    std::vector<Eigen::Vector3f> frame = createFrame(320, 240, 0);
+    PointCloudObstacle serial(10.0f);
+    PointCloudObstacle parallel(10.0f);
+    serial.insert(frame, 1);
+    parallel.insert(frame, 4);
+    BOOST_CHECK_EQUAL(serial.getNumPoints(), frame.size());
+    BOOST_CHECK_EQUAL(serial.getNumVoxels(), parallel.getNumVoxels());
+
+    for (size_t i = 0; i < frame.size(); i += 97)
+    {
+        BOOST_CHECK(parallel.isOccupied(frame[i]));
+    }
+
+    parallel.remove(frame, 4);
+    BOOST_CHECK_EQUAL(parallel.getNumPoints(), 0u);
+    BOOST_CHECK_EQUAL(parallel.getNumVoxels(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(testCollisionAndDistance)
+{
+    const float resolution = 10.0f;
+    PointCloudObstacle cloud(resolution);
+
+    // a plane of points at z = 200
+    std::vector<Eigen::Vector3f> plane;
+
+    for (int x = -50; x <= 50; x++)
+    {
+        for (int y = -50; y <= 50; y++)
+        {
+            plane.push_back(Eigen::Vector3f(x * 5.0f, y * 5.0f, 200.0f));
+        }
+    }
+
+    cloud.insert(plane);
+
+    CollisionModelPtr box = createBoxModel(50, 0, 0, 0);
+    BOOST_CHECK(!cloud.checkCollision(box));
+    BOOST_CHECK(cloud.checkCollision(box, 160));
+
+    const float leafRadius = box->getSphereTree()->getMaxLeafRadius();
+    const float slack = 2 * leafRadius + std::sqrt(3.0f) * resolution;
+
+    for (float z : {0.0f, 50.0f, 100.0f, 140.0f, 180.0f, 230.0f, 300.0f})
+    {
+        box = createBoxModel(50, 30, 0, z);
+        float exact = std::max(0.0f, std::abs(200.0f - z) - 50.0f);
+        float distance = cloud.getDistance(box);
+        BOOST_CHECK_LE(distance, exact + 1e-3f);
+        BOOST_CHECK_GE(distance, exact - slack);
+        BOOST_CHECK(cloud.checkCollision(box) || exact > 0);
+        BOOST_CHECK(!cloud.checkCollision(box) || exact <= slack);
+    }
+
+    // only points within maxDistance are considered
+    box = createBoxModel(50, 0, 0, -500);
+    BOOST_CHECK_EQUAL(cloud.getDistance(box, 100.0f), 100.0f);
+    BOOST_CHECK_EQUAL(PointCloudObstacle(resolution).getDistance(box), 1000.0f);
+}
+
+BOOST_AUTO_TEST_CASE(testCDManager)
+{
+    ObstaclePtr box(new Obstacle("Box", VisualizationNodePtr(), createBoxModel(50, 0, 0, 0)));
+    box->setGlobalPose(Eigen::Matrix4f::Identity());
+    ObstaclePtr other(new Obstacle("Other", VisualizationNodePtr(), createBoxModel(50, 0, 0, 0)));
+    Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+    pose(0, 3) = 500;
+    other->setGlobalPose(pose);
+    PointCloudObstaclePtr cloud(new PointCloudObstacle(10.0f));
+
+    // the cloud is only checked against the box
+    CDManager cdm;
+    cdm.addCollisionModel(box);
+    cdm.addCollisionModel(other);
+    cdm.addPointCloud(cloud, box);
+    BOOST_CHECK_EQUAL(cdm.getPointClouds().size(), 1u);
+    BOOST_CHECK_EQUAL(cdm.getSceneObjectSets().size(), 2u);
+    BOOST_CHECK(!cdm.isInCollision());
+
+    std::vector<Eigen::Vector3f> points(1, Eigen::Vector3f(0, 0, 300));
+    cloud->insert(points);
+    BOOST_CHECK(!cdm.isInCollision());
+    BOOST_CHECK_LE(cdm.getDistance(), 250.0f);
+    BOOST_CHECK_GT(cdm.getDistance(), 200.0f);
+
+    cloud->remove(points);
+    points[0] = Eigen::Vector3f(520, 20, 45);
+    cloud->insert(points);
+    BOOST_CHECK(!cdm.isInCollision());
+    BOOST_CHECK_CLOSE(cdm.getDistance(), 400.0f, 1e-3f);
+
+    cloud->remove(points);
+    points[0] = Eigen::Vector3f(20, 20, 45);
+    cloud->insert(points);
+    BOOST_CHECK(cdm.isInCollision());
+    BOOST_CHECK_EQUAL(cdm.getDistance(), 0.0f);
+
+    // the distances with closest points ignore the clouds
+    Eigen::Vector3f p1, p2;
+    int id1, id2;
+    BOOST_CHECK_CLOSE(cdm.getDistance(p1, p2, id1, id2), 400.0f, 1e-3f);
+
+    // a cloud can be added with several sets
+    cloud->remove(points);
+    points[0] = Eigen::Vector3f(520, 20, 45);
+    cloud->insert(points);
+    cdm.addPointCloud(cloud, other);
+    BOOST_CHECK_EQUAL(cdm.getPointClouds().size(), 1u);
+    BOOST_CHECK_EQUAL(cdm.getSceneObjectSets().size(), 2u);
+    BOOST_CHECK(cdm.isInCollision());
+    BOOST_CHECK_EQUAL(cdm.getDistance(), 0.0f);
+
+    // given sets are checked against all clouds
+    SceneObjectSetPtr set(new SceneObjectSet("Set"));
+    ObstaclePtr far(new Obstacle("Far", VisualizationNodePtr(), createBoxModel(10, 0, 0, 0)));
+    pose(2, 3) = -500;
+    far->setGlobalPose(pose);
+    set->addSceneObject(far);
+    BOOST_CHECK(!cdm.isInCollision(set));
+    cloud->insert(std::vector<Eigen::Vector3f>(1, Eigen::Vector3f(250, 0, 200)));
+    pose(0, 3) = 250;
+    pose(2, 3) = 200;
+    far->setGlobalPose(pose);
+    BOOST_CHECK(cdm.isInCollision(set));
+    BOOST_CHECK_THROW(cdm.addPointCloud(PointCloudObstaclePtr(), set), VirtualRobotException);
+}
+
+BOOST_AUTO_TEST_CASE(testBenchmark)
+{
+    const int numFrames = 10;
+    std::vector<std::vector<Eigen::Vector3f>> frames;
+
+    for (int i = 0; i < numFrames; i++)
+    {
+        frames.push_back(createFrame(640, 480, 0.1f * i));
+    }
+
+    for (unsigned int numThreads : {1u, 0u})
+    {
+        PointCloudObstacle cloud(20.0f);
+        auto start = std::chrono::steady_clock::now();
+        cloud.insert(frames[0], numThreads);
+        double insertMs = elapsedMs(start);
+
+        // replace the previous frame
+        start = std::chrono::steady_clock::now();
+
+        for (int i = 1; i < numFrames; i++)
+        {
+            cloud.remove(frames[i - 1], numThreads);
+            cloud.insert(frames[i], numThreads);
+        }
+
+        double replaceMs = elapsedMs(start) / (numFrames - 1);
+        BOOST_CHECK_EQUAL(cloud.getNumPoints(), frames.back().size());
+
+        BOOST_TEST_MESSAGE((numThreads == 1 ? "1 thread" : "all cores") << ": " << frames[0].size() << " points, insert "
+                           << insertMs << " ms, replace frame " << replaceMs << " ms (" << 1000.0 / replaceMs << " frames/s), "
+                           << cloud.getNumVoxels() << " voxels");
+    }
+
+    PointCloudObstacle cloud(20.0f);
+    cloud.insert(frames[0]);
+    CollisionModelPtr box = createBoxModel(100, 0, 0, 0);
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> coordinate(-800.0f, 800.0f);
+    std::uniform_real_distribution<float> depth(1000.0f, 1800.0f);
+    const int numQueries = 200;
+    int numCollisions = 0;
+    double collisionMs = 0;
+    double distanceMs = 0;
+
+    for (int i = 0; i < numQueries; i++)
+    {
+        Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+        pose.block<3, 1>(0, 3) = Eigen::Vector3f(coordinate(gen), coordinate(gen), depth(gen));
+        box->setGlobalPose(pose);
+
+        auto start = std::chrono::steady_clock::now();
+        bool collision = cloud.checkCollision(box);
+        collisionMs += elapsedMs(start);
+        start = std::chrono::steady_clock::now();
+        float distance = cloud.getDistance(box);
+        distanceMs += elapsedMs(start);
+
+        numCollisions += collision ? 1 : 0;
+        BOOST_CHECK_EQUAL(collision, distance == 0);
+    }
+
+    BOOST_CHECK_GT(numCollisions, 0);
+    BOOST_CHECK_LT(numCollisions, numQueries);
+    BOOST_TEST_MESSAGE("box (" << box->getSphereTree()->getNumLeaves() << " leaves), " << numQueries << " queries with "
+                       << numCollisions << " collisions: checkCollision " << collisionMs * 1000.0 / numQueries
+                       << " us, getDistance " << distanceMs * 1000.0 / numQueries << " us");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -10,6 +10,12 @@
 #include <VirtualRobot/XML/SceneIO.h>
 #include <VirtualRobot/Scene.h>
 #include <VirtualRobot/VirtualRobotException.h>
+#include <VirtualRobot/Obstacle.h>
+#include <VirtualRobot/RuntimeEnvironment.h>
+#include <VirtualRobot/CollisionDetection/CollisionModel.h>
+#include <VirtualRobot/Visualization/TriMeshModel.h>
+#include <chrono>
+#include <sstream>
 #include <string>
 
 BOOST_AUTO_TEST_SUITE(Scene)
@@ -69,4 +75,71 @@ BOOST_AUTO_TEST_CASE(testSceneInvalidRobot4Type)
 }
 
 
+BOOST_AUTO_TEST_CASE(testSceneParallelLoading)
+{
+    std::string stlFile("objects/stl/Piggy6.stl");
+    BOOST_REQUIRE(VirtualRobot::RuntimeEnvironment::getDataFileAbsolute(stlFile));
+
+    std::stringstream ss;
+    ss << "<Scene name='Obstacles'>";
+
+    for (int i = 0; i < 200; i++)
+    {
+        ss << "<Obstacle name='Obstacle" << i << "'>"
+           << "  <CollisionModel>";
+
+        if (i % 2 == 0)
+        {
+            ss << "<File>" << stlFile << "</File>";
+        }
+        else
+        {
+            ss << "<Primitives><Box width='" << (10 + i) << "' height='100' depth='100'/></Primitives>";
+        }
+
+        ss << "  </CollisionModel>"
+           << "  <GlobalPose><Transform><Translation x='" << 300 * i << "' y='0' z='0'/></Transform></GlobalPose>"
+           << "</Obstacle>";
+    }
+
+    ss << "</Scene>";
+
+    VirtualRobot::SceneIO::setNumLoadingThreads(1);
+    auto start = std::chrono::steady_clock::now();
+    VirtualRobot::ScenePtr sequential = VirtualRobot::SceneIO::createSceneFromString(ss.str(), "", VirtualRobot::RobotIO::eCollisionModelNoVisualization);
+    double sequentialMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    VirtualRobot::SceneIO::setNumLoadingThreads(4);
+    start = std::chrono::steady_clock::now();
+    VirtualRobot::ScenePtr parallel = VirtualRobot::SceneIO::createSceneFromString(ss.str(), "", VirtualRobot::RobotIO::eCollisionModelNoVisualization);
+    double parallelMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    BOOST_TEST_MESSAGE("200 obstacles: sequential " << sequentialMs << " ms, " << VirtualRobot::SceneIO::getNumLoadingThreads()
+                       << " threads " << parallelMs << " ms");
+
+    BOOST_REQUIRE(sequential && parallel);
+    std::vector<VirtualRobot::ObstaclePtr> a = sequential->getObstacles();
+    std::vector<VirtualRobot::ObstaclePtr> b = parallel->getObstacles();
+    BOOST_REQUIRE_EQUAL(a.size(), 200);
+    BOOST_REQUIRE_EQUAL(a.size(), b.size());
+
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        BOOST_CHECK_EQUAL(a[i]->getName(), b[i]->getName());
+        BOOST_REQUIRE(a[i]->getCollisionModel() && b[i]->getCollisionModel());
+        BOOST_CHECK_EQUAL(a[i]->getCollisionModel()->getName(), b[i]->getCollisionModel()->getName());
+        VirtualRobot::TriMeshModelPtr meshA = a[i]->getCollisionModel()->getTriMeshModel();
+        VirtualRobot::TriMeshModelPtr meshB = b[i]->getCollisionModel()->getTriMeshModel();
+        BOOST_CHECK_EQUAL(meshA->faces.size(), meshB->faces.size());
+        BOOST_CHECK(meshA->vertices == meshB->vertices);
+        BOOST_CHECK(a[i]->getGlobalPose().isApprox(b[i]->getGlobalPose()));
+    }
+
+    // errors in a worker thread are passed on
+    const std::string invalidScene = "<Scene name='Invalid'><Obstacle name='o1'><CollisionModel><File></File></CollisionModel></Obstacle>"
+                                     "<Obstacle name='o2'><CollisionModel><File></File></CollisionModel></Obstacle></Scene>";
+    BOOST_CHECK_THROW(VirtualRobot::SceneIO::createSceneFromString(invalidScene, "", VirtualRobot::RobotIO::eCollisionModelNoVisualization), VirtualRobot::VirtualRobotException);
+    VirtualRobot::SceneIO::setNumLoadingThreads(0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,211 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+
+#define BOOST_TEST_MODULE VirtualRobot_VirtualRobotSignedDistanceFieldTest
+
+#include <VirtualRobot/VirtualRobotTest.h>
+#include <VirtualRobot/CollisionDetection/CollisionChecker.h>
+#include <VirtualRobot/CollisionDetection/CollisionModel.h>
+#include <VirtualRobot/MathTools.h>
+#include <VirtualRobot/Obstacle.h>
+#include <VirtualRobot/SceneObjectSet.h>
+#include <VirtualRobot/Tools/SignedDistanceField.h>
+#include <VirtualRobot/Visualization/TriMeshModel.h>
+#include <VirtualRobot/Visualization/TriMeshUtils.h>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <random>
+
+using namespace VirtualRobot;
+
+BOOST_AUTO_TEST_SUITE(SignedDistanceFieldTest)
+
+namespace
+{
+    float boxDistance(const Eigen::Vector3f& p, const Eigen::Vector3f& halfSize)
+    {
+        Eigen::Vector3f q = p.cwiseAbs() - halfSize;
+        return q.cwiseMax(0.0f).norm() + std::min(q.maxCoeff(), 0.0f);
+    }
+
+    double elapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testBox)
+{
+    const Eigen::Vector3f halfSize(100, 50, 25);
+    SignedDistanceFieldPtr sdf = SignedDistanceField::Create(TriMeshUtils::CreateBox(Eigen::Matrix4f::Identity(), 2 * halfSize.x(), 2 * halfSize.y(), 2 * halfSize.z()), 5.0f, 20.0f, 1);
+    BOOST_REQUIRE(sdf);
+    BOOST_CHECK_EQUAL(sdf->getSize(), Eigen::Vector3i(49, 29, 19));
+
+    // the grid points store the exact distances
+    for (int z = 0; z < sdf->getSize().z(); z++)
+    {
+        for (int y = 0; y < sdf->getSize().y(); y++)
+        {
+            for (int x = 0; x < sdf->getSize().x(); x++)
+            {
+                Eigen::Vector3f p = sdf->getOrigin() + sdf->getResolution() * Eigen::Vector3f(x, y, z);
+                BOOST_CHECK_SMALL(sdf->getValue(x, y, z) - boxDistance(p, halfSize), 1e-3f);
+            }
+        }
+    }
+
+    // between the grid points, the interpolation error is below half the resolution
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> coordinate(-1.0f, 1.0f);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        Eigen::Vector3f p = Eigen::Vector3f(coordinate(gen), coordinate(gen), coordinate(gen)).cwiseProduct(halfSize + Eigen::Vector3f::Constant(15));
+        BOOST_CHECK_SMALL(sdf->getDistance(p) - boxDistance(p, halfSize), 2.5f);
+    }
+
+    Eigen::Vector3f gradient;
+    BOOST_CHECK_CLOSE(sdf->getDistance(Eigen::Vector3f(0, 0, 35), gradient), 10.0f, 1e-2f);
+    BOOST_CHECK(gradient.isApprox(Eigen::Vector3f::UnitZ(), 1e-3f));
+    BOOST_CHECK_CLOSE(sdf->getDistance(Eigen::Vector3f(-90, 3, 2), gradient), -10.0f, 1e-2f);
+    BOOST_CHECK(gradient.isApprox(-Eigen::Vector3f::UnitX(), 1e-3f));
+
+    // outside of the grid the distance to the grid is added
+    BOOST_CHECK_CLOSE(sdf->getDistance(Eigen::Vector3f(300, 0, 0), gradient), 200.0f, 1e-2f);
+    BOOST_CHECK(gradient.isApprox(Eigen::Vector3f::UnitX(), 1e-3f));
+
+    // the number of threads does not change the result
+    SignedDistanceFieldPtr parallel = SignedDistanceField::Create(TriMeshUtils::CreateBox(Eigen::Matrix4f::Identity(), 2 * halfSize.x(), 2 * halfSize.y(), 2 * halfSize.z()), 5.0f, 20.0f, 4);
+
+    for (int i = 0; i < 100; i++)
+    {
+        Eigen::Vector3f p = Eigen::Vector3f(coordinate(gen), coordinate(gen), coordinate(gen)) * 120;
+        BOOST_CHECK_EQUAL(parallel->getDistance(p), sdf->getDistance(p));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSceneObjectsAndFile)
+{
+    Eigen::Matrix4f pose;
+    MathTools::posrpy2eigen4f(100, 0, 50, 0.3f, 0, 0.5f, pose);
+
+    ObstaclePtr obstacle(new Obstacle("Box", VisualizationNodePtr(), CollisionModelPtr(new CollisionModel(TriMeshUtils::CreateBox(Eigen::Matrix4f::Identity(), 60, 60, 60), "Box"))));
+    obstacle->setGlobalPose(pose);
+    SceneObjectSetPtr objects(new SceneObjectSet("Objects"));
+    objects->addSceneObject(obstacle);
+
+    SignedDistanceFieldPtr sdf = SignedDistanceField::Create(objects, 2.0f, 10.0f);
+    BOOST_REQUIRE(sdf);
+    BOOST_CHECK_SMALL(sdf->getDistance(pose.block<3, 1>(0, 3)) + 30.0f, 2.0f);
+    Eigen::Vector3f top = pose.block<3, 3>(0, 0) * Eigen::Vector3f(0, 0, 40) + pose.block<3, 1>(0, 3);
+    BOOST_CHECK_SMALL(sdf->getDistance(top) - 10.0f, 0.2f);
+
+    std::string filename = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("sdf-%%%%-%%%%.bin")).string();
+    BOOST_REQUIRE(sdf->save(filename));
+    SignedDistanceFieldPtr loaded = SignedDistanceField::load(filename);
+    BOOST_REQUIRE(loaded);
+    BOOST_CHECK_EQUAL(loaded->getSize(), sdf->getSize());
+    BOOST_CHECK_EQUAL(loaded->getResolution(), sdf->getResolution());
+    BOOST_CHECK(loaded->getOrigin() == sdf->getOrigin());
+    BOOST_CHECK_EQUAL(loaded->getDistance(top), sdf->getDistance(top));
+    BOOST_CHECK_EQUAL(loaded->getValue(3, 4, 5), sdf->getValue(3, 4, 5));
+
+    // truncated files are rejected
+    {
+        std::ofstream output(filename.c_str(), std::ios::binary | std::ios::trunc);
+        output << "SXDF";
+    }
+    BOOST_CHECK(!SignedDistanceField::load(filename));
+    boost::filesystem::remove(filename);
+    BOOST_CHECK(!SignedDistanceField::load(filename));
+}
+
+BOOST_AUTO_TEST_CASE(testQueryBenchmark)
+{
+    // a sphere of many triangles, PQP computes the unsigned distance to the surface
+    TriMeshModelPtr mesh(new TriMeshModel());
+    const int rings = 60;
+    const int segments = 120;
+
+    auto spherePoint = [](int r, int s)
+    {
+        float theta = float(M_PI) * r / rings;
+        float phi = 2 * float(M_PI) * s / segments;
+        return Eigen::Vector3f(80 * std::sin(theta) * std::cos(phi), 80 * std::sin(theta) * std::sin(phi), 80 * std::cos(theta));
+    };
+
+    for (int r = 0; r < rings; r++)
+    {
+        for (int s = 0; s < segments; s++)
+        {
+            // the triangles at the poles would be degenerated
+            if (r < rings - 1)
+            {
+                mesh->addTriangleWithFace(spherePoint(r, s), spherePoint(r + 1, s), spherePoint(r + 1, s + 1));
+            }
+
+            if (r > 0)
+            {
+                mesh->addTriangleWithFace(spherePoint(r, s), spherePoint(r + 1, s + 1), spherePoint(r, s + 1));
+            }
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    SignedDistanceFieldPtr sdf = SignedDistanceField::Create(mesh, 4.0f, 40.0f);
+    double buildMs = elapsedMs(start);
+
+    CollisionModelPtr obstacle(new CollisionModel(mesh, "Obstacle"));
+    obstacle->setGlobalPose(Eigen::Matrix4f::Identity());
+    TriMeshModelPtr pointMesh(new TriMeshModel());
+    pointMesh->addTriangleWithFace(Eigen::Vector3f(0, 0, 0), Eigen::Vector3f(0.1f, 0, 0), Eigen::Vector3f(0, 0.1f, 0));
+    CollisionModelPtr point(new CollisionModel(pointMesh, "Point"));
+
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> coordinate(-110.0f, 110.0f);
+    std::vector<Eigen::Vector3f> queries;
+
+    for (int i = 0; i < 2000; i++)
+    {
+        queries.push_back(Eigen::Vector3f(coordinate(gen), coordinate(gen), coordinate(gen)));
+    }
+
+    start = std::chrono::steady_clock::now();
+    float sdfSum = 0;
+
+    for (const Eigen::Vector3f& q : queries)
+    {
+        sdfSum += std::abs(sdf->getDistance(q));
+    }
+
+    double sdfMs = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    float pqpSum = 0;
+    float maxError = 0;
+
+    for (const Eigen::Vector3f& q : queries)
+    {
+        Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+        pose.block<3, 1>(0, 3) = q;
+        point->setGlobalPose(pose);
+        float d = CollisionChecker::getGlobalCollisionChecker()->calculateDistance(point, obstacle);
+        pqpSum += d;
+        maxError = std::max(maxError, std::abs(std::abs(sdf->getDistance(q)) - d));
+    }
+
+    double pqpMs = elapsedMs(start);
+
+    BOOST_CHECK_LT(maxError, 0.5f);
+    BOOST_CHECK_CLOSE(sdfSum, pqpSum, 1.0f);
+    BOOST_TEST_MESSAGE(mesh->faces.size() << " triangles, " << sdf->getSize().prod() << " grid points built in " << buildMs << " ms; "
+                       << "query " << sdfMs * 1000.0 / queries.size() << " us, CollisionChecker::calculateDistance "
+                       << pqpMs * 1000.0 / queries.size() << " us, max. difference " << maxError << " mm");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,213 @@
+/**
+* @package    VirtualRobot
+* @copyright  2026 GNU Lesser General Public License
+*/
+
+#define BOOST_TEST_MODULE VirtualRobot_VirtualRobotSphereTreeTest
+
+#include <VirtualRobot/VirtualRobotTest.h>
+#include <VirtualRobot/CollisionDetection/CDManager.h>
+#include <VirtualRobot/CollisionDetection/CollisionChecker.h>
+#include <VirtualRobot/CollisionDetection/CollisionModel.h>
+#include <VirtualRobot/CollisionDetection/SphereTree.h>
+#include <VirtualRobot/MathTools.h>
+#include <VirtualRobot/Obstacle.h>
+#include <VirtualRobot/Visualization/TriMeshModel.h>
+#include <VirtualRobot/Visualization/TriMeshUtils.h>
+#include <VirtualRobot/VirtualRobotException.h>
+
+#include <chrono>
+#include <random>
+
+using namespace VirtualRobot;
+
+BOOST_AUTO_TEST_SUITE(SphereTreeTest)
+
+namespace
+{
+    Eigen::Matrix4f randomPose(std::mt19937& gen, float maxTranslation)
+    {
+        std::uniform_real_distribution<float> translation(-maxTranslation, maxTranslation);
+        std::uniform_real_distribution<float> angle(-float(M_PI), float(M_PI));
+        Eigen::Matrix4f pose;
+        MathTools::posrpy2eigen4f(translation(gen), translation(gen), translation(gen), angle(gen), angle(gen), angle(gen), pose);
+        return pose;
+    }
+
+    double elapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testLeaves)
+{
+    const Eigen::Vector3f halfSize(100, 50, 25);
+    TriMeshModelPtr box = TriMeshUtils::CreateBox(Eigen::Matrix4f::Identity(), 2 * halfSize.x(), 2 * halfSize.y(), 2 * halfSize.z());
+    SphereTreePtr tree = SphereTree::Create(*box, 10.0f);
+
+    BOOST_CHECK_GT(tree->getNumLeaves(), 100u);
+    BOOST_CHECK_LT(tree->getNumNodes(), tree->getNumLeaves());
+
+    for (size_t i = 0; i < tree->getNumLeaves(); i++)
+    {
+        BOOST_CHECK_LE(tree->getLeafRadius(i), 10.0f);
+        Eigen::Vector3f q = tree->getLeafCenter(i).cwiseAbs() - halfSize;
+        BOOST_CHECK_SMALL(q.maxCoeff(), 10.0f);
+    }
+
+    // all points of the surface are covered
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> coordinate(-1.0f, 1.0f);
+    Eigen::Matrix4f pose = randomPose(gen, 100);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        Eigen::Vector3f p = Eigen::Vector3f(coordinate(gen), coordinate(gen), coordinate(gen));
+        int axis;
+        p.cwiseAbs().maxCoeff(&axis);
+        p[axis] = p[axis] > 0 ? 1.0f : -1.0f;
+        p = p.cwiseProduct(halfSize);
+        BOOST_CHECK(tree->collides(pose.block<3, 3>(0, 0) * p + pose.block<3, 1>(0, 3), pose));
+    }
+
+    // points farther than twice the leaf radius from the surface are free
+    BOOST_CHECK(!tree->collides(Eigen::Vector3f::Zero(), Eigen::Matrix4f::Identity()));
+    BOOST_CHECK(!tree->collides(Eigen::Vector3f(0, 0, 50), Eigen::Matrix4f::Identity()));
+    BOOST_CHECK(tree->collides(Eigen::Vector3f(0, 0, 50), Eigen::Matrix4f::Identity(), 25.0f));
+    std::vector<Eigen::Vector3f> points(1, Eigen::Vector3f::Zero());
+    BOOST_CHECK(!tree->collides(points, Eigen::Matrix4f::Identity()));
+    points.push_back(Eigen::Vector3f(100, 0, 0));
+    BOOST_CHECK(tree->collides(points, Eigen::Matrix4f::Identity()));
+
+    BOOST_CHECK_THROW(SphereTree::Create(*box, 0.0f), VirtualRobotException);
+    BOOST_CHECK_EQUAL(SphereTree::Create(TriMeshModel(), 1.0f)->getNumLeaves(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(testConservativeBenchmark)
+{
+    CollisionModelPtr sphere(new CollisionModel(TriMeshUtils::CreateSphere(Eigen::Matrix4f::Identity(), 50, 60, 30), "Sphere"));
+    CollisionModelPtr box(new CollisionModel(TriMeshUtils::CreateBox(Eigen::Matrix4f::Identity(), 160, 80, 40), "Box"));
+    SphereTreePtr sphereTree = sphere->getSphereTree();
+    SphereTreePtr boxTree = box->getSphereTree();
+    BOOST_CHECK_EQUAL(sphere->getSphereTree(), sphereTree);
+    const float maxGap = 2 * (sphereTree->getMaxLeafRadius() + boxTree->getMaxLeafRadius());
+
+    CollisionCheckerPtr checker = CollisionChecker::getGlobalCollisionChecker();
+    std::mt19937 gen(7);
+    std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f>> poses;
+
+    for (int i = 0; i < 5000; i++)
+    {
+        poses.push_back(randomPose(gen, 150));
+    }
+
+    sphere->setGlobalPose(Eigen::Matrix4f::Identity());
+    std::vector<bool> exact;
+    auto start = std::chrono::steady_clock::now();
+
+    for (const Eigen::Matrix4f& pose : poses)
+    {
+        box->setGlobalPose(pose);
+        exact.push_back(checker->checkCollision(sphere, box));
+    }
+
+    double pqpMs = elapsedMs(start);
+    std::vector<bool> spheres;
+    start = std::chrono::steady_clock::now();
+
+    for (const Eigen::Matrix4f& pose : poses)
+    {
+        spheres.push_back(SphereTree::Collide(*sphereTree, Eigen::Matrix4f::Identity(), *boxTree, pose));
+    }
+
+    double treeMs = elapsedMs(start);
+    int numCollisions = 0;
+    int falsePositives = 0;
+
+    for (size_t i = 0; i < poses.size(); i++)
+    {
+        numCollisions += exact[i] ? 1 : 0;
+        BOOST_CHECK(spheres[i] || !exact[i]);
+
+        if (spheres[i] && !exact[i])
+        {
+            falsePositives++;
+            box->setGlobalPose(poses[i]);
+            BOOST_CHECK_LE(checker->calculateDistance(sphere, box), maxGap);
+        }
+    }
+
+    BOOST_CHECK_GT(numCollisions, 0);
+
+    // point clouds
+    std::vector<Eigen::Vector3f> cloud;
+    std::uniform_real_distribution<float> coordinate(-200.0f, 200.0f);
+
+    for (int i = 0; i < 10000; i++)
+    {
+        cloud.push_back(Eigen::Vector3f(coordinate(gen), coordinate(gen), coordinate(gen)));
+    }
+
+    start = std::chrono::steady_clock::now();
+    int pqpPoints = 0;
+
+    for (const Eigen::Vector3f& p : cloud)
+    {
+        pqpPoints += checker->checkCollision(sphere, p, 1.0f) ? 1 : 0;
+    }
+
+    double pqpPointsMs = elapsedMs(start);
+    start = std::chrono::steady_clock::now();
+    int treePoints = 0;
+
+    for (const Eigen::Vector3f& p : cloud)
+    {
+        treePoints += sphereTree->collides(p, Eigen::Matrix4f::Identity(), 1.0f) ? 1 : 0;
+    }
+
+    double treePointsMs = elapsedMs(start);
+    BOOST_CHECK_GE(treePoints, pqpPoints);
+
+    BOOST_TEST_MESSAGE("sphere (" << sphere->getNumFaces() << " faces, " << sphereTree->getNumLeaves() << " leaves) vs. box ("
+                       << boxTree->getNumLeaves() << " leaves), " << poses.size() << " poses with " << numCollisions << " collisions: "
+                       << "CollisionChecker " << pqpMs * 1000.0 / poses.size() << " us, sphere trees " << treeMs * 1000.0 / poses.size()
+                       << " us with " << falsePositives << " false positives; " << cloud.size() << " points: CollisionChecker "
+                       << pqpPointsMs * 1000.0 / cloud.size() << " us (" << pqpPoints << " hits), sphere tree "
+                       << treePointsMs * 1000.0 / cloud.size() << " us (" << treePoints << " hits)");
+}
+
+BOOST_AUTO_TEST_CASE(testCDManagerModes)
+{
+    ObstaclePtr box1(new Obstacle("Box1", VisualizationNodePtr(), CollisionModelPtr(new CollisionModel(TriMeshUtils::CreateBox(Eigen::Matrix4f::Identity(), 100, 100, 100), "Box1"))));
+    ObstaclePtr box2(new Obstacle("Box2", VisualizationNodePtr(), CollisionModelPtr(new CollisionModel(TriMeshUtils::CreateBox(Eigen::Matrix4f::Identity(), 100, 100, 100), "Box2"))));
+    box1->setGlobalPose(Eigen::Matrix4f::Identity());
+    const float leafRadius = box2->getCollisionModel()->getSphereTree()->getMaxLeafRadius();
+
+    CDManager cdm;
+    cdm.addCollisionModel(box1);
+    cdm.addCollisionModel(box2);
+    BOOST_CHECK_EQUAL(cdm.getCheckMode(), CDManager::eExact);
+
+    auto check = [&](float x, CDManager::CheckMode mode)
+    {
+        Eigen::Matrix4f pose = Eigen::Matrix4f::Identity();
+        pose(0, 3) = x;
+        box2->setGlobalPose(pose);
+        cdm.setCheckMode(mode);
+        return cdm.isInCollision();
+    };
+
+    for (CDManager::CheckMode mode : {CDManager::eExact, CDManager::eSphereTrees, CDManager::eSphereTreesExact})
+    {
+        BOOST_CHECK(!check(300, mode));
+        BOOST_CHECK(check(60, mode));
+    }
+
+    // the sphere trees report boxes that are close, the collision checker verifies them
+    BOOST_CHECK(!check(100 + leafRadius / 2, CDManager::eExact));
+    BOOST_CHECK(check(100 + leafRadius / 2, CDManager::eSphereTrees));
+    BOOST_CHECK(!check(100 + leafRadius / 2, CDManager::eSphereTreesExact));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -4,8 +4,10 @@
 #include <VirtualRobot/VirtualRobotTest.h>
 #include <VirtualRobot/TimeOptimalTrajectory/TimeOptimalTrajectory.h>
 #include <VirtualRobot/TimeOptimalTrajectory/Path.h>
+#include <VirtualRobot/VirtualRobotException.h>
 
 #include <chrono>
+#include <random>
 
 
 BOOST_AUTO_TEST_SUITE(TimeOptimalTrajectory)
@@ -238,4 +240,66 @@ BOOST_AUTO_TEST_CASE(exampleFromSimulationDifficult)
     BOOST_CHECK_EQUAL(trajectory.isValid(), true);
 }
 
+BOOST_AUTO_TEST_CASE(longPathBenchmark)
+{
+    // a random walk of a 6 DoF arm
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> step(-0.5, 0.5);
+    std::list<Eigen::VectorXd> waypoints;
+    Eigen::VectorXd waypoint = Eigen::VectorXd::Zero(6);
+
+    for (int i = 0; i < 300; i++)
+    {
+        for (int j = 0; j < 6; j++)
+        {
+            waypoint[j] += step(gen);
+        }
+
+        waypoints.push_back(waypoint);
+    }
+
+    Eigen::VectorXd maxVelocity = Eigen::VectorXd::Constant(6, 1.0);
+    Eigen::VectorXd maxAcceleration = Eigen::VectorXd::Constant(6, 2.0);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    VirtualRobot::TimeOptimalTrajectory trajectory(VirtualRobot::Path(waypoints, 0.05), maxVelocity, maxAcceleration, 0.001);
+    double generationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    BOOST_REQUIRE(trajectory.isValid());
+
+    // sample at 1 kHz
+    const double samplePeriod = 0.001;
+    const size_t numSamples = trajectory.getNumSamples(samplePeriod);
+    BOOST_CHECK_LE((numSamples - 1) * samplePeriod, trajectory.getDuration());
+    BOOST_CHECK_GT(numSamples * samplePeriod, trajectory.getDuration());
+    Eigen::MatrixXd positions(6, numSamples);
+    Eigen::MatrixXd velocities(6, numSamples);
+
+    start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < numSamples; i++)
+    {
+        positions.col(i) = trajectory.getPosition(i * samplePeriod);
+        velocities.col(i) = trajectory.getVelocity(i * samplePeriod);
+    }
+
+    double singleMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    Eigen::MatrixXd batchPositions(6, numSamples);
+    Eigen::MatrixXd batchVelocities(6, numSamples);
+    start = std::chrono::steady_clock::now();
+    trajectory.sample(samplePeriod, batchPositions, batchVelocities);
+    double batchMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    BOOST_CHECK_EQUAL((batchPositions - positions).cwiseAbs().maxCoeff(), 0.0);
+    BOOST_CHECK_EQUAL((batchVelocities - velocities).cwiseAbs().maxCoeff(), 0.0);
+    BOOST_CHECK_SMALL((positions.col(0) - waypoints.front()).norm(), 1e-6);
+    BOOST_CHECK_SMALL((positions.col(numSamples - 1) - waypoints.back()).norm(), 1e-2);
+    BOOST_CHECK_LE(velocities.cwiseAbs().maxCoeff(), 1.0 + 1e-3);
+    BOOST_CHECK_THROW(trajectory.getNumSamples(0.0), VirtualRobot::VirtualRobotException);
+
+    std::cout << "Trajectory generation (" << waypoints.size() << " waypoints, duration " << trajectory.getDuration() << " s) took: "
+              << generationMs << " ms, sampling " << numSamples << " points at 1 kHz took: " << singleMs << " ms with getPosition/getVelocity, "
+              << batchMs << " ms with sample" << std::endl;
+}
+
 BOOST_AUTO_TEST_SUITE_END()